@@ -71,19 +71,72 @@ public:
      */
     bool prefer_rows() const { return ROW; }
 
+    /**
+     * @param[out] total On output, the total number of structural non-zero elements, obtained from the index pointers.
+     * @return `true`.
+     */
+    bool nonzero_count(size_t& total) const { 
+        total = indptrs[indptrs.size() - 1];
+        return true;
+    }
+
+    /**
+     * @param row Should the number of non-zero elements be reported for each row?
+     * @param[out] counts Pointer to an array of length equal to the number of rows (if `row = true`) or columns (otherwise).
+     *
+     * @return Whether `counts` was filled.
+     * This is only `true` if `row = ROW`, where the numbers are obtained from the index pointers.
+     */
+    bool nonzero_counts(bool row, size_t* counts) const {
+        if (row != ROW) {
+            return false;
+        }
+        for (size_t i = 0, end = indptrs.size() - 1; i < end; ++i) {
+            counts[i] = indptrs[i + 1] - indptrs[i];
+        }
+        return true;
+    }
+
+    /**
+     * @return Approximate number of bytes used by this matrix, including the arrays of values, indices and index pointers.
+     */
+    size_t memory_usage() const {
+        return sizeof(CompressedSparseMatrix) + values.size() * sizeof(values[0]) + indices.size() * sizeof(indices[0]) + indptrs.size() * sizeof(indptrs[0]);
+    }
+
+    /**
+     * @param row Should the usage be reported for a workspace for row extraction?
+     *
+     * @return Approximate number of bytes used by each workspace.
+     * This is zero if `row = ROW`, as no workspace is required; otherwise, it is proportional to the number of columns (if `ROW = false`) or rows.
+     */
+    size_t workspace_memory_usage(bool row) const {
+        if (row == ROW) {
+            return 0;
+        }
+
+        // Including 'below_indices', which is only allocated for non-increasing access.
+        size_t nprimary = indptrs.size() - 1;
+        return sizeof(CompressedSparseWorkspace) + nprimary * (
+            sizeof(size_t) + 
+            sizeof(typename CompressedSparseWorkspace::indptr_type) + 
+            2 * sizeof(typename CompressedSparseWorkspace::index_type)
+        );
+    }
+
 public:
     const T* row(size_t r, T* buffer, size_t first, size_t last, Workspace* work=nullptr) const {
         if constexpr(ROW) {
             primary_dimension_expanded(r, first, last, this->ncols, buffer, 0);
         } else {
-            secondary_dimension_expanded(r, first, last, work, buffer, 0);
+            secondary_dimension_expanded(r, first, last, cast_workspace(work), buffer, 0);
         }
         return buffer;
     }
 
     const T* column(size_t c, T* buffer, size_t first, size_t last, Workspace* work=nullptr) const {
         if constexpr(ROW) {
-            secondary_dimension_expanded(c, first, last, work, buffer, 0);
+            secondary_dimension_expanded(c, first, last, cast_workspace(work), buffer, 0);
         } else {
             primary_dimension_expanded(c, first, last, this->nrows, buffer, 0);
         }
@@ -103,7 +156,7 @@ public:
         if constexpr(ROW) {
             return primary_dimension_raw(r, first, last, this->ncols, vbuffer, ibuffer);
         } else {
-            return secondary_dimension_raw(r, first, last, work, vbuffer, ibuffer); 
+            return secondary_dimension_raw(r, first, last, cast_workspace(work), vbuffer, ibuffer); 
         }
     }
 
@@ -113,7 +166,7 @@ public:
     SparseRange<T, IDX> sparse_column(size_t c, T* vbuffer, IDX* ibuffer, size_t first, size_t last, Workspace* work=nullptr, bool sorted=true) const {
         // It's always sorted anyway, no need to pass along 'sorted'.
         if constexpr(ROW) {
-            return secondary_dimension_raw(c, first, last, work, vbuffer, ibuffer); 
+            return secondary_dimension_raw(c, first, last, cast_workspace(work), vbuffer, ibuffer); 
         } else {
             return primary_dimension_raw(c, first, last, this->nrows, vbuffer, ibuffer);
         }
@@ -123,6 +176,143 @@ public:
 
     using Matrix<T, IDX>::sparse_column;
 
+public:
+    /**
+     * @param row Should views be reported for rows?
+     * @return Whether views are available, i.e., if `row = ROW` and both `U` and `V` have `data()` methods returning pointers to `T` and `IDX`, respectively.
+     */
+    bool has_sparse_view(bool row) const {
+        if constexpr(has_data<T, U>::value && has_data<IDX, V>::value) {
+            return row == ROW;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @copydoc Matrix::sparse_row_view()
+     */
+    bool sparse_row_view(size_t r, SparseRange<T, IDX>& view, size_t first, size_t last) const {
+        if constexpr(ROW) {
+            return primary_dimension_view(r, view, first, last, this->ncols);
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @copydoc Matrix::sparse_column_view()
+     */
+    bool sparse_column_view(size_t c, SparseRange<T, IDX>& view, size_t first, size_t last) const {
+        if constexpr(ROW) {
+            return false;
+        } else {
+            return primary_dimension_view(c, view, first, last, this->nrows);
+        }
+    }
+
+    using Matrix<T, IDX>::sparse_row_view;
+
+    using Matrix<T, IDX>::sparse_column_view;
+
+public:
+    /**
+     * @copydoc Matrix::rows()
+     */
+    const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            primary_block_expanded(first_row, last_row, first_col, last_col, buffer);
+        } else {
+            secondary_block_expanded(first_row, last_row, first_col, last_col, buffer);
+        }
+        return buffer;
+    }
+
+    /**
+     * @copydoc Matrix::columns()
+     */
+    const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            secondary_block_expanded(first_col, last_col, first_row, last_row, buffer);
+        } else {
+            primary_block_expanded(first_col, last_col, first_row, last_row, buffer);
+        }
+        return buffer;
+    }
+
+    /**
+     * @copydoc Matrix::sparse_rows()
+     */
+    SparseRange<T, IDX> sparse_rows(size_t first_row, size_t last_row, T* vbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_col, size_t last_col, Workspace* work=nullptr, bool sorted=true) const {
+        // Again, it's always sorted, no need to pass along 'sorted'.
+        if constexpr(ROW) {
+            return primary_block_raw(first_row, last_row, first_col, last_col, vbuffer, ibuffer, pbuffer);
+        } else {
+            return secondary_block_raw(first_row, last_row, first_col, last_col, vbuffer, ibuffer, pbuffer);
+        }
+    }
+
+    /**
+     * @copydoc Matrix::sparse_columns()
+     */
+    SparseRange<T, IDX> sparse_columns(size_t first_col, size_t last_col, T* vbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_row, size_t last_row, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(ROW) {
+            return secondary_block_raw(first_col, last_col, first_row, last_row, vbuffer, ibuffer, pbuffer);
+        } else {
+            return primary_block_raw(first_col, last_col, first_row, last_row, vbuffer, ibuffer, pbuffer);
+        }
+    }
+
+public:
+    /**
+     * @copydoc Matrix::row_indexed()
+     */
+    const T* row_indexed(size_t r, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            primary_indexed_expanded(r, n, indices, buffer);
+        } else {
+            secondary_indexed_expanded(r, n, indices, cast_workspace(work), buffer);
+        }
+        return buffer;
+    }
+
+    /**
+     * @copydoc Matrix::column_indexed()
+     */
+    const T* column_indexed(size_t c, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            secondary_indexed_expanded(c, n, indices, cast_workspace(work), buffer);
+        } else {
+            primary_indexed_expanded(c, n, indices, buffer);
+        }
+        return buffer;
+    }
+
+    /**
+     * @copydoc Matrix::sparse_row_indexed()
+     */
+    SparseRange<T, IDX> sparse_row_indexed(size_t r, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(ROW) {
+            return primary_indexed_raw(r, n, indices, vbuffer, ibuffer);
+        } else {
+            return secondary_indexed_raw(r, n, indices, cast_workspace(work), vbuffer, ibuffer);
+        }
+    }
+
+    /**
+     * @copydoc Matrix::sparse_column_indexed()
+     */
+    SparseRange<T, IDX> sparse_column_indexed(size_t c, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(ROW) {
+            return secondary_indexed_raw(c, n, indices, cast_workspace(work), vbuffer, ibuffer);
+        } else {
+            return primary_indexed_raw(c, n, indices, vbuffer, ibuffer);
+        }
+    }
+
+public:
+    struct CompressedSparseWorkspace;
+
 private:
     size_t nrows, ncols;
     U values;
@@ -198,16 +388,34 @@ private:
         return std::make_pair(iIt - indices.begin(), eIt - iIt);
     }
 
-    SparseRange<T, IDX> primary_dimension_raw(size_t i, size_t first, size_t last, size_t otherdim, T* out_values, IDX* out_indices) const {
+    bool primary_dimension_view(size_t i, SparseRange<T, IDX>& view, size_t first, size_t last, size_t otherdim) const {
+        if constexpr(has_data<T, U>::value && has_data<IDX, V>::value) {
+            auto obtained = primary_dimension(i, first, last, otherdim);
+            view.number = obtained.second;
+            view.value = values.data() + obtained.first;
+            view.index = indices.data() + obtained.first;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    SparseRange<T, IDX> primary_dimension_raw(size_t i, size_t first, size_t last, size_t otherdim, T* out_values, IDX* out_indices, SparseExtractMode mode = SPARSE_EXTRACT_BOTH) const {
+        // For the full range, the count is obtained from 'indptrs' without touching the indices.
         auto obtained = primary_dimension(i, first, last, otherdim);
         SparseRange<T, IDX> output(obtained.second);
+        if (mode == SPARSE_EXTRACT_NONE) {
+            return output;
+        }
 
-        if constexpr(has_data<T, U>::value) {
-            output.value = values.data() + obtained.first;
-        } else {
-            auto vIt = values.begin() + obtained.first;
-            std::copy(vIt, vIt + obtained.second, out_values);
-            output.value = out_values;
+        if (mode == SPARSE_EXTRACT_BOTH) {
+            if constexpr(has_data<T, U>::value) {
+                output.value = values.data() + obtained.first;
+            } else {
+                auto vIt = values.begin() + obtained.first;
+                std::copy(vIt, vIt + obtained.second, out_values);
+                output.value = out_values;
+            }
         }
 
         if constexpr(has_data<IDX, V>::value) {
@@ -232,6 +440,199 @@ private:
         return;
     }
 
+private:
+    void primary_block_expanded(size_t first, size_t last, size_t start, size_t end, T* out_values) const {
+        auto otherdim = max_secondary_index();
+        size_t width = end - start;
+        for (size_t i = first; i < last; ++i, out_values += width) {
+            primary_dimension_expanded(i, start, end, otherdim, out_values, 0);
+        }
+        return;
+    }
+
+    SparseRange<T, IDX> primary_block_raw(size_t first, size_t last, size_t start, size_t end, T* out_values, IDX* out_indices, size_t* out_pointers) const {
+        auto otherdim = max_secondary_index();
+        out_pointers[0] = 0;
+
+        if (start == 0 && end == otherdim) {
+            // Full-length primary vectors are already contiguous, so we can just return them directly.
+            const size_t offset = indptrs[first];
+            for (size_t i = first; i < last; ++i) {
+                out_pointers[i - first + 1] = indptrs[i + 1] - offset;
+            }
+
+            const size_t total = indptrs[last] - offset;
+            SparseRange<T, IDX> output(total);
+
+            if constexpr(has_data<T, U>::value) {
+                output.value = values.data() + offset;
+            } else {
+                auto vIt = values.begin() + offset;
+                std::copy(vIt, vIt + total, out_values);
+                output.value = out_values;
+            }
+
+            if constexpr(has_data<IDX, V>::value) {
+                output.index = indices.data() + offset;
+            } else {
+                auto iIt = indices.begin() + offset;
+                std::copy(iIt, iIt + total, out_indices);
+                output.index = out_indices;
+            }
+
+            return output;
+        }
+
+        size_t total = 0;
+        for (size_t i = first; i < last; ++i) {
+            auto obtained = primary_dimension(i, start, end, otherdim);
+            auto vIt = values.begin() + obtained.first;
+            std::copy(vIt, vIt + obtained.second, out_values + total);
+            auto iIt = indices.begin() + obtained.first;
+            std::copy(iIt, iIt + obtained.second, out_indices + total);
+            total += obtained.second;
+            out_pointers[i - first + 1] = total;
+        }
+
+        return SparseRange<T, IDX>(total, out_values, out_indices);
+    }
+
+    /* For a block along the secondary dimension, we iterate across the
+     * requested range of the primary dimension and scatter the non-zero
+     * elements into their destinations. This involves only one search per
+     * primary element, rather than one search per primary element for each
+     * secondary element as would be the case for repeated secondary calls.
+     */
+    void secondary_block_expanded(size_t first, size_t last, size_t start, size_t end, T* out_values) const {
+        auto otherdim = max_secondary_index();
+        size_t width = end - start;
+        std::fill(out_values, out_values + (last - first) * width, static_cast<T>(0));
+
+        for (size_t p = start; p < end; ++p) {
+            auto obtained = primary_dimension(p, first, last, otherdim);
+            auto vIt = values.begin() + obtained.first;
+            auto iIt = indices.begin() + obtained.first;
+            for (size_t x = 0; x < obtained.second; ++x, ++vIt, ++iIt) {
+                out_values[(*iIt - first) * width + (p - start)] = *vIt;
+            }
+        }
+        return;
+    }
+
+    SparseRange<T, IDX> secondary_block_raw(size_t first, size_t last, size_t start, size_t end, T* out_values, IDX* out_indices, size_t* out_pointers) const {
+        auto otherdim = max_secondary_index();
+        size_t height = last - first;
+        std::fill(out_pointers, out_pointers + height + 1, 0);
+
+        // First pass to count the number of non-zero elements for each secondary element.
+        std::vector<std::pair<size_t, size_t> > ranges;
+        ranges.reserve(end - start);
+        for (size_t p = start; p < end; ++p) {
+            ranges.push_back(primary_dimension(p, first, last, otherdim));
+            const auto& obtained = ranges.back();
+            auto iIt = indices.begin() + obtained.first;
+            for (size_t x = 0; x < obtained.second; ++x, ++iIt) {
+                ++out_pointers[*iIt - first + 1];
+            }
+        }
+
+        for (size_t s = 1; s <= height; ++s) {
+            out_pointers[s] += out_pointers[s - 1];
+        }
+
+        // Second pass to fill the outputs, using 'out_pointers' as the insertion
+        // position for each secondary element. Iterating across the primary
+        // dimension in increasing order guarantees that the output is sorted.
+        for (size_t p = start; p < end; ++p) {
+            const auto& obtained = ranges[p - start];
+            auto vIt = values.begin() + obtained.first;
+            auto iIt = indices.begin() + obtained.first;
+            for (size_t x = 0; x < obtained.second; ++x, ++vIt, ++iIt) {
+                auto& pos = out_pointers[*iIt - first];
+                out_values[pos] = *vIt;
+                out_indices[pos] = p;
+                ++pos;
+            }
+        }
+
+        // Each insertion position now points to the start of the next
+        // secondary element, so we shift everything back by one.
+        for (size_t s = height; s > 0; --s) {
+            out_pointers[s] = out_pointers[s - 1];
+        }
+        out_pointers[0] = 0;
+
+        return SparseRange<T, IDX>(out_pointers[height], out_values, out_indices);
+    }
+
+private:
+    /* Walks through the non-zero elements of primary element 'i' in the span of 'indices',
+     * calling 'fun(k, offset)' for each 'indices[k]' that has a non-zero element at 'offset'.
+     */
+    template<class Function>
+    void primary_indexed(size_t i, size_t n, const IDX* indices, Function fun) const {
+        if (n == 0) {
+            return;
+        }
+
+        auto obtained = primary_dimension(i, indices[0], static_cast<size_t>(indices[n - 1]) + 1, max_secondary_index());
+        size_t k = 0;
+        for (size_t x = obtained.first, end = obtained.first + obtained.second; x < end; ++x) {
+            size_t current = this->indices[x];
+            while (k < n && static_cast<size_t>(indices[k]) < current) {
+                ++k;
+            }
+            if (k == n) {
+                break;
+            }
+            if (static_cast<size_t>(indices[k]) == current) {
+                fun(k, x);
+            }
+        }
+        return;
+    }
+
+    void primary_indexed_expanded(size_t i, size_t n, const IDX* indices, T* out_values) const {
+        std::fill(out_values, out_values + n, static_cast<T>(0));
+        primary_indexed(i, n, indices, [&](size_t k, size_t x) -> void {
+            out_values[k] = values[x];
+        });
+        return;
+    }
+
+    SparseRange<T, IDX> primary_indexed_raw(size_t i, size_t n, const IDX* indices, T* out_values, IDX* out_indices) const {
+        size_t counter = 0;
+        primary_indexed(i, n, indices, [&](size_t k, size_t x) -> void {
+            out_values[counter] = values[x];
+            out_indices[counter] = indices[k];
+            ++counter;
+        });
+        return SparseRange<T, IDX>(counter, out_values, out_indices);
+    }
+
+    void secondary_indexed_expanded(IDX i, size_t n, const IDX* indices, CompressedSparseWorkspace* worker, T* out_values) const {
+        const size_t notfound = this->indices.size();
+        for (size_t k = 0; k < n; ++k) {
+            auto pos = secondary_dimension_lookup(i, indices[k], worker);
+            out_values[k] = (pos != notfound ? values[pos] : static_cast<T>(0));
+        }
+        return;
+    }
+
+    SparseRange<T, IDX> secondary_indexed_raw(IDX i, size_t n, const IDX* indices, CompressedSparseWorkspace* worker, T* out_values, IDX* out_indices) const {
+        const size_t notfound = this->indices.size();
+        size_t counter = 0;
+        for (size_t k = 0; k < n; ++k) {
+            auto pos = secondary_dimension_lookup(i, indices[k], worker);
+            if (pos != notfound) {
+                out_values[counter] = values[pos];
+                out_indices[counter] = indices[k];
+                ++counter;
+            }
+        }
+        return SparseRange<T, IDX>(counter, out_values, out_indices);
+    }
+
 public:
     /**
      * @param row Should a workspace be created for row-wise extraction?
@@ -254,6 +655,53 @@ public:
         }
     }
 
+    /**
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()`.
+     * @param oracle Pointer to an oracle predicting the upcoming requests.
+     *
+     * For extraction along the non-preferred dimension, the index pointers in `work` are moved to the first predicted request,
+     * and the tracking for decreasing indices is set up in advance if the predicted requests are not increasing.
+     * This has no effect along the preferred dimension, as no workspace is required.
+     */
+    void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {
+        prepare_oracle(cast_workspace(work), oracle.get());
+    }
+
+private:
+    void prepare_oracle(CompressedSparseWorkspace* worker, const Oracle* oracle) const {
+        if (worker == NULL || oracle == NULL || oracle->total() == 0) {
+            return;
+        }
+
+        size_t first = oracle->get(0);
+        auto max_index = max_secondary_index();
+        for (size_t current = 0, end = worker->previous_request.size(); current < end; ++current) {
+            auto limit = indptrs[current + 1];
+            size_t curptr = std::lower_bound(indices.begin() + indptrs[current], indices.begin() + limit, first) - indices.begin();
+            worker->current_indptrs[current] = curptr;
+            worker->current_indices[current] = (curptr < limit ? indices[curptr] : max_index);
+            worker->previous_request[current] = first;
+        }
+
+        if (!worker->store_below) {
+            for (size_t p = 1, total = oracle->total(); p < total; ++p) {
+                if (oracle->get(p) < oracle->get(p - 1)) {
+                    worker->store_below = true;
+                    break;
+                }
+            }
+        }
+
+        if (worker->store_below) {
+            worker->below_indices.resize(worker->previous_request.size());
+            for (size_t j = 0, end = worker->below_indices.size(); j != end; ++j) {
+                worker->below_indices[j] = define_below_index(j, worker->current_indptrs[j]);
+            }
+        }
+    }
+
+public:
     struct CompressedSparseWorkspace : public Workspace {
         CompressedSparseWorkspace(size_t max_index, const V& idx, const W& idp) : 
             previous_request(idp.size() - 1),
@@ -293,6 +741,111 @@ public:
         bool store_below = false;
     };
 
+public:
+    /**
+     * @param first First column to extract for each row.
+     * @param last One past the last column to extract for each row.
+     *
+     * @return A `DenseExtractor` for rows of this matrix.
+     * For extraction along the non-preferred dimension, the extractor holds its own `CompressedSparseWorkspace` that is used without any casting.
+     */
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new CompressedDenseExtractor<true>(this, first, last));
+    }
+
+    /**
+     * @param first First row to extract for each column.
+     * @param last One past the last row to extract for each column.
+     *
+     * @return A `DenseExtractor` for columns of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new CompressedDenseExtractor<false>(this, first, last));
+    }
+
+    /**
+     * @param first First column to extract for each row.
+     * @param last One past the last column to extract for each row.
+     * @param sorted Ignored, as the non-zero elements are always sorted.
+     * @param mode Components of the non-zero elements to be extracted.
+     *
+     * @return A `SparseExtractor` for rows of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new CompressedSparseExtractor<true>(this, first, last, sorted, mode));
+    }
+
+    /**
+     * @param first First row to extract for each column.
+     * @param last One past the last row to extract for each column.
+     * @param sorted Ignored, as the non-zero elements are always sorted.
+     * @param mode Components of the non-zero elements to be extracted.
+     *
+     * @return A `SparseExtractor` for columns of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new CompressedSparseExtractor<false>(this, first, last, sorted, mode));
+    }
+
+    using Matrix<T, IDX>::dense_row_extractor;
+
+    using Matrix<T, IDX>::dense_column_extractor;
+
+    using Matrix<T, IDX>::sparse_row_extractor;
+
+    using Matrix<T, IDX>::sparse_column_extractor;
+
+private:
+    /* Extractors hold a workspace only for the non-preferred dimension, i.e., when WANT_ROW != ROW. */
+    template<bool WANT_ROW>
+    struct CompressedDenseExtractor : public DenseExtractor<T, IDX> {
+        CompressedDenseExtractor(const CompressedSparseMatrix* p, size_t first, size_t last) : DenseExtractor<T, IDX>(first, last), parent(p) {
+            if constexpr(WANT_ROW != ROW) {
+                work.reset(new CompressedSparseWorkspace(parent->max_secondary_index(), parent->indices, parent->indptrs));
+            }
+        }
+
+        const T* fetch(size_t i, T* buffer) {
+            if constexpr(WANT_ROW == ROW) {
+                parent->primary_dimension_expanded(i, this->block_first, this->block_last, parent->max_secondary_index(), buffer, 0);
+            } else {
+                parent->secondary_dimension_expanded(i, this->block_first, this->block_last, work.get(), buffer, 0);
+            }
+            return buffer;
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            parent->prepare_oracle(work.get(), oracle.get());
+        }
+
+        const CompressedSparseMatrix* parent;
+        std::unique_ptr<CompressedSparseWorkspace> work;
+    };
+
+    template<bool WANT_ROW>
+    struct CompressedSparseExtractor : public SparseExtractor<T, IDX> {
+        CompressedSparseExtractor(const CompressedSparseMatrix* p, size_t first, size_t last, bool sorted, SparseExtractMode mode) : SparseExtractor<T, IDX>(first, last, sorted, mode), parent(p) {
+            if constexpr(WANT_ROW != ROW) {
+                work.reset(new CompressedSparseWorkspace(parent->max_secondary_index(), parent->indices, parent->indptrs));
+            }
+        }
+
+        SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) {
+            if constexpr(WANT_ROW == ROW) {
+                return parent->primary_dimension_raw(i, this->block_first, this->block_last, parent->max_secondary_index(), vbuffer, ibuffer, this->extract_mode);
+            } else {
+                return parent->secondary_dimension_raw(i, this->block_first, this->block_last, work.get(), vbuffer, ibuffer, this->extract_mode);
+            }
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            parent->prepare_oracle(work.get(), oracle.get());
+        }
+
+        const CompressedSparseMatrix* parent;
+        std::unique_ptr<CompressedSparseWorkspace> work;
+    };
+
 private:
     size_t max_secondary_index() const {
         if constexpr(ROW) {
@@ -310,101 +863,113 @@ private:
         return (curptr > indptrs[pos] ? indices[curptr - 1] + 1 : 0);
     }
 
-    template<class STORE>
-    void secondary_dimension(IDX i, size_t first, size_t last, Workspace* work, STORE& output) const {
-        if (work == nullptr) {
-            for (size_t c = first; c < last; ++c) { 
-                auto start = indices.begin() + indptrs[c];
-                auto end = indices.begin() + indptrs[c+1];
-                auto iIt = std::lower_bound(start, end, i);
-                if (iIt != end && *iIt == i) { 
-                    auto offset = iIt - indices.begin();
-                    output.add(c, values[offset]);
-                }
+    /* Returns the position of the element at 'i' in the primary element 'current',
+     * or the total number of non-zero elements if no such element exists.
+     */
+    size_t secondary_dimension_lookup(IDX i, size_t current, CompressedSparseWorkspace* worker) const {
+        if (worker == NULL) {
+            auto start = indices.begin() + indptrs[current];
+            auto end = indices.begin() + indptrs[current + 1];
+            auto iIt = std::lower_bound(start, end, i);
+            if (iIt != end && *iIt == i) { 
+                return iIt - indices.begin();
             }
-        } else {
-            CompressedSparseWorkspace& worker = *(dynamic_cast<CompressedSparseWorkspace*>(work));
-            auto max_index = max_secondary_index();
-
-            for (size_t current = first; current < last; ++current) {
-                auto& prev_i = worker.previous_request[current];
-                auto& curptr = worker.current_indptrs[current];
-                auto& curdex = worker.current_indices[current];
-
-                if (i > prev_i) {
-
-                    // Remember that we already store the index corresponding to the current indptr.
-                    // So, we only need to do more work if the request is greater than that index.
-                    if (i > curdex) {
-
-                        // Having a peek at the index of the next non-zero
-                        // element; maybe we're lucky enough that the requested
-                        // index is below this, as would be the case for
-                        // consecutive or near-consecutive accesses.
-                        ++curptr;
-                        auto limit = indptrs[current + 1];
-                        if (curptr < limit) {
-                            auto candidate = indices[curptr];
-                            if (candidate >= i) {
-                                curdex = candidate;
-                            } else {
-                                // Otherwise we need to search.
-                                curptr = std::lower_bound(indices.begin() + curptr, indices.begin() + limit, i) - indices.begin();
-                                curdex = (curptr < limit ? indices[curptr] : max_index);
-                            }
-                        } else {
-                            curdex = max_index;
-                        }
+            return indices.size();
+        }
 
-                        if (worker.store_below) {
-                            worker.below_indices[current] = define_below_index(current, curptr);
-                        }
-                    }
+        auto& prev_i = worker->previous_request[current];
+        auto& curptr = worker->current_indptrs[current];
+        auto& curdex = worker->current_indices[current];
+        auto max_index = max_secondary_index();
 
-                } else if (i < prev_i) {
-                    if (!worker.store_below) {
-                        worker.store_below = true;
+        if (i > prev_i) {
 
-                        // Backfilling everything so that all uses of 'below_indices' are valid.
-                        worker.below_indices.resize(worker.previous_request.size());
-                        for (size_t j = 0, end = worker.below_indices.size(); j != end; ++j) {
-                            worker.below_indices[j] = define_below_index(j, worker.current_indptrs[j]);
-                        }
+            // Remember that we already store the index corresponding to the current indptr.
+            // So, we only need to do more work if the request is greater than that index.
+            if (i > curdex) {
+
+                // Having a peek at the index of the next non-zero
+                // element; maybe we're lucky enough that the requested
+                // index is below this, as would be the case for
+                // consecutive or near-consecutive accesses.
+                ++curptr;
+                auto limit = indptrs[current + 1];
+                if (curptr < limit) {
+                    auto candidate = indices[curptr];
+                    if (candidate >= i) {
+                        curdex = candidate;
+                    } else {
+                        // Otherwise we need to search.
+                        curptr = std::lower_bound(indices.begin() + curptr, indices.begin() + limit, i) - indices.begin();
+                        curdex = (curptr < limit ? indices[curptr] : max_index);
                     }
+                } else {
+                    curdex = max_index;
+                }
 
-                    // Remember that below_indices stores 'indices[curptr - 1] + 1'.
-                    // So, we only need to do more work if the request is less than this;
-                    // otherwise the curptr remains unchanged. We also skip if curptr is
-                    // equal to 'indptrs[current]' because decreasing is impossible.
-                    auto& prevdex = worker.below_indices[current];
-                    auto limit = indptrs[current];
-                    if (i < prevdex && curptr > limit) {
-
-                        // Having a peek at the index of the non-zero element below us.
-                        // Maybe we're lucky and the requested index is equal to this,
-                        // in which case we can use it directly. This would be the case
-                        // for consecutive accesses in the opposite direction.
-                        auto candidate = indices[curptr - 1];
-                        if (candidate == i) {
-                            --curptr;
-                            curdex = candidate;
-                        } else if (candidate < i) {
-                            // Do nothing... though we should have never gotten here 
-                            // in the first place, as it would imply that 'i >= prevdex'.
-                        } else {
-                            // Otherwise we need to search.
-                            curptr = std::lower_bound(indices.begin() + limit, indices.begin() + curptr - 1, i) - indices.begin();
-                            curdex = indices[curptr]; // guaranteed to be valid as curptr - 1 >= limit.
-                        }
+                if (worker->store_below) {
+                    worker->below_indices[current] = define_below_index(current, curptr);
+                }
+            }
 
-                        prevdex = define_below_index(current, curptr);
-                    }
+        } else if (i < prev_i) {
+            if (!worker->store_below) {
+                worker->store_below = true;
+
+                // Backfilling everything so that all uses of 'below_indices' are valid.
+                worker->below_indices.resize(worker->previous_request.size());
+                for (size_t j = 0, end = worker->below_indices.size(); j != end; ++j) {
+                    worker->below_indices[j] = define_below_index(j, worker->current_indptrs[j]);
                 }
+            }
 
-                prev_i = i;
-                if (curdex == i) { // assuming i < max_index, of course.
-                    output.add(current, values[curptr]);
+            // Remember that below_indices stores 'indices[curptr - 1] + 1'.
+            // So, we only need to do more work if the request is less than this;
+            // otherwise the curptr remains unchanged. We also skip if curptr is
+            // equal to 'indptrs[current]' because decreasing is impossible.
+            auto& prevdex = worker->below_indices[current];
+            auto limit = indptrs[current];
+            if (i < prevdex && curptr > limit) {
+
+                // Having a peek at the index of the non-zero element below us.
+                // Maybe we're lucky and the requested index is equal to this,
+                // in which case we can use it directly. This would be the case
+                // for consecutive accesses in the opposite direction.
+                auto candidate = indices[curptr - 1];
+                if (candidate == i) {
+                    --curptr;
+                    curdex = candidate;
+                } else if (candidate < i) {
+                    // Do nothing... though we should have never gotten here 
+                    // in the first place, as it would imply that 'i >= prevdex'.
+                } else {
+                    // Otherwise we need to search.
+                    curptr = std::lower_bound(indices.begin() + limit, indices.begin() + curptr - 1, i) - indices.begin();
+                    curdex = indices[curptr]; // guaranteed to be valid as curptr - 1 >= limit.
                 }
+
+                prevdex = define_below_index(current, curptr);
+            }
+        }
+
+        prev_i = i;
+        if (curdex == i) { // assuming i < max_index, of course.
+            return curptr;
+        }
+        return indices.size();
+    }
+
+    static CompressedSparseWorkspace* cast_workspace(Workspace* work) {
+        return (work == nullptr ? NULL : dynamic_cast<CompressedSparseWorkspace*>(work));
+    }
+
+    template<class STORE>
+    void secondary_dimension(IDX i, size_t first, size_t last, CompressedSparseWorkspace* worker, STORE& output) const {
+        const size_t notfound = indices.size();
+        for (size_t current = first; current < last; ++current) {
+            auto pos = secondary_dimension_lookup(i, current, worker);
+            if (pos != notfound) {
+                output.add(current, values[pos]);
             }
         }
         return;
@@ -425,11 +990,41 @@ private:
         }
     };
 
-    SparseRange<T, IDX> secondary_dimension_raw(IDX i, size_t first, size_t last, Workspace* work, T* out_values, IDX* out_indices) const {
+    struct index_store {
+        IDX* out_indices;
+        size_t n = 0;
+        void add(IDX i, T) {
+            ++n;
+            *out_indices = i;
+            ++out_indices;
+            return;
+        }
+    };
+
+    struct count_store {
+        size_t n = 0;
+        void add(IDX, T) {
+            ++n;
+            return;
+        }
+    };
+
+    SparseRange<T, IDX> secondary_dimension_raw(IDX i, size_t first, size_t last, CompressedSparseWorkspace* worker, T* out_values, IDX* out_indices, SparseExtractMode mode = SPARSE_EXTRACT_BOTH) const {
+        if (mode == SPARSE_EXTRACT_NONE) {
+            count_store store;
+            secondary_dimension(i, first, last, worker, store);
+            return SparseRange<T, IDX>(store.n);
+        } else if (mode == SPARSE_EXTRACT_INDEX) {
+            index_store store;
+            store.out_indices = out_indices;
+            secondary_dimension(i, first, last, worker, store);
+            return SparseRange<T, IDX>(store.n, NULL, out_indices);
+        }
+
         raw_store store;
         store.out_values = out_values;
         store.out_indices = out_indices;
-        secondary_dimension(i, first, last, work, store);
+        secondary_dimension(i, first, last, worker, store);
         return SparseRange<T, IDX>(store.n, out_values, out_indices);
     }
 
@@ -442,12 +1037,12 @@ private:
         }
     };
 
-    void secondary_dimension_expanded(IDX i, size_t first, size_t last, Workspace* work, T* out_values, T empty) const {
+    void secondary_dimension_expanded(IDX i, size_t first, size_t last, CompressedSparseWorkspace* worker, T* out_values, T empty) const {
         std::fill(out_values, out_values + (last - first), empty);
         expanded_store store;
         store.out_values = out_values;
         store.first = first;
-        secondary_dimension(i, first, last, work, store);
+        secondary_dimension(i, first, last, worker, store);
         return;
     }
 };
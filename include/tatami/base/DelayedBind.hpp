@@ -4,6 +4,7 @@
 #include "Matrix.hpp"
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 /**
  * @file DelayedBind.hpp
@@ -155,6 +156,85 @@ public:
 
     using Matrix<T, IDX>::sparse_row;
 
+public:
+    /**
+     * @param row Should views be reported for rows?
+     * @return Whether views are available from all underlying matrices.
+     * This is always `false` for extraction across the combining dimension, as the values would need to be assembled from multiple matrices.
+     */
+    bool has_dense_view(bool row) const {
+        if (row != (MARGIN == 0)) {
+            return false;
+        }
+        for (const auto& x : mats) {
+            if (!x->has_dense_view(row)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @param row Should views be reported for rows?
+     * @return Whether views are available from all underlying matrices.
+     * This is always `false` for extraction across the combining dimension.
+     */
+    bool has_sparse_view(bool row) const {
+        if (row != (MARGIN == 0)) {
+            return false;
+        }
+        for (const auto& x : mats) {
+            if (!x->has_sparse_view(row)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool row_view(size_t r, const T*& view, size_t first, size_t last) const {
+        if constexpr(MARGIN == 0) {
+            size_t chosen = std::upper_bound(cumulative.begin(), cumulative.end(), r) - cumulative.begin() - 1;
+            return mats[chosen]->row_view(r - cumulative[chosen], view, first, last);
+        } else {
+            return false;
+        }
+    }
+
+    bool column_view(size_t c, const T*& view, size_t first, size_t last) const {
+        if constexpr(MARGIN == 0) {
+            return false;
+        } else {
+            size_t chosen = std::upper_bound(cumulative.begin(), cumulative.end(), c) - cumulative.begin() - 1;
+            return mats[chosen]->column_view(c - cumulative[chosen], view, first, last);
+        }
+    }
+
+    bool sparse_row_view(size_t r, SparseRange<T, IDX>& view, size_t first, size_t last) const {
+        if constexpr(MARGIN == 0) {
+            size_t chosen = std::upper_bound(cumulative.begin(), cumulative.end(), r) - cumulative.begin() - 1;
+            return mats[chosen]->sparse_row_view(r - cumulative[chosen], view, first, last);
+        } else {
+            return false;
+        }
+    }
+
+    bool sparse_column_view(size_t c, SparseRange<T, IDX>& view, size_t first, size_t last) const {
+        if constexpr(MARGIN == 0) {
+            return false;
+        } else {
+            size_t chosen = std::upper_bound(cumulative.begin(), cumulative.end(), c) - cumulative.begin() - 1;
+            return mats[chosen]->sparse_column_view(c - cumulative[chosen], view, first, last);
+        }
+    }
+
+    using Matrix<T, IDX>::row_view;
+
+    using Matrix<T, IDX>::column_view;
+
+    using Matrix<T, IDX>::sparse_row_view;
+
+    using Matrix<T, IDX>::sparse_column_view;
+
 private:
     template<bool ROW>
     SparseRange<T, IDX> extract_one_dimension_sparse(size_t i, T* out_values, IDX* out_indices, size_t start, size_t end, Workspace* work=nullptr, bool sorted=true) const {
@@ -224,6 +304,278 @@ private:
         return output;
     }
 
+public:
+    const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        if constexpr(MARGIN==0) {
+            return concatenate_blocks<true>(first_row, last_row, buffer, first_col, last_col, work);
+        } else {
+            return Matrix<T, IDX>::rows(first_row, last_row, buffer, first_col, last_col, work);
+        }
+    }
+
+    const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        if constexpr(MARGIN==0) {
+            return Matrix<T, IDX>::columns(first_col, last_col, buffer, first_row, last_row, work);
+        } else {
+            return concatenate_blocks<false>(first_col, last_col, buffer, first_row, last_row, work);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_rows(size_t first_row, size_t last_row, T* out_values, IDX* out_indices, size_t* out_pointers, size_t first_col, size_t last_col, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(MARGIN==0) {
+            return concatenate_blocks_sparse<true>(first_row, last_row, out_values, out_indices, out_pointers, first_col, last_col, work, sorted);
+        } else {
+            return Matrix<T, IDX>::sparse_rows(first_row, last_row, out_values, out_indices, out_pointers, first_col, last_col, work, sorted);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_columns(size_t first_col, size_t last_col, T* out_values, IDX* out_indices, size_t* out_pointers, size_t first_row, size_t last_row, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(MARGIN==0) {
+            return Matrix<T, IDX>::sparse_columns(first_col, last_col, out_values, out_indices, out_pointers, first_row, last_row, work, sorted);
+        } else {
+            return concatenate_blocks_sparse<false>(first_col, last_col, out_values, out_indices, out_pointers, first_row, last_row, work, sorted);
+        }
+    }
+
+private:
+    template<bool ROW>
+    const T* concatenate_blocks(size_t first, size_t last, T* buffer, size_t start, size_t end, Workspace* work) const {
+        BindWorkspace* work2 = NULL;
+        if (work != nullptr) {
+            work2 = static_cast<BindWorkspace*>(work);
+        }
+
+        size_t left = std::upper_bound(cumulative.begin(), cumulative.end(), first) - cumulative.begin() - 1;
+        size_t width = end - start;
+        size_t current = first;
+        auto output = buffer;
+
+        while (current < last) {
+            size_t curfirst = current - cumulative[left];
+            size_t curlast = std::min(cumulative[left + 1], last) - cumulative[left];
+
+            Workspace* curwork = NULL;
+            if (work2 != NULL) {
+                curwork = work2->workspaces[left].get();
+            }
+
+            const T* ptr;
+            if constexpr(ROW) {
+                ptr = mats[left]->rows(curfirst, curlast, output, start, end, curwork);
+            } else {
+                ptr = mats[left]->columns(curfirst, curlast, output, start, end, curwork);
+            }
+
+            size_t filled = (curlast - curfirst) * width;
+            if (ptr != output) {
+                std::copy(ptr, ptr + filled, output);
+            }
+            output += filled;
+            current += curlast - curfirst;
+            ++left;
+        }
+
+        return buffer;
+    }
+
+    template<bool ROW>
+    SparseRange<T, IDX> concatenate_blocks_sparse(size_t first, size_t last, T* out_values, IDX* out_indices, size_t* out_pointers, size_t start, size_t end, Workspace* work, bool sorted) const {
+        BindWorkspace* work2 = NULL;
+        if (work != nullptr) {
+            work2 = static_cast<BindWorkspace*>(work);
+        }
+
+        size_t left = std::upper_bound(cumulative.begin(), cumulative.end(), first) - cumulative.begin() - 1;
+        size_t current = first;
+        size_t total = 0;
+        out_pointers[0] = 0;
+
+        while (current < last) {
+            size_t curfirst = current - cumulative[left];
+            size_t curlast = std::min(cumulative[left + 1], last) - cumulative[left];
+
+            Workspace* curwork = NULL;
+            if (work2 != NULL) {
+                curwork = work2->workspaces[left].get();
+            }
+
+            // Each child fills its own offsets from zero, which are then shifted by the number of elements before it.
+            auto curvalues = out_values + total;
+            auto curindices = out_indices + total;
+            auto curpointers = out_pointers + (current - first);
+
+            SparseRange<T, IDX> range;
+            if constexpr(ROW) {
+                range = mats[left]->sparse_rows(curfirst, curlast, curvalues, curindices, curpointers, start, end, curwork, sorted);
+            } else {
+                range = mats[left]->sparse_columns(curfirst, curlast, curvalues, curindices, curpointers, start, end, curwork, sorted);
+            }
+
+            if (range.value != curvalues) {
+                std::copy(range.value, range.value + range.number, curvalues);
+            }
+            if (range.index != curindices) {
+                std::copy(range.index, range.index + range.number, curindices);
+            }
+            for (size_t i = 0, n = curlast - curfirst; i <= n; ++i) {
+                curpointers[i] += total;
+            }
+
+            total += range.number;
+            current += curlast - curfirst;
+            ++left;
+        }
+
+        return SparseRange<T, IDX>(total, out_values, out_indices);
+    }
+
+public:
+    const T* row_indexed(size_t r, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if constexpr(MARGIN==1) {
+            assemble_indexed<true>(r, buffer, n, indices, work);
+            return buffer;
+        } else {
+            return extract_one_dimension_indexed<true>(r, buffer, n, indices, work);
+        }
+    }
+
+    const T* column_indexed(size_t c, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if constexpr(MARGIN==1) {
+            return extract_one_dimension_indexed<false>(c, buffer, n, indices, work);
+        } else {
+            assemble_indexed<false>(c, buffer, n, indices, work);
+            return buffer;
+        }
+    }
+
+    SparseRange<T, IDX> sparse_row_indexed(size_t r, T* out_values, IDX* out_indices, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(MARGIN==1) {
+            return assemble_indexed_sparse<true>(r, out_values, out_indices, n, indices, work, sorted);
+        } else {
+            return extract_one_dimension_indexed_sparse<true>(r, out_values, out_indices, n, indices, work, sorted);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_column_indexed(size_t c, T* out_values, IDX* out_indices, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(MARGIN==1) {
+            return extract_one_dimension_indexed_sparse<false>(c, out_values, out_indices, n, indices, work, sorted);
+        } else {
+            return assemble_indexed_sparse<false>(c, out_values, out_indices, n, indices, work, sorted);
+        }
+    }
+
+private:
+    template<bool ROW>
+    const T* extract_one_dimension_indexed(size_t i, T* buffer, size_t n, const IDX* indices, Workspace* work) const {
+        size_t chosen = std::upper_bound(cumulative.begin(), cumulative.end(), i) - cumulative.begin() - 1;
+
+        if (work != nullptr) {
+            auto work2 = static_cast<BindWorkspace*>(work);
+            work = work2->workspaces[chosen].get();
+        }
+
+        if constexpr(ROW) {
+            return mats[chosen]->row_indexed(i - cumulative[chosen], buffer, n, indices, work);
+        } else {
+            return mats[chosen]->column_indexed(i - cumulative[chosen], buffer, n, indices, work);
+        }
+    }
+
+    template<bool ROW>
+    SparseRange<T, IDX> extract_one_dimension_indexed_sparse(size_t i, T* out_values, IDX* out_indices, size_t n, const IDX* indices, Workspace* work, bool sorted) const {
+        size_t chosen = std::upper_bound(cumulative.begin(), cumulative.end(), i) - cumulative.begin() - 1;
+
+        if (work != nullptr) {
+            auto work2 = static_cast<BindWorkspace*>(work);
+            work = work2->workspaces[chosen].get();
+        }
+
+        if constexpr(ROW) {
+            return mats[chosen]->sparse_row_indexed(i - cumulative[chosen], out_values, out_indices, n, indices, work, sorted);
+        } else {
+            return mats[chosen]->sparse_column_indexed(i - cumulative[chosen], out_values, out_indices, n, indices, work, sorted);
+        }
+    }
+
+    /* Splits the requested indices into runs belonging to each matrix, 
+     * calling 'fun(left, count, local_indices, curwork)' for each run.
+     * 'local_indices' are relative to the start of the 'left'-th matrix.
+     */
+    template<class Function>
+    void partition_indices(size_t n, const IDX* indices, Workspace* work, Function fun) const {
+        BindWorkspace* work2 = NULL;
+        if (work != nullptr) {
+            work2 = static_cast<BindWorkspace*>(work);
+        }
+
+        std::vector<IDX> local;
+        size_t k = 0;
+        while (k < n) {
+            size_t left = std::upper_bound(cumulative.begin(), cumulative.end(), indices[k]) - cumulative.begin() - 1;
+            size_t offset = cumulative[left], limit = cumulative[left + 1];
+
+            local.clear();
+            while (k < n && static_cast<size_t>(indices[k]) < limit) {
+                local.push_back(indices[k] - offset);
+                ++k;
+            }
+
+            Workspace* curwork = NULL;
+            if (work2 != NULL) {
+                curwork = work2->workspaces[left].get();
+            }
+
+            fun(left, local.size(), local.data(), curwork);
+        }
+    }
+
+    template<bool ROW>
+    void assemble_indexed(size_t i, T* buffer, size_t n, const IDX* indices, Workspace* work) const {
+        partition_indices(n, indices, work, [&](size_t left, size_t count, const IDX* local, Workspace* curwork) -> void {
+            const T* ptr;
+            if constexpr(ROW) {
+                ptr = mats[left]->row_indexed(i, buffer, count, local, curwork);
+            } else {
+                ptr = mats[left]->column_indexed(i, buffer, count, local, curwork);
+            }
+
+            if (ptr != buffer) {
+                std::copy(ptr, ptr + count, buffer);
+            }
+            buffer += count;
+        });
+    }
+
+    template<bool ROW>
+    SparseRange<T, IDX> assemble_indexed_sparse(size_t i, T* out_values, IDX* out_indices, size_t n, const IDX* indices, Workspace* work, bool sorted) const {
+        SparseRange<T, IDX> output(0, out_values, out_indices);
+        auto& ntotal = output.number;
+
+        partition_indices(n, indices, work, [&](size_t left, size_t count, const IDX* local, Workspace* curwork) -> void {
+            SparseRange<T, IDX> range;
+            if constexpr(ROW) {
+                range = mats[left]->sparse_row_indexed(i, out_values, out_indices, count, local, curwork, sorted);
+            } else {
+                range = mats[left]->sparse_column_indexed(i, out_values, out_indices, count, local, curwork, sorted);
+            }
+
+            if (range.value != out_values) {
+                std::copy(range.value, range.value + range.number, out_values);
+            }
+            if (range.index != out_indices) {
+                std::copy(range.index, range.index + range.number, out_indices);
+            }
+            for (size_t j = 0; j < range.number; ++j) {
+                out_indices[j] += cumulative[left];
+            }
+
+            ntotal += range.number;
+            out_values += range.number;
+            out_indices += range.number;
+        });
+
+        return output;
+    }
 
 public:
     /**
@@ -267,6 +619,40 @@ public:
         return std::shared_ptr<Workspace>(new BindWorkspace(std::move(workspaces)));
     }
 
+    /**
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()`.
+     * @param oracle Pointer to an oracle.
+     * Along the combining dimension, the predictions are split across the underlying matrices;
+     * otherwise, the same oracle is passed to all matrices.
+     */
+    void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {
+        if (work == nullptr) {
+            return;
+        }
+        auto work2 = static_cast<BindWorkspace*>(work);
+
+        if (oracle && row == (MARGIN==0)) {
+            std::vector<std::vector<size_t> > split(mats.size());
+            for (size_t p = 0, total = oracle->total(); p < total; ++p) {
+                auto i = oracle->get(p);
+                if (i >= cumulative.back()) {
+                    continue;
+                }
+                size_t chosen = std::upper_bound(cumulative.begin(), cumulative.end(), i) - cumulative.begin() - 1;
+                split[chosen].push_back(i - cumulative[chosen]);
+            }
+
+            for (size_t m = 0; m < mats.size(); ++m) {
+                mats[m]->set_oracle(row, work2->workspaces[m].get(), std::shared_ptr<const Oracle>(new FixedOracle(std::move(split[m]))));
+            }
+        } else {
+            for (size_t m = 0; m < mats.size(); ++m) {
+                mats[m]->set_oracle(row, work2->workspaces[m].get(), oracle);
+            }
+        }
+    }
+
     /**
      * @return The sparsity status of the underlying matrices.
      * If any individual matrix is not sparse, the combination is also considered to be non-sparse.
@@ -306,6 +692,75 @@ public:
         return output;
     }
 
+    /**
+     * @param[out] total On output, the total number of structural non-zero elements across all underlying matrices.
+     * @return Whether `total` was filled, which is only possible if the number is known for each underlying matrix.
+     */
+    bool nonzero_count(size_t& total) const {
+        total = 0;
+        for (const auto& x : mats) {
+            size_t current;
+            if (!x->nonzero_count(current)) {
+                return false;
+            }
+            total += current;
+        }
+        return true;
+    }
+
+    /**
+     * @param row Should the number of non-zero elements be reported for each row?
+     * @param[out] counts Pointer to an array of length equal to the number of rows (if `row = true`) or columns (otherwise).
+     *
+     * @return Whether `counts` was filled, which is only possible if the numbers are known for each underlying matrix.
+     * Along the combining dimension, the numbers for each matrix are concatenated; otherwise, they are summed across matrices.
+     */
+    bool nonzero_counts(bool row, size_t* counts) const {
+        if (row == (MARGIN == 0)) {
+            for (size_t m = 0; m < mats.size(); ++m) {
+                if (!mats[m]->nonzero_counts(row, counts + cumulative[m])) {
+                    return false;
+                }
+            }
+        } else {
+            size_t n = (row ? this->nrow() : this->ncol());
+            std::fill(counts, counts + n, 0);
+            std::vector<size_t> current(n);
+            for (const auto& x : mats) {
+                if (!x->nonzero_counts(row, current.data())) {
+                    return false;
+                }
+                for (size_t i = 0; i < n; ++i) {
+                    counts[i] += current[i];
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return Approximate number of bytes used by this matrix, summed across all underlying matrices.
+     */
+    size_t memory_usage() const {
+        size_t output = sizeof(DelayedBind) + cumulative.size() * sizeof(size_t) + mats.size() * sizeof(mats[0]);
+        for (const auto& x : mats) {
+            output += x->memory_usage();
+        }
+        return output;
+    }
+
+    /**
+     * @param row Should the usage be reported for a workspace for row extraction?
+     * @return Approximate number of bytes used by each workspace, which holds a workspace for each underlying matrix.
+     */
+    size_t workspace_memory_usage(bool row) const {
+        size_t output = sizeof(BindWorkspace) + mats.size() * sizeof(std::shared_ptr<Workspace>);
+        for (const auto& x : mats) {
+            output += x->workspace_memory_usage(row);
+        }
+        return output;
+    }
+
 private:
     std::vector<std::shared_ptr<const Matrix<T, IDX> > > mats;
     std::vector<size_t> cumulative;
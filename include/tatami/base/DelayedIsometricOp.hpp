@@ -2,7 +2,12 @@
 #define TATAMI_DELAYED_ISOMETRIC_OP_H
 
 #include <memory>
+#include <numeric>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 #include "Matrix.hpp"
+#include "compose_helpers.hpp"
 
 /**
  * @file DelayedIsometricOp.hpp
@@ -12,6 +17,34 @@
 
 namespace tatami {
 
+/**
+ * @cond
+ */
+// Base class for all isometric operations, so that make_DelayedIsometricOp()
+// can identify them without knowing the type of the operation.
+template<typename T, typename IDX>
+class IsometricOpBase : public Matrix<T, IDX> {
+public:
+    virtual std::shared_ptr<const Matrix<T, IDX> > isometric_seed() const = 0;
+
+    virtual void isometric_operations(std::vector<std::shared_ptr<const IsometricOperation<T, IDX> > >& ops) const = 0;
+
+    virtual bool isometric_sparse() const = 0;
+};
+
+template<class OP>
+struct is_chain_helper {
+    static constexpr bool value = false;
+};
+
+template<typename T, typename IDX, bool SPARSE>
+struct is_chain_helper<DelayedChainHelper<T, IDX, SPARSE> > {
+    static constexpr bool value = true;
+};
+/**
+ * @endcond
+ */
+
 /**
  * @brief Delayed isometric operations on a matrix.
  *
@@ -22,9 +55,21 @@ namespace tatami {
  * @tparam OP Functor class implementing the operation.
  * This should accept the row index, column index and value, and return the modified value after applying the operation. 
  * @tparam IDX Type of index value.
+ *
+ * Calling the functor for each element prevents the compiler from vectorizing the operation across a row or column.
+ * `OP` may optionally define bulk methods that modify a whole array of values from the same row or column in place:
+ *
+ * - `void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const`, 
+ *   where `buffer` contains the values of the contiguous block `[start, end)` of row `idx` (if `row = true`) or column `idx` (otherwise).
+ * - `template<typename IDX> void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const`,
+ *   where `values` contains `number` values from row or column `idx`, and `indices` contains their column or row indices, respectively.
+ *   This is used for both sparse extraction and indexed dense extraction.
+ *
+ * If present, these methods are used instead of the functor and should yield the same results.
+ * All helpers in `math_helpers.hpp`, `arith_scalar_helpers.hpp`, `arith_vector_helpers.hpp` and `compose_helpers.hpp` define these methods.
  */
 template<typename T, typename IDX, class OP>
-class DelayedIsometricOp : public Matrix<T, IDX> {
+class DelayedIsometricOp : public IsometricOpBase<T, IDX> {
 public:
     /**
      * @param p Pointer to the underlying matrix.
@@ -35,17 +80,13 @@ public:
 public:
     const T* row(size_t r, T* buffer, size_t start, size_t end, Workspace* work=nullptr) const {
         const T* raw = mat->row(r, buffer, start, end, work);
-        for (size_t i = start; i < end; ++i, ++raw) {
-            buffer[i - start] = operation(r, i, *raw);
-        }
+        dense_apply<true>(r, start, end, raw, buffer);
         return buffer;
     }
 
     const T* column(size_t c, T* buffer, size_t start, size_t end, Workspace* work=nullptr) const {
         const T* raw = mat->column(c, buffer, start, end, work);
-        for (size_t i = start; i < end; ++i, ++raw) {
-            buffer[i - start] = operation(i, c, *raw);
-        }
+        dense_apply<false>(c, start, end, raw, buffer);
         return buffer;
     }
 
@@ -57,38 +98,26 @@ public:
     SparseRange<T, IDX> sparse_row(size_t r, T* vbuffer, IDX* ibuffer, size_t start, size_t end, Workspace* work=nullptr, bool sorted=true) const {
         if constexpr(OP::sparse) {
             auto raw = mat->sparse_row(r, vbuffer, ibuffer, start, end, work, sorted);
-            for (size_t i = 0; i < raw.number; ++i) {
-                vbuffer[i] = operation(r, raw.index[i], raw.value[i]);
-            }
+            sparse_apply<true>(r, raw.number, raw.value, raw.index, vbuffer);
             return SparseRange<T, IDX>(raw.number, vbuffer, raw.index);
         } else {
             auto ptr = mat->row(r, vbuffer, start, end, work);
-            auto original_values = vbuffer;
-            auto original_indices = ibuffer;
-            for (size_t i = start; i < end; ++i, ++vbuffer, ++ibuffer, ++ptr) {
-                (*vbuffer) = operation(r, i, *ptr);
-                (*ibuffer) = i;
-            }
-            return SparseRange<T, IDX>(end - start, original_values, original_indices); 
+            dense_apply<true>(r, start, end, ptr, vbuffer);
+            std::iota(ibuffer, ibuffer + (end - start), static_cast<IDX>(start));
+            return SparseRange<T, IDX>(end - start, vbuffer, ibuffer); 
         }
     }
 
     SparseRange<T, IDX> sparse_column(size_t c, T* vbuffer, IDX* ibuffer, size_t start, size_t end, Workspace* work=nullptr, bool sorted=true) const {
         if constexpr(OP::sparse) {
             auto raw = mat->sparse_column(c, vbuffer, ibuffer, start, end, work, sorted);
-            for (size_t i = 0; i < raw.number; ++i) {
-                vbuffer[i] = operation(raw.index[i], c, raw.value[i]);
-            }
+            sparse_apply<false>(c, raw.number, raw.value, raw.index, vbuffer);
             return SparseRange<T, IDX>(raw.number, vbuffer, raw.index);
         } else {
             auto ptr = mat->column(c, vbuffer, start, end, work);
-            auto original_values = vbuffer;
-            auto original_indices = ibuffer;
-            for (size_t i = start; i < end; ++i, ++vbuffer, ++ibuffer, ++ptr) {
-                (*vbuffer) = operation(i, c, *ptr);
-                (*ibuffer) = i;
-            }
-            return SparseRange<T, IDX>(end - start, original_values, original_indices); 
+            dense_apply<false>(c, start, end, ptr, vbuffer);
+            std::iota(ibuffer, ibuffer + (end - start), static_cast<IDX>(start));
+            return SparseRange<T, IDX>(end - start, vbuffer, ibuffer); 
         }
     }
 
@@ -96,6 +125,299 @@ public:
 
     using Matrix<T, IDX>::sparse_row;
 
+public:
+    const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        const T* raw = mat->rows(first_row, last_row, buffer, first_col, last_col, work);
+        size_t width = last_col - first_col;
+        for (size_t r = first_row; r < last_row; ++r) {
+            size_t offset = (r - first_row) * width;
+            dense_apply<true>(r, first_col, last_col, raw + offset, buffer + offset);
+        }
+        return buffer;
+    }
+
+    const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        const T* raw = mat->columns(first_col, last_col, buffer, first_row, last_row, work);
+        size_t height = last_row - first_row;
+        for (size_t c = first_col; c < last_col; ++c) {
+            size_t offset = (c - first_col) * height;
+            dense_apply<false>(c, first_row, last_row, raw + offset, buffer + offset);
+        }
+        return buffer;
+    }
+
+    SparseRange<T, IDX> sparse_rows(size_t first_row, size_t last_row, T* vbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_col, size_t last_col, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(OP::sparse) {
+            auto raw = mat->sparse_rows(first_row, last_row, vbuffer, ibuffer, pbuffer, first_col, last_col, work, sorted);
+            for (size_t r = first_row; r < last_row; ++r) {
+                size_t offset = pbuffer[r - first_row], number = pbuffer[r - first_row + 1] - offset;
+                sparse_apply<true>(r, number, raw.value + offset, raw.index + offset, vbuffer + offset);
+            }
+            return SparseRange<T, IDX>(raw.number, vbuffer, raw.index);
+        } else {
+            rows(first_row, last_row, vbuffer, first_col, last_col, work);
+            return dense_block_indices(last_row - first_row, first_col, last_col, vbuffer, ibuffer, pbuffer);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_columns(size_t first_col, size_t last_col, T* vbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_row, size_t last_row, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(OP::sparse) {
+            auto raw = mat->sparse_columns(first_col, last_col, vbuffer, ibuffer, pbuffer, first_row, last_row, work, sorted);
+            for (size_t c = first_col; c < last_col; ++c) {
+                size_t offset = pbuffer[c - first_col], number = pbuffer[c - first_col + 1] - offset;
+                sparse_apply<false>(c, number, raw.value + offset, raw.index + offset, vbuffer + offset);
+            }
+            return SparseRange<T, IDX>(raw.number, vbuffer, raw.index);
+        } else {
+            columns(first_col, last_col, vbuffer, first_row, last_row, work);
+            return dense_block_indices(last_col - first_col, first_row, last_row, vbuffer, ibuffer, pbuffer);
+        }
+    }
+
+public:
+    const T* row_indexed(size_t r, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        const T* raw = mat->row_indexed(r, buffer, n, indices, work);
+        sparse_apply<true>(r, n, raw, indices, buffer);
+        return buffer;
+    }
+
+    const T* column_indexed(size_t c, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        const T* raw = mat->column_indexed(c, buffer, n, indices, work);
+        sparse_apply<false>(c, n, raw, indices, buffer);
+        return buffer;
+    }
+
+    SparseRange<T, IDX> sparse_row_indexed(size_t r, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(OP::sparse) {
+            auto raw = mat->sparse_row_indexed(r, vbuffer, ibuffer, n, indices, work, sorted);
+            sparse_apply<true>(r, raw.number, raw.value, raw.index, vbuffer);
+            return SparseRange<T, IDX>(raw.number, vbuffer, raw.index);
+        } else {
+            row_indexed(r, vbuffer, n, indices, work);
+            std::copy(indices, indices + n, ibuffer);
+            return SparseRange<T, IDX>(n, vbuffer, ibuffer);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_column_indexed(size_t c, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(OP::sparse) {
+            auto raw = mat->sparse_column_indexed(c, vbuffer, ibuffer, n, indices, work, sorted);
+            sparse_apply<false>(c, raw.number, raw.value, raw.index, vbuffer);
+            return SparseRange<T, IDX>(raw.number, vbuffer, raw.index);
+        } else {
+            column_indexed(c, vbuffer, n, indices, work);
+            std::copy(indices, indices + n, ibuffer);
+            return SparseRange<T, IDX>(n, vbuffer, ibuffer);
+        }
+    }
+
+private:
+    static SparseRange<T, IDX> dense_block_indices(size_t n, size_t start, size_t end, T* vbuffer, IDX* ibuffer, size_t* pbuffer) {
+        size_t width = end - start;
+        auto current = ibuffer;
+        pbuffer[0] = 0;
+        for (size_t j = 0; j < n; ++j) {
+            for (size_t i = start; i < end; ++i, ++current) {
+                *current = i;
+            }
+            pbuffer[j + 1] = pbuffer[j] + width;
+        }
+        return SparseRange<T, IDX>(n * width, vbuffer, ibuffer);
+    }
+
+public:
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new IsometricDenseExtractor<true>(this, mat->dense_row_extractor(first, last)));
+    }
+
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new IsometricDenseExtractor<false>(this, mat->dense_column_extractor(first, last)));
+    }
+
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new IsometricSparseExtractor<true>(this, first, last, sorted, mode));
+    }
+
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new IsometricSparseExtractor<false>(this, first, last, sorted, mode));
+    }
+
+    using Matrix<T, IDX>::dense_row_extractor;
+
+    using Matrix<T, IDX>::dense_column_extractor;
+
+    using Matrix<T, IDX>::sparse_row_extractor;
+
+    using Matrix<T, IDX>::sparse_column_extractor;
+
+private:
+    template<bool ROW>
+    T apply(size_t i, size_t j, T val) const {
+        if constexpr(ROW) {
+            return operation(i, j, val);
+        } else {
+            return operation(j, i, val);
+        }
+    }
+
+    // Applies the operation to the values of the block [start, end) of row/column 'i'.
+    // 'raw' may or may not be the same as 'buffer', depending on the underlying matrix.
+    template<bool ROW>
+    void dense_apply(size_t i, size_t start, size_t end, const T* raw, T* buffer) const {
+        if constexpr(has_dense_apply<OP, T>::value) {
+            if (raw != buffer) {
+                std::copy(raw, raw + (end - start), buffer);
+            }
+            operation.dense_apply(ROW, i, start, end, buffer);
+        } else {
+            for (size_t j = start; j < end; ++j, ++raw) {
+                buffer[j - start] = apply<ROW>(i, j, *raw);
+            }
+        }
+    }
+
+    // Same as above, for 'number' values at the specified 'indices' of row/column 'i'.
+    template<bool ROW>
+    void sparse_apply(size_t i, size_t number, const T* raw, const IDX* indices, T* buffer) const {
+        if constexpr(has_sparse_apply<OP, T, IDX>::value) {
+            if (raw != buffer) {
+                std::copy(raw, raw + number, buffer);
+            }
+            operation.sparse_apply(ROW, i, number, buffer, indices);
+        } else {
+            for (size_t j = 0; j < number; ++j) {
+                buffer[j] = apply<ROW>(i, indices[j], raw[j]);
+            }
+        }
+    }
+
+    template<bool ROW>
+    struct IsometricDenseExtractor : public DenseExtractor<T, IDX> {
+        IsometricDenseExtractor(const DelayedIsometricOp* p, std::unique_ptr<DenseExtractor<T, IDX> > in) : 
+            DenseExtractor<T, IDX>(in->first(), in->last()), parent(p), inner(std::move(in)) {}
+
+        const T* fetch(size_t i, T* buffer) {
+            const T* raw = inner->fetch(i, buffer);
+            parent->template dense_apply<ROW>(i, this->block_first, this->block_last, raw, buffer);
+            return buffer;
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            inner->set_oracle(std::move(oracle));
+        }
+
+        const DelayedIsometricOp* parent;
+        std::unique_ptr<DenseExtractor<T, IDX> > inner;
+    };
+
+    /* If the operation does not preserve sparsity, we extract a dense
+     * vector from the underlying matrix and report every element. In that
+     * case, the structure is known without touching the underlying matrix
+     * if the values are not required.
+     *
+     * The exception is when the caller allows a non-zero background and the
+     * operation is uniform along each row/column. Then, we extract a sparse
+     * vector from the underlying matrix and transform its background.
+     */
+    template<bool ROW>
+    struct IsometricSparseExtractor : public SparseExtractor<T, IDX> {
+        IsometricSparseExtractor(const DelayedIsometricOp* p, size_t first, size_t last, bool sorted, SparseExtractMode mode) : SparseExtractor<T, IDX>(first, last, sorted, mode), parent(p) {
+            if constexpr(OP::sparse) {
+                sinner = create_sparse();
+            } else if (mode == SPARSE_EXTRACT_BOTH) {
+                if constexpr(ROW) {
+                    dinner = parent->mat->dense_row_extractor(first, last);
+                } else {
+                    dinner = parent->mat->dense_column_extractor(first, last);
+                }
+            }
+        }
+
+        SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) {
+            if (OP::sparse || use_background) {
+                auto raw = sinner->fetch(i, vbuffer, ibuffer);
+                if (this->extract_mode == SPARSE_EXTRACT_BOTH) {
+                    parent->template sparse_apply<ROW>(i, raw.number, raw.value, raw.index, vbuffer);
+                    raw.value = vbuffer;
+                }
+                if (use_background) {
+                    raw.background = parent->template apply<ROW>(i, this->block_first, raw.background);
+                }
+                return raw;
+            } else {
+                if (this->extract_mode == SPARSE_EXTRACT_NONE) {
+                    return SparseRange<T, IDX>(this->length());
+                } else if (this->extract_mode == SPARSE_EXTRACT_INDEX) {
+                    std::iota(ibuffer, ibuffer + this->length(), static_cast<IDX>(this->block_first));
+                    return SparseRange<T, IDX>(this->length(), NULL, ibuffer);
+                }
+
+                auto ptr = dinner->fetch(i, vbuffer);
+                parent->template dense_apply<ROW>(i, this->block_first, this->block_last, ptr, vbuffer);
+                std::iota(ibuffer, ibuffer + this->length(), static_cast<IDX>(this->block_first));
+                return SparseRange<T, IDX>(this->length(), vbuffer, ibuffer);
+            }
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            current_oracle = oracle;
+            if (sinner) {
+                sinner->set_oracle(std::move(oracle));
+            } else if (dinner) {
+                dinner->set_oracle(std::move(oracle));
+            }
+        }
+
+        bool set_background(bool allow) {
+            if constexpr(OP::sparse) {
+                // A non-zero background from the underlying matrix can only be transformed if the operation is uniform.
+                use_background = sinner->set_background(allow && isometric_uniform(parent->operation, ROW));
+            } else {
+                if (allow && parent->sparse_background(ROW)) {
+                    if (!use_background) {
+                        dinner.reset();
+                        sinner = create_sparse();
+                        use_background = true;
+                    }
+                    sinner->set_background(true);
+                } else if (use_background) {
+                    sinner.reset();
+                    if (this->extract_mode == SPARSE_EXTRACT_BOTH) {
+                        if constexpr(ROW) {
+                            dinner = parent->mat->dense_row_extractor(this->block_first, this->block_last);
+                        } else {
+                            dinner = parent->mat->dense_column_extractor(this->block_first, this->block_last);
+                        }
+                        if (current_oracle) {
+                            dinner->set_oracle(current_oracle);
+                        }
+                    }
+                    use_background = false;
+                }
+            }
+            return use_background;
+        }
+
+        std::unique_ptr<SparseExtractor<T, IDX> > create_sparse() const {
+            std::unique_ptr<SparseExtractor<T, IDX> > output;
+            if constexpr(ROW) {
+                output = parent->mat->sparse_row_extractor(this->block_first, this->block_last, this->needs_sorted, this->extract_mode);
+            } else {
+                output = parent->mat->sparse_column_extractor(this->block_first, this->block_last, this->needs_sorted, this->extract_mode);
+            }
+            if (current_oracle) {
+                output->set_oracle(current_oracle);
+            }
+            return output;
+        }
+
+        const DelayedIsometricOp* parent;
+        std::unique_ptr<SparseExtractor<T, IDX> > sinner;
+        std::unique_ptr<DenseExtractor<T, IDX> > dinner;
+        std::shared_ptr<const Oracle> current_oracle;
+        bool use_background = false;
+    };
+
 public:
     size_t nrow() const {
         return mat->nrow();
@@ -112,6 +434,15 @@ public:
         return mat->new_workspace(row);
     }
 
+    /**
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()`.
+     * @param oracle Pointer to an oracle, which is passed to the underlying (pre-operation) matrix.
+     */
+    void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {
+        mat->set_oracle(row, work, std::move(oracle));
+    }
+
     /**
      * @return `true` if both the underlying (pre-operation) matrix is sparse and the operation preserves sparsity.
      * Otherwise returns `false`.
@@ -125,6 +456,94 @@ public:
      */
     bool prefer_rows() const { return mat->prefer_rows(); }
 
+    /**
+     * @return The natural block size of the underlying (pre-operation) matrix.
+     */
+    std::pair<size_t, size_t> tile_dimensions() const { return mat->tile_dimensions(); }
+
+    /**
+     * @param row Should row extraction be considered?
+     * @return Whether sparse extractors can report a non-zero background for each row (if `row = true`) or column.
+     * This is only possible if the operation is the same for all elements in each row/column (see `DelayedChainHelper::uniform()` for an example),
+     * and the underlying matrix is sparse or can itself report a non-zero background.
+     */
+    bool sparse_background(bool row) const {
+        if (!isometric_uniform(operation, row)) {
+            return false;
+        }
+        if constexpr(OP::sparse) {
+            return mat->sparse_background(row);
+        } else {
+            return mat->sparse() || mat->sparse_background(row);
+        }
+    }
+
+    /**
+     * @param[out] total On output, the total number of structural non-zero elements.
+     * @return Whether `total` was filled.
+     * This is only possible if the operation preserves sparsity and the number is known for the underlying matrix.
+     */
+    bool nonzero_count(size_t& total) const { 
+        if constexpr(OP::sparse) {
+            return mat->nonzero_count(total);
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @param row Should the number of non-zero elements be reported for each row?
+     * @param[out] counts Pointer to an array of length equal to the number of rows (if `row = true`) or columns (otherwise).
+     *
+     * @return Whether `counts` was filled.
+     * This is only possible if the operation preserves sparsity and the numbers are known for the underlying matrix.
+     */
+    bool nonzero_counts(bool row, size_t* counts) const { 
+        if constexpr(OP::sparse) {
+            return mat->nonzero_counts(row, counts);
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @return Approximate number of bytes used by this matrix, including the underlying matrix.
+     */
+    size_t memory_usage() const {
+        return sizeof(DelayedIsometricOp) + mat->memory_usage();
+    }
+
+    /**
+     * @param row Should the usage be reported for a workspace for row extraction?
+     * @return Approximate number of bytes used by each workspace, i.e., that of the underlying matrix.
+     */
+    size_t workspace_memory_usage(bool row) const {
+        return mat->workspace_memory_usage(row);
+    }
+
+    /**
+     * @cond
+     */
+    std::shared_ptr<const Matrix<T, IDX> > isometric_seed() const {
+        return mat;
+    }
+
+    void isometric_operations(std::vector<std::shared_ptr<const IsometricOperation<T, IDX> > >& ops) const {
+        if constexpr(is_chain_helper<OP>::value) {
+            const auto& existing = operation.get_operations();
+            ops.insert(ops.end(), existing.begin(), existing.end());
+        } else {
+            ops.emplace_back(new WrappedIsometricOperation<T, IDX, OP>(operation));
+        }
+    }
+
+    bool isometric_sparse() const {
+        return OP::sparse;
+    }
+    /**
+     * @endcond
+     */
+
 private:
     std::shared_ptr<const Matrix<T, IDX> > mat;
     OP operation;
@@ -134,6 +553,11 @@ private:
 /**
  * A `make_*` helper function to enable partial template deduction of supplied types.
  *
+ * If `p` is itself a `DelayedIsometricOp`, the operations are fused into a single layer around the matrix underlying `p`, using a `DelayedChainHelper`.
+ * This avoids extracting and walking through each row/column once per layer in a long chain of operations, e.g., normalization, log-transformation and scaling.
+ * The result is still sparse if all operations in the chain preserve sparsity.
+ * `p` itself is not modified and can still be used independently.
+ *
  * @tparam MAT A specialized `Matrix`, to be automatically deducted.
  * @tparam OP Helper class defining the operation.
  *
@@ -142,12 +566,24 @@ private:
  */
 template<class MAT, class OP>
 std::shared_ptr<MAT> make_DelayedIsometricOp(std::shared_ptr<MAT> p, OP op) {
-    return std::shared_ptr<MAT>(
-        new DelayedIsometricOp<typename MAT::data_type, typename MAT::index_type, typename std::remove_reference<OP>::type>(
-            p,
-            std::move(op)
-        )
-    );
+    typedef typename MAT::data_type T;
+    typedef typename MAT::index_type IDX;
+    typedef typename std::remove_reference<OP>::type Op;
+
+    auto previous = dynamic_cast<const IsometricOpBase<T, IDX>*>(p.get());
+    if (previous) {
+        std::vector<std::shared_ptr<const IsometricOperation<T, IDX> > > ops;
+        previous->isometric_operations(ops);
+        ops.emplace_back(new WrappedIsometricOperation<T, IDX, Op>(std::move(op)));
+
+        if (previous->isometric_sparse() && Op::sparse) {
+            return std::shared_ptr<MAT>(new DelayedIsometricOp<T, IDX, DelayedChainHelper<T, IDX, true> >(previous->isometric_seed(), std::move(ops)));
+        } else {
+            return std::shared_ptr<MAT>(new DelayedIsometricOp<T, IDX, DelayedChainHelper<T, IDX, false> >(previous->isometric_seed(), std::move(ops)));
+        }
+    }
+
+    return std::shared_ptr<MAT>(new DelayedIsometricOp<T, IDX, Op>(p, std::move(op)));
 }
 
 }
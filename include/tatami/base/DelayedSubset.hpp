@@ -2,8 +2,12 @@
 #define TATAMI_DELAYED_SUBSET
 
 #include "Matrix.hpp"
+#include "has_data.hpp"
 #include <algorithm>
 #include <memory>
+#include <vector>
+#include <numeric>
+#include <utility>
 
 /**
  * @file DelayedSubset.hpp
@@ -19,6 +23,13 @@ namespace tatami {
  * Implements delayed subsetting (i.e., slicing) on the rows or columns of a matrix.
  * This operation is "delayed" in that it is only evaluated on request, e.g., with `row()` or friends.
  *
+ * The subset indices are analyzed on construction to choose the extraction strategy across the subsetted dimension.
+ * For sorted and unique indices, each contiguous run of indices is extracted as a block from the underlying matrix,
+ * unless there are too many runs, in which case the indexed extraction methods (e.g., `Matrix::row_indexed()`) are used instead.
+ * For unsorted or duplicated indices, we extract the sorted and unique indices in the same manner and gather the requested values.
+ * In sparse extraction, each non-zero element of the sorted and unique indices is duplicated for all subset elements that refer to it,
+ * such that sparsity is preserved (including explicitly stored zeros).
+ *
  * @tparam MARGIN Dimension along which the subsetting is to occur.
  * If 0, the subset is applied to the rows; if 1, the subset is applied to the columns.
  * @tparam T Type of matrix value.
@@ -45,7 +56,7 @@ public:
             }
 
             auto& chosen = reverse_indices[indices[i]];
-            if (chosen != indices.size()) {
+            if (static_cast<size_t>(chosen) != indices.size()) {
                 // duplicates, we give up.
                 reverse_indices.clear(); 
                 break;
@@ -53,15 +64,32 @@ public:
 
             chosen = i;
         }
-       
+
+        // Sorted and unique indices can be passed directly to the extraction methods.
+        if (!reverse_indices.empty()) {
+            if constexpr(!has_data<IDX, V>::value) {
+                indices_copy.insert(indices_copy.end(), indices.begin(), indices.end());
+            }
+            return;
+        }
+
+        // Otherwise, we store the order of the indices for gathering.
+        sorted_order.resize(indices.size());
+        std::iota(sorted_order.begin(), sorted_order.end(), static_cast<IDX>(0));
+        std::stable_sort(sorted_order.begin(), sorted_order.end(), [&](IDX left, IDX right) -> bool { return indices[left] < indices[right]; });
+        for (size_t i = 0; i < sorted_order.size(); ++i) {
+            if (i == 0 || indices[sorted_order[i]] != indices[sorted_order[i - 1]]) {
+                ++nunique;
+            }
+        }
+
         return;
     }
 
 public:
     const T* row(size_t r, T* buffer, size_t start, size_t end, Workspace* work=nullptr) const {
         if constexpr(MARGIN==1) {
-            subset_expanded<true>(r, buffer, start, end, work);
-            return buffer;
+            return subset_expanded<true>(r, buffer, start, end, work);
         } else {
             return mat->row(indices[r], buffer, start, end, work);
         }
@@ -71,8 +99,7 @@ public:
         if constexpr(MARGIN==1) {
             return mat->column(indices[c], buffer, start, end, work);
         } else {
-            subset_expanded<false>(c, buffer, start, end, work);
-            return buffer;
+            return subset_expanded<false>(c, buffer, start, end, work);
         }
     }
 
@@ -103,6 +130,90 @@ public:
 
     using Matrix<T, IDX>::sparse_row;
 
+public:
+    /**
+     * @param row Should views be reported for rows?
+     * @return Whether views are available from the underlying matrix.
+     * This is always `false` for extraction across the subsetted dimension.
+     */
+    bool has_dense_view(bool row) const {
+        return row == (MARGIN == 0) && mat->has_dense_view(row);
+    }
+
+    /**
+     * @param row Should views be reported for rows?
+     * @return Whether views are available from the underlying matrix.
+     * This is always `false` for extraction across the subsetted dimension.
+     */
+    bool has_sparse_view(bool row) const {
+        return row == (MARGIN == 0) && mat->has_sparse_view(row);
+    }
+
+    bool row_view(size_t r, const T*& view, size_t first, size_t last) const {
+        if constexpr(MARGIN == 0) {
+            return mat->row_view(indices[r], view, first, last);
+        } else {
+            return false;
+        }
+    }
+
+    bool column_view(size_t c, const T*& view, size_t first, size_t last) const {
+        if constexpr(MARGIN == 0) {
+            return false;
+        } else {
+            return mat->column_view(indices[c], view, first, last);
+        }
+    }
+
+    bool sparse_row_view(size_t r, SparseRange<T, IDX>& view, size_t first, size_t last) const {
+        if constexpr(MARGIN == 0) {
+            return mat->sparse_row_view(indices[r], view, first, last);
+        } else {
+            return false;
+        }
+    }
+
+    bool sparse_column_view(size_t c, SparseRange<T, IDX>& view, size_t first, size_t last) const {
+        if constexpr(MARGIN == 0) {
+            return false;
+        } else {
+            return mat->sparse_column_view(indices[c], view, first, last);
+        }
+    }
+
+    using Matrix<T, IDX>::row_view;
+
+    using Matrix<T, IDX>::column_view;
+
+    using Matrix<T, IDX>::sparse_row_view;
+
+    using Matrix<T, IDX>::sparse_column_view;
+
+public:
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor(size_t start, size_t end) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new SubsetDenseExtractor<true>(this, start, end));
+    }
+
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor(size_t start, size_t end) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new SubsetDenseExtractor<false>(this, start, end));
+    }
+
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(size_t start, size_t end, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new SubsetSparseExtractor<true>(this, start, end, sorted, mode));
+    }
+
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(size_t start, size_t end, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new SubsetSparseExtractor<false>(this, start, end, sorted, mode));
+    }
+
+    using Matrix<T, IDX>::dense_row_extractor;
+
+    using Matrix<T, IDX>::dense_column_extractor;
+
+    using Matrix<T, IDX>::sparse_row_extractor;
+
+    using Matrix<T, IDX>::sparse_column_extractor;
+
 public:
     /**
      * @return Number of rows after any subsetting is applied.
@@ -140,6 +251,65 @@ public:
         return mat->prefer_rows();
     }
 
+    /**
+     * @param[out] total On output, the total number of structural non-zero elements in the subset.
+     * @return Whether `total` was filled.
+     * This is only possible if the counts along the subsetted dimension are known for the underlying matrix.
+     */
+    bool nonzero_count(size_t& total) const {
+        std::vector<size_t> counts(indices.size());
+        if (!nonzero_counts(MARGIN == 0, counts.data())) {
+            return false;
+        }
+        total = std::accumulate(counts.begin(), counts.end(), static_cast<size_t>(0));
+        return true;
+    }
+
+    /**
+     * @param row Should the number of non-zero elements be reported for each row?
+     * @param[out] counts Pointer to an array of length equal to the number of rows (if `row = true`) or columns (otherwise).
+     *
+     * @return Whether `counts` was filled.
+     * This is only possible along the subsetted dimension, if the counts are known for the underlying matrix.
+     */
+    bool nonzero_counts(bool row, size_t* counts) const {
+        if (row != (MARGIN == 0)) {
+            return false;
+        }
+        std::vector<size_t> full(row ? mat->nrow() : mat->ncol());
+        if (!mat->nonzero_counts(row, full.data())) {
+            return false;
+        }
+        for (size_t i = 0, end = indices.size(); i < end; ++i) {
+            counts[i] = full[indices[i]];
+        }
+        return true;
+    }
+
+    /**
+     * @return Approximate number of bytes used by this matrix, including the subset indices and the underlying (pre-subsetted) matrix.
+     */
+    size_t memory_usage() const {
+        return sizeof(DelayedSubset) + mat->memory_usage() + 
+            indices.size() * sizeof(indices[0]) + 
+            (reverse_indices.size() + indices_copy.size() + sorted_order.size()) * sizeof(IDX);
+    }
+
+    /**
+     * @param row Should the usage be reported for a workspace for row extraction?
+     *
+     * @return Approximate number of bytes used by each workspace.
+     * Along the subsetted dimension, this is the same as that of the underlying matrix;
+     * otherwise, it also includes the buffers for gathering unsorted or duplicated indices.
+     */
+    size_t workspace_memory_usage(bool row) const {
+        size_t output = mat->workspace_memory_usage(row);
+        if (row != (MARGIN == 0)) {
+            output += sizeof(SubsetWorkspace) + nunique * (sizeof(T) + 2 * sizeof(IDX) + sizeof(size_t)) + sorted_order.size() * 2 * sizeof(IDX);
+        }
+        return output;
+    }
+
     /**
      * @param row Should a workspace be created for row-wise extraction?
      *
@@ -149,157 +319,583 @@ public:
         if (row == (MARGIN==0)) {
             return mat->new_workspace(row);
         } else {
-            return std::shared_ptr<Workspace>(new SubsetWorkspace(mat.get(), indices, row));
+            return std::shared_ptr<Workspace>(new SubsetWorkspace(mat->new_workspace(row)));
+        }
+    }
+
+    /**
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()`.
+     * @param oracle Pointer to an oracle, which is passed to the underlying (pre-subsetted) matrix after mapping the predictions to the original indices.
+     */
+    void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {
+        if (row == (MARGIN==0)) {
+            if (oracle) {
+                oracle.reset(new SubsetOracle(std::move(oracle), &indices));
+            }
+            mat->set_oracle(row, work, std::move(oracle));
+        } else if (work) {
+            mat->set_oracle(row, static_cast<SubsetWorkspace*>(work)->work.get(), std::move(oracle));
         }
     }
 private:
+    /* For unsorted or duplicated indices, we extract the sorted and unique
+     * indices in the requested range and gather the values for each subset
+     * element. This avoids densifying the entire span of the indices. For
+     * sparse extraction, we instead scatter each non-zero element to all
+     * subset elements that refer to its index, as listed in 'positions'
+     * between consecutive 'offsets' for each unique index.
+     */
+    struct GatherPlan {
+        std::vector<IDX> unique;
+        std::vector<IDX> mapping;
+        std::vector<IDX> positions;
+        std::vector<size_t> offsets;
+        std::vector<T> holding;
+        std::vector<IDX> iholding;
+        std::vector<std::pair<IDX, T> > sorting;
+    };
+
     struct SubsetWorkspace : public Workspace {
-        template<class M>
-        SubsetWorkspace(const M* ptr, const V& indices, bool row) :
-            value_buffer(buffer_size(ptr, row)),
-            index_buffer(value_buffer.size()),
-            work(ptr->new_workspace(row)) 
-        {
-            update_last(0, indices.size(), indices);
-            return;
+        SubsetWorkspace(std::shared_ptr<Workspace> w) : work(std::move(w)) {}
+
+        std::shared_ptr<Workspace> work;
+
+        // Plan for the last requested range, to be reused across calls.
+        GatherPlan plan;
+        bool planned = false;
+        size_t last_start = 0, last_end = 0;
+    };
+
+    struct SubsetOracle : public Oracle {
+        SubsetOracle(std::shared_ptr<const Oracle> s, const V* i) : source(std::move(s)), indices(i) {}
+        size_t total() const { return source->total(); }
+        size_t get(size_t i) const { return (*indices)[source->get(i)]; }
+        std::shared_ptr<const Oracle> source;
+        const V* indices;
+    };
+
+    /* Extraction of sorted and unique indices from the underlying matrix. If
+     * these indices form only a few contiguous runs, each run is extracted as
+     * a block from its own extractor; otherwise, we fall back to the indexed
+     * extraction methods.
+     */
+    template<bool ROW>
+    struct SortedDenseFetcher {
+        SortedDenseFetcher() = default;
+
+        SortedDenseFetcher(const Matrix<T, IDX>* m, const IDX* s, size_t n) : mat(m), sorted(s), number(n) {
+            if (count_runs(sorted, number) > max_runs) {
+                work = mat->new_workspace(ROW);
+                return;
+            }
+
+            for (size_t start = 0; start < number; ) {
+                size_t end = run_end(sorted, start, number);
+                offsets.push_back(start);
+                if constexpr(ROW) {
+                    blocks.push_back(mat->dense_row_extractor(sorted[start], sorted[start] + (end - start)));
+                } else {
+                    blocks.push_back(mat->dense_column_extractor(sorted[start], sorted[start] + (end - start)));
+                }
+                start = end;
+            }
         }
 
-        void update_last(size_t start, size_t end, const V& indices) {
-            bool changed = false;
-            if (start != last_start.first) {
-                last_start.first = start;
-                changed = true;
+        const T* fetch(size_t i, T* buffer) {
+            if (blocks.size() == 1) {
+                return blocks.front()->fetch(i, buffer);
+            } else if (blocks.size()) {
+                for (size_t b = 0; b < blocks.size(); ++b) {
+                    auto dest = buffer + offsets[b];
+                    auto ptr = blocks[b]->fetch(i, dest);
+                    if (ptr != dest) {
+                        std::copy(ptr, ptr + blocks[b]->length(), dest);
+                    }
+                }
+                return buffer;
+            } else if constexpr(ROW) {
+                return mat->row_indexed(i, buffer, number, sorted, work.get());
+            } else {
+                return mat->column_indexed(i, buffer, number, sorted, work.get());
             }
-            if (end != last_end.first) {
-                last_end.first = end;
-                changed = true;
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            if (blocks.empty()) {
+                mat->set_oracle(ROW, work.get(), std::move(oracle));
+            } else {
+                for (auto& b : blocks) {
+                    b->set_oracle(oracle);
+                }
             }
-            if (changed && start < end) {
-                find_min_max(start, end, last_start.second, last_end.second, indices);
+        }
+
+        const Matrix<T, IDX>* mat = NULL;
+        const IDX* sorted = NULL;
+        size_t number = 0;
+        std::vector<std::unique_ptr<DenseExtractor<T, IDX> > > blocks;
+        std::vector<size_t> offsets;
+        std::shared_ptr<Workspace> work;
+    };
+
+    // Same as above, but the non-zero elements are reported with their indices in the underlying matrix.
+    template<bool ROW>
+    struct SortedSparseFetcher {
+        SortedSparseFetcher() = default;
+
+        SortedSparseFetcher(const Matrix<T, IDX>* m, const IDX* s, size_t n, bool ns, SparseExtractMode em) : mat(m), sorted(s), number(n), needs_sorted(ns), mode(em) {
+            if (count_runs(sorted, number) > max_runs) {
+                work = mat->new_workspace(ROW);
+                return;
+            }
+
+            for (size_t start = 0; start < number; ) {
+                size_t end = run_end(sorted, start, number);
+                if constexpr(ROW) {
+                    blocks.push_back(mat->sparse_row_extractor(sorted[start], sorted[start] + (end - start), needs_sorted, mode));
+                } else {
+                    blocks.push_back(mat->sparse_column_extractor(sorted[start], sorted[start] + (end - start), needs_sorted, mode));
+                }
+                start = end;
             }
-            return;
         }
 
-        static void find_min_max(size_t start, size_t end, size_t& min_index, size_t& max_index, const V& indices) {
-            min_index = *std::min_element(indices.begin() + start, indices.begin() + end);
-            max_index = *std::max_element(indices.begin() + start, indices.begin() + end) + 1;
+        // 'vbuffer' and 'ibuffer' should always be non-NULL with enough space for 'number' elements.
+        SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) {
+            if (blocks.size() == 1) {
+                return blocks.front()->fetch(i, vbuffer, ibuffer);
+            } else if (blocks.size()) {
+                size_t total = 0;
+                for (auto& b : blocks) {
+                    auto range = b->fetch_copy(i, vbuffer + total, ibuffer + total, SPARSE_COPY_BOTH);
+                    total += range.number;
+                }
+                return SparseRange<T, IDX>(total, (mode == SPARSE_EXTRACT_BOTH ? vbuffer : NULL), (mode != SPARSE_EXTRACT_NONE ? ibuffer : NULL));
+            } else if constexpr(ROW) {
+                return mat->sparse_row_indexed(i, vbuffer, ibuffer, number, sorted, work.get(), needs_sorted);
+            } else {
+                return mat->sparse_column_indexed(i, vbuffer, ibuffer, number, sorted, work.get(), needs_sorted);
+            }
         }
 
-        template <class M>
-        static size_t buffer_size(const M* ptr, bool row) {
-            return row ? ptr->ncol() : ptr->nrow();
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            if (blocks.empty()) {
+                mat->set_oracle(ROW, work.get(), std::move(oracle));
+            } else {
+                for (auto& b : blocks) {
+                    b->set_oracle(oracle);
+                }
+            }
         }
 
-        std::vector<T> value_buffer;
-        std::vector<IDX> index_buffer;
+        const Matrix<T, IDX>* mat = NULL;
+        const IDX* sorted = NULL;
+        size_t number = 0;
+        bool needs_sorted = true;
+        SparseExtractMode mode = SPARSE_EXTRACT_BOTH;
+        std::vector<std::unique_ptr<SparseExtractor<T, IDX> > > blocks;
         std::shared_ptr<Workspace> work;
+    };
+
+    /* Along the subsetted dimension, we just remap the requested index. Otherwise,
+     * we extract the sorted and unique indices with a fetcher that is created once
+     * on construction, gathering the values if the indices are unsorted or duplicated.
+     */
+    template<bool ROW>
+    struct SubsetDenseExtractor : public DenseExtractor<T, IDX> {
+        static constexpr bool along = (ROW == (MARGIN == 0));
+
+        SubsetDenseExtractor(const DelayedSubset* p, size_t start, size_t end) : DenseExtractor<T, IDX>(start, end), parent(p) {
+            if constexpr(along) {
+                if constexpr(ROW) {
+                    inner = parent->mat->dense_row_extractor(start, end);
+                } else {
+                    inner = parent->mat->dense_column_extractor(start, end);
+                }
+            } else {
+                if (start >= end) {
+                    return;
+                }
+                if (!parent->reverse_indices.empty()) {
+                    fetcher = SortedDenseFetcher<ROW>(parent->mat.get(), parent->sorted_indices() + start, end - start);
+                } else {
+                    parent->plan_gather(start, end, plan);
+                    fetcher = SortedDenseFetcher<ROW>(parent->mat.get(), plan.unique.data(), plan.unique.size());
+                }
+            }
+        }
+
+        const T* fetch(size_t i, T* buffer) {
+            if constexpr(along) {
+                return inner->fetch(parent->indices[i], buffer);
+            } else {
+                if (this->block_first >= this->block_last) {
+                    return buffer;
+                } else if (plan.mapping.empty()) {
+                    return fetcher.fetch(i, buffer);
+                } else {
+                    auto ptr = fetcher.fetch(i, plan.holding.data());
+                    gather_expanded(ptr, plan.mapping.data(), buffer, this->length());
+                    return buffer;
+                }
+            }
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            if constexpr(along) {
+                if (oracle) {
+                    oracle.reset(new SubsetOracle(std::move(oracle), &(parent->indices)));
+                }
+                inner->set_oracle(std::move(oracle));
+            } else if (this->block_first < this->block_last) {
+                fetcher.set_oracle(std::move(oracle));
+            }
+        }
+
+        const DelayedSubset* parent;
+        std::unique_ptr<DenseExtractor<T, IDX> > inner;
+        SortedDenseFetcher<ROW> fetcher;
+        GatherPlan plan;
+    };
+
+    template<bool ROW>
+    struct SubsetSparseExtractor : public SparseExtractor<T, IDX> {
+        static constexpr bool along = (ROW == (MARGIN == 0));
+
+        SubsetSparseExtractor(const DelayedSubset* p, size_t start, size_t end, bool sorted, SparseExtractMode mode) : SparseExtractor<T, IDX>(start, end, sorted, mode), parent(p) {
+            if constexpr(along) {
+                if constexpr(ROW) {
+                    sinner = parent->mat->sparse_row_extractor(start, end, sorted, mode);
+                } else {
+                    sinner = parent->mat->sparse_column_extractor(start, end, sorted, mode);
+                }
+            } else {
+                if (start >= end) {
+                    return;
+                }
+
+                // Values and indices are still needed for remapping, so we provide our own buffers if the caller doesn't.
+                if (mode != SPARSE_EXTRACT_BOTH) {
+                    vholding.resize(end - start);
+                    if (mode == SPARSE_EXTRACT_NONE) {
+                        iholding.resize(end - start);
+                    }
+                }
+
+                if (!parent->reverse_indices.empty()) {
+                    sfetcher = SortedSparseFetcher<ROW>(parent->mat.get(), parent->sorted_indices() + start, end - start, sorted, mode);
+                } else {
+                    // Values are not needed from the underlying matrix if the caller doesn't want them.
+                    parent->plan_gather(start, end, plan);
+                    auto inner_mode = (mode == SPARSE_EXTRACT_BOTH ? SPARSE_EXTRACT_BOTH : SPARSE_EXTRACT_INDEX);
+                    sfetcher = SortedSparseFetcher<ROW>(parent->mat.get(), plan.unique.data(), plan.unique.size(), sorted, inner_mode);
+                }
+            }
+        }
+
+        SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) {
+            if constexpr(along) {
+                return sinner->fetch(parent->indices[i], vbuffer, ibuffer);
+            } else {
+                if (this->extract_mode != SPARSE_EXTRACT_BOTH) {
+                    vbuffer = vholding.data();
+                    if (this->extract_mode == SPARSE_EXTRACT_NONE) {
+                        ibuffer = iholding.data();
+                    }
+                }
 
-        std::pair<size_t, size_t> last_start, last_end;
+                size_t total = 0;
+                if (this->block_first >= this->block_last) {
+                    ;
+                } else if (plan.mapping.empty()) {
+                    auto range = sfetcher.fetch(i, vbuffer, ibuffer);
+                    total = parent->remap_indexed(range, vbuffer, ibuffer);
+                } else {
+                    auto range = sfetcher.fetch(i, plan.holding.data(), plan.iholding.data());
+                    total = scatter_sparse(range, plan, vbuffer, ibuffer, this->needs_sorted && this->extract_mode != SPARSE_EXTRACT_NONE);
+                }
+                return this->restrict_mode(SparseRange<T, IDX>(total, vbuffer, ibuffer));
+            }
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            if constexpr(along) {
+                if (oracle) {
+                    oracle.reset(new SubsetOracle(std::move(oracle), &(parent->indices)));
+                }
+                sinner->set_oracle(std::move(oracle));
+            } else if (this->block_first >= this->block_last) {
+                return;
+            } else {
+                sfetcher.set_oracle(std::move(oracle));
+            }
+        }
+
+        const DelayedSubset* parent;
+        std::unique_ptr<SparseExtractor<T, IDX> > sinner;
+        SortedSparseFetcher<ROW> sfetcher;
+        GatherPlan plan;
+        std::vector<T> vholding;
+        std::vector<IDX> iholding;
     };
 
 private:
     std::shared_ptr<const Matrix<T, IDX> > mat;
     V indices;
     std::vector<IDX> reverse_indices;
+    std::vector<IDX> indices_copy;
+    std::vector<IDX> sorted_order;
+    size_t nunique = 0;
+
+    const IDX* sorted_indices() const {
+        if constexpr(has_data<IDX, V>::value) {
+            return indices.data();
+        } else {
+            return indices_copy.data();
+        }
+    }
+
+    // Maximum number of contiguous runs to be extracted as separate blocks.
+    static constexpr size_t max_runs = 8;
+
+    // Stops counting once we exceed 'max_runs', as the exact number doesn't matter.
+    static size_t count_runs(const IDX* sorted, size_t n) {
+        size_t runs = (n > 0);
+        for (size_t i = 1; i < n && runs <= max_runs; ++i) {
+            runs += (sorted[i] != sorted[i - 1] + 1);
+        }
+        return runs;
+    }
+
+    static size_t run_end(const IDX* sorted, size_t start, size_t n) {
+        ++start;
+        while (start < n && sorted[start] == sorted[start - 1] + 1) {
+            ++start;
+        }
+        return start;
+    }
+
+    void plan_gather(size_t start, size_t end, GatherPlan& plan) const {
+        plan.unique.clear();
+        plan.mapping.resize(end - start);
+        plan.positions.clear();
+        plan.offsets.clear();
+
+        for (size_t p : sorted_order) {
+            if (p < start || p >= end) {
+                continue;
+            }
+            IDX current = indices[p];
+            if (plan.unique.empty() || plan.unique.back() != current) {
+                plan.unique.push_back(current);
+                plan.offsets.push_back(plan.positions.size());
+            }
+            plan.mapping[p - start] = plan.unique.size() - 1;
+            plan.positions.push_back(p);
+        }
+        plan.offsets.push_back(plan.positions.size());
+
+        plan.holding.resize(plan.unique.size());
+        plan.iholding.resize(plan.unique.size());
+    }
+
+    GatherPlan& cached_plan(SubsetWorkspace* work, size_t start, size_t end) const {
+        if (!work->planned || start != work->last_start || end != work->last_end) {
+            plan_gather(start, end, work->plan);
+            work->planned = true;
+            work->last_start = start;
+            work->last_end = end;
+        }
+        return work->plan;
+    }
 
     template<bool ROW>
-    void subset_expanded(size_t r, T* buffer, size_t start, size_t end, Workspace* work) const {
+    const T* extract_sorted(size_t r, T* buffer, size_t n, const IDX* sorted, Workspace* work) const {
+        size_t nruns = count_runs(sorted, n);
+        if (nruns > max_runs) {
+            if constexpr(ROW) {
+                return mat->row_indexed(r, buffer, n, sorted, work);
+            } else {
+                return mat->column_indexed(r, buffer, n, sorted, work);
+            }
+        }
+
+        for (size_t start = 0; start < n; ) {
+            size_t end = run_end(sorted, start, n);
+            auto dest = buffer + start;
+            const T* ptr;
+            if constexpr(ROW) {
+                ptr = mat->row(r, dest, sorted[start], sorted[start] + (end - start), work);
+            } else {
+                ptr = mat->column(r, dest, sorted[start], sorted[start] + (end - start), work);
+            }
+
+            // A single contiguous run can be returned directly.
+            if (nruns == 1) {
+                return ptr;
+            } else if (ptr != dest) {
+                std::copy(ptr, ptr + (end - start), dest);
+            }
+            start = end;
+        }
+
+        return buffer;
+    }
+
+    template<bool ROW>
+    SparseRange<T, IDX> extract_sorted_sparse(size_t r, T* out_values, IDX* out_indices, size_t n, const IDX* sorted, Workspace* work, bool needs_sorted) const {
+        size_t nruns = count_runs(sorted, n);
+        if (nruns > max_runs) {
+            if constexpr(ROW) {
+                return mat->sparse_row_indexed(r, out_values, out_indices, n, sorted, work, needs_sorted);
+            } else {
+                return mat->sparse_column_indexed(r, out_values, out_indices, n, sorted, work, needs_sorted);
+            }
+        }
+
+        size_t total = 0;
+        for (size_t start = 0; start < n; ) {
+            size_t end = run_end(sorted, start, n);
+            auto vdest = out_values + total;
+            auto idest = out_indices + total;
+            SparseRange<T, IDX> range;
+            if constexpr(ROW) {
+                range = mat->sparse_row(r, vdest, idest, sorted[start], sorted[start] + (end - start), work, needs_sorted);
+            } else {
+                range = mat->sparse_column(r, vdest, idest, sorted[start], sorted[start] + (end - start), work, needs_sorted);
+            }
+
+            if (nruns == 1) {
+                return range;
+            }
+            if (range.value != vdest) {
+                std::copy(range.value, range.value + range.number, vdest);
+            }
+            if (range.index != idest) {
+                std::copy(range.index, range.index + range.number, idest);
+            }
+            total += range.number;
+            start = end;
+        }
+
+        return SparseRange<T, IDX>(total, out_values, out_indices);
+    }
+
+    template<bool ROW>
+    const T* subset_expanded(size_t r, T* buffer, size_t start, size_t end, Workspace* work) const {
         if (start >= end) {
-            return;
+            return buffer;
+        }
+
+        if (!reverse_indices.empty()) {
+            if (work != NULL) {
+                work = static_cast<SubsetWorkspace*>(work)->work.get();
+            }
+            return extract_sorted<ROW>(r, buffer, end - start, sorted_indices() + start, work);
         }
 
         if (work == NULL) {
-            std::vector<T> xbuffer(SubsetWorkspace::buffer_size(mat.get(), ROW));
-            size_t min_index, max_index;
-            SubsetWorkspace::find_min_max(start, end, min_index, max_index, indices);
-            subset_expanded_inner<ROW>(r, buffer, xbuffer.data(), start, end, min_index, max_index, NULL);
+            GatherPlan plan;
+            plan_gather(start, end, plan);
+            subset_expanded_gather<ROW>(r, buffer, plan, NULL);
         } else {
-            auto work0 = reinterpret_cast<SubsetWorkspace*>(work);
-            work0->update_last(start, end, indices);
-            subset_expanded_inner<ROW>(r, buffer, work0->value_buffer.data(), start, end, work0->last_start.second, work0->last_end.second, work0->work.get());
+            auto work0 = static_cast<SubsetWorkspace*>(work);
+            subset_expanded_gather<ROW>(r, buffer, cached_plan(work0, start, end), work0->work.get());
         }
+        return buffer;
     }
 
     template<bool ROW>
-    void subset_expanded_inner(size_t r, T* buffer, T* inner_buffer, size_t start, size_t end, size_t min_index, size_t max_index, Workspace* work) const {
-        const T* ptr = NULL;
-        if constexpr(ROW) {
-            ptr = mat->row(r, inner_buffer, min_index, max_index, work);
-        } else { 
-            ptr = mat->column(r, inner_buffer, min_index, max_index, work);
-        }
-        for (size_t i = start; i < end; ++i) {
-            *buffer = ptr[indices[i] - min_index];
-            ++buffer;
-        }
+    void subset_expanded_gather(size_t r, T* buffer, GatherPlan& plan, Workspace* work) const {
+        auto ptr = extract_sorted<ROW>(r, plan.holding.data(), plan.unique.size(), plan.unique.data(), work);
+        gather_expanded(ptr, plan.mapping.data(), buffer, plan.mapping.size());
         return;
     }
 
+    static void gather_expanded(const T* ptr, const IDX* mapping, T* buffer, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            buffer[i] = ptr[mapping[i]];
+        }
+    }
+
     template<bool ROW>
     size_t subset_sparse(size_t r, T* out_values, IDX* out_indices, size_t start, size_t end, Workspace* work, bool sorted) const {
         if (start >= end) {
             return 0;
         }
 
+        if (!reverse_indices.empty()) {
+            if (work != NULL) {
+                work = static_cast<SubsetWorkspace*>(work)->work.get();
+            }
+            auto range = extract_sorted_sparse<ROW>(r, out_values, out_indices, end - start, sorted_indices() + start, work, sorted);
+            return remap_indexed(range, out_values, out_indices);
+        }
+
         if (work == NULL) {
-            std::vector<T> xbuffer(SubsetWorkspace::buffer_size(mat.get(), ROW));
-            std::vector<IDX> ibuffer(xbuffer.size());
-            size_t min_index, max_index;
-            SubsetWorkspace::find_min_max(start, end, min_index, max_index, indices);
-            return subset_sparse_inner<ROW>(r, out_values, out_indices, xbuffer.data(), ibuffer.data(), start, end, min_index, max_index, NULL, sorted);
+            GatherPlan plan;
+            plan_gather(start, end, plan);
+            return subset_sparse_gather<ROW>(r, out_values, out_indices, plan, NULL, sorted);
         } else {
-            auto work0 = reinterpret_cast<SubsetWorkspace*>(work);
-            work0->update_last(start, end, indices);
-            return subset_sparse_inner<ROW>(r, out_values, out_indices, work0->value_buffer.data(), work0->index_buffer.data(), start, end, work0->last_start.second, work0->last_end.second, work0->work.get(), sorted);
+            auto work0 = static_cast<SubsetWorkspace*>(work);
+            return subset_sparse_gather<ROW>(r, out_values, out_indices, cached_plan(work0, start, end), work0->work.get(), sorted);
         }
     }
 
-    template<bool ROW>
-    size_t subset_sparse_inner(size_t r, T* out_values, IDX* out_indices, T* inner_out_values, IDX* inner_out_indices, size_t start, size_t end, size_t min_index, size_t max_index, Workspace* work, bool sorted) const {
-        if (reverse_indices.empty()) {
-            // Has duplicates or is out-of-order... need to expand the sparse vector into an array for indexing.
-            const T* ptr = NULL;
-            if constexpr(ROW) {
-                ptr = mat->row(r, inner_out_values, min_index, max_index, work);
-            } else { 
-                ptr = mat->column(r, inner_out_values, min_index, max_index, work);
-            }
-
-            auto copy = out_indices;
-            for (size_t i = start; i < end; ++i) {
-                auto val = ptr[indices[i] - min_index];
-                if (val) { // note that this means that any deliberately inserted zero elements are lost.
-                    *out_values = val;
-                    ++out_values;
-                    *out_indices = i;
-                    ++out_indices;
-                }
+    size_t remap_indexed(const SparseRange<T, IDX>& range, T* out_values, IDX* out_indices) const {
+        // Remapping to positions in the subset, which is safe even if 'range' points to 'out_*'.
+        // Either pointer may be NULL if the range was extracted without values or indices.
+        if (range.value) {
+            for (size_t i = 0; i < range.number; ++i) {
+                out_values[i] = range.value[i];
             }
+        }
+        if (range.index) {
+            for (size_t i = 0; i < range.number; ++i) {
+                out_indices[i] = reverse_indices[range.index[i]];
+            }
+        }
+        return range.number;
+    }
 
-            return static_cast<size_t>(out_indices - copy);
+    template<bool ROW>
+    size_t subset_sparse_gather(size_t r, T* out_values, IDX* out_indices, GatherPlan& plan, Workspace* work, bool sorted) const {
+        auto range = extract_sorted_sparse<ROW>(r, plan.holding.data(), plan.iholding.data(), plan.unique.size(), plan.unique.data(), work, sorted);
+        return scatter_sparse(range, plan, out_values, out_indices, sorted);
+    }
 
-        } else {
-            // No duplicates, this just involves doing the reverse look-up.
-            SparseRange<T, IDX> range;
-            if constexpr(ROW) {
-                range = mat->sparse_row(r, inner_out_values, inner_out_indices, min_index, max_index, work, sorted);
-            } else {
-                range = mat->sparse_column(r, inner_out_values, inner_out_indices, min_index, max_index, work, sorted);
+    static size_t scatter_sparse(const SparseRange<T, IDX>& range, GatherPlan& plan, T* out_values, IDX* out_indices, bool sorted) {
+        // Has duplicates or is out-of-order... each non-zero element is copied to all of its positions in the subset.
+        size_t total = 0;
+        for (size_t i = 0; i < range.number; ++i) {
+            size_t u = std::lower_bound(plan.unique.begin(), plan.unique.end(), range.index[i]) - plan.unique.begin();
+            for (size_t k = plan.offsets[u], end = plan.offsets[u + 1]; k < end; ++k, ++total) {
+                out_indices[total] = plan.positions[k];
+                if (range.value) {
+                    out_values[total] = range.value[i];
+                }
             }
+        }
 
-            auto copy = out_indices;
-            for (size_t i = 0; i < range.number; ++i, ++range.index, ++range.value) {
-                auto final_idx = reverse_indices[*range.index];
-                if (final_idx != static_cast<IDX>(indices.size())) {
-                    *out_values = *range.value;
-                    ++out_values;
-                    *out_indices = final_idx;
-                    ++out_indices;
+        // Positions are only sorted within each unique index, so we need to sort across indices.
+        if (sorted && !std::is_sorted(out_indices, out_indices + total)) {
+            if (range.value) {
+                plan.sorting.clear();
+                for (size_t i = 0; i < total; ++i) {
+                    plan.sorting.emplace_back(out_indices[i], out_values[i]);
+                }
+                std::sort(plan.sorting.begin(), plan.sorting.end());
+                for (size_t i = 0; i < total; ++i) {
+                    out_indices[i] = plan.sorting[i].first;
+                    out_values[i] = plan.sorting[i].second;
                 }
+            } else {
+                std::sort(out_indices, out_indices + total);
             }
-
-            return static_cast<size_t>(out_indices - copy);
         }
+
+        return total;
     }
 };
 
@@ -3,7 +3,9 @@
 
 #include "Matrix.hpp"
 #include <algorithm>
+#include <vector>
 #include <memory>
+#include <numeric>
 
 /**
  * @file DelayedSubsetBlock.hpp
@@ -83,6 +85,163 @@ public:
 
     using Matrix<T, IDX>::sparse_row;
 
+public:
+    bool has_dense_view(bool row) const {
+        return mat->has_dense_view(row);
+    }
+
+    /**
+     * @param row Should views be reported for rows?
+     * @return Whether views are available from the underlying matrix.
+     * This is always `false` for extraction across the subsetted dimension, as the indices would need to be shifted.
+     */
+    bool has_sparse_view(bool row) const {
+        return row == (MARGIN == 0) && mat->has_sparse_view(row);
+    }
+
+    bool row_view(size_t r, const T*& view, size_t start, size_t end) const {
+        if constexpr(MARGIN == 0) {
+            return mat->row_view(first + r, view, start, end);
+        } else {
+            return mat->row_view(r, view, first + start, first + end);
+        }
+    }
+
+    bool column_view(size_t c, const T*& view, size_t start, size_t end) const {
+        if constexpr(MARGIN == 0) {
+            return mat->column_view(c, view, first + start, first + end);
+        } else {
+            return mat->column_view(first + c, view, start, end);
+        }
+    }
+
+    bool sparse_row_view(size_t r, SparseRange<T, IDX>& view, size_t start, size_t end) const {
+        if constexpr(MARGIN == 0) {
+            return mat->sparse_row_view(first + r, view, start, end);
+        } else {
+            return false;
+        }
+    }
+
+    bool sparse_column_view(size_t c, SparseRange<T, IDX>& view, size_t start, size_t end) const {
+        if constexpr(MARGIN == 0) {
+            return false;
+        } else {
+            return mat->sparse_column_view(first + c, view, start, end);
+        }
+    }
+
+    using Matrix<T, IDX>::row_view;
+
+    using Matrix<T, IDX>::column_view;
+
+    using Matrix<T, IDX>::sparse_row_view;
+
+    using Matrix<T, IDX>::sparse_column_view;
+
+public:
+    const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        if constexpr(MARGIN == 0) {
+            return mat->rows(first + first_row, first + last_row, buffer, first_col, last_col, work);
+        } else {
+            return mat->rows(first_row, last_row, buffer, first + first_col, first + last_col, work);
+        }
+    }
+
+    const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        if constexpr(MARGIN == 0) {
+            return mat->columns(first_col, last_col, buffer, first + first_row, first + last_row, work);
+        } else {
+            return mat->columns(first + first_col, first + last_col, buffer, first_row, last_row, work);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_rows(size_t first_row, size_t last_row, T* out_values, IDX* out_indices, size_t* out_pointers, size_t first_col, size_t last_col, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(MARGIN==0) {
+            return mat->sparse_rows(first + first_row, first + last_row, out_values, out_indices, out_pointers, first_col, last_col, work, sorted);
+        } else {
+            auto output = mat->sparse_rows(first_row, last_row, out_values, out_indices, out_pointers, first + first_col, first + last_col, work, sorted);
+            shift_indices(output, out_indices);
+            return output;
+        }
+    }
+
+    SparseRange<T, IDX> sparse_columns(size_t first_col, size_t last_col, T* out_values, IDX* out_indices, size_t* out_pointers, size_t first_row, size_t last_row, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(MARGIN==0) {
+            auto output = mat->sparse_columns(first_col, last_col, out_values, out_indices, out_pointers, first + first_row, first + last_row, work, sorted);
+            shift_indices(output, out_indices);
+            return output;
+        } else {
+            return mat->sparse_columns(first + first_col, first + last_col, out_values, out_indices, out_pointers, first_row, last_row, work, sorted);
+        }
+    }
+
+public:
+    const T* row_indexed(size_t r, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if constexpr(MARGIN == 0) {
+            return mat->row_indexed(first + r, buffer, n, indices, work);
+        } else {
+            auto shifted = shift_requested(n, indices);
+            return mat->row_indexed(r, buffer, n, shifted.data(), work);
+        }
+    }
+
+    const T* column_indexed(size_t c, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if constexpr(MARGIN == 0) {
+            auto shifted = shift_requested(n, indices);
+            return mat->column_indexed(c, buffer, n, shifted.data(), work);
+        } else {
+            return mat->column_indexed(first + c, buffer, n, indices, work);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_row_indexed(size_t r, T* out_values, IDX* out_indices, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(MARGIN==0) {
+            return mat->sparse_row_indexed(first + r, out_values, out_indices, n, indices, work, sorted);
+        } else {
+            auto shifted = shift_requested(n, indices);
+            auto output = mat->sparse_row_indexed(r, out_values, out_indices, n, shifted.data(), work, sorted);
+            shift_indices(output, out_indices);
+            return output;
+        }
+    }
+
+    SparseRange<T, IDX> sparse_column_indexed(size_t c, T* out_values, IDX* out_indices, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(MARGIN==0) {
+            auto shifted = shift_requested(n, indices);
+            auto output = mat->sparse_column_indexed(c, out_values, out_indices, n, shifted.data(), work, sorted);
+            shift_indices(output, out_indices);
+            return output;
+        } else {
+            return mat->sparse_column_indexed(first + c, out_values, out_indices, n, indices, work, sorted);
+        }
+    }
+
+public:
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor(size_t start, size_t end) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new BlockDenseExtractor<true>(this, start, end));
+    }
+
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor(size_t start, size_t end) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new BlockDenseExtractor<false>(this, start, end));
+    }
+
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(size_t start, size_t end, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new BlockSparseExtractor<true>(this, start, end, sorted, mode));
+    }
+
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(size_t start, size_t end, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new BlockSparseExtractor<false>(this, start, end, sorted, mode));
+    }
+
+    using Matrix<T, IDX>::dense_row_extractor;
+
+    using Matrix<T, IDX>::dense_column_extractor;
+
+    using Matrix<T, IDX>::sparse_row_extractor;
+
+    using Matrix<T, IDX>::sparse_column_extractor;
+
 public:
     /**
      * @return Number of rows after any subsetting is applied.
@@ -115,6 +274,18 @@ public:
         return mat->new_workspace(row);
     }
 
+    /**
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()`.
+     * @param oracle Pointer to an oracle, which is passed to the underlying (pre-subsetted) matrix after shifting the predictions to the start of the block.
+     */
+    void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {
+        if (oracle && row == (MARGIN == 0)) {
+            oracle.reset(new BlockOracle(std::move(oracle), first));
+        }
+        mat->set_oracle(row, work, std::move(oracle));
+    }
+
     /**
      * @return The sparsity status of the underlying (pre-subsetted) matrix.
      */
@@ -129,10 +300,146 @@ public:
         return mat->prefer_rows();
     }
 
+    /**
+     * @return The natural block size of the underlying (pre-subsetted) matrix.
+     * Note that blocks may not be aligned to the start of the subset.
+     */
+    std::pair<size_t, size_t> tile_dimensions() const {
+        return mat->tile_dimensions();
+    }
+
+    /**
+     * @param[out] total On output, the total number of structural non-zero elements in the block.
+     * @return Whether `total` was filled.
+     * This is only possible if the counts along the subsetted dimension are known for the underlying matrix.
+     */
+    bool nonzero_count(size_t& total) const {
+        std::vector<size_t> counts(last - first);
+        if (!nonzero_counts(MARGIN == 0, counts.data())) {
+            return false;
+        }
+        total = std::accumulate(counts.begin(), counts.end(), static_cast<size_t>(0));
+        return true;
+    }
+
+    /**
+     * @param row Should the number of non-zero elements be reported for each row?
+     * @param[out] counts Pointer to an array of length equal to the number of rows (if `row = true`) or columns (otherwise).
+     *
+     * @return Whether `counts` was filled.
+     * This is only possible along the subsetted dimension, if the counts are known for the underlying matrix.
+     */
+    bool nonzero_counts(bool row, size_t* counts) const {
+        if (row != (MARGIN == 0)) {
+            return false;
+        }
+        std::vector<size_t> full(row ? mat->nrow() : mat->ncol());
+        if (!mat->nonzero_counts(row, full.data())) {
+            return false;
+        }
+        std::copy(full.begin() + first, full.begin() + last, counts);
+        return true;
+    }
+
+    /**
+     * @return Approximate number of bytes used by this matrix, including the underlying (pre-subsetted) matrix.
+     */
+    size_t memory_usage() const {
+        return sizeof(DelayedSubsetBlock) + mat->memory_usage();
+    }
+
+    /**
+     * @param row Should the usage be reported for a workspace for row extraction?
+     * @return Approximate number of bytes used by each workspace, i.e., that of the underlying (pre-subsetted) matrix.
+     */
+    size_t workspace_memory_usage(bool row) const {
+        return mat->workspace_memory_usage(row);
+    }
+
 private:
     std::shared_ptr<const Matrix<T, IDX> > mat;
     size_t first, last;
 
+    struct BlockOracle : public Oracle {
+        BlockOracle(std::shared_ptr<const Oracle> s, size_t o) : source(std::move(s)), offset(o) {}
+        size_t total() const { return source->total(); }
+        size_t get(size_t i) const { return source->get(i) + offset; }
+        std::shared_ptr<const Oracle> source;
+        size_t offset;
+    };
+
+    /* Along the subsetted dimension, the underlying extractor covers the
+     * same range and only the requested index is shifted. Otherwise, the
+     * range itself is shifted and the extracted indices are shifted back.
+     */
+    template<bool ROW>
+    struct BlockDenseExtractor : public DenseExtractor<T, IDX> {
+        static constexpr bool along = (ROW == (MARGIN == 0));
+
+        BlockDenseExtractor(const DelayedSubsetBlock* p, size_t start, size_t end) : DenseExtractor<T, IDX>(start, end), parent(p) {
+            size_t offset = (along ? 0 : parent->first);
+            if constexpr(ROW) {
+                inner = parent->mat->dense_row_extractor(start + offset, end + offset);
+            } else {
+                inner = parent->mat->dense_column_extractor(start + offset, end + offset);
+            }
+        }
+
+        const T* fetch(size_t i, T* buffer) {
+            if constexpr(along) {
+                return inner->fetch(i + parent->first, buffer);
+            } else {
+                return inner->fetch(i, buffer);
+            }
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            if (oracle && along) {
+                oracle.reset(new BlockOracle(std::move(oracle), parent->first));
+            }
+            inner->set_oracle(std::move(oracle));
+        }
+
+        const DelayedSubsetBlock* parent;
+        std::unique_ptr<DenseExtractor<T, IDX> > inner;
+    };
+
+    template<bool ROW>
+    struct BlockSparseExtractor : public SparseExtractor<T, IDX> {
+        static constexpr bool along = (ROW == (MARGIN == 0));
+
+        BlockSparseExtractor(const DelayedSubsetBlock* p, size_t start, size_t end, bool sorted, SparseExtractMode mode) : SparseExtractor<T, IDX>(start, end, sorted, mode), parent(p) {
+            size_t offset = (along ? 0 : parent->first);
+            if constexpr(ROW) {
+                inner = parent->mat->sparse_row_extractor(start + offset, end + offset, sorted, mode);
+            } else {
+                inner = parent->mat->sparse_column_extractor(start + offset, end + offset, sorted, mode);
+            }
+        }
+
+        SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) {
+            if constexpr(along) {
+                return inner->fetch(i + parent->first, vbuffer, ibuffer);
+            } else {
+                auto output = inner->fetch(i, vbuffer, ibuffer);
+                if (this->extract_mode != SPARSE_EXTRACT_NONE) {
+                    parent->shift_indices(output, ibuffer);
+                }
+                return output;
+            }
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            if (oracle && along) {
+                oracle.reset(new BlockOracle(std::move(oracle), parent->first));
+            }
+            inner->set_oracle(std::move(oracle));
+        }
+
+        const DelayedSubsetBlock* parent;
+        std::unique_ptr<SparseExtractor<T, IDX> > inner;
+    };
+
     template<bool ROW>
     SparseRange<T, IDX> subset_sparse(size_t i, T* out_values, IDX* out_indices, size_t start, size_t end, Workspace* work, bool sorted) const {
         SparseRange<T, IDX> output;
@@ -143,6 +450,19 @@ private:
             output = mat->sparse_column(i, out_values, out_indices, start + first, end + first, work, sorted);
         }
 
+        shift_indices(output, out_indices);
+        return output;
+    }
+
+    std::vector<IDX> shift_requested(size_t n, const IDX* indices) const {
+        std::vector<IDX> shifted(indices, indices + n);
+        for (auto& s : shifted) {
+            s += first;
+        }
+        return shifted;
+    }
+
+    void shift_indices(SparseRange<T, IDX>& output, IDX* out_indices) const {
         if (first) {
             if (out_indices != output.index) {
                 std::copy(output.index, output.index + output.number, out_indices);
@@ -152,8 +472,6 @@ private:
                 out_indices[i] -= first;
             }
         }
-
-        return output;
     }
 };
 
@@ -55,6 +55,97 @@ public:
 
     using Matrix<T, IDX>::sparse_row;
 
+public:
+    bool has_dense_view(bool row) const {
+        return mat->has_dense_view(!row);
+    }
+
+    bool has_sparse_view(bool row) const {
+        return mat->has_sparse_view(!row);
+    }
+
+    bool row_view(size_t r, const T*& view, size_t first, size_t last) const {
+        return mat->column_view(r, view, first, last);
+    }
+
+    bool column_view(size_t c, const T*& view, size_t first, size_t last) const {
+        return mat->row_view(c, view, first, last);
+    }
+
+    bool sparse_row_view(size_t r, SparseRange<T, IDX>& view, size_t first, size_t last) const {
+        return mat->sparse_column_view(r, view, first, last);
+    }
+
+    bool sparse_column_view(size_t c, SparseRange<T, IDX>& view, size_t first, size_t last) const {
+        return mat->sparse_row_view(c, view, first, last);
+    }
+
+    using Matrix<T, IDX>::row_view;
+
+    using Matrix<T, IDX>::column_view;
+
+    using Matrix<T, IDX>::sparse_row_view;
+
+    using Matrix<T, IDX>::sparse_column_view;
+
+public:
+    const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        return mat->columns(first_row, last_row, buffer, first_col, last_col, work);
+    }
+
+    const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        return mat->rows(first_col, last_col, buffer, first_row, last_row, work);
+    }
+
+    SparseRange<T, IDX> sparse_rows(size_t first_row, size_t last_row, T* vbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_col, size_t last_col, Workspace* work=nullptr, bool sorted=true) const {
+        return mat->sparse_columns(first_row, last_row, vbuffer, ibuffer, pbuffer, first_col, last_col, work, sorted);
+    }
+
+    SparseRange<T, IDX> sparse_columns(size_t first_col, size_t last_col, T* vbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_row, size_t last_row, Workspace* work=nullptr, bool sorted=true) const {
+        return mat->sparse_rows(first_col, last_col, vbuffer, ibuffer, pbuffer, first_row, last_row, work, sorted);
+    }
+
+    const T* row_indexed(size_t r, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        return mat->column_indexed(r, buffer, n, indices, work);
+    }
+
+    const T* column_indexed(size_t c, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        return mat->row_indexed(c, buffer, n, indices, work);
+    }
+
+    SparseRange<T, IDX> sparse_row_indexed(size_t r, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        return mat->sparse_column_indexed(r, vbuffer, ibuffer, n, indices, work, sorted);
+    }
+
+    SparseRange<T, IDX> sparse_column_indexed(size_t c, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        return mat->sparse_row_indexed(c, vbuffer, ibuffer, n, indices, work, sorted);
+    }
+
+public:
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor(size_t first, size_t last) const {
+        return mat->dense_column_extractor(first, last);
+    }
+
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor(size_t first, size_t last) const {
+        return mat->dense_row_extractor(first, last);
+    }
+
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return mat->sparse_column_extractor(first, last, sorted, mode);
+    }
+
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return mat->sparse_row_extractor(first, last, sorted, mode);
+    }
+
+    using Matrix<T, IDX>::dense_row_extractor;
+
+    using Matrix<T, IDX>::dense_column_extractor;
+
+    using Matrix<T, IDX>::sparse_row_extractor;
+
+    using Matrix<T, IDX>::sparse_column_extractor;
+
 public:
     /**
      * @return Number of rows after transposition.
@@ -77,6 +168,15 @@ public:
         return mat->new_workspace(!row);
     }
 
+    /**
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()`.
+     * @param oracle Pointer to an oracle, which is passed to the underlying (pre-transposed) matrix.
+     */
+    void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {
+        mat->set_oracle(!row, work, std::move(oracle));
+    }
+
     /**
      * @return The sparsity status of the underlying (pre-subsetted) matrix.
      */
@@ -90,6 +190,47 @@ public:
     bool prefer_rows() const {
         return !mat->prefer_rows();
     }
+
+    /**
+     * @return The natural block size of the underlying matrix, with the row and column dimensions swapped.
+     */
+    std::pair<size_t, size_t> tile_dimensions() const {
+        auto tiles = mat->tile_dimensions();
+        return std::make_pair(tiles.second, tiles.first);
+    }
+
+    /**
+     * @param[out] total On output, the total number of structural non-zero elements in the underlying matrix, if known.
+     * @return Whether `total` was filled.
+     */
+    bool nonzero_count(size_t& total) const {
+        return mat->nonzero_count(total);
+    }
+
+    /**
+     * @param row Should the number of non-zero elements be reported for each row?
+     * @param[out] counts Pointer to an array of length equal to the number of rows (if `row = true`) or columns (otherwise).
+     *
+     * @return Whether `counts` was filled, using the counts for the opposite dimension of the underlying matrix.
+     */
+    bool nonzero_counts(bool row, size_t* counts) const {
+        return mat->nonzero_counts(!row, counts);
+    }
+
+    /**
+     * @return Approximate number of bytes used by this matrix, including the underlying matrix.
+     */
+    size_t memory_usage() const {
+        return sizeof(DelayedTranspose) + mat->memory_usage();
+    }
+
+    /**
+     * @param row Should the usage be reported for a workspace for row extraction?
+     * @return Approximate number of bytes used by each workspace, i.e., that of the underlying matrix for the opposite dimension.
+     */
+    size_t workspace_memory_usage(bool row) const {
+        return mat->workspace_memory_usage(!row);
+    }
 private:
     std::shared_ptr<const Matrix<T, IDX> > mat;
 };
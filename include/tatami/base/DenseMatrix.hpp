@@ -64,6 +64,13 @@ public:
      */
     bool prefer_rows() const { return ROW; }
 
+    /**
+     * @return Approximate number of bytes used by this matrix, including the array of values.
+     */
+    size_t memory_usage() const {
+        return sizeof(DenseMatrix) + values.size() * sizeof(values[0]);
+    }
+
 public:
     const T* row(size_t r, T* buffer, size_t start, size_t end, Workspace* work=nullptr) const {
         if constexpr(ROW) {
@@ -87,10 +94,134 @@ public:
 
     using Matrix<T, IDX>::column;
 
+public:
+    /**
+     * @param row Should views be reported for rows?
+     * @return Whether views are available, i.e., if `row = ROW` and `V` has a `data()` method returning a pointer to `T`.
+     */
+    bool has_dense_view(bool row) const {
+        if constexpr(has_data<T, V>::value) {
+            return row == ROW;
+        } else {
+            return false;
+        }
+    }
+
+    bool row_view(size_t r, const T*& view, size_t first, size_t last) const {
+        if constexpr(ROW) {
+            return primary_view(r, view, first, ncols);
+        } else {
+            return false;
+        }
+    }
+
+    bool column_view(size_t c, const T*& view, size_t first, size_t last) const {
+        if constexpr(ROW) {
+            return false;
+        } else {
+            return primary_view(c, view, first, nrows);
+        }
+    }
+
+    using Matrix<T, IDX>::row_view;
+
+    using Matrix<T, IDX>::column_view;
+
+public:
+    const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            return primary_block(first_row, last_row, buffer, first_col, last_col, ncols);
+        } else {
+            secondary_block(first_row, last_row, buffer, first_col, last_col, nrows);
+            return buffer;
+        }
+    }
+
+    const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            secondary_block(first_col, last_col, buffer, first_row, last_row, ncols);
+            return buffer;
+        } else {
+            return primary_block(first_col, last_col, buffer, first_row, last_row, nrows);
+        }
+    }
+
+    const T* row_indexed(size_t r, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            primary_indexed(r, buffer, n, indices, ncols);
+        } else {
+            secondary_indexed(r, buffer, n, indices, nrows);
+        }
+        return buffer;
+    }
+
+    const T* column_indexed(size_t c, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            secondary_indexed(c, buffer, n, indices, ncols);
+        } else {
+            primary_indexed(c, buffer, n, indices, nrows);
+        }
+        return buffer;
+    }
+
 private: 
     size_t nrows, ncols;
     V values;
 
+    const T* primary_block(size_t first, size_t last, T* buffer, size_t start, size_t end, size_t dim_secondary) const {
+        if constexpr(has_data<T, V>::value) {
+            // Full-width blocks are already contiguous in the underlying store.
+            if (start == 0 && end == dim_secondary) {
+                return values.data() + first * dim_secondary;
+            }
+        }
+
+        size_t width = end - start;
+        auto current = buffer;
+        for (size_t i = first; i < last; ++i, current += width) {
+            auto it = values.begin() + i * dim_secondary;
+            std::copy(it + start, it + end, current);
+        }
+        return buffer;
+    }
+
+    void primary_indexed(size_t i, T* buffer, size_t n, const IDX* indices, size_t dim_secondary) const {
+        auto it = values.begin() + i * dim_secondary;
+        for (size_t k = 0; k < n; ++k) {
+            buffer[k] = *(it + indices[k]);
+        }
+        return;
+    }
+
+    void secondary_indexed(size_t i, T* buffer, size_t n, const IDX* indices, size_t dim_secondary) const {
+        for (size_t k = 0; k < n; ++k) {
+            buffer[k] = values[static_cast<size_t>(indices[k]) * dim_secondary + i];
+        }
+        return;
+    }
+
+    void secondary_block(size_t first, size_t last, T* buffer, size_t start, size_t end, size_t dim_secondary) const {
+        // Iterating along the underlying primary dimension to get contiguous reads.
+        size_t height = last - first;
+        for (size_t j = start; j < end; ++j) {
+            auto it = values.begin() + j * dim_secondary + first;
+            auto current = buffer + (j - start);
+            for (size_t i = 0; i < height; ++i, ++it, current += (end - start)) {
+                *current = *it;
+            }
+        }
+        return;
+    }
+
+    bool primary_view(size_t c, const T*& view, size_t start, size_t dim_secondary) const {
+        if constexpr(has_data<T, V>::value) {
+            view = values.data() + c * dim_secondary + start;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
     const T* primary(size_t c, T* buffer, size_t start, size_t end, Workspace* work, size_t dim_secondary) const {
         size_t shift = c * dim_secondary;
         if constexpr(has_data<T, V>::value) {
@@ -0,0 +1,248 @@
+#ifndef TATAMI_EXTRACTOR_H
+#define TATAMI_EXTRACTOR_H
+
+#include "SparseRange.hpp"
+#include "Oracle.hpp"
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+/**
+ * @file Extractor.hpp
+ *
+ * Defines the virtual base classes for extracting rows or columns with statically typed state.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Base class for extractors.
+ *
+ * An extractor is created by a `Matrix` for repeated extraction of the same range from different rows or columns.
+ * Unlike a `Workspace`, each extractor is typed by its matrix and holds all of its own state,
+ * so no type resolution or bounds setup is required for each request.
+ * Extractors are not thread-safe and should be created separately for each thread.
+ */
+class Extractor {
+public:
+    virtual ~Extractor() = default;
+
+    /**
+     * @return Index of the first column (for row extraction) or row (for column extraction) to be extracted.
+     */
+    size_t first() const {
+        return block_first;
+    }
+
+    /**
+     * @return One past the index of the last column (for row extraction) or row (for column extraction) to be extracted.
+     */
+    size_t last() const {
+        return block_last;
+    }
+
+    /**
+     * @return Number of columns (for row extraction) or rows (for column extraction) to be extracted.
+     * This is also the minimum length of the buffers supplied to `fetch()`.
+     */
+    size_t length() const {
+        return block_last - block_first;
+    }
+
+    /**
+     * Attach an oracle to this extractor, predicting the sequence of rows or columns to be requested with `fetch()`.
+     * This is the equivalent of `Matrix::set_oracle()` for extractors.
+     * Defaults to doing nothing if no specialized method is provided in derived classes.
+     *
+     * @param oracle Pointer to an oracle, or a null pointer to detach any existing oracle.
+     */
+    virtual void set_oracle(std::shared_ptr<const Oracle> oracle) {}
+
+protected:
+    /**
+     * @cond
+     */
+    Extractor(size_t f, size_t l) : block_first(f), block_last(l) {}
+
+    size_t block_first, block_last;
+    /**
+     * @endcond
+     */
+};
+
+/**
+ * @brief Extract dense rows or columns.
+ *
+ * @tparam T Type of the matrix data.
+ * @tparam IDX Type of the row/column indices.
+ */
+template<typename T, typename IDX>
+class DenseExtractor : public Extractor {
+public:
+    /**
+     * `buffer` may not necessarily be filled upon extraction if a pointer can be returned to the underlying data store.
+     * This can be checked by comparing the returned pointer to `buffer`; if they are the same, `buffer` has been filled.
+     *
+     * @param i Index of the row or column.
+     * @param buffer Pointer to an array with enough space for at least `length()` values.
+     *
+     * @return Pointer to the values of row/column `i`, starting from the value at `first()` and containing `length()` valid entries.
+     */
+    virtual const T* fetch(size_t i, T* buffer) = 0;
+
+    /**
+     * @param i Index of the row or column.
+     * @param buffer Pointer to an array with enough space for at least `length()` values.
+     *
+     * @return The array at `buffer` is filled with the values of row/column `i`, and `buffer` itself is returned.
+     */
+    const T* fetch_copy(size_t i, T* buffer) {
+        auto ptr = fetch(i, buffer);
+        if (ptr != buffer) {
+            std::copy(ptr, ptr + this->length(), buffer);
+        }
+        return buffer;
+    }
+
+    /**
+     * @param i Index of the row or column.
+     * @return A vector containing the values of row/column `i`.
+     */
+    std::vector<T> fetch(size_t i) {
+        std::vector<T> output(this->length());
+        fetch_copy(i, output.data());
+        return output;
+    }
+
+protected:
+    /**
+     * @cond
+     */
+    DenseExtractor(size_t f, size_t l) : Extractor(f, l) {}
+    /**
+     * @endcond
+     */
+};
+
+/**
+ * @brief Extract sparse rows or columns.
+ *
+ * @tparam T Type of the matrix data.
+ * @tparam IDX Type of the row/column indices.
+ */
+template<typename T, typename IDX>
+class SparseExtractor : public Extractor {
+public:
+    /**
+     * `vbuffer` and `ibuffer` may not necessarily be filled upon extraction if pointers can be returned to the underlying data store,
+     * see `Matrix::sparse_row()` for details.
+     *
+     * @param i Index of the row or column.
+     * @param vbuffer Pointer to an array with enough space for at least `length()` values.
+     * This may be NULL if `mode()` is not `SPARSE_EXTRACT_BOTH`.
+     * @param ibuffer Pointer to an array with enough space for at least `length()` indices.
+     * This may be NULL if `mode()` is `SPARSE_EXTRACT_NONE`.
+     *
+     * @return A `SparseRange` object containing the number of non-zero elements in row/column `i` from `first()` up to `last()`.
+     * This also contains pointers to arrays containing their indices and values.
+     * The value pointer is NULL if `mode()` is not `SPARSE_EXTRACT_BOTH`, and the index pointer is NULL if `mode()` is `SPARSE_EXTRACT_NONE`.
+     */
+    virtual SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) = 0;
+
+    /**
+     * @param i Index of the row or column.
+     * @param vbuffer Pointer to an array with enough space for at least `length()` values.
+     * @param ibuffer Pointer to an array with enough space for at least `length()` indices.
+     * @param copy Whether the non-zero values and/or indices should be copied into `vbuffer` and `ibuffer`, respectively.
+     *
+     * @return A `SparseRange` object containing the number of non-zero elements in row/column `i` from `first()` up to `last()`.
+     * Depending on `copy`, values and indices will be copied into `vbuffer` and/or `ibuffer`.
+     * Components that are not extracted according to `mode()` are not copied.
+     */
+    SparseRange<T, IDX> fetch_copy(size_t i, T* vbuffer, IDX* ibuffer, SparseCopyMode copy) {
+        auto output = fetch(i, vbuffer, ibuffer);
+
+        if ((copy == SPARSE_COPY_BOTH || copy == SPARSE_COPY_INDEX) && output.index != ibuffer && output.index) {
+            std::copy(output.index, output.index + output.number, ibuffer);
+            output.index = ibuffer;
+        }
+
+        if ((copy == SPARSE_COPY_BOTH || copy == SPARSE_COPY_VALUE) && output.value != vbuffer && output.value) {
+            std::copy(output.value, output.value + output.number, vbuffer);
+            output.value = vbuffer;
+        }
+
+        return output;
+    }
+
+    /**
+     * @param i Index of the row or column.
+     * @return A `SparseRangeCopy` object containing the non-zero elements of row/column `i` from `first()` up to `last()`.
+     * If `mode()` is not `SPARSE_EXTRACT_BOTH`, the `value` vector is empty;
+     * if `mode()` is `SPARSE_EXTRACT_NONE`, the `index` vector is also empty.
+     */
+    SparseRangeCopy<T, IDX> fetch(size_t i) {
+        SparseRangeCopy<T, IDX> output(this->length());
+        auto ret = fetch_copy(i, output.value.data(), output.index.data(), SPARSE_COPY_BOTH);
+        output.index.resize(extract_mode != SPARSE_EXTRACT_NONE ? ret.number : 0);
+        output.value.resize(extract_mode == SPARSE_EXTRACT_BOTH ? ret.number : 0);
+        output.background = ret.background;
+        return output;
+    }
+
+    /**
+     * Allow `fetch()` to report a non-zero `SparseRange::background`, i.e., the value of all elements in the row/column that are not listed in the output.
+     * This enables sparse extraction from matrices where all non-stored elements in each row/column have the same value but are not zero, see `Matrix::sparse_background()`.
+     * Callers should only request backgrounds if they can handle them, as unlisted elements are otherwise assumed to be zero.
+     * Defaults to doing nothing if no specialized method is provided in derived classes.
+     *
+     * @param allow Whether to allow non-zero backgrounds.
+     *
+     * @return Whether `fetch()` may report non-zero backgrounds.
+     * If `false`, all unlisted elements are zero.
+     */
+    virtual bool set_background(bool allow) { return false; }
+
+    /**
+     * @return Whether the non-zero elements are sorted by their indices in the output of `fetch()`.
+     */
+    bool sorted() const {
+        return needs_sorted;
+    }
+
+    /**
+     * @return The components of the non-zero elements that are extracted by `fetch()`.
+     */
+    SparseExtractMode mode() const {
+        return extract_mode;
+    }
+
+protected:
+    /**
+     * @cond
+     */
+    SparseExtractor(size_t f, size_t l, bool s, SparseExtractMode m) : Extractor(f, l), needs_sorted(s), extract_mode(m) {}
+
+    bool needs_sorted;
+
+    SparseExtractMode extract_mode;
+
+    // Hides any components that were extracted anyway but were not requested.
+    SparseRange<T, IDX> restrict_mode(SparseRange<T, IDX> output) const {
+        if (extract_mode != SPARSE_EXTRACT_BOTH) {
+            output.value = NULL;
+            if (extract_mode == SPARSE_EXTRACT_NONE) {
+                output.index = NULL;
+            }
+        }
+        return output;
+    }
+    /**
+     * @endcond
+     */
+};
+
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "SparseRange.hpp"
 #include "Workspace.hpp"
+#include "Oracle.hpp"
+#include "Extractor.hpp"
 
 /**
  * @file Matrix.hpp
@@ -81,6 +83,20 @@ public:
      */
     virtual std::shared_ptr<Workspace> new_workspace(bool row) const { return nullptr; }
 
+    /**
+     * Attach an oracle to a workspace, predicting the sequence of rows or columns that will be requested with that workspace.
+     * Derived classes can use these predictions to prefetch data for upcoming requests.
+     * Defaults to doing nothing if no specialized method is provided in derived classes.
+     *
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()` with the same `row`.
+     * This may be null, in which case the oracle is ignored.
+     * @param oracle Pointer to an oracle, predicting the row indices (if `row = true`) or column indices (otherwise) to be requested with `work`.
+     * Predictions should be in the same order as the calls to `row()`, `column()` or their sparse counterparts.
+     * This may also be null to detach any existing oracle.
+     */
+    virtual void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {}
+
     /**
      * @return Is this matrix sparse?
      * Defaults to `false` if no specialized method is provided in derived classes.
@@ -111,6 +127,75 @@ public:
         }
     }
 
+    /**
+     * Report the natural block size for this matrix, e.g., the chunk dimensions in a file-backed matrix.
+     * Blocks of this size, or multiples thereof, can be extracted efficiently with `rows()` or `columns()`; this is used by `apply_tiled()` to choose its tiles.
+     * Defaults to zero in both dimensions if no specialized method is provided in derived classes.
+     *
+     * @return A `pair` containing the number of rows (`first`) and columns (`second`) in each block.
+     * A value of zero indicates that there is no natural block size for that dimension.
+     */
+    virtual std::pair<size_t, size_t> tile_dimensions() const { return std::make_pair(0, 0); }
+
+    /**
+     * Report the total number of structural non-zero elements, i.e., the elements that would be returned by `sparse_row()` or `sparse_column()` across the entire matrix.
+     * Note that structural non-zeros may include explicitly stored zeros.
+     * Defaults to `false` if no specialized method is provided in derived classes.
+     *
+     * @param[out] total On output, the total number of structural non-zero elements.
+     * This is only filled if the number is cheaply known, i.e., without extracting the matrix contents.
+     *
+     * @return Whether `total` was filled.
+     */
+    virtual bool nonzero_count(size_t& total) const { return false; }
+
+    /**
+     * Report the number of structural non-zero elements in each row or column, see `nonzero_count()` for details.
+     * Defaults to `false` if no specialized method is provided in derived classes.
+     *
+     * @param row Should the number of non-zero elements be reported for each row?
+     * If `false`, numbers are reported for each column instead.
+     * @param[out] counts Pointer to an array of length equal to the number of rows (if `row = true`) or columns (otherwise).
+     * On output, this contains the number of structural non-zero elements in each row or column.
+     * This is only filled if the numbers are cheaply known.
+     *
+     * @return Whether `counts` was filled.
+     */
+    virtual bool nonzero_counts(bool row, size_t* counts) const { return false; }
+
+    /**
+     * Report whether rows or columns can be efficiently extracted in sparse form with a non-zero background, see `SparseExtractor::set_background()`.
+     * This is intended for matrices that are not `sparse()` but where all non-stored elements in each row or column have the same value, e.g., after centering the rows of a sparse matrix.
+     * Defaults to `false` if no specialized method is provided in derived classes.
+     *
+     * @param row Should row extraction be considered?
+     * If `false`, column extraction is considered instead.
+     *
+     * @return Whether sparse extractors for rows (or columns) of this matrix can report a non-zero background.
+     */
+    virtual bool sparse_background(bool row) const { return false; }
+
+    /**
+     * Report the memory used by this matrix, e.g., to decide on the number of threads or the size of the caches in file-backed matrices.
+     * For delayed operations, this includes the memory used by the underlying matrices.
+     * Matrices or arrays that are shared between multiple objects are counted each time they are referenced.
+     * Defaults to zero if no specialized method is provided in derived classes.
+     *
+     * @return Approximate number of bytes used by this matrix, not including any workspaces.
+     */
+    virtual size_t memory_usage() const { return 0; }
+
+    /**
+     * Report the memory used by each workspace for this matrix, see `memory_usage()` for details.
+     * Defaults to zero if no specialized method is provided in derived classes.
+     *
+     * @param row Should the usage be reported for a workspace for row extraction?
+     *
+     * @return Approximate number of bytes used by a workspace created by `new_workspace()` with the same `row`, or by an extractor for rows (if `row = true`) or columns.
+     * This refers to the maximum size of the workspace when extracting the full extent of each row or column.
+     */
+    virtual size_t workspace_memory_usage(bool row) const { return 0; }
+
 public:
     /**
      * `buffer` may not necessarily be filled upon extraction if a pointer can be returned to the underlying data store.
@@ -289,6 +374,124 @@ public:
         return column(c, 0, this->nrow(), work);
     }
 
+public:
+    /**
+     * Extract a contiguous block of rows in a single call.
+     * This avoids the overhead of a separate virtual call (and associated bookkeeping in delayed operations) for each row.
+     * Defaults to repeated calls to `row()` if no specialized method is provided in derived classes.
+     *
+     * `buffer` may not necessarily be filled upon extraction if a pointer can be returned to the underlying data store.
+     * This can be checked by comparing the returned pointer to `buffer`; if they are the same, `buffer` has been filled.
+     *
+     * @param first_row First row of the block.
+     * @param last_row One past the last row of the block.
+     * @param buffer Pointer to an array with enough space for at least `(last_row - first_row) * (last_col - first_col)` values.
+     * @param first_col First column to extract for each row.
+     * @param last_col One past the last column to extract for each row.
+     * @param work Pointer to a workspace, see `row()` for details.
+     *
+     * @return Pointer to the values of the block in row-major layout,
+     * i.e., the values of row `first_row + i` start at position `i * (last_col - first_col)`.
+     */
+    virtual const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        size_t width = last_col - first_col;
+        auto current = buffer;
+        for (size_t r = first_row; r < last_row; ++r, current += width) {
+            row_copy(r, current, first_col, last_col, work);
+        }
+        return buffer;
+    }
+
+    /**
+     * Extract a contiguous block of columns in a single call.
+     * This avoids the overhead of a separate virtual call (and associated bookkeeping in delayed operations) for each column.
+     * Defaults to repeated calls to `column()` if no specialized method is provided in derived classes.
+     *
+     * `buffer` may not necessarily be filled upon extraction if a pointer can be returned to the underlying data store.
+     * This can be checked by comparing the returned pointer to `buffer`; if they are the same, `buffer` has been filled.
+     *
+     * @param first_col First column of the block.
+     * @param last_col One past the last column of the block.
+     * @param buffer Pointer to an array with enough space for at least `(last_col - first_col) * (last_row - first_row)` values.
+     * @param first_row First row to extract for each column.
+     * @param last_row One past the last row to extract for each column.
+     * @param work Pointer to a workspace, see `column()` for details.
+     *
+     * @return Pointer to the values of the block in column-major layout,
+     * i.e., the values of column `first_col + i` start at position `i * (last_row - first_row)`.
+     */
+    virtual const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        size_t height = last_row - first_row;
+        auto current = buffer;
+        for (size_t c = first_col; c < last_col; ++c, current += height) {
+            column_copy(c, current, first_row, last_row, work);
+        }
+        return buffer;
+    }
+
+public:
+    /**
+     * Extract an arbitrary subset of columns from a row.
+     * This is more efficient than extracting the entire range spanned by `indices` when those indices are scattered,
+     * as specialized methods in derived classes will only touch the requested elements.
+     * Defaults to extracting the range from `indices[0]` to `indices[n - 1]` with `row()` and gathering the requested values.
+     *
+     * @param r Index of the row.
+     * @param buffer Pointer to an array with enough space for at least `n` values.
+     * @param n Number of columns to extract.
+     * @param indices Pointer to an array of `n` column indices, sorted in strictly increasing order.
+     * @param work Pointer to a workspace, see `row()` for details.
+     *
+     * @return Pointer to the values of row `r`, where the `i`-th value corresponds to column `indices[i]`.
+     * As with `row()`, this may not be equal to `buffer` if the values can be obtained directly from the underlying data store.
+     */
+    virtual const T* row_indexed(size_t r, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        gather_dense<true>(r, buffer, n, indices, work);
+        return buffer;
+    }
+
+    /**
+     * Extract an arbitrary subset of rows from a column.
+     * This is more efficient than extracting the entire range spanned by `indices` when those indices are scattered,
+     * as specialized methods in derived classes will only touch the requested elements.
+     * Defaults to extracting the range from `indices[0]` to `indices[n - 1]` with `column()` and gathering the requested values.
+     *
+     * @param c Index of the column.
+     * @param buffer Pointer to an array with enough space for at least `n` values.
+     * @param n Number of rows to extract.
+     * @param indices Pointer to an array of `n` row indices, sorted in strictly increasing order.
+     * @param work Pointer to a workspace, see `column()` for details.
+     *
+     * @return Pointer to the values of column `c`, where the `i`-th value corresponds to row `indices[i]`.
+     * As with `column()`, this may not be equal to `buffer` if the values can be obtained directly from the underlying data store.
+     */
+    virtual const T* column_indexed(size_t c, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        gather_dense<false>(c, buffer, n, indices, work);
+        return buffer;
+    }
+
+private:
+    template<bool ROW>
+    void gather_dense(size_t i, T* buffer, size_t n, const IDX* indices, Workspace* work) const {
+        if (n == 0) {
+            return;
+        }
+
+        size_t first = indices[0], last = indices[n - 1] + 1;
+        std::vector<T> holding(last - first);
+        const T* ptr;
+        if constexpr(ROW) {
+            ptr = row(i, holding.data(), first, last, work);
+        } else {
+            ptr = column(i, holding.data(), first, last, work);
+        }
+
+        for (size_t k = 0; k < n; ++k) {
+            buffer[k] = ptr[indices[k] - first];
+        }
+        return;
+    }
+
 public:
     /**
      * `vbuffer` may not necessarily be filled upon extraction if a pointer can be returned to the underlying data store.
@@ -541,6 +744,428 @@ public:
     SparseRangeCopy<T, IDX> sparse_column(size_t c, Workspace* work=nullptr, bool sorted=true) const {
         return sparse_column(c, 0, this->nrow(), work, sorted);
     }
+
+public:
+    /**
+     * Extract the non-zero elements for a contiguous block of rows in a single call.
+     * The output is returned in a compressed sparse row-like layout, where the non-zero elements of each row are stored consecutively.
+     * Defaults to repeated calls to `sparse_row()` if no specialized method is provided in derived classes.
+     *
+     * On return, `pbuffer` is filled with the offsets for each row, where the non-zero elements of row `first_row + i` occupy positions `[pbuffer[i], pbuffer[i + 1])` of the returned arrays and `pbuffer[0]` is always zero.
+     * `vbuffer` and `ibuffer` may not necessarily be filled if pointers can be returned to the underlying data store, see `sparse_row()` for details.
+     *
+     * @param first_row First row of the block.
+     * @param last_row One past the last row of the block.
+     * @param vbuffer Pointer to an array with enough space for at least `(last_row - first_row) * (last_col - first_col)` values.
+     * @param ibuffer Pointer to an array with enough space for at least `(last_row - first_row) * (last_col - first_col)` indices.
+     * @param pbuffer Pointer to an array with enough space for at least `last_row - first_row + 1` offsets.
+     * @param first_col First column to extract for each row.
+     * @param last_col One past the last column to extract for each row.
+     * @param work Pointer to a workspace, see comments in `sparse_row()`.
+     * @param sorted Should the non-zero elements be sorted by their indices within each row? See `sparse_row()` for details.
+     *
+     * @return A `SparseRange` object containing the total number of non-zero elements in the block.
+     * This also contains pointers to arrays containing their column indices and values.
+     */
+    virtual SparseRange<T, IDX> sparse_rows(size_t first_row, size_t last_row, T* vbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_col, size_t last_col, Workspace* work=nullptr, bool sorted=true) const {
+        pbuffer[0] = 0;
+        size_t total = 0;
+        for (size_t r = first_row; r < last_row; ++r) {
+            auto range = sparse_row_copy(r, vbuffer + total, ibuffer + total, first_col, last_col, SPARSE_COPY_BOTH, work, sorted);
+            total += range.number;
+            pbuffer[r - first_row + 1] = total;
+        }
+        return SparseRange<T, IDX>(total, vbuffer, ibuffer);
+    }
+
+    /**
+     * Extract the non-zero elements for a contiguous block of columns in a single call.
+     * The output is returned in a compressed sparse column-like layout, where the non-zero elements of each column are stored consecutively.
+     * Defaults to repeated calls to `sparse_column()` if no specialized method is provided in derived classes.
+     *
+     * On return, `pbuffer` is filled with the offsets for each column, where the non-zero elements of column `first_col + i` occupy positions `[pbuffer[i], pbuffer[i + 1])` of the returned arrays and `pbuffer[0]` is always zero.
+     * `vbuffer` and `ibuffer` may not necessarily be filled if pointers can be returned to the underlying data store, see `sparse_column()` for details.
+     *
+     * @param first_col First column of the block.
+     * @param last_col One past the last column of the block.
+     * @param vbuffer Pointer to an array with enough space for at least `(last_col - first_col) * (last_row - first_row)` values.
+     * @param ibuffer Pointer to an array with enough space for at least `(last_col - first_col) * (last_row - first_row)` indices.
+     * @param pbuffer Pointer to an array with enough space for at least `last_col - first_col + 1` offsets.
+     * @param first_row First row to extract for each column.
+     * @param last_row One past the last row to extract for each column.
+     * @param work Pointer to a workspace, see comments in `sparse_column()`.
+     * @param sorted Should the non-zero elements be sorted by their indices within each column? See `sparse_column()` for details.
+     *
+     * @return A `SparseRange` object containing the total number of non-zero elements in the block.
+     * This also contains pointers to arrays containing their row indices and values.
+     */
+    virtual SparseRange<T, IDX> sparse_columns(size_t first_col, size_t last_col, T* vbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_row, size_t last_row, Workspace* work=nullptr, bool sorted=true) const {
+        pbuffer[0] = 0;
+        size_t total = 0;
+        for (size_t c = first_col; c < last_col; ++c) {
+            auto range = sparse_column_copy(c, vbuffer + total, ibuffer + total, first_row, last_row, SPARSE_COPY_BOTH, work, sorted);
+            total += range.number;
+            pbuffer[c - first_col + 1] = total;
+        }
+        return SparseRange<T, IDX>(total, vbuffer, ibuffer);
+    }
+
+public:
+    /**
+     * Extract the non-zero elements for an arbitrary subset of columns from a row.
+     * Defaults to extracting the range from `indices[0]` to `indices[n - 1]` with `sparse_row()` and retaining only the requested columns.
+     *
+     * `vbuffer` and `ibuffer` may not necessarily be filled upon extraction, see `sparse_row()` for details.
+     *
+     * @param r Index of the row.
+     * @param vbuffer Pointer to an array with enough space for at least `n` values.
+     * @param ibuffer Pointer to an array with enough space for at least `n` indices.
+     * @param n Number of columns to extract.
+     * @param indices Pointer to an array of `n` column indices, sorted in strictly increasing order.
+     * @param work Pointer to a workspace, see comments in `sparse_row()`.
+     * @param sorted Should the non-zero elements be sorted by their indices? See `sparse_row()` for details.
+     *
+     * @return A `SparseRange` object containing the number of non-zero elements in `r` from the requested columns.
+     * This also contains pointers to arrays containing their column indices (i.e., values of `indices`, not positions in `indices`) and values.
+     */
+    virtual SparseRange<T, IDX> sparse_row_indexed(size_t r, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        return gather_sparse<true>(r, vbuffer, ibuffer, n, indices, work);
+    }
+
+    /**
+     * Extract the non-zero elements for an arbitrary subset of rows from a column.
+     * Defaults to extracting the range from `indices[0]` to `indices[n - 1]` with `sparse_column()` and retaining only the requested rows.
+     *
+     * `vbuffer` and `ibuffer` may not necessarily be filled upon extraction, see `sparse_column()` for details.
+     *
+     * @param c Index of the column.
+     * @param vbuffer Pointer to an array with enough space for at least `n` values.
+     * @param ibuffer Pointer to an array with enough space for at least `n` indices.
+     * @param n Number of rows to extract.
+     * @param indices Pointer to an array of `n` row indices, sorted in strictly increasing order.
+     * @param work Pointer to a workspace, see comments in `sparse_column()`.
+     * @param sorted Should the non-zero elements be sorted by their indices? See `sparse_column()` for details.
+     *
+     * @return A `SparseRange` object containing the number of non-zero elements in `c` from the requested rows.
+     * This also contains pointers to arrays containing their row indices (i.e., values of `indices`, not positions in `indices`) and values.
+     */
+    virtual SparseRange<T, IDX> sparse_column_indexed(size_t c, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work=nullptr, bool sorted=true) const {
+        return gather_sparse<false>(c, vbuffer, ibuffer, n, indices, work);
+    }
+
+private:
+    template<bool ROW>
+    SparseRange<T, IDX> gather_sparse(size_t i, T* vbuffer, IDX* ibuffer, size_t n, const IDX* indices, Workspace* work) const {
+        if (n == 0) {
+            return SparseRange<T, IDX>(0, vbuffer, ibuffer);
+        }
+
+        size_t first = indices[0], last = indices[n - 1] + 1;
+        std::vector<T> vholding(last - first);
+        std::vector<IDX> iholding(last - first);
+
+        // Always requesting sorted output here, as we need it for the merge.
+        SparseRange<T, IDX> range;
+        if constexpr(ROW) {
+            range = sparse_row(i, vholding.data(), iholding.data(), first, last, work, true);
+        } else {
+            range = sparse_column(i, vholding.data(), iholding.data(), first, last, work, true);
+        }
+
+        size_t counter = 0;
+        auto it = indices, end = indices + n;
+        for (size_t x = 0; x < range.number; ++x) {
+            auto current = range.index[x];
+            while (it != end && *it < current) {
+                ++it;
+            }
+            if (it == end) {
+                break;
+            }
+            if (*it == current) {
+                vbuffer[counter] = range.value[x];
+                ibuffer[counter] = current;
+                ++counter;
+            }
+        }
+
+        return SparseRange<T, IDX>(counter, vbuffer, ibuffer);
+    }
+
+public:
+    /**
+     * @param row Should views be reported for rows?
+     *
+     * @return Whether `row_view()` (if `row = true`) or `column_view()` is guaranteed to succeed for any row or column, respectively.
+     * This allows callers to decide whether buffers need to be allocated prior to any extraction.
+     * Defaults to `false` if no specialized method is provided in derived classes.
+     */
+    virtual bool has_dense_view(bool row) const { return false; }
+
+    /**
+     * @param row Should views be reported for rows?
+     *
+     * @return Whether `sparse_row_view()` (if `row = true`) or `sparse_column_view()` is guaranteed to succeed for any row or column, respectively.
+     * Defaults to `false` if no specialized method is provided in derived classes.
+     */
+    virtual bool has_sparse_view(bool row) const { return false; }
+
+    /**
+     * Obtain a direct view into the underlying storage for the values of a row, without any copying.
+     * Defaults to reporting that no view is available, if no specialized method is provided in derived classes.
+     *
+     * @param r Index of the row.
+     * @param[out] view On output, a pointer to the value at `first` in row `r`, with `last - first` contiguous values.
+     * This is only set if the return value is `true`.
+     * @param first First column to view.
+     * @param last One past the last column to view.
+     *
+     * @return Whether a view is available.
+     * If `true`, `view` points directly to the matrix's own storage and remains valid for the lifetime of the matrix.
+     */
+    virtual bool row_view(size_t r, const T*& view, size_t first, size_t last) const { return false; }
+
+    /**
+     * Obtain a direct view into the underlying storage for the values of a column, without any copying.
+     * Defaults to reporting that no view is available, if no specialized method is provided in derived classes.
+     *
+     * @param c Index of the column.
+     * @param[out] view On output, a pointer to the value at `first` in column `c`, with `last - first` contiguous values.
+     * This is only set if the return value is `true`.
+     * @param first First row to view.
+     * @param last One past the last row to view.
+     *
+     * @return Whether a view is available.
+     * If `true`, `view` points directly to the matrix's own storage and remains valid for the lifetime of the matrix.
+     */
+    virtual bool column_view(size_t c, const T*& view, size_t first, size_t last) const { return false; }
+
+    /**
+     * @param r Index of the row.
+     * @param[out] view On output, a pointer to the values of row `r`, see `row_view()` for details.
+     * @return Whether a view is available.
+     */
+    bool row_view(size_t r, const T*& view) const {
+        return row_view(r, view, 0, this->ncol());
+    }
+
+    /**
+     * @param c Index of the column.
+     * @param[out] view On output, a pointer to the values of column `c`, see `column_view()` for details.
+     * @return Whether a view is available.
+     */
+    bool column_view(size_t c, const T*& view) const {
+        return column_view(c, view, 0, this->nrow());
+    }
+
+    /**
+     * Obtain a direct view into the underlying storage for the non-zero elements of a row, without any copying.
+     * Defaults to reporting that no view is available, if no specialized method is provided in derived classes.
+     *
+     * @param r Index of the row.
+     * @param[out] view On output, a `SparseRange` containing the number of non-zero elements in `r` from `first` up to `last`,
+     * along with pointers to their values and column indices, sorted by increasing index.
+     * This is only set if the return value is `true`.
+     * @param first First column to view.
+     * @param last One past the last column to view.
+     *
+     * @return Whether a view is available.
+     * If `true`, the pointers in `view` refer directly to the matrix's own storage and remain valid for the lifetime of the matrix.
+     */
+    virtual bool sparse_row_view(size_t r, SparseRange<T, IDX>& view, size_t first, size_t last) const { return false; }
+
+    /**
+     * Obtain a direct view into the underlying storage for the non-zero elements of a column, without any copying.
+     * Defaults to reporting that no view is available, if no specialized method is provided in derived classes.
+     *
+     * @param c Index of the column.
+     * @param[out] view On output, a `SparseRange` containing the number of non-zero elements in `c` from `first` up to `last`,
+     * along with pointers to their values and row indices, sorted by increasing index.
+     * This is only set if the return value is `true`.
+     * @param first First row to view.
+     * @param last One past the last row to view.
+     *
+     * @return Whether a view is available.
+     * If `true`, the pointers in `view` refer directly to the matrix's own storage and remain valid for the lifetime of the matrix.
+     */
+    virtual bool sparse_column_view(size_t c, SparseRange<T, IDX>& view, size_t first, size_t last) const { return false; }
+
+    /**
+     * @param r Index of the row.
+     * @param[out] view On output, the non-zero elements of row `r`, see `sparse_row_view()` for details.
+     * @return Whether a view is available.
+     */
+    bool sparse_row_view(size_t r, SparseRange<T, IDX>& view) const {
+        return sparse_row_view(r, view, 0, this->ncol());
+    }
+
+    /**
+     * @param c Index of the column.
+     * @param[out] view On output, the non-zero elements of column `c`, see `sparse_column_view()` for details.
+     * @return Whether a view is available.
+     */
+    bool sparse_column_view(size_t c, SparseRange<T, IDX>& view) const {
+        return sparse_column_view(c, view, 0, this->nrow());
+    }
+
+public:
+    /**
+     * Create an extractor for repeated extraction of dense rows.
+     * This is more efficient than calling `row()` with a `Workspace` as all type resolution and bounds setup is done once, on construction of the extractor.
+     * Defaults to an extractor that wraps a workspace from `new_workspace()` and calls `row()`, if no specialized method is provided in derived classes.
+     *
+     * @param first First column to extract for each row.
+     * @param last One past the last column to extract for each row.
+     *
+     * @return A `DenseExtractor` for rows of this matrix.
+     * This holds a pointer to the current matrix and should not outlive it.
+     */
+    virtual std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new DefaultDenseExtractor<true>(this, first, last));
+    }
+
+    /**
+     * Create an extractor for repeated extraction of dense columns.
+     * This is more efficient than calling `column()` with a `Workspace` as all type resolution and bounds setup is done once, on construction of the extractor.
+     * Defaults to an extractor that wraps a workspace from `new_workspace()` and calls `column()`, if no specialized method is provided in derived classes.
+     *
+     * @param first First row to extract for each column.
+     * @param last One past the last row to extract for each column.
+     *
+     * @return A `DenseExtractor` for columns of this matrix.
+     * This holds a pointer to the current matrix and should not outlive it.
+     */
+    virtual std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new DefaultDenseExtractor<false>(this, first, last));
+    }
+
+    /**
+     * @return A `DenseExtractor` for all columns of each row.
+     */
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor() const {
+        return dense_row_extractor(0, this->ncol());
+    }
+
+    /**
+     * @return A `DenseExtractor` for all rows of each column.
+     */
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor() const {
+        return dense_column_extractor(0, this->nrow());
+    }
+
+    /**
+     * Create an extractor for repeated extraction of sparse rows, see `dense_row_extractor()` for details.
+     * Defaults to an extractor that wraps a workspace from `new_workspace()` and calls `sparse_row()`, if no specialized method is provided in derived classes.
+     *
+     * @param first First column to extract for each row.
+     * @param last One past the last column to extract for each row.
+     * @param sorted Should the non-zero elements be sorted by their indices? See `sparse_row()` for details.
+     * @param mode Components of the non-zero elements to be extracted.
+     * Implementations may use this to skip the reading or computation of values and/or indices.
+     *
+     * @return A `SparseExtractor` for rows of this matrix.
+     * This holds a pointer to the current matrix and should not outlive it.
+     */
+    virtual std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new DefaultSparseExtractor<true>(this, first, last, sorted, mode));
+    }
+
+    /**
+     * Create an extractor for repeated extraction of sparse columns, see `dense_column_extractor()` for details.
+     * Defaults to an extractor that wraps a workspace from `new_workspace()` and calls `sparse_column()`, if no specialized method is provided in derived classes.
+     *
+     * @param first First row to extract for each column.
+     * @param last One past the last row to extract for each column.
+     * @param sorted Should the non-zero elements be sorted by their indices? See `sparse_column()` for details.
+     * @param mode Components of the non-zero elements to be extracted.
+     * Implementations may use this to skip the reading or computation of values and/or indices.
+     *
+     * @return A `SparseExtractor` for columns of this matrix.
+     * This holds a pointer to the current matrix and should not outlive it.
+     */
+    virtual std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new DefaultSparseExtractor<false>(this, first, last, sorted, mode));
+    }
+
+    /**
+     * @param sorted Should the non-zero elements be sorted by their indices? See `sparse_row()` for details.
+     * @param mode Components of the non-zero elements to be extracted.
+     * @return A `SparseExtractor` for all columns of each row.
+     */
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return sparse_row_extractor(0, this->ncol(), sorted, mode);
+    }
+
+    /**
+     * @param sorted Should the non-zero elements be sorted by their indices? See `sparse_column()` for details.
+     * @param mode Components of the non-zero elements to be extracted.
+     * @return A `SparseExtractor` for all rows of each column.
+     */
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return sparse_column_extractor(0, this->nrow(), sorted, mode);
+    }
+
+private:
+    template<bool ROW>
+    struct DefaultDenseExtractor : public DenseExtractor<T, IDX> {
+        DefaultDenseExtractor(const Matrix* p, size_t first, size_t last) : DenseExtractor<T, IDX>(first, last), parent(p), work(p->new_workspace(ROW)) {}
+
+        const T* fetch(size_t i, T* buffer) {
+            if constexpr(ROW) {
+                return parent->row(i, buffer, this->block_first, this->block_last, work.get());
+            } else {
+                return parent->column(i, buffer, this->block_first, this->block_last, work.get());
+            }
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            parent->set_oracle(ROW, work.get(), std::move(oracle));
+        }
+
+        const Matrix* parent;
+        std::shared_ptr<Workspace> work;
+    };
+
+    template<bool ROW>
+    struct DefaultSparseExtractor : public SparseExtractor<T, IDX> {
+        DefaultSparseExtractor(const Matrix* p, size_t first, size_t last, bool sorted, SparseExtractMode mode) : 
+            SparseExtractor<T, IDX>(first, last, sorted, mode), parent(p), work(p->new_workspace(ROW)) 
+        {
+            // Allocating our own buffers for components that the caller doesn't want.
+            if (mode != SPARSE_EXTRACT_BOTH) {
+                vholding.resize(last - first);
+                if (mode == SPARSE_EXTRACT_NONE) {
+                    iholding.resize(last - first);
+                }
+            }
+        }
+
+        SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) {
+            if (this->extract_mode != SPARSE_EXTRACT_BOTH) {
+                vbuffer = vholding.data();
+                if (this->extract_mode == SPARSE_EXTRACT_NONE) {
+                    ibuffer = iholding.data();
+                }
+            }
+
+            SparseRange<T, IDX> output;
+            if constexpr(ROW) {
+                output = parent->sparse_row(i, vbuffer, ibuffer, this->block_first, this->block_last, work.get(), this->needs_sorted);
+            } else {
+                output = parent->sparse_column(i, vbuffer, ibuffer, this->block_first, this->block_last, work.get(), this->needs_sorted);
+            }
+            return this->restrict_mode(output);
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            parent->set_oracle(ROW, work.get(), std::move(oracle));
+        }
+
+        const Matrix* parent;
+        std::shared_ptr<Workspace> work;
+        std::vector<T> vholding;
+        std::vector<IDX> iholding;
+    };
 };
 
 /**
@@ -0,0 +1,90 @@
+#ifndef TATAMI_ORACLE_H
+#define TATAMI_ORACLE_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file Oracle.hpp
+ *
+ * Defines the virtual base `Oracle` class and some common implementations.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Predict future access requests.
+ *
+ * An oracle predicts the sequence of rows or columns that will be requested with a particular workspace.
+ * This is attached to a workspace with `Matrix::set_oracle()`, allowing matrix implementations to prefetch data for upcoming requests,
+ * e.g., by loading all of the relevant chunks from file in a single call.
+ *
+ * Predictions are treated as hints, so incorrect predictions will only affect the efficiency of extraction and not the results.
+ * Oracles should not have any state that changes with each call to `get()`, as the same oracle may be shared across multiple workspaces.
+ */
+class Oracle {
+public:
+    virtual ~Oracle() = default;
+
+    /**
+     * @return Total number of predicted requests.
+     */
+    virtual size_t total() const = 0;
+
+    /**
+     * @param i Position of the request in the predicted sequence.
+     * This should be less than `total()`.
+     *
+     * @return Index of the row or column for the `i`-th request.
+     */
+    virtual size_t get(size_t i) const = 0;
+};
+
+/**
+ * @brief Predict requests for consecutive rows or columns.
+ */
+class ConsecutiveOracle : public Oracle {
+public:
+    /**
+     * @param s Index of the first row/column to be requested.
+     * @param l Number of consecutive rows/columns to be requested.
+     */
+    ConsecutiveOracle(size_t s, size_t l) : start(s), length(l) {}
+
+    size_t total() const {
+        return length;
+    }
+
+    size_t get(size_t i) const {
+        return start + i;
+    }
+
+private:
+    size_t start, length;
+};
+
+/**
+ * @brief Predict requests from a known sequence of rows or columns.
+ */
+class FixedOracle : public Oracle {
+public:
+    /**
+     * @param p Vector of row/column indices, in the order in which they will be requested.
+     */
+    FixedOracle(std::vector<size_t> p) : predictions(std::move(p)) {}
+
+    size_t total() const {
+        return predictions.size();
+    }
+
+    size_t get(size_t i) const {
+        return predictions[i];
+    }
+
+private:
+    std::vector<size_t> predictions;
+};
+
+}
+
+#endif
@@ -58,6 +58,12 @@ struct SparseRange {
      * Has at least `number` addressible entries. 
      */
     const IDX* index = NULL;
+
+    /**
+     * Value of all elements in the range that are not listed in `index`.
+     * This is always zero unless non-zero backgrounds were requested with `SparseExtractor::set_background()`.
+     */
+    T background = 0;
 };
 
 /**
@@ -82,6 +88,11 @@ struct SparseRangeCopy {
      */
     std::vector<IDX> index;
 
+    /**
+     * Value of all elements that are not listed in `index`, see `SparseRange::background`.
+     */
+    T background = 0;
+
     /**
      * @param n Number of non-zero elements.
      */
@@ -94,6 +105,13 @@ struct SparseRangeCopy {
  */
 enum SparseCopyMode { SPARSE_COPY_INDEX, SPARSE_COPY_VALUE, SPARSE_COPY_BOTH };
 
+/**
+ * What components of the non-zero elements should be extracted?
+ * Both the values and indices (`BOTH`), just the indices (`INDEX`), or neither (`NONE`) such that only the number of non-zero elements is reported.
+ * Skipping a component allows matrix implementations to avoid reading or computing it altogether.
+ */
+enum SparseExtractMode { SPARSE_EXTRACT_BOTH, SPARSE_EXTRACT_INDEX, SPARSE_EXTRACT_NONE };
+
 }
 
 #endif
@@ -38,6 +38,45 @@ struct DelayedAddScalarHelper {
         return val + scalar; 
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the sum of each value and the scalar.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t j = 0, n = end - start; j < n; ++j) {
+            buffer[j] = buffer[j] + scalar;
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the sum of each value and the scalar.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = values[j] + scalar;
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Addition is always assumed to discard structural sparsity, even when the scalar is zero.
      */
@@ -73,6 +112,45 @@ struct DelayedMultiplyScalarHelper {
         return val * scalar; 
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the product of each value and the scalar.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t j = 0, n = end - start; j < n; ++j) {
+            buffer[j] = buffer[j] * scalar;
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the product of each value and the scalar.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = values[j] * scalar;
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Multiplication is always assumed to preserve structural sparsity.
      * Non-finite `scalar` values are not considered.
@@ -115,6 +193,57 @@ struct DelayedSubtractScalarHelper {
         }
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the result of the subtraction for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        if constexpr(RIGHT) {
+            for (size_t j = 0, n = end - start; j < n; ++j) {
+                buffer[j] = buffer[j] - scalar;
+            }
+        } else {
+            for (size_t j = 0, n = end - start; j < n; ++j) {
+                buffer[j] = scalar - buffer[j];
+            }
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the result of the subtraction for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        if constexpr(RIGHT) {
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = values[j] - scalar;
+            }
+        } else {
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = scalar - values[j];
+            }
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Subtraction is always assumed to discard structural sparsity, even when the scalar is zero.
      */
@@ -156,6 +285,57 @@ struct DelayedDivideScalarHelper {
         }
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the result of the division for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        if constexpr(RIGHT) {
+            for (size_t j = 0, n = end - start; j < n; ++j) {
+                buffer[j] = buffer[j] / scalar;
+            }
+        } else {
+            for (size_t j = 0, n = end - start; j < n; ++j) {
+                buffer[j] = scalar / buffer[j];
+            }
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the result of the division for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        if constexpr(RIGHT) {
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = values[j] / scalar;
+            }
+        } else {
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = scalar / values[j];
+            }
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Division is always assumed to preserve structural sparsity.
      * Non-finite or zero `scalar` values are not considered here.
@@ -46,6 +46,60 @@ struct DelayedAddVectorHelper {
         }
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the sum of each value and the corresponding vector element.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        size_t n = end - start;
+        if (row == (MARGIN == 0)) {
+            const auto element = vec[idx];
+            for (size_t j = 0; j < n; ++j) {
+                buffer[j] = buffer[j] + element;
+            }
+        } else {
+            for (size_t j = 0; j < n; ++j) {
+                buffer[j] = buffer[j] + vec[start + j];
+            }
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the sum of each value and the corresponding vector element.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        if (row == (MARGIN == 0)) {
+            const auto element = vec[idx];
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = values[j] + element;
+            }
+        } else {
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = values[j] + vec[indices[j]];
+            }
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows (if `true`) or columns (otherwise).
+     * @return Whether the operation is the same for all elements in each row or column, i.e., whether `row` is consistent with `MARGIN`.
+     */
+    bool uniform(bool row) const {
+        return row == (MARGIN == 0);
+    }
+
     /**
      * Addition is always assumed to discard structural sparsity, even when the added value is zero.
      */
@@ -108,12 +162,75 @@ struct DelayedSubtractVectorHelper {
         }
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the result of the subtraction for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        size_t n = end - start;
+        if (row == (MARGIN == 0)) {
+            const auto element = vec[idx];
+            for (size_t j = 0; j < n; ++j) {
+                buffer[j] = combine(buffer[j], element);
+            }
+        } else {
+            for (size_t j = 0; j < n; ++j) {
+                buffer[j] = combine(buffer[j], vec[start + j]);
+            }
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the result of the subtraction for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        if (row == (MARGIN == 0)) {
+            const auto element = vec[idx];
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = combine(values[j], element);
+            }
+        } else {
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = combine(values[j], vec[indices[j]]);
+            }
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows (if `true`) or columns (otherwise).
+     * @return Whether the operation is the same for all elements in each row or column, i.e., whether `row` is consistent with `MARGIN`.
+     */
+    bool uniform(bool row) const {
+        return row == (MARGIN == 0);
+    }
+
     /**
      * Subtraction is always assumed to discard structural sparsity, even when the subtracted value is zero.
      */
     static const bool sparse = false; 
 private:
     const V vec;
+
+    template<typename E>
+    static T combine(T val, E element) {
+        if constexpr(RIGHT) {
+            return val - element;
+        } else {
+            return element - val;
+        }
+    }
 };
 
 /**
@@ -159,6 +276,60 @@ struct DelayedMultiplyVectorHelper {
         }
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the product of each value and the corresponding vector element.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        size_t n = end - start;
+        if (row == (MARGIN == 0)) {
+            const auto element = vec[idx];
+            for (size_t j = 0; j < n; ++j) {
+                buffer[j] = buffer[j] * element;
+            }
+        } else {
+            for (size_t j = 0; j < n; ++j) {
+                buffer[j] = buffer[j] * vec[start + j];
+            }
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the product of each value and the corresponding vector element.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        if (row == (MARGIN == 0)) {
+            const auto element = vec[idx];
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = values[j] * element;
+            }
+        } else {
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = values[j] * vec[indices[j]];
+            }
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows (if `true`) or columns (otherwise).
+     * @return Whether the operation is the same for all elements in each row or column, i.e., whether `row` is consistent with `MARGIN`.
+     */
+    bool uniform(bool row) const {
+        return row == (MARGIN == 0);
+    }
+
     /**
      * Multiplication is always assumed to preserve structural sparsity.
      */
@@ -221,6 +392,60 @@ struct DelayedDivideVectorHelper {
         }
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the result of the division for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        size_t n = end - start;
+        if (row == (MARGIN == 0)) {
+            const auto element = vec[idx];
+            for (size_t j = 0; j < n; ++j) {
+                buffer[j] = combine(buffer[j], element);
+            }
+        } else {
+            for (size_t j = 0; j < n; ++j) {
+                buffer[j] = combine(buffer[j], vec[start + j]);
+            }
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the result of the division for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        if (row == (MARGIN == 0)) {
+            const auto element = vec[idx];
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = combine(values[j], element);
+            }
+        } else {
+            for (size_t j = 0; j < number; ++j) {
+                values[j] = combine(values[j], vec[indices[j]]);
+            }
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows (if `true`) or columns (otherwise).
+     * @return Whether the operation is the same for all elements in each row or column, i.e., whether `row` is consistent with `MARGIN`.
+     */
+    bool uniform(bool row) const {
+        return row == (MARGIN == 0);
+    }
+
     /**
      * Division is always assumed to preserve structural sparsity.
      * Non-finite or zero `scalar` values are not considered here.
@@ -228,6 +453,15 @@ struct DelayedDivideVectorHelper {
     static const bool sparse = true;
 private:
     const V vec;
+
+    template<typename E>
+    static T combine(T val, E element) {
+        if constexpr(RIGHT) {
+            return val / element;
+        } else {
+            return element / val;
+        }
+    }
 };
 
 /**
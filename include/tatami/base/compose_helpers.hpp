@@ -0,0 +1,326 @@
+#ifndef TATAMI_COMPOSE_HELPERS_H
+#define TATAMI_COMPOSE_HELPERS_H
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file compose_helpers.hpp
+ *
+ * Helper classes that compose multiple operations into a single operation,
+ * to be used as the `OP` in the `DelayedIsometricOp` class.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+template<class OP, typename T, typename = int>
+struct has_dense_apply {
+    static constexpr bool value = false;
+};
+
+template<class OP, typename T>
+struct has_dense_apply<OP, T, decltype((void) std::declval<const OP&>().dense_apply(true, 0, 0, 0, static_cast<T*>(nullptr)), 0)> {
+    static constexpr bool value = true;
+};
+
+template<class OP, typename T, typename IDX, typename = int>
+struct has_sparse_apply {
+    static constexpr bool value = false;
+};
+
+template<class OP, typename T, typename IDX>
+struct has_sparse_apply<OP, T, IDX, decltype((void) std::declval<const OP&>().sparse_apply(true, 0, 0, static_cast<T*>(nullptr), static_cast<const IDX*>(nullptr)), 0)> {
+    static constexpr bool value = true;
+};
+
+template<class OP, typename = int>
+struct has_uniform {
+    static constexpr bool value = false;
+};
+
+template<class OP>
+struct has_uniform<OP, decltype((void) std::declval<const OP&>().uniform(true), 0)> {
+    static constexpr bool value = true;
+};
+
+// Operations without a uniform() method are assumed to depend on both indices.
+template<class OP>
+bool isometric_uniform(const OP& op, bool row) {
+    if constexpr(has_uniform<OP>::value) {
+        return op.uniform(row);
+    } else {
+        return false;
+    }
+}
+
+// In-place application of an operation to a buffer, using the bulk methods if available.
+template<typename T, class OP>
+void isometric_dense_apply(const OP& op, bool row, size_t idx, size_t start, size_t end, T* buffer) {
+    if constexpr(has_dense_apply<OP, T>::value) {
+        op.dense_apply(row, idx, start, end, buffer);
+    } else if (row) {
+        for (size_t j = start; j < end; ++j, ++buffer) {
+            *buffer = op(idx, j, *buffer);
+        }
+    } else {
+        for (size_t j = start; j < end; ++j, ++buffer) {
+            *buffer = op(j, idx, *buffer);
+        }
+    }
+}
+
+template<typename T, typename IDX, class OP>
+void isometric_sparse_apply(const OP& op, bool row, size_t idx, size_t number, T* values, const IDX* indices) {
+    if constexpr(has_sparse_apply<OP, T, IDX>::value) {
+        op.sparse_apply(row, idx, number, values, indices);
+    } else if (row) {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = op(idx, indices[j], values[j]);
+        }
+    } else {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = op(indices[j], idx, values[j]);
+        }
+    }
+}
+
+// Number of elements to pass through all composed operations at once, so
+// that each chunk stays in the cache while the operations are applied.
+constexpr size_t isometric_chunk_size = 1024;
+
+// Type-erased operation, for runtime composition.
+template<typename T, typename IDX>
+struct IsometricOperation {
+    virtual ~IsometricOperation() = default;
+    virtual T apply(size_t r, size_t c, T val) const = 0;
+    virtual void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const = 0;
+    virtual void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const = 0;
+    virtual bool uniform(bool row) const = 0;
+};
+
+template<typename T, typename IDX, class OP>
+struct WrappedIsometricOperation : public IsometricOperation<T, IDX> {
+    WrappedIsometricOperation(OP o) : op(std::move(o)) {}
+
+    T apply(size_t r, size_t c, T val) const {
+        return op(r, c, val);
+    }
+
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        isometric_dense_apply(op, row, idx, start, end, buffer);
+    }
+
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        isometric_sparse_apply(op, row, idx, number, values, indices);
+    }
+
+    bool uniform(bool row) const {
+        return isometric_uniform(op, row);
+    }
+
+    OP op;
+};
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Compose two operations at compile time.
+ *
+ * This should be used as the `OP` in the `DelayedIsometricOp` class.
+ * It is equivalent to nesting a `DelayedIsometricOp` with `OP2` around another `DelayedIsometricOp` with `OP1`,
+ * but each row/column is only extracted once and both operations are applied to each chunk of values before moving onto the next chunk.
+ *
+ * @tparam OP1 Class of the first operation.
+ * @tparam OP2 Class of the second operation, applied to the output of the first.
+ */
+template<class OP1, class OP2>
+struct DelayedComposedHelper {
+    /**
+     * @param o1 Instance of the first operation.
+     * @param o2 Instance of the second operation.
+     */
+    DelayedComposedHelper(OP1 o1, OP2 o2) : first(std::move(o1)), second(std::move(o2)) {}
+
+    /**
+     * @param r Row index.
+     * @param c Column index.
+     * @param val Matrix value.
+     *
+     * @return `val` after applying the first and then the second operation.
+     */
+    auto operator()(size_t r, size_t c, decltype(std::declval<const OP1&>()(0, 0, 0)) val) const {
+        return second(r, c, first(r, c, val));
+    }
+
+    /**
+     * @tparam T Type of the matrix value.
+     *
+     * @param row Whether `buffer` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the values after applying both operations.
+     */
+    template<typename T>
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t s = start; s < end; s += isometric_chunk_size) {
+            size_t e = std::min(end, s + isometric_chunk_size);
+            auto current = buffer + (s - start);
+            isometric_dense_apply(first, row, idx, s, e, current);
+            isometric_dense_apply(second, row, idx, s, e, current);
+        }
+    }
+
+    /**
+     * @tparam T Type of the matrix value.
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the values after applying both operations.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`.
+     */
+    template<typename T, typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t s = 0; s < number; s += isometric_chunk_size) {
+            size_t n = std::min(number - s, isometric_chunk_size);
+            isometric_sparse_apply(first, row, idx, n, values + s, indices + s);
+            isometric_sparse_apply(second, row, idx, n, values + s, indices + s);
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows (if `true`) or columns (otherwise).
+     * @return Whether both operations are the same for all elements in each row or column.
+     */
+    bool uniform(bool row) const {
+        return isometric_uniform(first, row) && isometric_uniform(second, row);
+    }
+
+    /**
+     * Sparsity is only preserved if both operations preserve sparsity.
+     */
+    static const bool sparse = OP1::sparse && OP2::sparse;
+private:
+    OP1 first;
+    OP2 second;
+};
+
+/**
+ * A `make_*` helper function to enable partial template deduction of supplied types.
+ * See the `tatami::DelayedComposedHelper` documentation for more details on the arguments.
+ */
+template<class OP1, class OP2>
+DelayedComposedHelper<OP1, OP2> make_DelayedComposedHelper(OP1 o1, OP2 o2) {
+    return DelayedComposedHelper<OP1, OP2>(std::move(o1), std::move(o2));
+}
+
+/**
+ * @brief Compose a sequence of operations at runtime.
+ *
+ * This should be used as the `OP` in the `DelayedIsometricOp` class.
+ * Instances are usually created by `make_DelayedIsometricOp()` when it is applied to another `DelayedIsometricOp`,
+ * in which case the operation types are not known at compile time.
+ * Each chunk of values is passed through all operations before moving onto the next chunk.
+ *
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam SPARSE Whether all operations preserve sparsity.
+ */
+template<typename T, typename IDX, bool SPARSE>
+struct DelayedChainHelper {
+    /**
+     * @param ops Vector of operations, to be applied in order.
+     */
+    DelayedChainHelper(std::vector<std::shared_ptr<const IsometricOperation<T, IDX> > > ops) : operations(std::move(ops)) {}
+
+    /**
+     * @param r Row index.
+     * @param c Column index.
+     * @param val Matrix value.
+     *
+     * @return `val` after applying all operations.
+     */
+    T operator()(size_t r, size_t c, T val) const {
+        for (const auto& op : operations) {
+            val = op->apply(r, c, val);
+        }
+        return val;
+    }
+
+    /**
+     * @param row Whether `buffer` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the values after applying all operations.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t s = start; s < end; s += isometric_chunk_size) {
+            size_t e = std::min(end, s + isometric_chunk_size);
+            auto current = buffer + (s - start);
+            for (const auto& op : operations) {
+                op->dense_apply(row, idx, s, e, current);
+            }
+        }
+    }
+
+    /**
+     * @param row Whether `values` contains values from a row.
+     * @param idx Index of the row (if `row = true`) or column (otherwise).
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the values after applying all operations.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`.
+     */
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t s = 0; s < number; s += isometric_chunk_size) {
+            size_t n = std::min(number - s, isometric_chunk_size);
+            for (const auto& op : operations) {
+                op->sparse_apply(row, idx, n, values + s, indices + s);
+            }
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows (if `true`) or columns (otherwise).
+     * @return Whether all operations are the same for all elements in each row or column.
+     */
+    bool uniform(bool row) const {
+        for (const auto& op : operations) {
+            if (!op->uniform(row)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return The operations in this chain.
+     */
+    const std::vector<std::shared_ptr<const IsometricOperation<T, IDX> > >& get_operations() const {
+        return operations;
+    }
+
+    /**
+     * Sparsity is only preserved if all operations preserve sparsity.
+     */
+    static const bool sparse = SPARSE;
+private:
+    std::vector<std::shared_ptr<const IsometricOperation<T, IDX> > > operations;
+};
+
+}
+
+#endif
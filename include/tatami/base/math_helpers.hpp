@@ -28,6 +28,45 @@ struct DelayedAbsHelper {
         return std::abs(val);
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the absolute value for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t j = 0, n = end - start; j < n; ++j) {
+            buffer[j] = std::abs(buffer[j]);
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the absolute value for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = std::abs(values[j]);
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Sparsity is always preserved.
      */
@@ -60,6 +99,45 @@ struct DelayedLogHelper {
         return std::log(val)/log_base;
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the logarithm for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t j = 0, n = end - start; j < n; ++j) {
+            buffer[j] = std::log(buffer[j])/log_base;
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the logarithm for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = std::log(values[j])/log_base;
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Sparsity is always discarded
      */
@@ -84,6 +162,45 @@ struct DelayedSqrtHelper {
         return std::sqrt(val);
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the square root for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t j = 0, n = end - start; j < n; ++j) {
+            buffer[j] = std::sqrt(buffer[j]);
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the square root for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = std::sqrt(values[j]);
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Sparsity is always preserved.
      */
@@ -116,6 +233,45 @@ struct DelayedLog1pHelper {
         return std::log1p(val)/log_base;
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the logarithm of the value plus 1 for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t j = 0, n = end - start; j < n; ++j) {
+            buffer[j] = std::log1p(buffer[j])/log_base;
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the logarithm of the value plus 1 for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = std::log1p(values[j])/log_base;
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Sparsity is always preserved.
      */
@@ -140,6 +296,45 @@ struct DelayedRoundHelper {
         return std::round(val);
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the rounded value for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t j = 0, n = end - start; j < n; ++j) {
+            buffer[j] = std::round(buffer[j]);
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the rounded value for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = std::round(values[j]);
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Sparsity is always preserved.
      */
@@ -162,6 +357,45 @@ struct DelayedExpHelper {
         return std::exp(val);
     }
 
+    /**
+     * @param row Whether `buffer` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param start Index of the first column (if `row = true`) or row (otherwise) in `buffer`.
+     * @param end Index of one-past-the-last column or row in `buffer`.
+     * @param[in,out] buffer Pointer to an array of length `end - start`, containing matrix values.
+     * On output, this contains the exponential for each value.
+     */
+    void dense_apply(bool row, size_t idx, size_t start, size_t end, T* buffer) const {
+        for (size_t j = 0, n = end - start; j < n; ++j) {
+            buffer[j] = std::exp(buffer[j]);
+        }
+    }
+
+    /**
+     * @tparam IDX Type of the indices.
+     *
+     * @param row Whether `values` contains values from a row, ignored.
+     * @param idx Index of the row or column, ignored.
+     * @param number Number of values.
+     * @param[in,out] values Pointer to an array of length `number`, containing matrix values.
+     * On output, this contains the exponential for each value.
+     * @param indices Pointer to an array of length `number`, containing the column (if `row = true`) or row indices of `values`, ignored.
+     */
+    template<typename IDX>
+    void sparse_apply(bool row, size_t idx, size_t number, T* values, const IDX* indices) const {
+        for (size_t j = 0; j < number; ++j) {
+            values[j] = std::exp(values[j]);
+        }
+    }
+
+    /**
+     * @param row Whether to consider rows or columns, ignored.
+     * @return `true`, as the operation does not depend on the row or column indices.
+     */
+    bool uniform(bool row) const {
+        return true;
+    }
+
     /**
      * Sparsity is always discarded.
      */
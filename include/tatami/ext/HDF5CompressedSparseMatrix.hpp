@@ -7,8 +7,11 @@
 #include <cstdint>
 #include <type_traits>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 
 #include "../base/Matrix.hpp"
+#include "../base/Oracle.hpp"
 #include "HDF5DenseMatrix.hpp"
 
 /**
@@ -52,6 +55,7 @@ class HDF5CompressedSparseMatrix : public tatami::Matrix<T, IDX> {
 
     std::vector<size_t> cache_id;
     std::vector<std::pair<size_t, size_t> > cache_limits;
+    size_t effective_cache_limit;
 
 public:
     /**
@@ -153,7 +157,7 @@ public:
             cache_limits.emplace_back(0, pointers[1]);
         }
 
-        size_t effective_cache_limit = cache_limit / total_element_size;
+        effective_cache_limit = cache_limit / total_element_size;
 
         size_t counter = 0, start = 0;
         for (size_t i = 1; i < cache_id.size(); ++i) {
@@ -194,6 +198,69 @@ public:
         return ROW;
     }
 
+    /**
+     * @param[out] total On output, the total number of structural non-zero elements, obtained from the in-memory index pointers.
+     * @return `true`.
+     */
+    bool nonzero_count(size_t& total) const { 
+        total = pointers.back();
+        return true;
+    }
+
+    /**
+     * @param row Should the number of non-zero elements be reported for each row?
+     * @param[out] counts Pointer to an array of length equal to the number of rows (if `row = true`) or columns (otherwise).
+     *
+     * @return Whether `counts` was filled.
+     * This is only `true` if `row = ROW`, where the numbers are obtained from the in-memory index pointers without any reads from file.
+     */
+    bool nonzero_counts(bool row, size_t* counts) const {
+        if (row != ROW) {
+            return false;
+        }
+        for (size_t i = 0, end = pointers.size() - 1; i < end; ++i) {
+            counts[i] = pointers[i + 1] - pointers[i];
+        }
+        return true;
+    }
+
+    /**
+     * @return Approximate number of bytes used by this matrix in memory, i.e., the index pointers and the cache assignments.
+     * This does not include the contents of the file.
+     */
+    size_t memory_usage() const {
+        return sizeof(HDF5CompressedSparseMatrix) + file_name.size() + data_name.size() + index_name.size() +
+            pointers.size() * sizeof(hsize_t) + 
+            cache_id.size() * sizeof(size_t) + 
+            cache_limits.size() * sizeof(std::pair<size_t, size_t>);
+    }
+
+    /**
+     * @param row Should the usage be reported for a workspace for row extraction?
+     *
+     * @return Approximate number of bytes used by each workspace.
+     * For extraction along the primary dimension, this is dominated by the cache of values and indices, which is no greater than the largest of the `cache_limit` and the size of any single primary element.
+     * For extraction along the secondary dimension, this is dominated by the indices of the largest primary element.
+     */
+    size_t workspace_memory_usage(bool row) const {
+        size_t largest = 0;
+        for (size_t i = 1; i < pointers.size(); ++i) {
+            largest = std::max(largest, static_cast<size_t>(pointers[i] - pointers[i - 1]));
+        }
+
+        size_t output = sizeof(HDF5SparseWorkspace);
+        if (row == ROW) {
+            size_t nelements = std::max(largest, effective_cache_limit);
+            for (const auto& x : cache_limits) {
+                nelements = std::max(nelements, x.second - x.first);
+            }
+            output += nelements * (sizeof(T) + sizeof(IDX));
+        } else {
+            output += largest * sizeof(IDX);
+        }
+        return output;
+    }
+
 public:
     /**
      * @cond
@@ -207,6 +274,15 @@ public:
         std::vector<T> data_cache;
         std::vector<IDX> index_cache;
         size_t current_cache_id = -1;
+
+        // Only used if an oracle is supplied, in which case the caches hold the predicted primary elements in 'oracle_cached',
+        // where the contents of each primary element start at the corresponding entry of 'oracle_offsets'.
+        std::shared_ptr<const Oracle> oracle;
+        size_t oracle_position = 0;
+        std::vector<size_t> oracle_cached, oracle_offsets;
+
+        // Set by extractors that only need the structure, in which case 'data_cache' is never filled.
+        bool skip_data = false;
     };
     /**
      * @endcond
@@ -217,7 +293,12 @@ public:
      * @return A shared pointer to a `Workspace` object is returned.
      */
     std::shared_ptr<Workspace> new_workspace(bool row) const {
-        std::shared_ptr<Workspace> output;
+        return std::shared_ptr<Workspace>(create_workspace().release());
+    }
+
+private:
+    std::unique_ptr<HDF5SparseWorkspace> create_workspace() const {
+        std::unique_ptr<HDF5SparseWorkspace> output;
 
 #ifndef TATAMI_HDF5_PARALLEL_LOCK        
         #pragma omp critical
@@ -246,6 +327,32 @@ public:
         return output;
     }
 
+public:
+    /**
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()`.
+     * @param oracle Pointer to an oracle predicting the upcoming requests.
+     *
+     * If an oracle is supplied, the cache is populated with the rows (if `ROW = true`) or columns (otherwise) that are predicted to be requested next,
+     * rather than with a contiguous block of rows/columns.
+     * This has no effect for extraction along the other dimension.
+     */
+    void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {
+        if (work == nullptr) {
+            return;
+        }
+        reset_oracle(*dynamic_cast<HDF5SparseWorkspace*>(work), std::move(oracle));
+    }
+
+private:
+    static void reset_oracle(HDF5SparseWorkspace& work, std::shared_ptr<const Oracle> oracle) {
+        work.oracle = std::move(oracle);
+        work.oracle_position = 0;
+        work.oracle_cached.clear();
+        work.oracle_offsets.clear();
+        work.current_cache_id = -1;
+    }
+
 private:
     template<typename IndexIt, typename DataIt, typename Thing> 
     size_t copy_primary_to_buffer(IndexIt istart, DataIt dstart, size_t len, size_t first, size_t last, T* dbuffer, Thing thing) const {
@@ -261,7 +368,6 @@ private:
                 *dbuffer = *dstart;
             }
         } else {
-            std::fill(dbuffer, dbuffer + (last - first), 0);
             for (size_t i = request_start; i < len && *istart < last; ++i, ++istart, ++dstart, ++count) {
                 dbuffer[*istart - first] = *dstart; 
             }
@@ -272,6 +378,47 @@ private:
 
     template<typename Thing>
     size_t extract_primary(size_t i, T* dbuffer, Thing thing, size_t first, size_t last, HDF5SparseWorkspace& work) const {
+        size_t offset = (work.oracle ? cache_primary_with_oracle(i, work) : cache_primary(i, work));
+        size_t len = pointers[i + 1] - pointers[i];
+        if (len == 0) {
+            return 0;
+        }
+        return copy_primary_to_buffer(work.index_cache.begin() + offset, work.data_cache.begin() + offset, len, first, last, dbuffer, thing);
+    }
+
+    /* Only the indices are used here, so the workspace should have been
+     * created with 'skip_data = true' to avoid reading the values. If only
+     * the count is requested for the full range, we don't need to read
+     * anything at all as it is available from the pointers.
+     */
+    size_t extract_primary_structure(size_t i, IDX* ibuffer, size_t first, size_t last, HDF5SparseWorkspace& work) const {
+        size_t len = pointers[i + 1] - pointers[i];
+        size_t otherdim = (ROW ? ncols : nrows);
+        if (ibuffer == NULL && first == 0 && last == otherdim) {
+            return len;
+        }
+
+        size_t offset = (work.oracle ? cache_primary_with_oracle(i, work) : cache_primary(i, work));
+        if (len == 0) {
+            return 0;
+        }
+
+        auto istart = work.index_cache.begin() + offset;
+        auto iend = istart + len;
+        if (first) {
+            istart = std::lower_bound(istart, iend, first);
+        }
+        if (last != otherdim) {
+            iend = std::lower_bound(istart, iend, last);
+        }
+        if (ibuffer) {
+            std::copy(istart, iend, ibuffer);
+        }
+        return iend - istart;
+    }
+
+    // Returns the offset of the primary element 'i' in the workspace's caches.
+    size_t cache_primary(size_t i, HDF5SparseWorkspace& work) const {
         if (cache_id[i] != work.current_cache_id) {
             // Pulling out the entire chunk containing 'i'.
             work.current_cache_id = cache_id[i];
@@ -293,8 +440,10 @@ private:
             work.index_cache.resize(count);
             work.index.read(work.index_cache.data(), HDF5::define_mem_type<IDX>(), work.memspace, work.dataspace);
 
-            work.data_cache.resize(count);
-            work.data.read(work.data_cache.data(), HDF5::define_mem_type<T>(), work.memspace, work.dataspace);
+            if (!work.skip_data) {
+                work.data_cache.resize(count);
+                work.data.read(work.data_cache.data(), HDF5::define_mem_type<T>(), work.memspace, work.dataspace);
+            }
 
 #ifndef TATAMI_HDF5_PARALLEL_LOCK 
             }
@@ -303,16 +452,94 @@ private:
 #endif
         }
 
-        size_t len = pointers[i + 1] - pointers[i];
-        if (len == 0) {
-            return 0;
+        return pointers[i] - cache_limits[work.current_cache_id].first;
+    }
+
+    /* With an oracle, we fill the cache with the upcoming predicted requests,
+     * reading them all in a single call with a union of hyperslabs.
+     */
+    size_t cache_primary_with_oracle(size_t i, HDF5SparseWorkspace& work) const {
+        const auto& oracle = *(work.oracle);
+        size_t total = oracle.total();
+        if (work.oracle_position < total && oracle.get(work.oracle_position) == i) {
+            ++work.oracle_position;
         }
 
-        const auto& limits = cache_limits[work.current_cache_id];
-        size_t offset = pointers[i] - limits.first;
-        auto istart = work.index_cache.begin() + offset;
-        auto dstart = work.data_cache.begin() + offset;
-        return copy_primary_to_buffer(istart, dstart, len, first, last, dbuffer, thing);
+        auto& cached = work.oracle_cached;
+        auto it = std::lower_bound(cached.begin(), cached.end(), i);
+        if (it == cached.end() || *it != i) {
+            cached.clear();
+            cached.push_back(i);
+            size_t used = pointers[i + 1] - pointers[i];
+            for (size_t p = work.oracle_position; p < total; ++p) {
+                auto next = oracle.get(p);
+                size_t len = pointers[next + 1] - pointers[next];
+                if (used + len > effective_cache_limit) {
+                    break;
+                }
+                used += len;
+                cached.push_back(next);
+            }
+            std::sort(cached.begin(), cached.end());
+            cached.erase(std::unique(cached.begin(), cached.end()), cached.end());
+
+            auto& offsets = work.oracle_offsets;
+            offsets.resize(cached.size());
+            hsize_t count = 0;
+            for (size_t k = 0; k < cached.size(); ++k) {
+                offsets[k] = count;
+                count += pointers[cached[k] + 1] - pointers[cached[k]];
+            }
+            work.index_cache.resize(count);
+            if (!work.skip_data) {
+                work.data_cache.resize(count);
+            }
+
+            if (count) {
+#ifndef TATAMI_HDF5_PARALLEL_LOCK        
+                #pragma omp critical
+                {
+#else
+                TATAMI_HDF5_PARALLEL_LOCK([&]() -> void {
+#endif
+
+                work.dataspace.selectNone();
+                size_t k = 0;
+                while (k < cached.size()) {
+                    hsize_t start = pointers[cached[k]];
+                    hsize_t end = pointers[cached[k] + 1];
+                    ++k;
+
+                    // Merging runs of primary elements that are contiguous in the file.
+                    while (k < cached.size() && pointers[cached[k]] == end) {
+                        end = pointers[cached[k] + 1];
+                        ++k;
+                    }
+
+                    hsize_t len = end - start;
+                    if (len) {
+                        work.dataspace.selectHyperslab(H5S_SELECT_OR, &len, &start);
+                    }
+                }
+
+                work.memspace.setExtentSimple(1, &count);
+                work.memspace.selectAll();
+                work.index.read(work.index_cache.data(), HDF5::define_mem_type<IDX>(), work.memspace, work.dataspace);
+                if (!work.skip_data) {
+                    work.data.read(work.data_cache.data(), HDF5::define_mem_type<T>(), work.memspace, work.dataspace);
+                }
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK 
+                }
+#else
+                });
+#endif
+            }
+
+            it = std::lower_bound(cached.begin(), cached.end(), i);
+        }
+
+        return work.oracle_offsets[it - cached.begin()];
     }
 
     template<typename Thing>
@@ -372,7 +599,7 @@ private:
     size_t extract_secondary(size_t i, T* dbuffer, Thing thing, size_t first, size_t last, 
         H5::DataSet& data, H5::DataSet& index, 
         H5::DataSpace& dataspace, H5::DataSpace& memspace, 
-        std::vector<IDX>& index_cache) const
+        std::vector<IDX>& index_cache, bool skip_data = false) const
     {
         // Looping over all secondary dimensions.
         size_t counter = 0;
@@ -390,19 +617,21 @@ private:
 
             auto it = std::lower_bound(index_cache.begin(), index_cache.end(), i);
             if (it != index_cache.end() && *it == i) {
-                offset = left + (it - index_cache.begin());
-                count = 1;
-                dataspace.selectHyperslab(H5S_SELECT_SET, &count, &offset);
-                memspace.setExtentSimple(1, &count);
-                memspace.selectAll();
-
-                auto dest = dbuffer;
-                if constexpr(std::is_same<Thing, IDX*>::value) {
-                    dest += counter;
-                } else {
-                    dest += j - first;
+                if (!skip_data) {
+                    offset = left + (it - index_cache.begin());
+                    count = 1;
+                    dataspace.selectHyperslab(H5S_SELECT_SET, &count, &offset);
+                    memspace.setExtentSimple(1, &count);
+                    memspace.selectAll();
+
+                    auto dest = dbuffer;
+                    if constexpr(std::is_same<Thing, IDX*>::value) {
+                        dest += counter;
+                    } else {
+                        dest += j - first;
+                    }
+                    data.read(dest, HDF5::define_mem_type<T>(), memspace, dataspace);
                 }
-                data.read(dest, HDF5::define_mem_type<T>(), memspace, dataspace);
 
                 if constexpr(std::is_same<typename std::remove_reference<Thing>::type, IDX*>::value) {
                     thing[counter] = j;
@@ -426,7 +655,7 @@ private:
 #endif
 
         // Reusing the index cache inside the workspace as a holding ground for the indices extracted for each column.
-        n = extract_secondary(i, dbuffer, thing, first, last, work.data, work.index, work.dataspace, work.memspace, work.index_cache);
+        n = extract_secondary(i, dbuffer, thing, first, last, work.data, work.index, work.dataspace, work.memspace, work.index_cache, work.skip_data);
 
 #ifndef TATAMI_HDF5_PARALLEL_LOCK 
         }
@@ -502,6 +731,7 @@ public:
 
 private:
     const T* expand_primary(size_t i, T* buffer, size_t first, size_t last, Workspace* work) const {
+        std::fill(buffer, buffer + (last - first), 0);
         if (work) {
             auto wptr = dynamic_cast<HDF5SparseWorkspace*>(work);
             extract_primary(i, buffer, false, first, last, *wptr);
@@ -512,6 +742,7 @@ private:
     }
 
     const T* expand_secondary(size_t i, T* buffer, size_t first, size_t last, Workspace* work) const {
+        std::fill(buffer, buffer + (last - first), 0);
         if (work) {
             auto wptr = dynamic_cast<HDF5SparseWorkspace*>(work);
             extract_secondary(i, buffer, false, first, last, *wptr);
@@ -541,6 +772,253 @@ public:
     using Matrix<T, IDX>::row;
 
     using Matrix<T, IDX>::column;
+
+public:
+    /**
+     * @param first First column to extract for each row.
+     * @param last One past the last column to extract for each row.
+     *
+     * @return A `DenseExtractor` for rows of this matrix.
+     * This holds its own `HDF5SparseWorkspace`, i.e., its own file handle and cache, which is used without any casting.
+     */
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new HDF5DenseExtractor<true>(this, first, last));
+    }
+
+    /**
+     * @param first First row to extract for each column.
+     * @param last One past the last row to extract for each column.
+     *
+     * @return A `DenseExtractor` for columns of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new HDF5DenseExtractor<false>(this, first, last));
+    }
+
+    /**
+     * @param first First column to extract for each row.
+     * @param last One past the last column to extract for each row.
+     * @param sorted Ignored, as the non-zero elements are always sorted.
+     * @param mode Components of the non-zero elements to be extracted.
+     * If the values are not required, the data is not read from file.
+     *
+     * @return A `SparseExtractor` for rows of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new HDF5SparseExtractor<true>(this, first, last, sorted, mode));
+    }
+
+    /**
+     * @param first First row to extract for each column.
+     * @param last One past the last row to extract for each column.
+     * @param sorted Ignored, as the non-zero elements are always sorted.
+     * @param mode Components of the non-zero elements to be extracted.
+     * If the values are not required, the data is not read from file.
+     *
+     * @return A `SparseExtractor` for columns of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new HDF5SparseExtractor<false>(this, first, last, sorted, mode));
+    }
+
+    using Matrix<T, IDX>::dense_row_extractor;
+
+    using Matrix<T, IDX>::dense_column_extractor;
+
+    using Matrix<T, IDX>::sparse_row_extractor;
+
+    using Matrix<T, IDX>::sparse_column_extractor;
+
+private:
+    template<bool WANT_ROW>
+    struct HDF5DenseExtractor : public DenseExtractor<T, IDX> {
+        HDF5DenseExtractor(const HDF5CompressedSparseMatrix* p, size_t first, size_t last) : DenseExtractor<T, IDX>(first, last), parent(p), work(p->create_workspace()) {}
+
+        const T* fetch(size_t i, T* buffer) {
+            std::fill(buffer, buffer + this->length(), 0);
+            if constexpr(WANT_ROW == ROW) {
+                parent->extract_primary(i, buffer, false, this->block_first, this->block_last, *work);
+            } else {
+                parent->extract_secondary(i, buffer, false, this->block_first, this->block_last, *work);
+            }
+            return buffer;
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            reset_oracle(*work, std::move(oracle));
+        }
+
+        const HDF5CompressedSparseMatrix* parent;
+        std::unique_ptr<HDF5SparseWorkspace> work;
+    };
+
+    template<bool WANT_ROW>
+    struct HDF5SparseExtractor : public SparseExtractor<T, IDX> {
+        HDF5SparseExtractor(const HDF5CompressedSparseMatrix* p, size_t first, size_t last, bool sorted, SparseExtractMode mode) : 
+            SparseExtractor<T, IDX>(first, last, sorted, mode), parent(p), work(p->create_workspace()) 
+        {
+            work->skip_data = (mode != SPARSE_EXTRACT_BOTH);
+            if constexpr(WANT_ROW != ROW) {
+                // Secondary extraction always reports indices, so we need somewhere to put them.
+                if (mode == SPARSE_EXTRACT_NONE) {
+                    iholding.resize(last - first);
+                }
+            }
+        }
+
+        SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) {
+            if (this->extract_mode == SPARSE_EXTRACT_NONE) {
+                ibuffer = NULL;
+            }
+
+            size_t n;
+            if constexpr(WANT_ROW == ROW) {
+                if (this->extract_mode == SPARSE_EXTRACT_BOTH) {
+                    n = parent->extract_primary(i, vbuffer, ibuffer, this->block_first, this->block_last, *work);
+                } else {
+                    n = parent->extract_primary_structure(i, ibuffer, this->block_first, this->block_last, *work);
+                }
+            } else {
+                n = parent->extract_secondary(i, vbuffer, (ibuffer ? ibuffer : iholding.data()), this->block_first, this->block_last, *work);
+            }
+
+            return this->restrict_mode(SparseRange<T, IDX>(n, vbuffer, ibuffer));
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            reset_oracle(*work, std::move(oracle));
+        }
+
+        const HDF5CompressedSparseMatrix* parent;
+        std::unique_ptr<HDF5SparseWorkspace> work;
+        std::vector<IDX> iholding;
+    };
+
+private:
+    /* For a block along the primary dimension, the non-zero elements are
+     * contiguous in the file, so we can pull them all out with one read.
+     * We use separate buffers here to avoid clobbering the workspace's cache.
+     */
+    void read_primary_block(size_t first, size_t last, std::vector<IDX>& index_cache, std::vector<T>& data_cache, Workspace* work) const {
+        hsize_t offset = pointers[first];
+        hsize_t count = pointers[last] - pointers[first];
+        index_cache.resize(count);
+        data_cache.resize(count);
+        if (count == 0) {
+            return;
+        }
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK        
+        #pragma omp critical
+        {
+#else
+        TATAMI_HDF5_PARALLEL_LOCK([&]() -> void {
+#endif
+
+        if (work) {
+            auto wptr = dynamic_cast<HDF5SparseWorkspace*>(work);
+            wptr->dataspace.selectHyperslab(H5S_SELECT_SET, &count, &offset);
+            wptr->memspace.setExtentSimple(1, &count);
+            wptr->memspace.selectAll();
+            wptr->index.read(index_cache.data(), HDF5::define_mem_type<IDX>(), wptr->memspace, wptr->dataspace);
+            wptr->data.read(data_cache.data(), HDF5::define_mem_type<T>(), wptr->memspace, wptr->dataspace);
+
+        } else {
+            H5::FileAccPropList fapl(H5::FileAccPropList::DEFAULT.getId());
+            fapl.setCache(0, 0, 0, 0);
+            H5::H5File file(file_name, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, fapl);
+
+            auto data = file.openDataSet(data_name);
+            auto index = file.openDataSet(index_name);
+            auto dataspace = data.getSpace();
+
+            dataspace.selectHyperslab(H5S_SELECT_SET, &count, &offset);
+            H5::DataSpace memspace(1, &count);
+            memspace.selectAll();
+
+            index.read(index_cache.data(), HDF5::define_mem_type<IDX>(), memspace, dataspace);
+            data.read(data_cache.data(), HDF5::define_mem_type<T>(), memspace, dataspace);
+        }
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK 
+        }
+#else
+        });
+#endif
+
+        return;
+    }
+
+    SparseRange<T, IDX> extract_primary_block(size_t first, size_t last, T* dbuffer, IDX* ibuffer, size_t* pbuffer, size_t start, size_t end, Workspace* work) const {
+        std::vector<IDX> index_cache;
+        std::vector<T> data_cache;
+        read_primary_block(first, last, index_cache, data_cache, work);
+
+        size_t total = 0;
+        pbuffer[0] = 0;
+        for (size_t i = first; i < last; ++i) {
+            size_t len = pointers[i + 1] - pointers[i];
+            if (len) {
+                size_t offset = pointers[i] - pointers[first];
+                total += copy_primary_to_buffer(index_cache.begin() + offset, data_cache.begin() + offset, len, start, end, dbuffer + total, ibuffer + total);
+            }
+            pbuffer[i - first + 1] = total;
+        }
+
+        return SparseRange<T, IDX>(total, dbuffer, ibuffer);
+    }
+
+    const T* expand_primary_block(size_t first, size_t last, T* buffer, size_t start, size_t end, Workspace* work) const {
+        std::vector<IDX> index_cache;
+        std::vector<T> data_cache;
+        read_primary_block(first, last, index_cache, data_cache, work);
+
+        size_t width = end - start;
+        std::fill(buffer, buffer + (last - first) * width, 0);
+        auto current = buffer;
+        for (size_t i = first; i < last; ++i, current += width) {
+            size_t len = pointers[i + 1] - pointers[i];
+            if (len) {
+                size_t offset = pointers[i] - pointers[first];
+                copy_primary_to_buffer(index_cache.begin() + offset, data_cache.begin() + offset, len, start, end, current, false);
+            }
+        }
+
+        return buffer;
+    }
+
+public:
+    const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            return expand_primary_block(first_row, last_row, buffer, first_col, last_col, work);
+        } else {
+            return Matrix<T, IDX>::rows(first_row, last_row, buffer, first_col, last_col, work);
+        }
+    }
+
+    const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        if constexpr(ROW) {
+            return Matrix<T, IDX>::columns(first_col, last_col, buffer, first_row, last_row, work);
+        } else {
+            return expand_primary_block(first_col, last_col, buffer, first_row, last_row, work);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_rows(size_t first_row, size_t last_row, T* dbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_col, size_t last_col, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(ROW) {
+            return extract_primary_block(first_row, last_row, dbuffer, ibuffer, pbuffer, first_col, last_col, work);
+        } else {
+            return Matrix<T, IDX>::sparse_rows(first_row, last_row, dbuffer, ibuffer, pbuffer, first_col, last_col, work, sorted);
+        }
+    }
+
+    SparseRange<T, IDX> sparse_columns(size_t first_col, size_t last_col, T* dbuffer, IDX* ibuffer, size_t* pbuffer, size_t first_row, size_t last_row, Workspace* work=nullptr, bool sorted=true) const {
+        if constexpr(ROW) {
+            return Matrix<T, IDX>::sparse_columns(first_col, last_col, dbuffer, ibuffer, pbuffer, first_row, last_row, work, sorted);
+        } else {
+            return extract_primary_block(first_col, last_col, dbuffer, ibuffer, pbuffer, first_row, last_row, work);
+        }
+    }
 };
 
 }
@@ -7,8 +7,11 @@
 #include <cstdint>
 #include <type_traits>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 
 #include "../base/Matrix.hpp"
+#include "../base/Oracle.hpp"
 
 /**
  * @file HDF5DenseMatrix.hpp
@@ -227,6 +230,44 @@ public:
         }
     }
 
+    /**
+     * @return The dimensions of each HDF5 chunk in terms of rows (`first`) and columns (`second`) of this matrix.
+     * For contiguous datasets, each chunk is considered to be a single element of the first dimension.
+     */
+    std::pair<size_t, size_t> tile_dimensions() const {
+        if constexpr(transpose) {
+            return std::make_pair(chunk_seconddim, chunk_firstdim);
+        } else {
+            return std::make_pair(chunk_firstdim, chunk_seconddim);
+        }
+    }
+
+    /**
+     * @return Approximate number of bytes used by this matrix in memory.
+     * This does not include the contents of the file.
+     */
+    size_t memory_usage() const {
+        return sizeof(HDF5DenseMatrix) + file_name.size() + dataset_name.size();
+    }
+
+    /**
+     * @param row Should the usage be reported for a workspace for row extraction?
+     *
+     * @return Approximate number of bytes used by each workspace.
+     * This is dominated by the chunk cache, which is no greater than the `cache_limit` used in the constructor.
+     * An extra buffer of the same size is required when extracting along the second dimension, to transpose the contents of the cache.
+     */
+    size_t workspace_memory_usage(bool row) const {
+        size_t cache_size;
+        if (row != transpose) {
+            cache_size = cache_firstdim * seconddim;
+        } else {
+            cache_size = cache_seconddim * firstdim;
+        }
+        size_t nbuffers = (row == transpose ? 2 : 1);
+        return sizeof(HDF5DenseWorkspace) + nbuffers * cache_size * sizeof(T);
+    }
+
 public:
     /**
      * @cond
@@ -241,6 +282,11 @@ public:
         std::vector<T> cache, buffer;
         size_t cached_chunk = -1;
         hsize_t cached_first = 0, cached_last = 0;
+
+        // Only used if an oracle is supplied, in which case 'cache' holds the predicted vectors in 'oracle_cached'.
+        std::shared_ptr<const Oracle> oracle;
+        size_t oracle_position = 0;
+        std::vector<size_t> oracle_cached;
     };
     /**
      * @endcond
@@ -251,7 +297,12 @@ public:
      * @return A shared pointer to a `Workspace` object is returned.
      */
     std::shared_ptr<Workspace> new_workspace(bool row) const {
-        std::shared_ptr<Workspace> output;
+        return std::shared_ptr<Workspace>(create_workspace().release());
+    }
+
+private:
+    std::unique_ptr<HDF5DenseWorkspace> create_workspace() const {
+        std::unique_ptr<HDF5DenseWorkspace> output;
 
 #ifndef TATAMI_HDF5_PARALLEL_LOCK        
         #pragma omp critical
@@ -280,6 +331,31 @@ public:
         return output;
     }
 
+public:
+    /**
+     * @param row Was `work` created for row extraction?
+     * @param work Pointer to a workspace created by `new_workspace()`.
+     * @param oracle Pointer to an oracle predicting the upcoming requests.
+     *
+     * If an oracle is supplied, the cache is populated with the rows/columns that are predicted to be requested next,
+     * rather than with a contiguous block of rows/columns.
+     * This avoids reading chunks that will not be used when the requests are not consecutive.
+     */
+    void set_oracle(bool row, Workspace* work, std::shared_ptr<const Oracle> oracle) const {
+        if (work == nullptr) {
+            return;
+        }
+        reset_oracle(*dynamic_cast<HDF5DenseWorkspace*>(work), std::move(oracle));
+    }
+
+private:
+    static void reset_oracle(HDF5DenseWorkspace& work, std::shared_ptr<const Oracle> oracle) {
+        work.oracle = std::move(oracle);
+        work.oracle_position = 0;
+        work.oracle_cached.clear();
+        work.cached_chunk = -1;
+    }
+
 private:
     template<bool row>
     const T* extract(size_t i, T* buffer, size_t first, size_t last, H5::DataSet& dataset, H5::DataSpace& dataspace, H5::DataSpace& memspace) const {
@@ -340,6 +416,10 @@ private:
             return out;
         }
 
+        if (work.oracle) {
+            return extract_with_oracle<row>(i, buffer, first, last, cache_mydim, chunk_otherdim, otherdim, work);
+        }
+
         size_t chunk = i / cache_mydim;
         size_t index = i % cache_mydim;
 
@@ -429,6 +509,111 @@ private:
         return buffer;
     }
 
+    /* With an oracle, we fill the cache with the upcoming predicted requests,
+     * reading them all in a single call with a union of hyperslabs.
+     */
+    template<bool row>
+    const T* extract_with_oracle(size_t i, T* buffer, size_t first, size_t last, hsize_t cache_mydim, hsize_t chunk_otherdim, hsize_t otherdim, HDF5DenseWorkspace& work) const {
+        const auto& oracle = *(work.oracle);
+        size_t total = oracle.total();
+        if (work.oracle_position < total && oracle.get(work.oracle_position) == i) {
+            ++work.oracle_position;
+        }
+        if (first >= last) {
+            return buffer;
+        }
+
+        auto& cached = work.oracle_cached;
+        auto it = std::lower_bound(cached.begin(), cached.end(), i);
+        if (it == cached.end() || *it != i || first < work.cached_first || last > work.cached_last) {
+            cached.clear();
+            cached.push_back(i);
+            for (size_t p = work.oracle_position; p < total && cached.size() < cache_mydim; ++p) {
+                cached.push_back(oracle.get(p));
+            }
+            std::sort(cached.begin(), cached.end());
+            cached.erase(std::unique(cached.begin(), cached.end()), cached.end());
+
+            size_t first_chunk = first / chunk_otherdim;
+            size_t last_chunk = last ? (last - 1) / chunk_otherdim + 1 : 0; 
+            hsize_t new_cached_first = first_chunk * chunk_otherdim;
+            hsize_t new_cached_last = std::min(otherdim, last_chunk * chunk_otherdim);
+            hsize_t new_span = new_cached_last - new_cached_first;
+            hsize_t ncached = cached.size();
+
+            T* destination;
+            work.cache.resize(new_span * ncached);
+            if constexpr(row != transpose) {
+                destination = work.cache.data();
+            } else {
+                work.buffer.resize(work.cache.size());
+                destination = work.buffer.data();
+            }
+
+            constexpr int x = (row != transpose);
+            hsize_t offset[2];
+            hsize_t count[2];
+            offset[x] = new_cached_first;
+            count[x] = new_span;
+
+            hsize_t mcount[2];
+            mcount[1-x] = ncached;
+            mcount[x] = new_span;
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK        
+            #pragma omp critical
+            {
+#else
+            TATAMI_HDF5_PARALLEL_LOCK([&]() -> void {
+#endif
+
+            work.dataspace.selectNone();
+            size_t k = 0;
+            while (k < ncached) {
+                size_t run = 1;
+                while (k + run < ncached && cached[k + run] == cached[k] + run) {
+                    ++run;
+                }
+                offset[1-x] = cached[k];
+                count[1-x] = run;
+                work.dataspace.selectHyperslab(H5S_SELECT_OR, count, offset);
+                k += run;
+            }
+
+            work.memspace.setExtentSimple(2, mcount);
+            work.memspace.selectAll();
+            work.dataset.read(destination, HDF5::define_mem_type<T>(), work.memspace, work.dataspace);
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK        
+            }
+#else
+            });
+#endif
+
+            if constexpr(row == transpose) {
+                auto output = work.cache.begin();
+                for (hsize_t y = 0; y < ncached; ++y, output += new_span) {
+                    auto in = work.buffer.begin() + y;
+                    for (hsize_t z = 0; z < new_span; ++z, in += ncached) {
+                        *(output + z) = *in;
+                    }
+                }
+            }
+
+            work.cached_first = new_cached_first;
+            work.cached_last = new_cached_last;
+            it = std::lower_bound(cached.begin(), cached.end(), i);
+        }
+
+        auto start = work.cache.begin() + (it - cached.begin()) * (work.cached_last - work.cached_first);
+        std::copy(
+            start + (first - work.cached_first), 
+            start + (last - work.cached_first), 
+            buffer
+        );
+        return buffer;
+    }
+
     template<bool row>
     const T* extract(size_t i, T* buffer, size_t first, size_t last, Workspace* work) const {
         if (work) {
@@ -475,6 +660,266 @@ public:
     using Matrix<T, IDX>::row;
 
     using Matrix<T, IDX>::column;
+
+public:
+    /**
+     * @param first First column to extract for each row.
+     * @param last One past the last column to extract for each row.
+     *
+     * @return A `DenseExtractor` for rows of this matrix.
+     * This holds its own `HDF5DenseWorkspace`, i.e., its own file handle and cache, which is used without any casting.
+     */
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_row_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new HDF5DenseExtractor<true>(this, first, last));
+    }
+
+    /**
+     * @param first First row to extract for each column.
+     * @param last One past the last row to extract for each column.
+     *
+     * @return A `DenseExtractor` for columns of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<DenseExtractor<T, IDX> > dense_column_extractor(size_t first, size_t last) const {
+        return std::unique_ptr<DenseExtractor<T, IDX> >(new HDF5DenseExtractor<false>(this, first, last));
+    }
+
+    /**
+     * @param first First column to extract for each row.
+     * @param last One past the last column to extract for each row.
+     * @param sorted Ignored, as all elements are reported in order.
+     * @param mode Components of the non-zero elements to be extracted.
+     * If the values are not required, no data is read from file.
+     *
+     * @return A `SparseExtractor` for rows of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_row_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new HDF5SparseExtractor<true>(this, first, last, sorted, mode));
+    }
+
+    /**
+     * @param first First row to extract for each column.
+     * @param last One past the last row to extract for each column.
+     * @param sorted Ignored, as all elements are reported in order.
+     * @param mode Components of the non-zero elements to be extracted.
+     * If the values are not required, no data is read from file.
+     *
+     * @return A `SparseExtractor` for columns of this matrix, see `dense_row_extractor()` for details.
+     */
+    std::unique_ptr<SparseExtractor<T, IDX> > sparse_column_extractor(size_t first, size_t last, bool sorted=true, SparseExtractMode mode=SPARSE_EXTRACT_BOTH) const {
+        return std::unique_ptr<SparseExtractor<T, IDX> >(new HDF5SparseExtractor<false>(this, first, last, sorted, mode));
+    }
+
+    using Matrix<T, IDX>::dense_row_extractor;
+
+    using Matrix<T, IDX>::dense_column_extractor;
+
+    using Matrix<T, IDX>::sparse_row_extractor;
+
+    using Matrix<T, IDX>::sparse_column_extractor;
+
+private:
+    template<bool row>
+    struct HDF5DenseExtractor : public DenseExtractor<T, IDX> {
+        HDF5DenseExtractor(const HDF5DenseMatrix* p, size_t first, size_t last) : DenseExtractor<T, IDX>(first, last), parent(p), work(p->create_workspace()) {}
+
+        const T* fetch(size_t i, T* buffer) {
+            return parent->extract<row>(i, buffer, this->block_first, this->block_last, *work);
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            reset_oracle(*work, std::move(oracle));
+        }
+
+        const HDF5DenseMatrix* parent;
+        std::unique_ptr<HDF5DenseWorkspace> work;
+    };
+
+    template<bool row>
+    struct HDF5SparseExtractor : public SparseExtractor<T, IDX> {
+        HDF5SparseExtractor(const HDF5DenseMatrix* p, size_t first, size_t last, bool sorted, SparseExtractMode mode) : SparseExtractor<T, IDX>(first, last, sorted, mode), parent(p), work(p->create_workspace()) {}
+
+        SparseRange<T, IDX> fetch(size_t i, T* vbuffer, IDX* ibuffer) {
+            // All elements are reported, so the structure is known without reading anything.
+            if (this->extract_mode == SPARSE_EXTRACT_NONE) {
+                return SparseRange<T, IDX>(this->length());
+            }
+
+            for (size_t j = this->block_first; j < this->block_last; ++j) {
+                ibuffer[j - this->block_first] = j;
+            }
+            if (this->extract_mode == SPARSE_EXTRACT_INDEX) {
+                return SparseRange<T, IDX>(this->length(), NULL, ibuffer);
+            }
+
+            auto ptr = parent->extract<row>(i, vbuffer, this->block_first, this->block_last, *work);
+            return SparseRange<T, IDX>(this->length(), ptr, ibuffer);
+        }
+
+        void set_oracle(std::shared_ptr<const Oracle> oracle) {
+            reset_oracle(*work, std::move(oracle));
+        }
+
+        const HDF5DenseMatrix* parent;
+        std::unique_ptr<HDF5DenseWorkspace> work;
+    };
+
+private:
+    /* For blocks, we bypass the manual cache and read the entire block in a
+     * single call, so each chunk is only touched once per request.
+     */
+    template<bool row>
+    const T* extract_block(size_t first_i, size_t last_i, T* buffer, size_t first, size_t last, Workspace* work) const {
+        hsize_t offset[2];
+        hsize_t count[2];
+
+        constexpr int x = (row != transpose);
+        offset[1-x] = first_i;
+        offset[x] = first;
+        count[1-x] = last_i - first_i;
+        count[x] = last - first;
+        if (count[0] == 0 || count[1] == 0) {
+            return buffer;
+        }
+
+        // If the request is along the second dimension, HDF5 will return the
+        // block in the wrong layout, so we need a holding area for transposition.
+        std::vector<T> holding;
+        T* destination = buffer;
+        if constexpr(row == transpose) {
+            auto& target = (work ? dynamic_cast<HDF5DenseWorkspace*>(work)->buffer : holding);
+            target.resize(count[0] * count[1]);
+            destination = target.data();
+        }
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK        
+        #pragma omp critical
+        {
+#else
+        TATAMI_HDF5_PARALLEL_LOCK([&]() -> void {
+#endif
+
+        if (work) {
+            auto wptr = dynamic_cast<HDF5DenseWorkspace*>(work);
+            wptr->dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+            wptr->memspace.setExtentSimple(2, count);
+            wptr->memspace.selectAll();
+            wptr->dataset.read(destination, HDF5::define_mem_type<T>(), wptr->memspace, wptr->dataspace);
+
+        } else {
+            H5::FileAccPropList fapl(H5::FileAccPropList::DEFAULT.getId());
+            fapl.setCache(10000, 0, 0, 0);
+
+            H5::H5File file(file_name, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, fapl);
+            auto dataset = file.openDataSet(dataset_name);
+            auto dataspace = dataset.getSpace();
+
+            dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+            H5::DataSpace memspace(2, count);
+            memspace.selectAll();
+            dataset.read(destination, HDF5::define_mem_type<T>(), memspace, dataspace);
+        }
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK        
+        }
+#else
+        });
+#endif
+
+        if constexpr(row == transpose) {
+            auto output = buffer;
+            for (hsize_t y = 0; y < count[1]; ++y, output += count[0]) {
+                auto in = destination + y;
+                for (hsize_t z = 0; z < count[0]; ++z, in += count[1]) {
+                    output[z] = *in;
+                }
+            }
+        }
+
+        return buffer;
+    }
+
+public:
+    const T* rows(size_t first_row, size_t last_row, T* buffer, size_t first_col, size_t last_col, Workspace* work=nullptr) const {
+        return extract_block<true>(first_row, last_row, buffer, first_col, last_col, work);
+    }
+
+    const T* columns(size_t first_col, size_t last_col, T* buffer, size_t first_row, size_t last_row, Workspace* work=nullptr) const {
+        return extract_block<false>(first_col, last_col, buffer, first_row, last_row, work);
+    }
+
+private:
+    /* Without a workspace, we select the union of all runs of consecutive
+     * indices so that only the requested elements are read from file. With a
+     * workspace, we defer to the default, which uses the manual cache.
+     */
+    template<bool row>
+    const T* extract_indexed(size_t i, T* buffer, size_t n, const IDX* indices) const {
+        if (n == 0) {
+            return buffer;
+        }
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK        
+        #pragma omp critical
+        {
+#else
+        TATAMI_HDF5_PARALLEL_LOCK([&]() -> void {
+#endif
+
+        H5::FileAccPropList fapl(H5::FileAccPropList::DEFAULT.getId());
+        fapl.setCache(10000, 0, 0, 0);
+
+        H5::H5File file(file_name, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, fapl);
+        auto dataset = file.openDataSet(dataset_name);
+        auto dataspace = dataset.getSpace();
+        dataspace.selectNone();
+
+        hsize_t offset[2];
+        hsize_t count[2];
+        constexpr int x = (row != transpose);
+        offset[1-x] = i;
+        count[1-x] = 1;
+
+        size_t k = 0;
+        while (k < n) {
+            size_t run = 1;
+            while (k + run < n && static_cast<size_t>(indices[k + run]) == static_cast<size_t>(indices[k]) + run) {
+                ++run;
+            }
+            offset[x] = indices[k];
+            count[x] = run;
+            dataspace.selectHyperslab(H5S_SELECT_OR, count, offset);
+            k += run;
+        }
+
+        hsize_t total = n;
+        H5::DataSpace memspace(1, &total);
+        dataset.read(buffer, HDF5::define_mem_type<T>(), memspace, dataspace);
+
+#ifndef TATAMI_HDF5_PARALLEL_LOCK        
+        }
+#else
+        });
+#endif
+
+        return buffer;
+    }
+
+public:
+    const T* row_indexed(size_t r, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if (work) {
+            return Matrix<T, IDX>::row_indexed(r, buffer, n, indices, work);
+        } else {
+            return extract_indexed<true>(r, buffer, n, indices);
+        }
+    }
+
+    const T* column_indexed(size_t c, T* buffer, size_t n, const IDX* indices, Workspace* work=nullptr) const {
+        if (work) {
+            return Matrix<T, IDX>::column_indexed(c, buffer, n, indices, work);
+        } else {
+            return extract_indexed<false>(c, buffer, n, indices);
+        }
+    }
 };
 
 }
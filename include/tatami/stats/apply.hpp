@@ -2,15 +2,14 @@
 #define TATAMI_STATS_APPLY_H
 
 #include "../base/Matrix.hpp"
+#include "../base/Oracle.hpp"
 #include "config.hpp"
+#include "parallelize.hpp"
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
-#include <cmath>
 #include <vector>
 #include <algorithm>
+#include <utility>
+#include <cmath>
 
 /**
  * @file apply.hpp
@@ -20,6 +19,391 @@
 
 namespace tatami {
 
+namespace stats {
+
+/**
+ * @cond
+ */
+// Costs of processing each target vector, for balancing the work across threads in the sparse paths.
+// This is empty if the number of non-zero elements is not known in advance or if there is only one thread.
+template<bool ROW, typename T, typename IDX>
+std::vector<size_t> nonzero_costs(const Matrix<T, IDX>* p, int threads) {
+    std::vector<size_t> costs;
+    if (threads > 1) {
+        costs.resize(ROW ? p->nrow() : p->ncol());
+        if (!p->nonzero_counts(ROW, costs.data())) {
+            costs.clear();
+        }
+    }
+    return costs;
+}
+
+// Running calculations where each thread processes a contiguous range of
+// running vectors for all target vectors, using a mergeable partial state.
+// The partial states are merged in order so that the results are deterministic.
+template<bool ROW, bool SPARSE, typename T, typename IDX, class Factory, class Threads>
+void apply_running_partial(const Matrix<T, IDX>* p, Factory& factory, Threads& threads, size_t nthreads) {
+    const size_t dim = (ROW ? p->nrow() : p->ncol());
+    const size_t otherdim = (ROW ? p->ncol() : p->nrow());
+
+    auto create = [&]() -> auto {
+        if constexpr(SPARSE) {
+            return factory.sparse_running_partial();
+        } else {
+            return factory.dense_running_partial();
+        }
+    };
+
+    typedef decltype(create()) State;
+    constexpr SparseExtractMode mode = sparse_extract_mode<State>::value;
+    std::vector<State> states;
+    states.reserve(nthreads);
+    for (size_t t = 0; t < nthreads; ++t) {
+        states.push_back(create());
+    }
+
+    size_t per_state = std::ceil(static_cast<double>(otherdim) / nthreads);
+    parallelize_chunks(nthreads, threads, APPLY_SCHEDULE_STATIC, [&](WorkerChunks& chunks) -> void {
+        std::vector<T> obuffer(dim);
+        std::vector<IDX> ibuffer(SPARSE ? dim : 0);
+
+        size_t tstart, tend;
+        while (chunks.next(tstart, tend)) {
+            for (size_t t = tstart; t < tend; ++t) {
+                size_t start = std::min(otherdim, t * per_state), end = std::min(otherdim, start + per_state);
+                auto& stat = states[t];
+
+                if constexpr(SPARSE) {
+                    auto ext = (ROW ? p->sparse_column_extractor(true, mode) : p->sparse_row_extractor(true, mode)); 
+                    ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(start, end - start)));
+                    for (size_t i = start; i < end; ++i) {
+                        stat.add(ext->fetch(i, obuffer.data(), ibuffer.data()));
+                    }
+                } else {
+                    auto ext = (ROW ? p->dense_column_extractor() : p->dense_row_extractor()); 
+                    ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(start, end - start)));
+                    for (size_t i = start; i < end; ++i) {
+                        stat.add(ext->fetch(i, obuffer.data()));
+                    }
+                }
+            }
+        }
+    });
+
+    for (size_t t = 1; t < nthreads; ++t) {
+        states[0].merge(states[t]);
+    }
+    states[0].finish();
+}
+
+// Number of target vectors to transpose at once in each thread, such that
+// the transposed block fits in the per-thread share of 'limit' bytes.
+inline size_t choose_transpose_block(size_t dim, size_t otherdim, size_t bytes, size_t limit, size_t threads) {
+    size_t per_target = std::max(static_cast<size_t>(1), otherdim * bytes * std::max(static_cast<size_t>(1), threads));
+    return std::max(static_cast<size_t>(1), std::min(dim, limit / per_target));
+}
+
+// Direct calculations where each thread extracts a block of target vectors along the preferred dimension,
+// i.e., as slices of the running vectors, and transposes the block into contiguous target vectors in memory.
+template<bool ROW, typename T, typename IDX, class Factory, class Threads>
+void apply_transposed(const Matrix<T, IDX>* p, Factory& factory, Threads& threads, ApplySchedule schedule, size_t limit) {
+    const size_t dim = (ROW ? p->nrow() : p->ncol());
+    const size_t otherdim = (ROW ? p->ncol() : p->nrow());
+    const size_t nthreads = std::max(1, count_threads(threads));
+
+    if constexpr(has_sparse_direct<Factory>::value) {
+        if (p->sparse()) {
+            size_t block = choose_transpose_block(dim, otherdim, sizeof(T) + sizeof(IDX), limit, nthreads);
+            auto costs = nonzero_costs<ROW>(p, nthreads);
+
+            parallelize_chunks(dim, (costs.empty() ? NULL : costs.data()), threads, schedule, [&](WorkerChunks& chunks) -> void {
+                std::vector<T> obuffer(block);
+                std::vector<IDX> ibuffer(block);
+                std::vector<std::vector<T> > values(block);
+                std::vector<std::vector<IDX> > indices(block);
+
+                auto stat = factory.sparse_direct();
+                constexpr bool do_copy = has_nonconst_sparse_compute<decltype(stat), T, IDX>::value;
+
+                // Indices are always needed to assign each non-zero element to its target vector.
+                constexpr bool use_values = (sparse_extract_mode<decltype(stat)>::value == SPARSE_EXTRACT_BOTH);
+                constexpr SparseExtractMode mode = (use_values ? SPARSE_EXTRACT_BOTH : SPARSE_EXTRACT_INDEX);
+
+                size_t start, end;
+                while (chunks.next(start, end)) {
+                    for (size_t bstart = start; bstart < end; bstart += block) {
+                        size_t bend = std::min(end, bstart + block), len = bend - bstart;
+                        for (size_t j = 0; j < len; ++j) {
+                            values[j].clear();
+                            indices[j].clear();
+                        }
+
+                        // Flipped around, as we're extracting along the preferred dimension.
+                        auto ext = (ROW ? p->sparse_column_extractor(bstart, bend, true, mode) : p->sparse_row_extractor(bstart, bend, true, mode));
+                        ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(0, otherdim)));
+                        for (size_t i = 0; i < otherdim; ++i) {
+                            auto range = ext->fetch(i, obuffer.data(), ibuffer.data());
+                            for (size_t k = 0; k < range.number; ++k) {
+                                size_t j = range.index[k] - bstart;
+                                if constexpr(use_values) {
+                                    values[j].push_back(range.value[k]);
+                                }
+                                indices[j].push_back(i);
+                            }
+                        }
+
+                        // Buffers are already owned by this thread, so they can be directly mutated by compute_copy().
+                        for (size_t j = 0; j < len; ++j) {
+                            if constexpr(do_copy) {
+                                stat.compute_copy(bstart + j, indices[j].size(), values[j].data(), indices[j].data());
+                            } else {
+                                SparseRange<T, IDX> range(indices[j].size(), (use_values ? values[j].data() : NULL), indices[j].data());
+                                stat.compute(bstart + j, range);
+                            }
+                        }
+                    }
+                }
+            });
+            return;
+        }
+    }
+
+    size_t block = choose_transpose_block(dim, otherdim, sizeof(T), limit, nthreads);
+    parallelize_chunks(dim, threads, schedule, [&](WorkerChunks& chunks) -> void {
+        std::vector<T> obuffer(block);
+        std::vector<T> transposed(block * otherdim);
+
+        auto stat = factory.dense_direct();
+        constexpr bool do_copy = has_nonconst_dense_compute<decltype(stat), T>::value;
+
+        size_t start, end;
+        while (chunks.next(start, end)) {
+            for (size_t bstart = start; bstart < end; bstart += block) {
+                size_t bend = std::min(end, bstart + block), len = bend - bstart;
+
+                auto ext = (ROW ? p->dense_column_extractor(bstart, bend) : p->dense_row_extractor(bstart, bend)); // flipped around, see above.
+                ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(0, otherdim)));
+                for (size_t i = 0; i < otherdim; ++i) {
+                    auto ptr = ext->fetch(i, obuffer.data());
+                    auto tptr = transposed.data() + i;
+                    for (size_t j = 0; j < len; ++j, tptr += otherdim) {
+                        *tptr = ptr[j];
+                    }
+                }
+
+                auto tptr = transposed.data();
+                for (size_t j = 0; j < len; ++j, tptr += otherdim) {
+                    if constexpr(do_copy) {
+                        stat.compute_copy(bstart + j, tptr);
+                    } else {
+                        stat.compute(bstart + j, static_cast<const T*>(tptr));
+                    }
+                }
+            }
+        }
+    });
+}
+
+// Shared implementation of apply() for a number of threads or a ThreadPool.
+template<int MARGIN, typename T, typename IDX, class Factory, class Threads>
+void apply_internal(const Matrix<T, IDX>* p, Factory& factory, Threads& threads, ApplySchedule schedule, size_t transpose_limit) {
+    size_t NR = p->nrow(), NC = p->ncol();
+
+    /* One might question why we use MARGIN in the template if we just convert
+     * it to ROW here. This is because 'MARGIN' is used when we're doing
+     * something to the matrix; 'ROW' is used for the representation of the
+     * matrix itself. I'm keeping the distinction clear in the interface.
+     */
+    constexpr bool ROW = (MARGIN == 0);
+
+    const size_t dim = (ROW ? NR : NC);
+    const size_t otherdim = (ROW ? NC : NR);
+
+    /* If we support running calculations AND the preference 
+     * is not consistent with the margin, we give it a shot.
+     */
+    if constexpr(stats::has_sparse_running<Factory>::value || stats::has_dense_running<Factory>::value) {
+        if (p->prefer_rows() != ROW){
+
+            // If there are fewer target vectors than threads, splitting the target vectors would leave some
+            // threads idle; so we split the running vectors across threads instead, and merge each thread's
+            // partial statistics at the end.
+            if constexpr(stats::has_parallel_backend<Threads>()) {
+                size_t nthreads = stats::count_threads(threads);
+                if (nthreads > 1 && dim < nthreads && dim < otherdim) {
+                    if constexpr(stats::has_sparse_running<Factory>::value) {
+                        if (p->sparse()) {
+                            if constexpr(stats::has_sparse_running_partial<Factory>::value) {
+                                stats::apply_running_partial<ROW, true>(p, factory, threads, nthreads);
+                                return;
+                            }
+                        }
+                    }
+
+                    if constexpr(stats::has_dense_running_partial<Factory>::value) {
+                        if (!stats::has_sparse_running<Factory>::value || !p->sparse()) {
+                            stats::apply_running_partial<ROW, false>(p, factory, threads, nthreads);
+                            return;
+                        }
+                    }
+                }
+            }
+
+            if constexpr(stats::has_sparse_running<Factory>::value) {
+                if (p->sparse()) {
+                    if constexpr(stats::has_sparse_running_parallel<Factory>::value && stats::has_parallel_backend<Threads>()) {
+                        auto costs = stats::nonzero_costs<ROW>(p, stats::count_threads(threads));
+                        stats::parallelize_chunks(dim, (costs.empty() ? NULL : costs.data()), threads, schedule, [&](stats::WorkerChunks& chunks) -> void {
+                            size_t start, end;
+                            while (chunks.next(start, end)) {
+                                std::vector<T> obuffer(end - start);
+                                std::vector<IDX> ibuffer(obuffer.size());
+
+                                auto stat = factory.sparse_running(start, end);
+                                constexpr SparseExtractMode mode = stats::sparse_extract_mode<decltype(stat)>::value;
+
+                                // Flipped around; remember, we're trying to get the preferred dimension.
+                                auto ext = (ROW ? p->sparse_column_extractor(start, end, true, mode) : p->sparse_row_extractor(start, end, true, mode));
+                                ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(0, otherdim)));
+
+                                for (size_t i = 0; i < otherdim; ++i) {
+                                    auto range = ext->fetch(i, obuffer.data(), ibuffer.data());
+                                    stat.add(range);
+                                }
+                                stat.finish();
+                            }
+                        });
+                        return;
+                    }
+                    auto stat = factory.sparse_running();
+                    constexpr SparseExtractMode mode = stats::sparse_extract_mode<decltype(stat)>::value;
+                    std::vector<T> obuffer(dim);
+                    std::vector<IDX> ibuffer(dim);
+                    auto ext = (ROW ? p->sparse_column_extractor(true, mode) : p->sparse_row_extractor(true, mode)); // flipped around, see above.
+                    ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(0, otherdim)));
+
+                    for (size_t i = 0; i < otherdim; ++i) {
+                        auto range = ext->fetch(i, obuffer.data(), ibuffer.data());
+                        stat.add(range);
+                    }
+                    stat.finish();
+                    return;
+                }
+            }
+
+            if constexpr(stats::has_dense_running_parallel<Factory>::value && stats::has_parallel_backend<Threads>()) {
+                stats::parallelize_chunks(dim, threads, schedule, [&](stats::WorkerChunks& chunks) -> void {
+                    size_t start, end;
+                    while (chunks.next(start, end)) {
+                        auto stat = factory.dense_running(start, end);
+                        std::vector<T> obuffer(end - start);
+                        auto ext = (ROW ? p->dense_column_extractor(start, end) : p->dense_row_extractor(start, end)); // flipped around, see above.
+                        ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(0, otherdim)));
+
+                        for (size_t i = 0; i < otherdim; ++i) {
+                            auto ptr = ext->fetch(i, obuffer.data());
+                            stat.add(ptr);
+                        }
+                        stat.finish();
+                    }
+                });
+                return;
+            }
+            auto stat = factory.dense_running();
+            std::vector<T> obuffer(dim);
+            auto ext = (ROW ? p->dense_column_extractor() : p->dense_row_extractor()); // flipped around, see above.
+            ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(0, otherdim)));
+
+            for (size_t i = 0; i < otherdim; ++i) {
+                auto ptr = ext->fetch(i, obuffer.data());
+                stat.add(ptr);
+            }
+            stat.finish();
+            return;
+        }
+    }
+
+    /* If we only support direct calculations AND the preference is not
+     * consistent with the margin, we avoid extracting each target vector
+     * along the non-preferred dimension by transposing blocks in memory.
+     */
+    if constexpr(!stats::has_sparse_running<Factory>::value && !stats::has_dense_running<Factory>::value) {
+        if (p->prefer_rows() != ROW && transpose_limit > 0 && otherdim > 0) {
+            stats::apply_transposed<ROW>(p, factory, threads, schedule, transpose_limit);
+            return;
+        }
+    }
+
+    if constexpr(stats::has_sparse_direct<Factory>::value) {
+        // Matrices with a non-zero background are only extracted in sparse form if the factory can handle it.
+        bool background = false;
+        if constexpr(stats::supports_sparse_background<decltype(factory.sparse_direct())>::value) {
+            background = !p->sparse() && p->sparse_background(ROW);
+        }
+
+        if (p->sparse() || background) {
+            auto costs = stats::nonzero_costs<ROW>(p, stats::count_threads(threads));
+            stats::parallelize_chunks(dim, (costs.empty() ? NULL : costs.data()), threads, schedule, [&](stats::WorkerChunks& chunks) -> void {
+                std::vector<T> obuffer(otherdim);
+                std::vector<IDX> ibuffer(otherdim);
+                auto stat = factory.sparse_direct();
+                constexpr SparseExtractMode mode = stats::sparse_extract_mode<decltype(stat)>::value;
+                auto ext = (ROW ? p->sparse_row_extractor(true, mode) : p->sparse_column_extractor(true, mode));
+                if (background) {
+                    ext->set_background(true);
+                }
+
+                constexpr bool do_copy = stats::has_nonconst_sparse_compute<decltype(stat), T, IDX>::value;
+                constexpr SparseCopyMode copy_mode = stats::nonconst_sparse_compute_copy_mode<decltype(stat)>::value;
+
+                // Each chunk is contiguous, so we know exactly which vectors will be requested.
+                size_t start, end;
+                while (chunks.next(start, end)) {
+                    ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(start, end - start)));
+                    for (size_t i = start; i < end; ++i) {
+                        if constexpr(do_copy) {
+                            auto range = ext->fetch_copy(i, obuffer.data(), ibuffer.data(), copy_mode);
+                            stat.compute_copy(i, range.number, obuffer.data(), ibuffer.data());
+                        } else {
+                            auto range = ext->fetch(i, obuffer.data(), ibuffer.data());
+                            stat.compute(i, range);
+                        }
+                    }
+                }
+            });
+            return;
+        }
+    }
+
+    stats::parallelize_chunks(dim, threads, schedule, [&](stats::WorkerChunks& chunks) -> void {
+        std::vector<T> obuffer(otherdim);
+        auto ext = (ROW ? p->dense_row_extractor() : p->dense_column_extractor());
+        auto stat = factory.dense_direct();
+        constexpr bool do_copy = stats::has_nonconst_dense_compute<decltype(stat), T>::value;
+
+        size_t start, end;
+        while (chunks.next(start, end)) {
+            ext->set_oracle(std::shared_ptr<const Oracle>(new ConsecutiveOracle(start, end - start)));
+            for (size_t i = start; i < end; ++i) {
+                if constexpr(do_copy) {
+                    ext->fetch_copy(i, obuffer.data());
+                    stat.compute_copy(i, obuffer.data());
+                } else {
+                    auto ptr = ext->fetch(i, obuffer.data());
+                    stat.compute(i, ptr);
+                }
+            }
+        }
+    });
+
+    return;
+}
+/**
+ * @endcond
+ */
+
+}
+
 /**
  * @tparam MARGIN The dimension over which to apply the calculation of statistics, i.e., rows (0) or columns (1).
  * @tparam T Type of the matrix value, should be summable.
@@ -29,6 +413,9 @@ namespace tatami {
  * @param p Pointer to a `tatami::Matrix`.
  * @param factory Instance of a factory.
  * @param threads Number of threads to use for matrix traversal.
+ * @param schedule Strategy for distributing the target vectors across threads, see `ApplySchedule` for details.
+ * @param transpose_limit Maximum size of the transposition buffers in bytes, across all threads; see the "Transposed direct calculations" section.
+ * Setting this to zero disables the transposition.
  *
  * @section apply_overview Overview
  * In this function, we consider the matrix to be a collection of "target vectors".
@@ -65,6 +452,16 @@ namespace tatami {
  *
  * See the `VarianceFactory` in `variances.hpp` for an example of a valid factory class. 
  *
+ * @section apply_extract Structure-only calculations
+ * Some statistics only depend on the positions of the non-zero elements, e.g., the number of non-zero elements in each row/column.
+ * The `struct`s returned by `sparse_direct()`, `sparse_running()` or `sparse_running_partial()` may contain a static `extract_mode` member to indicate which components are required, see the options for a `SparseExtractMode`.
+ * `apply()` will then create its extractors with this mode, allowing matrix implementations to skip loading the values (or both values and indices) altogether.
+ * Any skipped components will be NULL in the `SparseRange` objects passed to `compute()` or `add()`.
+ * Note that the running calculations typically require the indices to assign each non-zero element to its target vector,
+ * and the transposed direct calculations (see below) always extract the indices for the same reason.
+ *
+ * See the `NonZeroCountFactory` in `counts.hpp` for an example.
+ *
  * @section apply_mutable Mutating copies
  * In some applications, it may be necessary to mutate the buffers containing the contents of each row/column (e.g., sorting for quantile calculations).
  * This is accommodated by replacing the `compute()` method with a `compute_copy()` method for the `*_direct()` outputs.
@@ -121,6 +518,23 @@ namespace tatami {
  * #define TATAMI_CUSTOM_PARALLEL parallelize
  * ```
  *
+ * @section apply_schedule Scheduling
+ * By default, each thread processes a single contiguous block of target vectors.
+ * This is inefficient when the cost of processing each target vector is highly variable, e.g., for sparse matrices where some rows/columns contain many more non-zero elements than others,
+ * as the thread with the most expensive block determines the total run time.
+ * Setting `schedule = APPLY_SCHEDULE_DYNAMIC` will split the target vectors into several contiguous chunks per thread,
+ * where each thread takes the next unprocessed chunk once it finishes its current chunk.
+ * Each chunk is still contiguous, so the extractors created in each thread can take advantage of consecutive access within each chunk.
+ *
+ * For sparse matrices, the cost of processing each target vector is proportional to its number of non-zero elements.
+ * If these numbers are known in advance (see `Matrix::nonzero_counts()`), e.g., from the index pointers of a compressed sparse matrix,
+ * the boundaries of the blocks (or chunks, for dynamic scheduling) are chosen so that each block contains a similar number of non-zero elements.
+ * Otherwise, each block contains the same number of target vectors.
+ *
+ * Dynamic scheduling is supported for both OpenMP and `TATAMI_CUSTOM_PARALLEL`.
+ * In the latter case, the macro is called with `n` and `t` both set to `threads`, and each of the `n` jobs runs a worker that takes chunks until all target vectors are processed.
+ * As such, the macro should still run each job in a separate thread for effective parallelization.
+ *
  * @section apply_parallel Factory parallelization
  * Thread safety is _not_ required in each call to `compute()` and `add()` within the same instance of a returned `struct`.
  * However, there should be thread safety across instances, which is most relevant when results are being written back to the shared memory in `factory`.
@@ -141,236 +555,245 @@ namespace tatami {
  *   It should also have a `finish()` method, to be called to finalize any calculations after all running vectors are supplied.
  *
  * These overloads are optional and the function will fall back to serial processing if they are not supplied (and the function decides perform a running calculation).
+ * With dynamic scheduling, these overloads may be called multiple times in each thread, once for each chunk of target vectors.
+ *
+ * If there are fewer target vectors than threads, `apply()` will split the running vectors across threads instead, so that all threads can be used.
+ * This requires the factory to have `dense_running_partial()` and/or `sparse_running_partial()` methods that accept no arguments, in addition to the corresponding serial `dense_running()` or `sparse_running()` methods.
+ * Each method should return a `struct` that holds its own partial statistics for all target vectors, with:
+ *
+ * - an `add()` method that accepts a pointer to a running vector (for `dense_running_partial()`) or a `SparseRange` object (for `sparse_running_partial()`), as described for the serial running calculations.
+ * - a `merge()` method that accepts another instance of the same `struct` by reference, and updates its own statistics to include those of the other instance.
+ *   The other instance will not be used after this call and may be modified.
+ * - a `finish()` method that writes the final statistics to `factory`.
+ *
+ * In this case, each thread creates its own instance and supplies a contiguous range of running vectors to `add()`.
+ * The instances are then merged in order of their ranges, and `finish()` is called on the merged instance.
+ * Note that the results may be slightly different (within numerical precision) from those of a serial calculation, due to the different order of operations.
+ *
+ * @section apply_transpose Transposed direct calculations
+ * If the factory only supports direct calculations and the matrix prefers the other dimension (e.g., row medians for a compressed sparse column matrix),
+ * extracting each target vector along the non-preferred dimension can be very inefficient.
+ * Instead, each thread extracts a block of consecutive target vectors from each running vector, i.e., along the preferred dimension, and transposes the block in memory. 
+ * The contents of each target vector are then passed to `compute()` (or `compute_copy()`) as usual.
+ * The number of target vectors in each block is chosen so that the transposition buffers of all threads fit within `transpose_limit`,
+ * though each block will always contain at least one target vector.
+ *
+ * @section apply_oracle Extraction and prefetching
+ * Each thread creates its own `DenseExtractor` or `SparseExtractor` for the range of target vectors (or running vectors) that it processes,
+ * so that no type resolution or bounds setup is required for each row/column.
+ * Each extractor is also supplied with a `ConsecutiveOracle`, as the sequence of rows/columns to be requested by each thread is known in advance.
+ * This allows matrix implementations to prefetch the data for upcoming requests.
+ *
+ * @section apply_pool Thread pools
+ * An overload of `apply()` accepts a `ThreadPool` in place of `threads`.
+ * The pool's workers are re-used across calls, which avoids the cost of starting a new parallel region for each matrix;
+ * the same pool can also be shared between concurrent callers to cap the total number of threads.
+ * Calls to `apply()` from inside a factory running on a pool (e.g., when computing a statistic for each of many small matrices) are executed serially in the current worker.
  */
 template<int MARGIN, typename T, typename IDX, class Factory>
-void apply(const Matrix<T, IDX>* p, Factory& factory, int threads = 1) {
-    /**
-     * @cond
-     */
-    size_t NR = p->nrow(), NC = p->ncol();
+void apply(const Matrix<T, IDX>* p, Factory& factory, int threads = 1, ApplySchedule schedule = APPLY_SCHEDULE_STATIC, size_t transpose_limit = 100000000) {
+    stats::apply_internal<MARGIN>(p, factory, threads, schedule, transpose_limit);
+}
 
-    /* One might question why we use MARGIN in the template if we just convert
-     * it to ROW here. This is because 'MARGIN' is used when we're doing
-     * something to the matrix; 'ROW' is used for the representation of the
-     * matrix itself. I'm keeping the distinction clear in the interface.
-     */
-    constexpr bool ROW = (MARGIN == 0);
+/**
+ * Overload of `apply()` that uses a persistent `ThreadPool` instead of OpenMP or `TATAMI_CUSTOM_PARALLEL`.
+ * This avoids the cost of starting a new parallel region in each call, and allows the same threads to be shared across concurrent calls.
+ *
+ * @tparam MARGIN The dimension over which to apply the calculation of statistics, i.e., rows (0) or columns (1).
+ * @tparam T Type of the matrix value, should be summable.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Factory Factory class to create the statistic-calculating classes.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param factory Instance of a factory.
+ * @param pool Pool of threads to use for matrix traversal.
+ * The number of threads is defined by `ThreadPool::num_threads()`.
+ * @param schedule Strategy for distributing the target vectors across threads, see `ApplySchedule` for details.
+ * @param transpose_limit Maximum size of the transposition buffers in bytes, see the other `apply()` overload for details.
+ */
+template<int MARGIN, typename T, typename IDX, class Factory>
+void apply(const Matrix<T, IDX>* p, Factory& factory, ThreadPool& pool, ApplySchedule schedule = APPLY_SCHEDULE_STATIC, size_t transpose_limit = 100000000) {
+    stats::apply_internal<MARGIN>(p, factory, pool, schedule, transpose_limit);
+}
 
-    const size_t dim = (ROW ? NR : NC);
-    const size_t otherdim = (ROW ? NC : NR);
+namespace stats {
 
-    /* If we support running calculations AND the preference 
-     * is not consistent with the margin, we give it a shot.
-     */
-    if constexpr(stats::has_sparse_running<Factory>::value || stats::has_dense_running<Factory>::value) {
-        if (p->prefer_rows() != ROW){
+/**
+ * @cond
+ */
+// Chooses the extent of each tile along the target and running dimensions.
+// Tiles are multiples of the natural block size, extended along the running
+// dimension first so that each target vector is visited in as few tiles as possible.
+template<bool ROW, typename T, typename IDX>
+std::pair<size_t, size_t> choose_tiles(const Matrix<T, IDX>* p, size_t tile_limit, int threads) {
+    const size_t dim = (ROW ? p->nrow() : p->ncol());
+    const size_t otherdim = (ROW ? p->ncol() : p->nrow());
 
-            if constexpr(stats::has_sparse_running<Factory>::value) {
-                if (p->sparse()) {
-#if defined(_OPENMP) || defined(TATAMI_CUSTOM_PARALLEL)
-                    if constexpr(stats::has_sparse_running_parallel<Factory>::value) {
-#ifndef TATAMI_CUSTOM_PARALLEL
-                        #pragma omp parallel num_threads(threads)
-                        {
-                            // We use the omp methods here to get the total number of threads, just in case something
-                            // causes us to have fewer threads than the number we requested.
-                            size_t worker_size = std::ceil(static_cast<double>(dim) / omp_get_num_threads());
-                            size_t start = worker_size * omp_get_thread_num(), end = std::min(dim, start + worker_size);
-#else
-                        TATAMI_CUSTOM_PARALLEL(dim, [&](size_t start, size_t end) -> void {
-#endif
-                            if (start < end) {
-                                std::vector<T> obuffer(end - start);
-                                std::vector<IDX> ibuffer(obuffer.size());
-                                auto wrk = p->new_workspace(!ROW);
-                                auto stat = factory.sparse_running(start, end);
+    auto natural = p->tile_dimensions();
+    size_t target = std::max(static_cast<size_t>(1), std::min(dim, ROW ? natural.first : natural.second));
+    size_t running = std::max(static_cast<size_t>(1), std::min(otherdim, ROW ? natural.second : natural.first));
+    const size_t limit = std::max(static_cast<size_t>(1), tile_limit / sizeof(T));
 
-                                for (size_t i = 0; i < otherdim; ++i) {
-                                    if constexpr(ROW) { // flipped around; remember, we're trying to get the preferred dimension.
-                                        auto range = p->sparse_column(i, obuffer.data(), ibuffer.data(), start, end, wrk.get());
-                                        stat.add(range);
-                                    } else {
-                                        auto range = p->sparse_row(i, obuffer.data(), ibuffer.data(), start, end, wrk.get());
-                                        stat.add(range);
-                                    }
-                                }
-                                stat.finish();
-                            }
-#ifndef TATAMI_CUSTOM_PARALLEL
-                        }
-#else
-                        }, threads);
-#endif
-                        return;
-                    }
-#endif
-                    auto stat = factory.sparse_running();
-                    std::vector<T> obuffer(dim);
-                    std::vector<IDX> ibuffer(dim);
-                    auto wrk = p->new_workspace(!ROW);
+    size_t multiple = limit / (target * running);
+    if (multiple > 1) {
+        running = std::min(otherdim, running * multiple);
+    }
+    multiple = limit / (target * running);
+    if (multiple > 1) {
+        target = std::min(dim, target * multiple);
+    }
 
-                    for (size_t i = 0; i < otherdim; ++i) {
-                        if constexpr(ROW) { // flipped around; remember, we're trying to get the preferred dimension.
-                            auto range = p->sparse_column(i, obuffer.data(), ibuffer.data(), wrk.get());
-                            stat.add(range);
-                        } else {
-                            auto range = p->sparse_row(i, obuffer.data(), ibuffer.data(), wrk.get());
-                            stat.add(range);
-                        }
-                    }
-                    stat.finish();
-                    return;
-                }
-            }
+    // Making sure that each thread gets at least one tile.
+    if (threads > 1 && dim) {
+        size_t per_thread = std::ceil(static_cast<double>(dim) / threads);
+        if (target > per_thread) {
+            size_t block = std::max(static_cast<size_t>(1), ROW ? natural.first : natural.second);
+            target = (per_thread > block ? (per_thread / block) * block : per_thread);
+        }
+    }
 
-#if defined(_OPENMP) || defined(TATAMI_CUSTOM_PARALLEL)
-            if constexpr(stats::has_dense_running_parallel<Factory>::value) {
-#ifndef TATAMI_CUSTOM_PARALLEL
-                #pragma omp parallel num_threads(threads)
-                {
-                    size_t worker_size = std::ceil(static_cast<double>(dim) / omp_get_num_threads());
-                    size_t start = worker_size * omp_get_thread_num(), end = std::min(dim, start + worker_size);
-#else
-                TATAMI_CUSTOM_PARALLEL(dim, [&](size_t start, size_t end) -> void {
-#endif                
-                    if (start < end) {
-                        auto stat = factory.dense_running(start, end);
-                        std::vector<T> obuffer(end - start);
-                        auto wrk = p->new_workspace(!ROW);
+    return std::make_pair(target, running);
+}
+/**
+ * @endcond
+ */
 
-                        for (size_t i = 0; i < otherdim; ++i) {
-                            if constexpr(ROW) { // flipped around, see above.
-                                auto ptr = p->column(i, obuffer.data(), start, end, wrk.get());
-                                stat.add(ptr);
-                            } else {
-                                auto ptr = p->row(i, obuffer.data(), start, end, wrk.get());
-                                stat.add(ptr);
+}
+
+namespace stats {
+
+/**
+ * @cond
+ */
+// Shared implementation of apply_tiled() for a number of threads or a ThreadPool.
+template<int MARGIN, typename T, typename IDX, class Factory, class Threads>
+void apply_tiled_internal(const Matrix<T, IDX>* p, Factory& factory, Threads& threads, size_t tile_limit) {
+    constexpr bool ROW = (MARGIN == 0);
+
+    if constexpr(has_dense_running_parallel<Factory>::value) {
+        const size_t dim = (ROW ? p->nrow() : p->ncol());
+        const size_t otherdim = (ROW ? p->ncol() : p->nrow());
+
+        auto tiles = choose_tiles<ROW>(p, tile_limit, count_threads(threads));
+        const size_t target_tile = tiles.first, running_tile = tiles.second;
+        const size_t ntiles = (dim ? (dim - 1) / target_tile + 1 : 0);
+
+        if constexpr(has_sparse_running_parallel<Factory>::value) {
+            if (p->sparse()) {
+                parallelize_chunks(ntiles, threads, APPLY_SCHEDULE_STATIC, [&](WorkerChunks& chunks) -> void {
+                    std::vector<T> vbuffer(target_tile * running_tile);
+                    std::vector<IDX> ibuffer(vbuffer.size());
+                    std::vector<size_t> pbuffer(running_tile + 1);
+
+                    size_t tstart, tend;
+                    while (chunks.next(tstart, tend)) {
+                        for (size_t t = tstart; t < tend; ++t) {
+                            size_t start = t * target_tile, end = std::min(dim, start + target_tile);
+                            auto stat = factory.sparse_running(start, end);
+
+                            for (size_t r = 0; r < otherdim; r += running_tile) {
+                                size_t rend = std::min(otherdim, r + running_tile);
+                                auto block = (ROW ? 
+                                    p->sparse_columns(r, rend, vbuffer.data(), ibuffer.data(), pbuffer.data(), start, end) :
+                                    p->sparse_rows(r, rend, vbuffer.data(), ibuffer.data(), pbuffer.data(), start, end));
+
+                                for (size_t i = 0, n = rend - r; i < n; ++i) {
+                                    SparseRange<T, IDX> range(pbuffer[i + 1] - pbuffer[i], block.value + pbuffer[i], block.index + pbuffer[i]);
+                                    stat.add(range);
+                                }
                             }
+                            stat.finish();
                         }
-                        stat.finish();
                     }
-#ifndef TATAMI_CUSTOM_PARALLEL
-                }
-#else
-                }, threads);
-#endif
+                });
                 return;
             }
-#endif
-            auto stat = factory.dense_running();
-            std::vector<T> obuffer(dim);
-            auto wrk = p->new_workspace(!ROW);
-
-            for (size_t i = 0; i < otherdim; ++i) {
-                if constexpr(ROW) { // flipped around, see above.
-                    auto ptr = p->column(i, obuffer.data(), wrk.get());
-                    stat.add(ptr);
-                } else {
-                    auto ptr = p->row(i, obuffer.data(), wrk.get());
-                    stat.add(ptr);
-                }
-            }
-            stat.finish();
-            return;
         }
-    }
 
-    if constexpr(stats::has_sparse_direct<Factory>::value) {
-        if (p->sparse()) {
-#ifndef TATAMI_CUSTOM_PARALLEL
-            #pragma omp parallel num_threads(threads)
-            {
-#else
-            TATAMI_CUSTOM_PARALLEL(dim, [&](size_t start, size_t end) -> void {
-#endif
-                std::vector<T> obuffer(otherdim);
-                auto wrk = p->new_workspace(ROW);
-                std::vector<IDX> ibuffer(otherdim);
-                auto stat = factory.sparse_direct();
+        parallelize_chunks(ntiles, threads, APPLY_SCHEDULE_STATIC, [&](WorkerChunks& chunks) -> void {
+            std::vector<T> buffer(target_tile * running_tile);
 
-                constexpr bool do_copy = stats::has_nonconst_sparse_compute<decltype(stat), T, IDX>::value;
-                constexpr SparseCopyMode copy_mode = stats::nonconst_sparse_compute_copy_mode<decltype(stat)>::value;
+            size_t tstart, tend;
+            while (chunks.next(tstart, tend)) {
+                for (size_t t = tstart; t < tend; ++t) {
+                    size_t start = t * target_tile, end = std::min(dim, start + target_tile), len = end - start;
+                    auto stat = factory.dense_running(start, end);
 
-#ifndef TATAMI_CUSTOM_PARALLEL
-                // Without chunk size specification, static scheduling should distribute
-                // one chunk to each job, so everything is as contiguous as possible.
-                #pragma omp for schedule(static)
-                for (size_t i = 0; i < dim; ++i) {
-#else
-                for (size_t i = start; i < end; ++i) {
-#endif
-                    if constexpr(ROW) {
-                        if constexpr(do_copy) {
-                            auto range = p->sparse_row_copy(i, obuffer.data(), ibuffer.data(), copy_mode, wrk.get());
-                            stat.compute_copy(i, range.number, obuffer.data(), ibuffer.data());
-                        } else {
-                            auto range = p->sparse_row(i, obuffer.data(), ibuffer.data(), wrk.get());
-                            stat.compute(i, range);
-                        }
-                    } else {
-                        if constexpr(do_copy) {
-                            auto range = p->sparse_column_copy(i, obuffer.data(), ibuffer.data(), copy_mode, wrk.get());
-                            stat.compute_copy(i, range.number, obuffer.data(), ibuffer.data());
-                        } else {
-                            auto range = p->sparse_column(i, obuffer.data(), ibuffer.data(), wrk.get());
-                            stat.compute(i, range);
+                    for (size_t r = 0; r < otherdim; r += running_tile) {
+                        size_t rend = std::min(otherdim, r + running_tile);
+
+                        // Each running vector is stored contiguously, so we request columns when computing row statistics and vice versa.
+                        auto ptr = (ROW ? 
+                            p->columns(r, rend, buffer.data(), start, end) :
+                            p->rows(r, rend, buffer.data(), start, end));
+
+                        for (size_t i = 0, n = rend - r; i < n; ++i, ptr += len) {
+                            stat.add(ptr);
                         }
                     }
+                    stat.finish();
                 }
-#ifndef TATAMI_CUSTOM_PARALLEL
             }
-#else
-            }, threads);
-#endif
-            return;
-        }
+        });
+        return;
     }
 
-#ifndef TATAMI_CUSTOM_PARALLEL
-    #pragma omp parallel num_threads(threads)
-    {
-#else
-    TATAMI_CUSTOM_PARALLEL(dim, [&](size_t start, size_t end) -> void {
-#endif
-        std::vector<T> obuffer(otherdim);
-        auto wrk = p->new_workspace(ROW);
-        auto stat = factory.dense_direct();
-        constexpr bool do_copy = stats::has_nonconst_dense_compute<decltype(stat), T>::value;
+    tatami::apply<MARGIN>(p, factory, threads);
+    return;
+}
+/**
+ * @endcond
+ */
 
-#ifndef TATAMI_CUSTOM_PARALLEL
-        #pragma omp for schedule(static)
-        for (size_t i = 0; i < dim; ++i) {
-#else            
-        for (size_t i = start; i < end; ++i) {
-#endif
-            if constexpr(ROW) {
-                if constexpr(do_copy) {
-                    auto ptr = p->row_copy(i, obuffer.data(), wrk.get());
-                    stat.compute_copy(i, obuffer.data());
-                } else {
-                    auto ptr = p->row(i, obuffer.data(), wrk.get());
-                    stat.compute(i, ptr);
-                }
-            } else {
-                if constexpr(do_copy) {
-                    auto ptr = p->column_copy(i, obuffer.data(), wrk.get());
-                    stat.compute_copy(i, obuffer.data());
-                } else {
-                    auto ptr = p->column(i, obuffer.data(), wrk.get());
-                    stat.compute(i, ptr);
-                }
-            }
-        }
-#ifndef TATAMI_CUSTOM_PARALLEL            
-    }
-#else
-    }, threads);
-#endif
+}
 
-    /**
-     * @endcond
-     */
-    return; 
+/**
+ * @tparam MARGIN The dimension over which to apply the calculation of statistics, i.e., rows (0) or columns (1).
+ * @tparam T Type of the matrix value, should be summable.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Factory Factory class to create the statistic-calculating classes.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param factory Instance of a factory, see `apply()` for details.
+ * @param threads Number of threads to use for matrix traversal.
+ * @param tile_limit Maximum size of each tile in bytes.
+ *
+ * This function performs the same calculations as `apply()` but visits the matrix in two-dimensional tiles, 
+ * where each tile spans a contiguous range of target vectors and a contiguous range of running vectors.
+ * Each tile is extracted with a single call to `Matrix::rows()`/`Matrix::columns()` (or their sparse counterparts),
+ * and the statistics for its target vectors are accumulated across successive tiles along the running dimension.
+ * The tile dimensions are chosen as multiples of `Matrix::tile_dimensions()` within `tile_limit`,
+ * so that each chunk of a file-backed matrix is read exactly once without relying on any cache.
+ * Memory usage is bounded by `tile_limit` per thread, regardless of the size of the matrix.
+ *
+ * This requires the parallel overloads of `dense_running()` (and `sparse_running()`, for sparse matrices) that accept the first and one-past-the-last target vectors.
+ * Each returned `struct` is responsible for a single range of target vectors and receives every running vector in order, split across multiple tiles.
+ * If these overloads are not available, this function falls back to `apply()`.
+ * Tiles with different ranges of target vectors are distributed across threads, see `apply()` for details on parallelization.
+ */
+template<int MARGIN, typename T, typename IDX, class Factory>
+void apply_tiled(const Matrix<T, IDX>* p, Factory& factory, int threads = 1, size_t tile_limit = 100000000) {
+    stats::apply_tiled_internal<MARGIN>(p, factory, threads, tile_limit);
+}
+
+/**
+ * Overload of `apply_tiled()` that uses a persistent `ThreadPool` instead of OpenMP or `TATAMI_CUSTOM_PARALLEL`.
+ * See the `apply()` overload with a `ThreadPool` for details.
+ *
+ * @tparam MARGIN The dimension over which to apply the calculation of statistics, i.e., rows (0) or columns (1).
+ * @tparam T Type of the matrix value, should be summable.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Factory Factory class to create the statistic-calculating classes.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param factory Instance of a factory, see `apply()` for details.
+ * @param pool Pool of threads to use for matrix traversal.
+ * The number of threads is defined by `ThreadPool::num_threads()`.
+ * @param tile_limit Maximum size of each tile in bytes.
+ */
+template<int MARGIN, typename T, typename IDX, class Factory>
+void apply_tiled(const Matrix<T, IDX>* p, Factory& factory, ThreadPool& pool, size_t tile_limit = 100000000) {
+    stats::apply_tiled_internal<MARGIN>(p, factory, pool, tile_limit);
 }
 
 }
@@ -0,0 +1,198 @@
+#ifndef TATAMI_STATS_COMBINED_HPP
+#define TATAMI_STATS_COMBINED_HPP
+
+#include "../base/Matrix.hpp"
+#include "apply.hpp"
+#include "config.hpp"
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+/**
+ * @file combined.hpp
+ *
+ * Compute multiple statistics from a `tatami::Matrix` in a single pass.
+ */
+
+namespace tatami {
+
+namespace stats {
+
+/**
+ * @cond
+ */
+template<class ... Stats>
+struct CombinedDirect {
+    CombinedDirect(Stats... s) : stats(std::move(s)...) {}
+
+    static constexpr bool background = (supports_sparse_background<Stats>::value && ...);
+
+    template<typename V>
+    void compute(size_t i, const V* ptr) {
+        std::apply([&](auto& ... s) -> void { (s.compute(i, ptr), ...); }, stats);
+    }
+
+    template<typename T, typename IDX>
+    void compute(size_t i, const SparseRange<T, IDX>& range) {
+        std::apply([&](auto& ... s) -> void { (s.compute(i, range), ...); }, stats);
+    }
+private:
+    std::tuple<Stats...> stats;
+};
+
+template<class ... Stats>
+struct CombinedRunning {
+    CombinedRunning(Stats... s) : stats(std::move(s)...) {}
+
+    template<typename V>
+    void add(const V* ptr) {
+        std::apply([&](auto& ... s) -> void { (s.add(ptr), ...); }, stats);
+    }
+
+    template<typename T, typename IDX>
+    void add(const SparseRange<T, IDX>& range) {
+        std::apply([&](auto& ... s) -> void { (s.add(range), ...); }, stats);
+    }
+
+    void finish() {
+        std::apply([&](auto& ... s) -> void { (s.finish(), ...); }, stats);
+    }
+
+    void merge(CombinedRunning& other) {
+        merge_each(other, std::index_sequence_for<Stats...>());
+    }
+private:
+    std::tuple<Stats...> stats;
+
+    template<size_t ... I>
+    void merge_each(CombinedRunning& other, std::index_sequence<I...>) {
+        (std::get<I>(stats).merge(std::get<I>(other.stats)), ...);
+    }
+};
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Combine multiple factories for a single pass with `apply()`.
+ *
+ * Each extracted row/column (or its `SparseRange`) is supplied to all of the component factories in turn,
+ * so that several statistics can be computed while only reading the matrix once.
+ * This is most useful for file-backed matrices where each extraction pass is expensive.
+ *
+ * A calculation mode (e.g., sparse direct, dense running) is only made available to `apply()` if it is supported by all of the component factories.
+ * This ensures that the combined factory always uses a mode that is valid for every statistic;
+ * in the worst case, all statistics are computed directly from the dense target vectors.
+ * Factories that mutate the extracted buffers via `compute_copy()` (e.g., `MedianFactory`) are not supported, as the other factories require the original values.
+ *
+ * @tparam Factories Classes of the component factories, see `apply()` for the requirements.
+ */
+template<class ... Factories>
+struct CombinedFactory {
+public:
+    /**
+     * @param f Instances of the component factories.
+     * These should be constructed with the same dimensions, i.e., for the same target and running vectors.
+     */
+    CombinedFactory(Factories... f) : factories(std::move(f)...) {}
+
+private:
+    std::tuple<Factories...> factories;
+
+public:
+    /**
+     * @return An object with a `compute()` method that calls the `compute()` method for the `dense_direct()` output of each component factory.
+     */
+    auto dense_direct() {
+        return std::apply([](auto& ... f) { return CombinedDirect<decltype(f.dense_direct())...>(f.dense_direct()...); }, factories);
+    }
+
+    /**
+     * @return An object with a `compute()` method that calls the `compute()` method for the `sparse_direct()` output of each component factory.
+     * Only available if all component factories have a `sparse_direct()` method.
+     */
+    template<bool enabled = (has_sparse_direct<Factories>::value && ...), typename std::enable_if<enabled, int>::type = 0>
+    auto sparse_direct() {
+        return std::apply([](auto& ... f) { return CombinedDirect<decltype(f.sparse_direct())...>(f.sparse_direct()...); }, factories);
+    }
+
+    /**
+     * @return An object with `add()` and `finish()` methods that call the corresponding methods for the `dense_running()` output of each component factory.
+     * Only available if all component factories have a `dense_running()` method.
+     */
+    template<bool enabled = (has_dense_running<Factories>::value && ...), typename std::enable_if<enabled, int>::type = 0>
+    auto dense_running() {
+        return std::apply([](auto& ... f) { return CombinedRunning<decltype(f.dense_running())...>(f.dense_running()...); }, factories);
+    }
+
+    /**
+     * @param start Index of the first target vector to be processed.
+     * @param end One past the index of the last target vector to be processed.
+     *
+     * @return An object with `add()` and `finish()` methods that call the corresponding methods for the `dense_running()` output of each component factory.
+     * Only available if all component factories have a parallelized `dense_running()` method.
+     */
+    template<bool enabled = (has_dense_running_parallel<Factories>::value && ...), typename std::enable_if<enabled, int>::type = 0>
+    auto dense_running(size_t start, size_t end) {
+        return std::apply([&](auto& ... f) { return CombinedRunning<decltype(f.dense_running(start, end))...>(f.dense_running(start, end)...); }, factories);
+    }
+
+    /**
+     * @return An object with `add()` and `finish()` methods that call the corresponding methods for the `sparse_running()` output of each component factory.
+     * Only available if all component factories have a `sparse_running()` method.
+     */
+    template<bool enabled = (has_sparse_running<Factories>::value && ...), typename std::enable_if<enabled, int>::type = 0>
+    auto sparse_running() {
+        return std::apply([](auto& ... f) { return CombinedRunning<decltype(f.sparse_running())...>(f.sparse_running()...); }, factories);
+    }
+
+    /**
+     * @param start Index of the first target vector to be processed.
+     * @param end One past the index of the last target vector to be processed.
+     *
+     * @return An object with `add()` and `finish()` methods that call the corresponding methods for the `sparse_running()` output of each component factory.
+     * Only available if all component factories have a parallelized `sparse_running()` method.
+     */
+    template<bool enabled = (has_sparse_running_parallel<Factories>::value && ...), typename std::enable_if<enabled, int>::type = 0>
+    auto sparse_running(size_t start, size_t end) {
+        return std::apply([&](auto& ... f) { return CombinedRunning<decltype(f.sparse_running(start, end))...>(f.sparse_running(start, end)...); }, factories);
+    }
+
+    /**
+     * @return An object with `add()`, `merge()` and `finish()` methods that call the corresponding methods for the `dense_running_partial()` output of each component factory.
+     * Only available if all component factories have a `dense_running_partial()` method.
+     */
+    template<bool enabled = (has_dense_running_partial<Factories>::value && ...), typename std::enable_if<enabled, int>::type = 0>
+    auto dense_running_partial() {
+        return std::apply([](auto& ... f) { return CombinedRunning<decltype(f.dense_running_partial())...>(f.dense_running_partial()...); }, factories);
+    }
+
+    /**
+     * @return An object with `add()`, `merge()` and `finish()` methods that call the corresponding methods for the `sparse_running_partial()` output of each component factory.
+     * Only available if all component factories have a `sparse_running_partial()` method.
+     */
+    template<bool enabled = (has_sparse_running_partial<Factories>::value && ...), typename std::enable_if<enabled, int>::type = 0>
+    auto sparse_running_partial() {
+        return std::apply([](auto& ... f) { return CombinedRunning<decltype(f.sparse_running_partial())...>(f.sparse_running_partial()...); }, factories);
+    }
+};
+
+}
+
+/**
+ * A `make_*` helper function to enable template deduction of the factory types.
+ *
+ * @tparam Factories Classes of the component factories, to be automatically deducted.
+ *
+ * @param f Instances of the component factories.
+ *
+ * @return A `CombinedFactory` that can be passed to `apply()` to compute all statistics in a single pass.
+ */
+template<class ... Factories>
+stats::CombinedFactory<Factories...> make_CombinedFactory(Factories... f) {
+    return stats::CombinedFactory<Factories...>(std::move(f)...);
+}
+
+}
+
+#endif
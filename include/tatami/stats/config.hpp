@@ -67,6 +67,30 @@ struct has_dense_running_parallel<V, decltype((void) std::declval<V>().dense_run
 
 /******************/
 
+template<class V, typename = int>
+struct has_dense_running_partial {
+    static constexpr bool value = false;
+};
+
+template<class V>
+struct has_dense_running_partial<V, decltype((void) std::declval<V>().dense_running_partial(), 0)> {
+    static constexpr bool value = true;
+};
+
+/******************/
+
+template<class V, typename = int>
+struct has_sparse_running_partial {
+    static constexpr bool value = false;
+};
+
+template<class V>
+struct has_sparse_running_partial<V, decltype((void) std::declval<V>().sparse_running_partial(), 0)> {
+    static constexpr bool value = true;
+};
+
+/******************/
+
 template<class V, typename T, typename = int>
 struct has_nonconst_dense_compute {
     static constexpr bool value = false;
@@ -101,6 +125,30 @@ struct nonconst_sparse_compute_copy_mode<V, decltype((void) V::copy_mode, 0)> {
     static constexpr SparseCopyMode value = V::copy_mode;
 };
 
+/******************/
+
+template<class V, typename = int>
+struct sparse_extract_mode {
+    static constexpr SparseExtractMode value = SPARSE_EXTRACT_BOTH;
+};
+
+template<class V>
+struct sparse_extract_mode<V, decltype((void) V::extract_mode, 0)> {
+    static constexpr SparseExtractMode value = V::extract_mode;
+};
+
+/******************/
+
+template<class V, typename = int>
+struct supports_sparse_background {
+    static constexpr bool value = false;
+};
+
+template<class V>
+struct supports_sparse_background<V, decltype((void) V::background, 0)> {
+    static constexpr bool value = V::background;
+};
+
 }
 
 }
@@ -0,0 +1,409 @@
+#ifndef TATAMI_STATS_COUNTS_HPP
+#define TATAMI_STATS_COUNTS_HPP
+
+#include "../base/Matrix.hpp"
+#include "apply.hpp"
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * @file counts.hpp
+ *
+ * Count the non-zero elements, or the elements above a threshold, in each row or column of a `tatami::Matrix`.
+ */
+
+namespace tatami {
+
+namespace stats {
+
+/**
+ * @cond
+ */
+template<typename O>
+struct NonZeroCountFactory {
+public:
+    NonZeroCountFactory(O* o, size_t d1, size_t d2) : output(o), dim(d1), otherdim(d2) {}
+
+private:
+    O* output;
+    size_t dim, otherdim;
+
+public:
+    struct DenseDirect {
+        DenseDirect(O* o, size_t d2) : output(o), otherdim(d2) {}
+
+        template<typename V>
+        void compute(size_t i, const V* ptr) {
+            O count = 0;
+            for (size_t j = 0; j < otherdim; ++j) {
+                count += (ptr[j] != 0);
+            }
+            output[i] = count;
+        }
+    private:
+        O* output;
+        size_t otherdim;
+    };
+
+    DenseDirect dense_direct() {
+        return DenseDirect(output, otherdim);
+    }
+
+public:
+    struct SparseDirect {
+        SparseDirect(O* o) : output(o) {}
+
+        static constexpr SparseExtractMode extract_mode = SPARSE_EXTRACT_NONE;
+
+        template<typename T, typename IDX>
+        void compute(size_t i, const SparseRange<T, IDX>& range) {
+            output[i] = range.number;
+        }
+    private:
+        O* output;
+    };
+
+    SparseDirect sparse_direct() {
+        return SparseDirect(output);
+    }
+
+public:
+    struct DenseRunning {
+        DenseRunning(O* o, size_t d1) : output(o), dim(d1) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            for (size_t d = 0; d < dim; ++d) {
+                output[d] += (ptr[d] != 0);
+            }
+        }
+
+        void finish() {}
+    private:
+        O* output;
+        size_t dim;
+    };
+
+    DenseRunning dense_running() {
+        return DenseRunning(output, dim);
+    }
+
+    DenseRunning dense_running(size_t start, size_t end) {
+        return DenseRunning(output + start, end - start);
+    }
+
+public:
+    struct SparseRunning {
+        SparseRunning(O* o) : output(o) {}
+
+        static constexpr SparseExtractMode extract_mode = SPARSE_EXTRACT_INDEX;
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            for (size_t j = 0; j < range.number; ++j) {
+                ++output[range.index[j]];
+            }
+        }
+
+        void finish() {}
+    private:
+        O* output;
+    };
+
+    SparseRunning sparse_running() {
+        return SparseRunning(output);
+    }
+
+    SparseRunning sparse_running(size_t start, size_t end) {
+        return SparseRunning(output);
+    }
+
+public:
+    struct RunningPartial {
+        RunningPartial(O* o, size_t d1) : output(o), counts(d1) {}
+
+        static constexpr SparseExtractMode extract_mode = SPARSE_EXTRACT_INDEX;
+
+        template<typename V>
+        void add(const V* ptr) {
+            for (size_t d = 0, end = counts.size(); d < end; ++d) {
+                counts[d] += (ptr[d] != 0);
+            }
+        }
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            for (size_t j = 0; j < range.number; ++j) {
+                ++counts[range.index[j]];
+            }
+        }
+
+        void merge(const RunningPartial& other) {
+            for (size_t d = 0, end = counts.size(); d < end; ++d) {
+                counts[d] += other.counts[d];
+            }
+        }
+
+        void finish() {
+            std::copy(counts.begin(), counts.end(), output);
+        }
+    private:
+        O* output;
+        std::vector<O> counts;
+    };
+
+    RunningPartial dense_running_partial() {
+        return RunningPartial(output, dim);
+    }
+
+    RunningPartial sparse_running_partial() {
+        return RunningPartial(output, dim);
+    }
+};
+
+template<typename O>
+struct ThresholdCountFactory {
+public:
+    ThresholdCountFactory(O* o, size_t d1, size_t d2, double t) : output(o), dim(d1), otherdim(d2), threshold(t) {}
+
+private:
+    O* output;
+    size_t dim, otherdim;
+    double threshold;
+
+public:
+    struct DenseDirect {
+        DenseDirect(O* o, size_t d2, double t) : output(o), otherdim(d2), threshold(t) {}
+
+        template<typename V>
+        void compute(size_t i, const V* ptr) {
+            O count = 0;
+            for (size_t j = 0; j < otherdim; ++j) {
+                count += (ptr[j] > threshold);
+            }
+            output[i] = count;
+        }
+    private:
+        O* output;
+        size_t otherdim;
+        double threshold;
+    };
+
+    DenseDirect dense_direct() {
+        return DenseDirect(output, otherdim, threshold);
+    }
+
+public:
+    struct SparseDirect {
+        SparseDirect(O* o, size_t d2, double t) : output(o), otherdim(d2), threshold(t) {}
+
+        template<typename V, typename IDX>
+        void compute(size_t i, const SparseRange<V, IDX>& range) {
+            O count = 0;
+            for (size_t j = 0; j < range.number; ++j) {
+                count += (range.value[j] > threshold);
+            }
+            if (threshold < 0) {
+                count += otherdim - range.number; // all implicit zeros are above the threshold.
+            }
+            output[i] = count;
+        }
+    private:
+        O* output;
+        size_t otherdim;
+        double threshold;
+    };
+
+    SparseDirect sparse_direct() {
+        return SparseDirect(output, otherdim, threshold);
+    }
+
+public:
+    // Dense and sparse running calculations share the same class. For sparse
+    // inputs with a negative threshold, we also need to count the structural
+    // non-zeros to account for the implicit zeros in finish().
+    struct Running {
+        Running(O* o, size_t s, size_t e, double t) : output(o), start(s), threshold(t), counts(e - s), nonzeros(t < 0 ? e - s : 0) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            for (size_t d = 0, end = counts.size(); d < end; ++d) {
+                counts[d] += (ptr[d] > threshold);
+            }
+        }
+
+        template<typename V, typename IDX>
+        void add(const SparseRange<V, IDX>& range) {
+            ++counter;
+            for (size_t j = 0; j < range.number; ++j) {
+                auto d = range.index[j] - start;
+                counts[d] += (range.value[j] > threshold);
+                if (threshold < 0) {
+                    ++nonzeros[d];
+                }
+            }
+        }
+
+        void merge(const Running& other) {
+            counter += other.counter;
+            for (size_t d = 0, end = counts.size(); d < end; ++d) {
+                counts[d] += other.counts[d];
+            }
+            for (size_t d = 0, end = nonzeros.size(); d < end; ++d) {
+                nonzeros[d] += other.nonzeros[d];
+            }
+        }
+
+        void finish() {
+            for (size_t d = 0, end = counts.size(); d < end; ++d) {
+                output[start + d] = counts[d];
+                if (threshold < 0 && counter) {
+                    output[start + d] += counter - nonzeros[d];
+                }
+            }
+        }
+    private:
+        O* output;
+        size_t start;
+        double threshold;
+        std::vector<O> counts;
+        std::vector<size_t> nonzeros;
+        size_t counter = 0;
+    };
+
+    Running dense_running() {
+        return Running(output, 0, dim, threshold);
+    }
+
+    Running dense_running(size_t start, size_t end) {
+        // Dense running vectors are already offset to 'start'.
+        return Running(output + start, 0, end - start, threshold);
+    }
+
+    Running sparse_running() {
+        return Running(output, 0, dim, threshold);
+    }
+
+    Running sparse_running(size_t start, size_t end) {
+        return Running(output, start, end, threshold);
+    }
+
+    Running dense_running_partial() {
+        return Running(output, 0, dim, threshold);
+    }
+
+    Running sparse_running_partial() {
+        return Running(output, 0, dim, threshold);
+    }
+};
+
+template<bool ROW, typename Output, typename T, typename IDX>
+std::vector<Output> compute_nnz(const Matrix<T, IDX>* p, int threads) {
+    size_t dim = (ROW ? p->nrow() : p->ncol());
+    std::vector<Output> output(dim);
+
+    // Counts along the compressed dimension are read directly from the index pointers, without any extraction.
+    if (p->sparse()) {
+        if constexpr(std::is_same<Output, size_t>::value) {
+            if (p->nonzero_counts(ROW, output.data())) {
+                return output;
+            }
+        } else {
+            std::vector<size_t> counts(dim);
+            if (p->nonzero_counts(ROW, counts.data())) {
+                std::copy(counts.begin(), counts.end(), output.begin());
+                return output;
+            }
+        }
+    }
+
+    NonZeroCountFactory factory(output.data(), dim, (ROW ? p->ncol() : p->nrow()));
+    apply<(ROW ? 0 : 1)>(p, factory, threads);
+    return output;
+}
+/**
+ * @endcond
+ */
+
+}
+
+/**
+ * For sparse matrices, this counts the structural non-zero elements, i.e., explicitly stored zeros are also counted.
+ * If the counts are known from the matrix structure (see `Matrix::nonzero_counts()`), e.g., from the index pointers of a compressed sparse column matrix, they are returned without any extraction.
+ * Otherwise, only the indices of the non-zero elements are extracted.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of columns, containing the number of non-zero elements in each column.
+ */
+template<typename Output = size_t, typename T, typename IDX>
+std::vector<Output> column_nnz(const Matrix<T, IDX>* p, int threads = 1) {
+    return stats::compute_nnz<false, Output>(p, threads);
+}
+
+/**
+ * See `column_nnz()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of rows, containing the number of non-zero elements in each row.
+ */
+template<typename Output = size_t, typename T, typename IDX>
+std::vector<Output> row_nnz(const Matrix<T, IDX>* p, int threads = 1) {
+    return stats::compute_nnz<true, Output>(p, threads);
+}
+
+/**
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param threshold Threshold on the matrix values.
+ * If this is negative, all zeros (including the implicit zeros of a sparse matrix) are counted.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of columns, containing the number of values in each column that are greater than `threshold`.
+ */
+template<typename Output = size_t, typename T, typename IDX>
+std::vector<Output> column_count_above(const Matrix<T, IDX>* p, double threshold, int threads = 1) {
+    std::vector<Output> output(p->ncol());
+    stats::ThresholdCountFactory factory(output.data(), p->ncol(), p->nrow(), threshold);
+    apply<1>(p, factory, threads);
+    return output;
+}
+
+/**
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param threshold Threshold on the matrix values.
+ * If this is negative, all zeros (including the implicit zeros of a sparse matrix) are counted.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of rows, containing the number of values in each row that are greater than `threshold`.
+ */
+template<typename Output = size_t, typename T, typename IDX>
+std::vector<Output> row_count_above(const Matrix<T, IDX>* p, double threshold, int threads = 1) {
+    std::vector<Output> output(p->nrow());
+    stats::ThresholdCountFactory factory(output.data(), p->nrow(), p->ncol(), threshold);
+    apply<0>(p, factory, threads);
+    return output;
+}
+
+}
+
+#endif
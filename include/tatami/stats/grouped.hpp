@@ -0,0 +1,572 @@
+#ifndef TATAMI_STATS_GROUPED_HPP
+#define TATAMI_STATS_GROUPED_HPP
+
+#include "../base/Matrix.hpp"
+#include "apply.hpp"
+#include "kernels.hpp"
+#include "variances.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+/**
+ * @file grouped.hpp
+ *
+ * Compute row and column statistics for groups of columns or rows from a `tatami::Matrix`.
+ */
+
+namespace tatami {
+
+namespace stats {
+
+/**
+ * @cond
+ */
+template<typename G>
+std::vector<size_t> tabulate_groups(const G* group, size_t n) {
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < n; ++i) {
+        size_t g = group[i];
+        if (g >= sizes.size()) {
+            sizes.resize(g + 1);
+        }
+        ++sizes[g];
+    }
+    return sizes;
+}
+
+template<typename O>
+std::vector<O*> offset_pointers(const std::vector<O*>& ptrs, size_t start) {
+    auto copy = ptrs;
+    for (auto& c : copy) {
+        c += start;
+    }
+    return copy;
+}
+
+/* For all grouped factories, the running calculations assume that each
+ * struct receives every running vector in order, so that the group of each
+ * running vector can be determined from the number of previous add() calls.
+ * This holds for the serial and parallel running calculations in apply(), as
+ * well as apply_tiled(). We do not support the partial running calculations
+ * as each struct only receives a subset of running vectors.
+ */
+template<typename O, typename G, bool NONZERO>
+struct GroupedSumFactory {
+public:
+    GroupedSumFactory(std::vector<O*> o, size_t d1, size_t d2, const G* g) : output(std::move(o)), dim(d1), otherdim(d2), group(g) {}
+
+private:
+    std::vector<O*> output;
+    size_t dim, otherdim;
+    const G* group;
+
+public:
+    struct DenseDirect {
+        DenseDirect(const std::vector<O*>& o, size_t d2, const G* g) : output(o), otherdim(d2), group(g), buffer(output.size()) {}
+
+        template<typename V>
+        void compute(size_t i, const V* ptr) {
+            std::fill(buffer.begin(), buffer.end(), 0);
+            for (size_t j = 0; j < otherdim; ++j) {
+                if constexpr(NONZERO) {
+                    buffer[group[j]] += (ptr[j] != 0);
+                } else {
+                    buffer[group[j]] += ptr[j];
+                }
+            }
+            for (size_t g = 0, end = output.size(); g < end; ++g) {
+                output[g][i] = buffer[g];
+            }
+        }
+    private:
+        const std::vector<O*>& output;
+        size_t otherdim;
+        const G* group;
+        std::vector<O> buffer;
+    };
+
+    DenseDirect dense_direct() {
+        return DenseDirect(output, otherdim, group);
+    }
+
+public:
+    struct SparseDirect {
+        SparseDirect(const std::vector<O*>& o, const G* g) : output(o), group(g), buffer(output.size()) {}
+
+        // Non-zero counts only need the indices to identify the group.
+        static constexpr SparseExtractMode extract_mode = (NONZERO ? SPARSE_EXTRACT_INDEX : SPARSE_EXTRACT_BOTH);
+
+        template<typename T, typename IDX>
+        void compute(size_t i, const SparseRange<T, IDX>& range) {
+            std::fill(buffer.begin(), buffer.end(), 0);
+            for (size_t j = 0; j < range.number; ++j) {
+                if constexpr(NONZERO) {
+                    ++buffer[group[range.index[j]]];
+                } else {
+                    buffer[group[range.index[j]]] += range.value[j];
+                }
+            }
+            for (size_t g = 0, end = output.size(); g < end; ++g) {
+                output[g][i] = buffer[g];
+            }
+        }
+    private:
+        const std::vector<O*>& output;
+        const G* group;
+        std::vector<O> buffer;
+    };
+
+    SparseDirect sparse_direct() {
+        return SparseDirect(output, group);
+    }
+
+public:
+    struct DenseRunning {
+        DenseRunning(std::vector<O*> o, size_t d1, const G* g) : output(std::move(o)), dim(d1), group(g) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            auto out = output[group[counter]];
+            ++counter;
+            if constexpr(NONZERO) {
+                for (size_t d = 0; d < dim; ++d) {
+                    out[d] += (ptr[d] != 0);
+                }
+            } else {
+                kernels::running_sum(out, ptr, dim);
+            }
+        }
+
+        void finish() {}
+    private:
+        std::vector<O*> output;
+        size_t dim;
+        const G* group;
+        size_t counter = 0;
+    };
+
+    DenseRunning dense_running() {
+        return DenseRunning(output, dim, group);
+    }
+
+    DenseRunning dense_running(size_t start, size_t end) {
+        return DenseRunning(offset_pointers(output, start), end - start, group);
+    }
+
+public:
+    struct SparseRunning {
+        SparseRunning(const std::vector<O*>& o, const G* g) : output(o), group(g) {}
+
+        static constexpr SparseExtractMode extract_mode = (NONZERO ? SPARSE_EXTRACT_INDEX : SPARSE_EXTRACT_BOTH);
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            auto out = output[group[counter]];
+            ++counter;
+            for (size_t j = 0; j < range.number; ++j) {
+                if constexpr(NONZERO) {
+                    ++out[range.index[j]];
+                } else {
+                    out[range.index[j]] += range.value[j];
+                }
+            }
+        }
+
+        void finish() {}
+    private:
+        const std::vector<O*>& output;
+        const G* group;
+        size_t counter = 0;
+    };
+
+    SparseRunning sparse_running() {
+        return SparseRunning(output, group);
+    }
+
+    SparseRunning sparse_running(size_t start, size_t end) {
+        return SparseRunning(output, group);
+    }
+};
+
+template<typename O, typename G>
+struct GroupedVarianceFactory {
+public:
+    GroupedVarianceFactory(std::vector<O*> m, std::vector<O*> v, size_t d1, size_t d2, const G* g, const size_t* s) :
+        means(std::move(m)), vars(std::move(v)), dim(d1), otherdim(d2), group(g), sizes(s) {}
+
+private:
+    std::vector<O*> means, vars;
+    size_t dim, otherdim;
+    const G* group;
+    const size_t* sizes;
+
+public:
+    struct DenseDirect {
+        DenseDirect(const std::vector<O*>& m, const std::vector<O*>& v, size_t d2, const G* g, const size_t* s) :
+            means(m), vars(v), otherdim(d2), group(g), sizes(s), tmp_means(m.size()), tmp_vars(m.size()) {}
+
+        template<typename V>
+        void compute(size_t i, const V* ptr) {
+            std::fill(tmp_means.begin(), tmp_means.end(), 0);
+            std::fill(tmp_vars.begin(), tmp_vars.end(), 0);
+            for (size_t j = 0; j < otherdim; ++j) {
+                tmp_means[group[j]] += ptr[j];
+            }
+            for (size_t g = 0, end = tmp_means.size(); g < end; ++g) {
+                tmp_means[g] /= sizes[g];
+            }
+            for (size_t j = 0; j < otherdim; ++j) {
+                O delta = ptr[j] - tmp_means[group[j]];
+                tmp_vars[group[j]] += delta * delta;
+            }
+            for (size_t g = 0, end = tmp_means.size(); g < end; ++g) {
+                means[g][i] = (sizes[g] ? tmp_means[g] : std::numeric_limits<O>::quiet_NaN());
+                vars[g][i] = variances::finish_variance_direct(tmp_vars[g], sizes[g]);
+            }
+        }
+    private:
+        const std::vector<O*>& means, & vars;
+        size_t otherdim;
+        const G* group;
+        const size_t* sizes;
+        std::vector<O> tmp_means, tmp_vars;
+    };
+
+    DenseDirect dense_direct() {
+        return DenseDirect(means, vars, otherdim, group, sizes);
+    }
+
+public:
+    struct SparseDirect {
+        SparseDirect(const std::vector<O*>& m, const std::vector<O*>& v, const G* g, const size_t* s) :
+            means(m), vars(v), group(g), sizes(s), tmp_means(m.size()), tmp_vars(m.size()), tmp_nonzeros(m.size()) {}
+
+        template<typename T, typename IDX>
+        void compute(size_t i, const SparseRange<T, IDX>& range) {
+            std::fill(tmp_means.begin(), tmp_means.end(), 0);
+            std::fill(tmp_vars.begin(), tmp_vars.end(), 0);
+            std::fill(tmp_nonzeros.begin(), tmp_nonzeros.end(), 0);
+            for (size_t j = 0; j < range.number; ++j) {
+                auto g = group[range.index[j]];
+                tmp_means[g] += range.value[j];
+                ++tmp_nonzeros[g];
+            }
+            for (size_t g = 0, end = tmp_means.size(); g < end; ++g) {
+                tmp_means[g] /= sizes[g];
+            }
+            for (size_t j = 0; j < range.number; ++j) {
+                auto g = group[range.index[j]];
+                O delta = range.value[j] - tmp_means[g];
+                tmp_vars[g] += delta * delta;
+            }
+            for (size_t g = 0, end = tmp_means.size(); g < end; ++g) {
+                tmp_vars[g] += tmp_means[g] * tmp_means[g] * (sizes[g] - tmp_nonzeros[g]); // accounting for the zeros.
+                means[g][i] = (sizes[g] ? tmp_means[g] : std::numeric_limits<O>::quiet_NaN());
+                vars[g][i] = variances::finish_variance_direct(tmp_vars[g], sizes[g]);
+            }
+        }
+    private:
+        const std::vector<O*>& means, & vars;
+        const G* group;
+        const size_t* sizes;
+        std::vector<O> tmp_means, tmp_vars;
+        std::vector<size_t> tmp_nonzeros;
+    };
+
+    SparseDirect sparse_direct() {
+        return SparseDirect(means, vars, group, sizes);
+    }
+
+public:
+    struct DenseRunning {
+        DenseRunning(std::vector<O*> m, std::vector<O*> v, size_t d1, const G* g) : means(std::move(m)), vars(std::move(v)), dim(d1), group(g), counts(means.size()) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            auto g = group[counter];
+            ++counter;
+            variances::compute_running(ptr, dim, means[g], vars[g], counts[g]);
+        }
+
+        void finish() {
+            for (size_t g = 0, end = means.size(); g < end; ++g) {
+                variances::finish_running(dim, means[g], vars[g], counts[g]);
+            }
+        }
+    private:
+        std::vector<O*> means, vars;
+        size_t dim;
+        const G* group;
+        std::vector<int> counts;
+        size_t counter = 0;
+    };
+
+    DenseRunning dense_running() {
+        return DenseRunning(means, vars, dim, group);
+    }
+
+    DenseRunning dense_running(size_t start, size_t end) {
+        return DenseRunning(offset_pointers(means, start), offset_pointers(vars, start), end - start, group);
+    }
+
+public:
+    struct SparseRunning {
+        SparseRunning(const std::vector<O*>& m, const std::vector<O*>& v, const G* g, size_t s, size_t e) :
+            means(m), vars(v), group(g), start(s), end(e), counts(m.size()), nonzeros(m.size(), std::vector<int>(e - s)) {}
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            auto g = group[counter];
+            ++counter;
+            // Indices in 'range' are not shifted by 'start', so we ask for them to be offset.
+            variances::compute_running(range, means[g] + start, vars[g] + start, nonzeros[g].data(), counts[g], start);
+        }
+
+        void finish() {
+            for (size_t g = 0, ngroups = means.size(); g < ngroups; ++g) {
+                variances::finish_running(end - start, means[g] + start, vars[g] + start, nonzeros[g].data(), counts[g]);
+            }
+        }
+    private:
+        const std::vector<O*>& means, & vars;
+        const G* group;
+        size_t start, end;
+        std::vector<int> counts;
+        std::vector<std::vector<int> > nonzeros;
+        size_t counter = 0;
+    };
+
+    SparseRunning sparse_running() {
+        return SparseRunning(means, vars, group, 0, dim);
+    }
+
+    SparseRunning sparse_running(size_t start, size_t end) {
+        return SparseRunning(means, vars, group, start, end);
+    }
+};
+
+template<typename Output>
+std::vector<Output*> fetch_pointers(std::vector<std::vector<Output> >& output) {
+    std::vector<Output*> ptrs;
+    ptrs.reserve(output.size());
+    for (auto& o : output) {
+        ptrs.push_back(o.data());
+    }
+    return ptrs;
+}
+
+template<bool ROW, bool NONZERO, typename Output, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > compute_grouped_sums(const Matrix<T, IDX>* p, const Group* group, int threads) {
+    size_t dim = (ROW ? p->nrow() : p->ncol()), otherdim = (ROW ? p->ncol() : p->nrow());
+    size_t ngroups = tabulate_groups(group, otherdim).size();
+    std::vector<std::vector<Output> > output(ngroups, std::vector<Output>(dim));
+
+    GroupedSumFactory<Output, Group, NONZERO> factory(fetch_pointers(output), dim, otherdim, group);
+    apply<(ROW ? 0 : 1)>(p, factory, threads);
+    return output;
+}
+
+template<bool ROW, typename Output, typename T, typename IDX, typename Group>
+std::pair<std::vector<std::vector<Output> >, std::vector<std::vector<Output> > > compute_grouped_variances(const Matrix<T, IDX>* p, const Group* group, int threads) {
+    size_t dim = (ROW ? p->nrow() : p->ncol()), otherdim = (ROW ? p->ncol() : p->nrow());
+    auto sizes = tabulate_groups(group, otherdim);
+    std::vector<std::vector<Output> > means(sizes.size(), std::vector<Output>(dim)), vars(means);
+
+    GroupedVarianceFactory<Output, Group> factory(fetch_pointers(means), fetch_pointers(vars), dim, otherdim, group, sizes.data());
+    apply<(ROW ? 0 : 1)>(p, factory, threads);
+    return std::make_pair(std::move(means), std::move(vars));
+}
+/**
+ * @endcond
+ */
+
+}
+
+/**
+ * All groups are processed in a single pass through the matrix, see `apply()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Group Integer type of the group assignments.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param[in] group Pointer to an array of length equal to the number of columns, containing the group assignment for each column.
+ * Group identifiers should be consecutive and 0-based.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of groups.
+ * Each entry is a vector of length equal to the number of rows, containing the row sums across the columns in the corresponding group.
+ */
+template<typename Output = double, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > row_sums_by_group(const Matrix<T, IDX>* p, const Group* group, int threads = 1) {
+    return stats::compute_grouped_sums<true, false, Output>(p, group, threads);
+}
+
+/**
+ * See `row_sums_by_group()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Group Integer type of the group assignments.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param[in] group Pointer to an array of length equal to the number of rows, containing the group assignment for each row.
+ * Group identifiers should be consecutive and 0-based.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of groups.
+ * Each entry is a vector of length equal to the number of columns, containing the column sums across the rows in the corresponding group.
+ */
+template<typename Output = double, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > column_sums_by_group(const Matrix<T, IDX>* p, const Group* group, int threads = 1) {
+    return stats::compute_grouped_sums<false, false, Output>(p, group, threads);
+}
+
+/**
+ * For sparse matrices, structural non-zero elements are counted, see `row_nnz()` for details.
+ * Only the indices of the non-zero elements are extracted.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Group Integer type of the group assignments.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param[in] group Pointer to an array of length equal to the number of columns, containing the group assignment for each column.
+ * Group identifiers should be consecutive and 0-based.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of groups.
+ * Each entry is a vector of length equal to the number of rows, containing the number of non-zero elements in each row across the columns in the corresponding group.
+ */
+template<typename Output = size_t, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > row_nnz_by_group(const Matrix<T, IDX>* p, const Group* group, int threads = 1) {
+    return stats::compute_grouped_sums<true, true, Output>(p, group, threads);
+}
+
+/**
+ * See `row_nnz_by_group()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Group Integer type of the group assignments.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param[in] group Pointer to an array of length equal to the number of rows, containing the group assignment for each row.
+ * Group identifiers should be consecutive and 0-based.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of groups.
+ * Each entry is a vector of length equal to the number of columns, containing the number of non-zero elements in each column across the rows in the corresponding group.
+ */
+template<typename Output = size_t, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > column_nnz_by_group(const Matrix<T, IDX>* p, const Group* group, int threads = 1) {
+    return stats::compute_grouped_sums<false, true, Output>(p, group, threads);
+}
+
+/**
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Group Integer type of the group assignments.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param[in] group Pointer to an array of length equal to the number of columns, containing the group assignment for each column.
+ * Group identifiers should be consecutive and 0-based.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of groups.
+ * Each entry is a vector of length equal to the number of rows, containing the row means across the columns in the corresponding group.
+ */
+template<typename Output = double, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > row_means_by_group(const Matrix<T, IDX>* p, const Group* group, int threads = 1) {
+    auto output = row_sums_by_group<Output>(p, group, threads);
+    auto sizes = stats::tabulate_groups(group, p->ncol());
+    for (size_t g = 0; g < output.size(); ++g) {
+        for (auto& o : output[g]) {
+            o /= sizes[g];
+        }
+    }
+    return output;
+}
+
+/**
+ * See `row_means_by_group()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Group Integer type of the group assignments.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param[in] group Pointer to an array of length equal to the number of rows, containing the group assignment for each row.
+ * Group identifiers should be consecutive and 0-based.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of groups.
+ * Each entry is a vector of length equal to the number of columns, containing the column means across the rows in the corresponding group.
+ */
+template<typename Output = double, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > column_means_by_group(const Matrix<T, IDX>* p, const Group* group, int threads = 1) {
+    auto output = column_sums_by_group<Output>(p, group, threads);
+    auto sizes = stats::tabulate_groups(group, p->nrow());
+    for (size_t g = 0; g < output.size(); ++g) {
+        for (auto& o : output[g]) {
+            o /= sizes[g];
+        }
+    }
+    return output;
+}
+
+/**
+ * As with `row_variances()`, the exact algorithm depends on the preferred dimension, so the results may be slightly different (within numerical precision) for row- and column-major matrices.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Group Integer type of the group assignments.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param[in] group Pointer to an array of length equal to the number of columns, containing the group assignment for each column.
+ * Group identifiers should be consecutive and 0-based.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of groups.
+ * Each entry is a vector of length equal to the number of rows, containing the row variances across the columns in the corresponding group.
+ * Variances are NaN for groups with fewer than two columns.
+ */
+template<typename Output = double, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > row_variances_by_group(const Matrix<T, IDX>* p, const Group* group, int threads = 1) {
+    return stats::compute_grouped_variances<true, Output>(p, group, threads).second;
+}
+
+/**
+ * See `row_variances_by_group()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ * @tparam Group Integer type of the group assignments.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param[in] group Pointer to an array of length equal to the number of rows, containing the group assignment for each row.
+ * Group identifiers should be consecutive and 0-based.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of groups.
+ * Each entry is a vector of length equal to the number of columns, containing the column variances across the rows in the corresponding group.
+ * Variances are NaN for groups with fewer than two rows.
+ */
+template<typename Output = double, typename T, typename IDX, typename Group>
+std::vector<std::vector<Output> > column_variances_by_group(const Matrix<T, IDX>* p, const Group* group, int threads = 1) {
+    return stats::compute_grouped_variances<false, Output>(p, group, threads).second;
+}
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef TATAMI_STATS_KERNELS_HPP
+#define TATAMI_STATS_KERNELS_HPP
+
+#include <cstddef>
+
+/**
+ * @file kernels.hpp
+ *
+ * Vectorizable kernels for the inner loops of the statistics calculations.
+ */
+
+/**
+ * Number of independent accumulators used by the reduction kernels.
+ * Reductions like `std::accumulate()` have a loop-carried dependency on a single accumulator, which prevents the compiler from using SIMD instructions for floating-point types (as this would change the order of additions).
+ * Splitting the reduction across several accumulators removes this dependency, so that each block of values can be processed with a single vector instruction;
+ * the widest instruction set enabled at compile time (e.g., `-mavx2`, `-mavx512f` or `-march=native`) is used without any changes to the code.
+ * The default of 8 fills an AVX-512 register for `double`s.
+ *
+ * Callers may define this to 1 before including any **tatami** headers, which restores strictly sequential reductions.
+ * This is occasionally useful for reproducing results exactly across representations, e.g., dense and sparse sums will then be computed in the same order.
+ */
+#ifndef TATAMI_KERNEL_LANES
+#define TATAMI_KERNEL_LANES 8
+#endif
+
+namespace tatami {
+
+namespace stats {
+
+/**
+ * @cond
+ */
+namespace kernels {
+
+constexpr size_t lanes = TATAMI_KERNEL_LANES;
+
+template<typename O, typename T>
+O sum(const T* ptr, size_t n) {
+    O partial[lanes] = {};
+    size_t j = 0;
+    for (; j + lanes <= n; j += lanes) {
+        for (size_t l = 0; l < lanes; ++l) {
+            partial[l] += ptr[j + l];
+        }
+    }
+
+    O total = 0;
+    for (size_t l = 0; l < lanes; ++l) {
+        total += partial[l];
+    }
+    for (; j < n; ++j) {
+        total += ptr[j];
+    }
+    return total;
+}
+
+template<typename O, typename T>
+O squared_deviations(const T* ptr, size_t n, O mean) {
+    O partial[lanes] = {};
+    size_t j = 0;
+    for (; j + lanes <= n; j += lanes) {
+        for (size_t l = 0; l < lanes; ++l) {
+            O delta = ptr[j + l] - mean;
+            partial[l] += delta * delta;
+        }
+    }
+
+    O total = 0;
+    for (size_t l = 0; l < lanes; ++l) {
+        total += partial[l];
+    }
+    for (; j < n; ++j) {
+        O delta = ptr[j] - mean;
+        total += delta * delta;
+    }
+    return total;
+}
+
+// Written with ternaries rather than branches, so that the compiler can emit
+// vector min/max instructions. Assumes that n > 0.
+template<bool compute_max, typename T>
+T extreme(const T* ptr, size_t n) {
+    auto choose = [](T current, T candidate) -> T {
+        if constexpr(compute_max) {
+            return (current < candidate ? candidate : current);
+        } else {
+            return (current > candidate ? candidate : current);
+        }
+    };
+
+    T best = ptr[0];
+    size_t j = 0;
+    if (n >= lanes) {
+        T partial[lanes];
+        for (size_t l = 0; l < lanes; ++l) {
+            partial[l] = ptr[l];
+        }
+        for (j = lanes; j + lanes <= n; j += lanes) {
+            for (size_t l = 0; l < lanes; ++l) {
+                partial[l] = choose(partial[l], ptr[j + l]);
+            }
+        }
+        for (size_t l = 0; l < lanes; ++l) {
+            best = choose(best, partial[l]);
+        }
+    }
+
+    for (; j < n; ++j) {
+        best = choose(best, ptr[j]);
+    }
+    return best;
+}
+
+// Element-wise updates across target vectors have no dependencies between
+// iterations, so they vectorize as long as the loop body is branch-free.
+template<bool compute_max, typename O, typename T>
+void running_extreme(O* output, const T* ptr, size_t n) {
+    for (size_t d = 0; d < n; ++d) {
+        O candidate = ptr[d];
+        if constexpr(compute_max) {
+            output[d] = (output[d] < candidate ? candidate : output[d]);
+        } else {
+            output[d] = (output[d] > candidate ? candidate : output[d]);
+        }
+    }
+}
+
+template<typename O, typename T>
+void running_sum(O* output, const T* ptr, size_t n) {
+    for (size_t d = 0; d < n; ++d) {
+        output[d] += ptr[d];
+    }
+}
+
+template<typename T, typename O>
+void running_welford(const T* ptr, size_t n, O* means, O* vars, double count) {
+    for (size_t d = 0; d < n; ++d) {
+        const double delta = ptr[d] - means[d];
+        means[d] += delta / count;
+        vars[d] += delta * (ptr[d] - means[d]);
+    }
+}
+
+}
+/**
+ * @endcond
+ */
+
+}
+
+}
+
+#endif
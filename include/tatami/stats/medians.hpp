@@ -8,6 +8,7 @@
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 /**
  * @file medians.hpp
@@ -22,24 +23,179 @@ namespace stats {
 /**
  * @cond
  */
+/* The select_*() functions find the value at 'rank' (0-based) among the sorted
+ * values, returned in 'first'. If 'lower = true', the value at 'rank - 1' is
+ * also returned in 'second'; this is cheap as all values before 'rank' are
+ * no greater than the selected value after nth_element, so we just need their
+ * maximum. These are also used for the quantile calculations.
+ */
+template<typename T>
+std::pair<double, double> select_dense(T* buffer, size_t n, size_t rank, bool lower) {
+    std::nth_element(buffer, buffer + rank, buffer + n);
+    std::pair<double, double> output(buffer[rank], 0);
+    if (lower) {
+        output.second = *std::max_element(buffer, buffer + rank);
+    }
+    return output;
+}
+
+/* Here, 'n' non-zero values in 'buffer' are supplemented by 'nzero' implicit zeros.
+ * Rather than sorting, we partition the non-zeros into negative and positive
+ * values and select the relevant ranks from whichever side they fall into.
+ */
+template<typename T>
+std::pair<double, double> select_sparse(T* buffer, size_t n, size_t nzero, size_t rank, bool lower) {
+    auto vend = buffer + n;
+    auto negend = std::partition(buffer, vend, [](T x) -> bool { return x < 0; });
+    size_t nneg = negend - buffer;
+    size_t zeroend = nneg + nzero;
+
+    std::pair<double, double> output(0, 0);
+    if (rank < nneg) {
+        std::nth_element(buffer, buffer + rank, negend);
+        output.first = buffer[rank];
+    } else if (rank >= zeroend) {
+        std::nth_element(negend, buffer + rank - nzero, vend);
+        output.first = buffer[rank - nzero];
+    }
+
+    if (lower) {
+        if (rank < nneg) {
+            output.second = *std::max_element(buffer, buffer + rank);
+        } else if (rank == nneg) {
+            output.second = *std::max_element(buffer, negend);
+        } else if (rank < zeroend) {
+            ; // zero is the lower value.
+        } else if (rank == zeroend) {
+            if (nzero == 0) {
+                output.second = *std::max_element(buffer, negend); // guaranteed to be at least one negative value.
+            }
+        } else {
+            output.second = *std::max_element(negend, buffer + rank - nzero);
+        }
+    }
+
+    return output;
+}
+
+/* Counting-based selection for small non-negative integers, which is the typical
+ * case for count data (e.g., after loading into a layered sparse matrix).
+ * Values in 'buffer' are supplemented by 'nzero' implicit zeros.
+ * tabulate_counted() returns false if the values are not suitable, in which case the caller should fall back to selection;
+ * otherwise, any number of ranks can be obtained from the same 'counts' with select_tabulated().
+ */
+template<typename T>
+bool tabulate_counted(const T* buffer, size_t n, size_t nzero, std::vector<size_t>& counts) {
+    size_t total = n + nzero;
+
+    // Histogram is only worthwhile if its size does not exceed the number of observations.
+    size_t maxed = 0;
+    for (size_t j = 0; j < n; ++j) {
+        auto val = buffer[j];
+        if (!(val >= 0 && static_cast<double>(val) < total)) { // also catches NaNs.
+            return false;
+        }
+        size_t ival = val;
+        if (ival != val) {
+            return false;
+        }
+        if (ival > maxed) {
+            maxed = ival;
+        }
+    }
+
+    counts.clear();
+    counts.resize(maxed + 1);
+    counts[0] = nzero;
+    for (size_t j = 0; j < n; ++j) {
+        ++counts[static_cast<size_t>(buffer[j])];
+    }
+    return true;
+}
+
+inline std::pair<double, double> select_tabulated(const std::vector<size_t>& counts, size_t rank, bool lower) {
+    size_t cumulative = 0, val = 0;
+    while (cumulative + counts[val] <= rank) {
+        cumulative += counts[val];
+        ++val;
+    }
+
+    std::pair<double, double> output(val, 0);
+    if (lower) {
+        if (cumulative < rank) {
+            // The value at 'rank - 1' lies in the same bin.
+            output.second = val;
+        } else {
+            size_t other = val - 1;
+            while (counts[other] == 0) {
+                --other;
+            }
+            output.second = other;
+        }
+    }
+    return output;
+}
+
+template<typename T>
+bool select_counted(const T* buffer, size_t n, size_t nzero, size_t rank, bool lower, std::vector<size_t>& counts, std::pair<double, double>& output) {
+    if (!tabulate_counted(buffer, n, nzero, counts)) {
+        return false;
+    }
+    output = select_tabulated(counts, rank, lower);
+    return true;
+}
+
 template<typename O = double, typename T>
 O compute_median(T* buffer, size_t n) {
     if (n == 0) {
         return std::numeric_limits<O>::quiet_NaN();
     }
 
-    size_t halfway = n / 2;
     bool is_even = (n % 2 == 0);
+    auto selected = select_dense(buffer, n, n / 2, is_even);
+    if (is_even) {
+        return (selected.first + selected.second)/2;
+    } else {
+        return selected.first;
+    }
+}
+
+// Median of 'n' non-zero values in 'buffer' plus 'nzero' implicit zeros.
+template<typename O = double, typename T>
+O compute_sparse_median(T* buffer, size_t n, size_t nzero) {
+    size_t total = n + nzero;
+    if (total == 0) {
+        return std::numeric_limits<O>::quiet_NaN();
+    }
+
+    bool is_even = (total % 2 == 0);
+    auto selected = select_sparse(buffer, n, nzero, total / 2, is_even);
+    if (is_even) {
+        return (selected.first + selected.second)/2;
+    } else {
+        return selected.first;
+    }
+}
+
+template<typename O, typename T>
+bool compute_counted_median(const T* buffer, size_t n, size_t nzero, std::vector<size_t>& counts, O& output) {
+    size_t total = n + nzero;
+    if (total == 0) {
+        return false;
+    }
+
+    bool is_even = (total % 2 == 0);
+    std::pair<double, double> selected;
+    if (!select_counted(buffer, n, nzero, total / 2, is_even, counts, selected)) {
+        return false;
+    }
 
-    // At some point, I found two nth_element calls to be faster than partial_sort.
-    std::nth_element(buffer, buffer + halfway, buffer + n);
-    double medtmp = *(buffer + halfway);
     if (is_even) {
-        std::nth_element(buffer, buffer + halfway - 1, buffer + n);
-        return (medtmp + *(buffer + halfway - 1))/2;
+        output = (selected.first + selected.second)/2;
     } else {
-        return medtmp;
+        output = selected.first;
     }
+    return true;
 }
 
 template<typename O>
@@ -56,11 +212,14 @@ public:
 
         template<typename T>
         void compute_copy(size_t i, T* ptr) {
-            output[i] = compute_median<O>(ptr, otherdim);
+            if (!compute_counted_median(ptr, otherdim, 0, counts, output[i])) {
+                output[i] = compute_median<O>(ptr, otherdim);
+            }
         }
     private:
         O* output;
         size_t otherdim;
+        std::vector<size_t> counts;
     };
 
     Dense dense_direct() {
@@ -75,53 +234,20 @@ public:
 
         template<typename T, typename IDX>
         void compute_copy(size_t i, size_t n, T* vbuffer, IDX*) {
-            if (n == otherdim) {
-                output[i] = compute_median<O>(vbuffer, otherdim);
-            } else if (n * 2 < otherdim) {
+            if (n * 2 < otherdim) {
                 output[i] = 0; // zero is the median if there are too many zeroes.
-            } else {
-                if (vbuffer != vbuffer) {
-                    std::copy(vbuffer, vbuffer + n, vbuffer);
-                }
-
-                size_t halfway = otherdim / 2;
-                bool is_even = (otherdim % 2 == 0);
-
-                auto vend = vbuffer + n;
-                std::sort(vbuffer, vend);
-                size_t zeropos = std::lower_bound(vbuffer, vend, 0) - vbuffer;
-                size_t nzero = otherdim - n;
-
-                if (!is_even) {
-                    if (zeropos > halfway) {
-                        output[i] = vbuffer[halfway];
-                    } else if (halfway >= zeropos + nzero) {
-                        output[i] = vbuffer[halfway - nzero];
-                    } else {
-                        output[i] = 0; // zero is the median.
-                    }
-                } else {
-                    double tmp = 0;
-                    if (zeropos > halfway) {
-                        tmp = vbuffer[halfway] + vbuffer[halfway - 1];
-                    } else if (zeropos == halfway) {
-                        // guaranteed to be at least 1 zero.
-                        tmp += vbuffer[halfway - 1];
-                    } else if (zeropos < halfway && zeropos + nzero > halfway) {
-                        ; // zero is the median.
-                    } else if (zeropos + nzero == halfway) {
-                        // guaranteed to be at least 1 zero.
-                        tmp += vbuffer[halfway - nzero];
-                    } else {
-                        tmp = vbuffer[halfway - nzero] + vbuffer[halfway - nzero - 1];
-                    }
-                    output[i] = tmp / 2;
-                }
+                return;
+            }
+
+            size_t nzero = otherdim - n;
+            if (!compute_counted_median(vbuffer, n, nzero, counts, output[i])) {
+                output[i] = compute_sparse_median<O>(vbuffer, n, nzero);
             }
         }
     private:
         O* output;
         size_t otherdim;
+        std::vector<size_t> counts;
     };
 
     Sparse sparse_direct() {
@@ -166,7 +292,7 @@ template<typename Output = double, typename T, typename IDX>
 inline std::vector<Output> row_medians(const Matrix<T, IDX>* p, int threads = 1) {
     std::vector<Output> output(p->nrow());
     stats::MedianFactory factory(output.data(), p->ncol());
-    apply<0>(p, factory);
+    apply<0>(p, factory, threads);
     return output;
 }
 
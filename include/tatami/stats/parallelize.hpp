@@ -0,0 +1,353 @@
+#ifndef TATAMI_STATS_PARALLELIZE_HPP
+#define TATAMI_STATS_PARALLELIZE_HPP
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../utils/ThreadPool.hpp"
+
+#include <cmath>
+#include <atomic>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * @file parallelize.hpp
+ *
+ * @brief Distribute contiguous ranges of jobs across workers.
+ */
+
+namespace tatami {
+
+/**
+ * Strategy for distributing the target vectors across threads in `apply()`.
+ *
+ * - `APPLY_SCHEDULE_STATIC`: each thread processes a single contiguous block.
+ * - `APPLY_SCHEDULE_DYNAMIC`: the target vectors are split into several contiguous chunks per thread,
+ *   and each thread takes the next unprocessed chunk once it has finished its current one.
+ *   This is useful when the cost of processing each vector is highly variable, e.g., for sparse matrices with skewed numbers of non-zero elements.
+ */
+enum ApplySchedule { APPLY_SCHEDULE_STATIC, APPLY_SCHEDULE_DYNAMIC };
+
+namespace stats {
+
+/**
+ * @brief Contiguous chunks of jobs to be processed by a single worker.
+ *
+ * Instances of this class are created by `parallelize_chunks()` and should be iterated by calling `next()` until it returns `false`.
+ */
+class WorkerChunks {
+public:
+    /**
+     * @cond
+     */
+    // A single range of jobs.
+    WorkerChunks(size_t s, size_t e) : static_start(s), static_end(e) {}
+
+    // Chunks from 'b', taken from a counter that is shared between workers.
+    WorkerChunks(const std::vector<size_t>* b, std::atomic<size_t>* c) : boundaries(b), counter(c) {}
+
+    // Every 'step'-th chunk from 'b', starting from 'first' and ending before 'last'.
+    WorkerChunks(const std::vector<size_t>* b, size_t first, size_t last, size_t step) : boundaries(b), current(first), last_chunk(last), chunk_step(step) {}
+    /**
+     * @endcond
+     */
+
+    /**
+     * @param[out] start On output, the index of the first job in the next chunk.
+     * @param[out] end On output, one past the index of the last job in the next chunk.
+     *
+     * @return Whether there is another chunk to be processed.
+     * If `false`, `start` and `end` should be ignored.
+     */
+    bool next(size_t& start, size_t& end) {
+        if (boundaries == nullptr) {
+            if (used || static_start >= static_end) {
+                return false;
+            }
+            used = true;
+            start = static_start;
+            end = static_end;
+            return true;
+        }
+
+        size_t nchunks = boundaries->size() - 1;
+        while (1) {
+            size_t chosen;
+            if (counter) {
+                chosen = counter->fetch_add(1);
+                if (chosen >= nchunks) {
+                    return false;
+                }
+            } else {
+                if (current >= last_chunk) {
+                    return false;
+                }
+                chosen = current;
+                current += chunk_step;
+            }
+
+            // Skipping empty chunks, which can occur if costs are very uneven.
+            start = (*boundaries)[chosen];
+            end = (*boundaries)[chosen + 1];
+            if (start < end) {
+                return true;
+            }
+        }
+    }
+
+private:
+    size_t static_start = 0, static_end = 0;
+    bool used = false;
+
+    const std::vector<size_t>* boundaries = nullptr;
+    std::atomic<size_t>* counter = nullptr;
+    size_t current = 0, last_chunk = 0, chunk_step = 1;
+};
+
+/**
+ * Number of chunks to create per thread for dynamic scheduling in `parallelize_chunks()`.
+ * More chunks improve load balancing at the cost of more per-chunk setup, e.g., creating extractors in running calculations.
+ */
+constexpr size_t dynamic_chunks_per_thread = 4;
+
+/**
+ * Split jobs into contiguous chunks with similar total costs.
+ * The cost of each job is defined as its `costs` plus 1, to account for any fixed overhead per job (e.g., for rows/columns with no non-zero elements).
+ *
+ * @param n Number of jobs.
+ * @param costs Pointer to an array of length `n`, containing the cost of each job, e.g., the number of non-zero elements in each row/column.
+ * If NULL, all jobs are assumed to have the same cost.
+ * @param nchunks Number of chunks.
+ *
+ * @return Vector of length `nchunks + 1`, containing the boundaries of the chunks.
+ * Chunk `i` contains the jobs from `output[i]` up to `output[i + 1]`.
+ * Some chunks may be empty if `nchunks` is greater than `n` or if the costs are very uneven.
+ */
+inline std::vector<size_t> chunk_boundaries(size_t n, const size_t* costs, size_t nchunks) {
+    std::vector<size_t> output(nchunks + 1);
+    output[nchunks] = n;
+
+    if (costs == NULL) {
+        size_t chunk_size = std::ceil(static_cast<double>(n) / nchunks);
+        for (size_t i = 1; i < nchunks; ++i) {
+            output[i] = std::min(n, i * chunk_size);
+        }
+        return output;
+    }
+
+    double total = n;
+    for (size_t i = 0; i < n; ++i) {
+        total += costs[i];
+    }
+
+    // Each boundary is placed at the first job where the cumulative cost reaches the desired fraction of the total.
+    double cumulative = 0;
+    size_t job = 0;
+    for (size_t i = 1; i < nchunks; ++i) {
+        double threshold = total * static_cast<double>(i) / nchunks;
+        while (job < n && cumulative < threshold) {
+            cumulative += costs[job] + 1;
+            ++job;
+        }
+        output[i] = job;
+    }
+
+    return output;
+}
+
+/**
+ * Distribute `n` jobs across `threads` workers, using OpenMP or `TATAMI_CUSTOM_PARALLEL` (see `apply()` for details).
+ * Each job is assigned to exactly one worker, and each worker receives its jobs as contiguous chunks.
+ *
+ * @tparam Function Function to be run by each worker.
+ * This should accept a `WorkerChunks` object by reference and call its `next()` method to obtain each chunk of jobs to process.
+ * Any per-worker setup (e.g., creation of extractors or buffers) can be performed once, before the first call to `next()`.
+ *
+ * @param n Number of jobs.
+ * @param costs Pointer to an array of length `n` containing the cost of each job, see `chunk_boundaries()`.
+ * If provided, chunk boundaries are chosen so that each chunk has a similar total cost.
+ * If NULL, each chunk contains a similar number of jobs.
+ * @param threads Number of threads.
+ * @param schedule Scheduling strategy.
+ * For static scheduling, each worker receives a single chunk.
+ * For dynamic scheduling, the jobs are split into `dynamic_chunks_per_thread` chunks per thread, which are taken by workers as they become available.
+ * @param f Function to run in each worker.
+ */
+template<class Function>
+void parallelize_chunks(size_t n, const size_t* costs, int threads, ApplySchedule schedule, Function f) {
+    bool dynamic = (schedule == APPLY_SCHEDULE_DYNAMIC && threads > 1);
+
+    if (dynamic || (costs != NULL && threads > 1)) {
+        size_t nchunks = static_cast<size_t>(threads) * (dynamic ? dynamic_chunks_per_thread : 1);
+        auto boundaries = chunk_boundaries(n, costs, nchunks);
+
+        if (dynamic) {
+            std::atomic<size_t> counter(0);
+#ifndef TATAMI_CUSTOM_PARALLEL
+            #pragma omp parallel num_threads(threads)
+            {
+                WorkerChunks chunks(&boundaries, &counter);
+                f(chunks);
+            }
+#else
+            // Each worker just pulls chunks until the counter is exhausted, so the range that it receives is irrelevant.
+            TATAMI_CUSTOM_PARALLEL(threads, [&](size_t, size_t) -> void {
+                WorkerChunks chunks(&boundaries, &counter);
+                f(chunks);
+            }, threads);
+#endif
+            return;
+        }
+
+#ifndef TATAMI_CUSTOM_PARALLEL
+        #pragma omp parallel num_threads(threads)
+        {
+            size_t first = 0, step = 1;
+#ifdef _OPENMP
+            // Each worker takes one chunk, unless we got fewer threads than we requested.
+            first = omp_get_thread_num();
+            step = omp_get_num_threads();
+#endif
+            WorkerChunks chunks(&boundaries, first, nchunks, step);
+            f(chunks);
+        }
+#else
+        TATAMI_CUSTOM_PARALLEL(nchunks, [&](size_t start, size_t end) -> void {
+            WorkerChunks chunks(&boundaries, start, end, 1);
+            f(chunks);
+        }, threads);
+#endif
+        return;
+    }
+
+#ifndef TATAMI_CUSTOM_PARALLEL
+    #pragma omp parallel num_threads(threads)
+    {
+        size_t start = 0, end = n;
+#ifdef _OPENMP
+        // We use the omp methods here to get the total number of threads, just in case something
+        // causes us to have fewer threads than the number we requested.
+        size_t worker_size = std::ceil(static_cast<double>(n) / omp_get_num_threads());
+        start = std::min(n, worker_size * omp_get_thread_num());
+        end = std::min(n, start + worker_size);
+#endif
+        WorkerChunks chunks(start, end);
+        f(chunks);
+    }
+#else
+    TATAMI_CUSTOM_PARALLEL(n, [&](size_t start, size_t end) -> void {
+        WorkerChunks chunks(start, end);
+        f(chunks);
+    }, threads);
+#endif
+}
+
+/**
+ * Overload of `parallelize_chunks()` where all jobs have the same cost.
+ *
+ * @tparam Function Function to be run by each worker.
+ *
+ * @param n Number of jobs.
+ * @param threads Number of threads.
+ * @param schedule Scheduling strategy.
+ * @param f Function to run in each worker.
+ */
+template<class Function>
+void parallelize_chunks(size_t n, int threads, ApplySchedule schedule, Function f) {
+    parallelize_chunks(n, static_cast<const size_t*>(NULL), threads, schedule, std::move(f));
+}
+
+/**
+ * Distribute `n` jobs across the threads of a `ThreadPool`, see the other `parallelize_chunks()` overload for details.
+ *
+ * @tparam Function Function to be run by each worker.
+ *
+ * @param n Number of jobs.
+ * @param costs Pointer to an array of length `n` containing the cost of each job, see `chunk_boundaries()`.
+ * This may be NULL.
+ * @param pool Pool of threads, where the number of workers is defined by `ThreadPool::num_threads()`.
+ * @param schedule Scheduling strategy.
+ * @param f Function to run in each worker.
+ */
+template<class Function>
+void parallelize_chunks(size_t n, const size_t* costs, ThreadPool& pool, ApplySchedule schedule, Function f) {
+    size_t threads = pool.num_threads();
+    bool dynamic = (schedule == APPLY_SCHEDULE_DYNAMIC && threads > 1);
+
+    if (dynamic || (costs != NULL && threads > 1)) {
+        size_t nchunks = threads * (dynamic ? dynamic_chunks_per_thread : 1);
+        auto boundaries = chunk_boundaries(n, costs, nchunks);
+
+        if (dynamic) {
+            std::atomic<size_t> counter(0);
+            pool.run(threads, [&](size_t) -> void {
+                WorkerChunks chunks(&boundaries, &counter);
+                f(chunks);
+            });
+        } else {
+            pool.run(nchunks, [&](size_t w) -> void {
+                WorkerChunks chunks(&boundaries, w, w + 1, 1);
+                f(chunks);
+            });
+        }
+        return;
+    }
+
+    size_t worker_size = std::ceil(static_cast<double>(n) / threads);
+    pool.run(threads, [&](size_t w) -> void {
+        size_t start = std::min(n, worker_size * w);
+        size_t end = std::min(n, start + worker_size);
+        WorkerChunks chunks(start, end);
+        f(chunks);
+    });
+}
+
+/**
+ * Overload of `parallelize_chunks()` for a `ThreadPool` where all jobs have the same cost.
+ *
+ * @tparam Function Function to be run by each worker.
+ *
+ * @param n Number of jobs.
+ * @param pool Pool of threads.
+ * @param schedule Scheduling strategy.
+ * @param f Function to run in each worker.
+ */
+template<class Function>
+void parallelize_chunks(size_t n, ThreadPool& pool, ApplySchedule schedule, Function f) {
+    parallelize_chunks(n, static_cast<const size_t*>(NULL), pool, schedule, std::move(f));
+}
+
+/**
+ * @cond
+ */
+inline int count_threads(int threads) {
+    return threads;
+}
+
+inline int count_threads(const ThreadPool& pool) {
+    return pool.num_threads();
+}
+
+// Whether the parallelized running calculations can be used in apply().
+// Without a parallel backend, it is more efficient to use a single extractor for all target vectors.
+template<class Threads>
+constexpr bool has_parallel_backend() {
+#if defined(_OPENMP) || defined(TATAMI_CUSTOM_PARALLEL)
+    return true;
+#else
+    return std::is_same<Threads, ThreadPool>::value;
+#endif
+}
+/**
+ * @endcond
+ */
+
+}
+
+}
+
+#endif
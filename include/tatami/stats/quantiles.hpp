@@ -0,0 +1,901 @@
+#ifndef TATAMI_STATS_QUANTILES_HPP
+#define TATAMI_STATS_QUANTILES_HPP
+
+#include "../base/Matrix.hpp"
+#include "apply.hpp"
+#include "medians.hpp"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+
+/**
+ * @file quantiles.hpp
+ *
+ * Compute row and column quantiles from a `tatami::Matrix`, either exactly or approximately.
+ * Also computes the median absolute deviation for each row or column.
+ */
+
+namespace tatami {
+
+namespace stats {
+
+/**
+ * @cond
+ */
+// Quantiles are defined by linear interpolation between order statistics,
+// i.e., type 7 in R's quantile() function.
+struct QuantilePosition {
+    QuantilePosition(size_t total, double prob) {
+        double h = (total - 1) * prob;
+        rank = static_cast<size_t>(std::floor(h));
+        fraction = h - rank;
+        if (fraction > 0) {
+            ++rank;
+        }
+    }
+
+    size_t rank;
+    double fraction;
+
+    bool lower() const {
+        return fraction > 0;
+    }
+
+    template<typename O>
+    O interpolate(const std::pair<double, double>& selected) const {
+        if (fraction > 0) {
+            return selected.second + fraction * (selected.first - selected.second);
+        } else {
+            return selected.first;
+        }
+    }
+};
+
+inline void check_quantile_probability(double prob) {
+    if (!(prob >= 0 && prob <= 1)) {
+        throw std::runtime_error("quantile probability should lie in [0, 1]");
+    }
+}
+
+inline void check_quantile_probabilities(const std::vector<double>& probs) {
+    for (auto prob : probs) {
+        check_quantile_probability(prob);
+    }
+}
+
+/* Selects multiple ranks from the same buffer, which must be requested in non-decreasing order.
+ * After each nth_element() call, all values before the selected rank are no greater than it
+ * and all values after it are no less, so the next selection only needs to search the
+ * values after the previous rank. This allows several quantiles to be obtained from one copy.
+ */
+template<typename T>
+struct SequentialSelector {
+    SequentialSelector(T* b, size_t n_) : buffer(b), n(n_) {}
+
+    std::pair<double, double> select(size_t rank, bool lower) {
+        if (from == 0 || rank >= from) {
+            std::nth_element(buffer + from, buffer + rank, buffer + n);
+
+            // Value at 'rank - 1' is the maximum of everything before 'rank',
+            // which is either in the newly partitioned region or at the end of the previous one.
+            if (rank > from) {
+                before = *std::max_element(buffer + from, buffer + rank);
+            } else if (rank) {
+                before = buffer[rank - 1];
+            }
+            from = rank + 1;
+        }
+
+        // Otherwise, 'rank' is the same as the previous request, so we can just re-use it.
+        std::pair<double, double> output(buffer[rank], 0);
+        if (lower) {
+            output.second = before;
+        }
+        return output;
+    }
+private:
+    T* buffer;
+    size_t n;
+    size_t from = 0;
+    double before = 0;
+};
+
+/* Sparse counterpart of the SequentialSelector, where 'n' non-zero values in
+ * 'buffer' are supplemented by 'nzero' implicit zeros. As in select_sparse(),
+ * the non-zeros are partitioned into negative and positive values, and each
+ * side is searched separately for the requested ranks.
+ */
+template<typename T>
+struct SparseSequentialSelector {
+    SparseSequentialSelector(T* buffer, size_t n, size_t nz) : 
+        nneg(partition_negative(buffer, n)), 
+        nzero(nz), 
+        negatives(buffer, nneg), 
+        positives(buffer + nneg, n - nneg) 
+    {}
+
+    std::pair<double, double> select(size_t rank, bool lower) {
+        if (rank < nneg) {
+            return negatives.select(rank, lower);
+        }
+
+        size_t zeroend = nneg + nzero;
+        std::pair<double, double> output(0, 0);
+        if (rank >= zeroend) {
+            if (rank > zeroend) {
+                return positives.select(rank - zeroend, lower);
+            }
+            output.first = positives.select(0, false).first;
+        }
+
+        // At this point, 'rank - 1' is either the largest negative value or one of the zeros.
+        if (lower && rank == nneg) {
+            output.second = negatives.select(nneg - 1, false).first;
+        }
+        return output;
+    }
+private:
+    static size_t partition_negative(T* buffer, size_t n) {
+        return std::partition(buffer, buffer + n, [](T x) -> bool { return x < 0; }) - buffer;
+    }
+
+    size_t nneg, nzero;
+    SequentialSelector<T> negatives, positives;
+};
+
+/* Positions are sorted by rank so that the SequentialSelector can be used to
+ * find all quantiles in a single pass over the buffer.
+ */
+struct QuantilePositions {
+    QuantilePositions(size_t total, const std::vector<double>& probs) {
+        check_quantile_probabilities(probs);
+        if (total == 0) {
+            return;
+        }
+
+        positions.reserve(probs.size());
+        for (auto prob : probs) {
+            positions.emplace_back(total, prob);
+        }
+
+        order.resize(probs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t left, size_t right) -> bool { return positions[left].rank < positions[right].rank; });
+    }
+
+    std::vector<QuantilePosition> positions;
+    std::vector<size_t> order;
+};
+
+template<typename O>
+struct QuantileFactory {
+    QuantileFactory(std::vector<O*> o, size_t d2, const std::vector<double>& probs) : output(std::move(o)), otherdim(d2), positions(d2, probs) {}
+
+private:
+    std::vector<O*> output;
+    size_t otherdim;
+    QuantilePositions positions;
+
+    template<class Select>
+    static void fill(size_t i, const std::vector<O*>& output, const QuantilePositions& positions, Select select) {
+        for (auto q : positions.order) {
+            const auto& pos = positions.positions[q];
+            output[q][i] = pos.template interpolate<O>(select(pos.rank, pos.lower()));
+        }
+    }
+
+    static void fill_NaN(size_t i, const std::vector<O*>& output) {
+        for (auto o : output) {
+            o[i] = std::numeric_limits<O>::quiet_NaN();
+        }
+    }
+
+public:
+    struct Dense {
+        Dense(const std::vector<O*>& o, size_t d2, const QuantilePositions& p) : output(o), otherdim(d2), positions(p) {}
+
+        template<typename T>
+        void compute_copy(size_t i, T* ptr) {
+            if (otherdim == 0) {
+                fill_NaN(i, output);
+                return;
+            }
+
+            if (tabulate_counted(ptr, otherdim, 0, counts)) {
+                fill(i, output, positions, [&](size_t rank, bool lower) -> std::pair<double, double> { return select_tabulated(counts, rank, lower); });
+            } else {
+                SequentialSelector<T> selector(ptr, otherdim);
+                fill(i, output, positions, [&](size_t rank, bool lower) -> std::pair<double, double> { return selector.select(rank, lower); });
+            }
+        }
+    private:
+        const std::vector<O*>& output;
+        size_t otherdim;
+        const QuantilePositions& positions;
+        std::vector<size_t> counts;
+    };
+
+    Dense dense_direct() {
+        return Dense(output, otherdim, positions);
+    }
+
+public:
+    struct Sparse {
+        Sparse(const std::vector<O*>& o, size_t d2, const QuantilePositions& p) : output(o), otherdim(d2), positions(p) {}
+
+        static constexpr SparseCopyMode copy_mode = SPARSE_COPY_VALUE;
+
+        template<typename T, typename IDX>
+        void compute_copy(size_t i, size_t n, T* vbuffer, IDX*) {
+            if (otherdim == 0) {
+                fill_NaN(i, output);
+                return;
+            }
+
+            size_t nzero = otherdim - n;
+            if (tabulate_counted(vbuffer, n, nzero, counts)) {
+                fill(i, output, positions, [&](size_t rank, bool lower) -> std::pair<double, double> { return select_tabulated(counts, rank, lower); });
+            } else {
+                SparseSequentialSelector<T> selector(vbuffer, n, nzero);
+                fill(i, output, positions, [&](size_t rank, bool lower) -> std::pair<double, double> { return selector.select(rank, lower); });
+            }
+        }
+    private:
+        const std::vector<O*>& output;
+        size_t otherdim;
+        const QuantilePositions& positions;
+        std::vector<size_t> counts;
+    };
+
+    Sparse sparse_direct() {
+        return Sparse(output, otherdim, positions);
+    }
+};
+
+template<typename O>
+struct MadFactory {
+    MadFactory(O* o, size_t d2) : output(o), otherdim(d2) {}
+
+private:
+    O* output;
+    size_t otherdim;
+
+public:
+    struct Dense {
+        Dense(O* o, size_t d2) : output(o), otherdim(d2), deviations(d2) {}
+
+        template<typename T>
+        void compute_copy(size_t i, T* ptr) {
+            if (otherdim == 0) {
+                output[i] = std::numeric_limits<O>::quiet_NaN();
+                return;
+            }
+
+            O center;
+            if (!compute_counted_median(ptr, otherdim, 0, counts, center)) {
+                center = compute_median<O>(ptr, otherdim);
+            }
+
+            for (size_t j = 0; j < otherdim; ++j) {
+                deviations[j] = std::abs(ptr[j] - center);
+            }
+            output[i] = compute_median<O>(deviations.data(), otherdim);
+        }
+    private:
+        O* output;
+        size_t otherdim;
+        std::vector<size_t> counts;
+        std::vector<O> deviations;
+    };
+
+    Dense dense_direct() {
+        return Dense(output, otherdim);
+    }
+
+public:
+    struct Sparse {
+        Sparse(O* o, size_t d2) : output(o), otherdim(d2) {}
+
+        static constexpr SparseCopyMode copy_mode = SPARSE_COPY_VALUE;
+
+        template<typename T, typename IDX>
+        void compute_copy(size_t i, size_t n, T* vbuffer, IDX*) {
+            if (otherdim == 0) {
+                output[i] = std::numeric_limits<O>::quiet_NaN();
+                return;
+            }
+
+            size_t nzero = otherdim - n;
+            O center;
+            if (!compute_counted_median(vbuffer, n, nzero, counts, center)) {
+                center = compute_sparse_median<O>(vbuffer, n, nzero);
+            }
+
+            // All implicit zeros have the same deviation, so we shift the 
+            // deviations such that the zeros remain implicit.
+            O zdev = std::abs(center);
+            deviations.resize(n);
+            for (size_t j = 0; j < n; ++j) {
+                deviations[j] = std::abs(vbuffer[j] - center) - zdev;
+            }
+            output[i] = compute_sparse_median<O>(deviations.data(), n, nzero) + zdev;
+        }
+    private:
+        O* output;
+        size_t otherdim;
+        std::vector<size_t> counts;
+        std::vector<O> deviations;
+    };
+
+    Sparse sparse_direct() {
+        return Sparse(output, otherdim);
+    }
+};
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Mergeable sketch for approximate quantiles.
+ *
+ * This implements a KLL-style sketch where observations are stored in a hierarchy of compactors.
+ * Each item at level `h` represents `2^h` observations; when a level exceeds its capacity, it is sorted and every other item is promoted to the next level.
+ * Capacities decrease geometrically from the top level, so the memory usage is roughly `3 * k` items regardless of the number of observations.
+ * The alternating choice of the promoted items is deterministic, so results are reproducible for the same sequence of observations.
+ *
+ * No compaction occurs until `k` observations have been added, so the quantiles are exact for short vectors.
+ * Zeros can be supplied implicitly to `quantile()`, which allows sparse vectors to be summarized from their non-zero values only.
+ */
+class QuantileSketch {
+public:
+    /**
+     * @param k Capacity of the top level of the sketch.
+     * Larger values improve accuracy at the cost of memory.
+     */
+    QuantileSketch(size_t k = 200) : top(std::max(static_cast<size_t>(2), k)), levels(1) {}
+
+    /**
+     * @param x Observed value.
+     */
+    void add(double x) {
+        levels[0].push_back(x);
+        ++n;
+        if (levels[0].size() > capacity(0)) {
+            compress();
+        }
+    }
+
+    /**
+     * @param other Another sketch, constructed with the same `k`.
+     * On return, this sketch summarizes the observations of both sketches.
+     */
+    void merge(const QuantileSketch& other) {
+        if (other.levels.size() > levels.size()) {
+            levels.resize(other.levels.size());
+        }
+        for (size_t h = 0; h < other.levels.size(); ++h) {
+            levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+        }
+        n += other.n;
+        compress();
+    }
+
+    /**
+     * Remove all observations from the sketch.
+     */
+    void clear() {
+        levels.clear();
+        levels.resize(1);
+        n = 0;
+        offset = 0;
+    }
+
+    /**
+     * @return Number of observations added to this sketch.
+     */
+    size_t count() const {
+        return n;
+    }
+
+    /**
+     * @param prob Probability of the quantile, in `[0, 1]`.
+     * @param nzero Number of additional zeros to include in the distribution.
+     *
+     * @return Approximate quantile of the observations and the additional zeros, using the same interpolation as R's `quantile()` (type 7).
+     * This is NaN if there are no observations.
+     */
+    double quantile(double prob, size_t nzero = 0) const {
+        size_t total = n + nzero;
+        if (total == 0) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        return lookup(weigh(nzero), total, prob);
+    }
+
+    /**
+     * @param probs Probabilities of the quantiles, each in `[0, 1]`.
+     * @param nzero Number of additional zeros to include in the distribution.
+     *
+     * @return Approximate quantiles for each entry of `probs`, see `quantile()` for details.
+     * This is more efficient than calling `quantile()` separately for each probability.
+     */
+    std::vector<double> quantile(const std::vector<double>& probs, size_t nzero = 0) const {
+        size_t total = n + nzero;
+        if (total == 0) {
+            return std::vector<double>(probs.size(), std::numeric_limits<double>::quiet_NaN());
+        }
+
+        auto weighted = weigh(nzero);
+        std::vector<double> output;
+        output.reserve(probs.size());
+        for (auto prob : probs) {
+            output.push_back(lookup(weighted, total, prob));
+        }
+        return output;
+    }
+
+private:
+    size_t top;
+    std::vector<std::vector<double> > levels;
+    size_t n = 0;
+    int offset = 0;
+
+    std::vector<std::pair<double, size_t> > weigh(size_t nzero) const {
+        std::vector<std::pair<double, size_t> > weighted;
+        if (nzero) {
+            weighted.emplace_back(0, nzero);
+        }
+        size_t weight = 1;
+        for (const auto& level : levels) {
+            for (auto x : level) {
+                weighted.emplace_back(x, weight);
+            }
+            weight *= 2;
+        }
+        std::sort(weighted.begin(), weighted.end());
+        return weighted;
+    }
+
+    static double lookup(const std::vector<std::pair<double, size_t> >& weighted, size_t total, double prob) {
+        QuantilePosition pos(total, prob);
+        std::pair<double, double> selected;
+        size_t cumulative = 0;
+        auto it = weighted.begin();
+        while (cumulative + it->second <= pos.rank) {
+            cumulative += it->second;
+            ++it;
+        }
+        selected.first = it->first;
+
+        if (pos.lower()) {
+            if (cumulative < pos.rank) {
+                selected.second = it->first;
+            } else {
+                selected.second = (it - 1)->first;
+            }
+        }
+
+        return pos.template interpolate<double>(selected);
+    }
+
+    size_t capacity(size_t h) const {
+        size_t depth = levels.size() - h - 1;
+        return std::max(static_cast<size_t>(2), static_cast<size_t>(std::ceil(top * std::pow(2.0 / 3, depth))));
+    }
+
+    void compress() {
+        for (size_t h = 0; h < levels.size(); ++h) {
+            if (levels[h].size() <= capacity(h)) {
+                continue;
+            }
+            if (h + 1 == levels.size()) {
+                levels.emplace_back();
+            }
+
+            auto& current = levels[h];
+            auto& next = levels[h + 1];
+            std::sort(current.begin(), current.end());
+
+            // If there are an odd number of items, the smallest stays at this level
+            // so that the total weight is preserved.
+            size_t keep = current.size() % 2;
+            for (size_t i = keep + offset; i < current.size(); i += 2) {
+                next.push_back(current[i]);
+            }
+            current.resize(keep);
+            offset = 1 - offset;
+        }
+    }
+};
+
+/**
+ * @cond
+ */
+template<typename O>
+struct ApproximateQuantileFactory {
+    ApproximateQuantileFactory(std::vector<O*> o, size_t d1, size_t d2, std::vector<double> p, size_t k_) : output(std::move(o)), dim(d1), otherdim(d2), probs(std::move(p)), k(k_) {
+        check_quantile_probabilities(probs);
+    }
+
+private:
+    std::vector<O*> output;
+    size_t dim, otherdim;
+    std::vector<double> probs;
+    size_t k;
+
+    static void fill(size_t i, const std::vector<O*>& output, const std::vector<double>& probs, const QuantileSketch& sketch, size_t nzero) {
+        if (probs.size() == 1) {
+            output[0][i] = sketch.quantile(probs[0], nzero);
+        } else {
+            auto results = sketch.quantile(probs, nzero);
+            for (size_t q = 0, end = probs.size(); q < end; ++q) {
+                output[q][i] = results[q];
+            }
+        }
+    }
+
+public:
+    // Zeros are never added to the sketches, so that dense and sparse inputs yield the same results.
+    struct DenseDirect {
+        DenseDirect(const std::vector<O*>& o, size_t d2, const std::vector<double>& p, size_t k) : output(o), otherdim(d2), probs(p), sketch(k) {}
+
+        template<typename V>
+        void compute(size_t i, const V* ptr) {
+            sketch.clear();
+            for (size_t j = 0; j < otherdim; ++j) {
+                if (ptr[j]) {
+                    sketch.add(ptr[j]);
+                }
+            }
+            fill(i, output, probs, sketch, otherdim - sketch.count());
+        }
+    private:
+        const std::vector<O*>& output;
+        size_t otherdim;
+        const std::vector<double>& probs;
+        QuantileSketch sketch;
+    };
+
+    DenseDirect dense_direct() {
+        return DenseDirect(output, otherdim, probs, k);
+    }
+
+public:
+    struct SparseDirect {
+        SparseDirect(const std::vector<O*>& o, size_t d2, const std::vector<double>& p, size_t k) : output(o), otherdim(d2), probs(p), sketch(k) {}
+
+        template<typename T, typename IDX>
+        void compute(size_t i, const SparseRange<T, IDX>& range) {
+            sketch.clear();
+            for (size_t j = 0; j < range.number; ++j) {
+                if (range.value[j]) {
+                    sketch.add(range.value[j]);
+                }
+            }
+            fill(i, output, probs, sketch, otherdim - sketch.count());
+        }
+    private:
+        const std::vector<O*>& output;
+        size_t otherdim;
+        const std::vector<double>& probs;
+        QuantileSketch sketch;
+    };
+
+    SparseDirect sparse_direct() {
+        return SparseDirect(output, otherdim, probs, k);
+    }
+
+public:
+    // The same class is used for all running calculations, as the sketches are indexed relative to 'start'.
+    // Dense running vectors are already offset to 'start', so only sparse indices need to be shifted.
+    struct Running {
+        Running(const std::vector<O*>& o, size_t s, size_t e, const std::vector<double>& p, size_t k) : output(o), start(s), probs(p), sketches(e - s, QuantileSketch(k)) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            ++counter;
+            for (size_t d = 0, end = sketches.size(); d < end; ++d) {
+                if (ptr[d]) {
+                    sketches[d].add(ptr[d]);
+                }
+            }
+        }
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            ++counter;
+            for (size_t j = 0; j < range.number; ++j) {
+                if (range.value[j]) {
+                    sketches[range.index[j] - start].add(range.value[j]);
+                }
+            }
+        }
+
+        void merge(const Running& other) {
+            counter += other.counter;
+            for (size_t d = 0, end = sketches.size(); d < end; ++d) {
+                sketches[d].merge(other.sketches[d]);
+            }
+        }
+
+        void finish() {
+            for (size_t d = 0, end = sketches.size(); d < end; ++d) {
+                fill(start + d, output, probs, sketches[d], counter - sketches[d].count());
+            }
+        }
+    private:
+        const std::vector<O*>& output;
+        size_t start;
+        const std::vector<double>& probs;
+        std::vector<QuantileSketch> sketches;
+        size_t counter = 0;
+    };
+
+    Running dense_running() {
+        return Running(output, 0, dim, probs, k);
+    }
+
+    Running dense_running(size_t start, size_t end) {
+        return Running(output, start, end, probs, k);
+    }
+
+    Running sparse_running() {
+        return Running(output, 0, dim, probs, k);
+    }
+
+    Running sparse_running(size_t start, size_t end) {
+        return Running(output, start, end, probs, k);
+    }
+
+    Running dense_running_partial() {
+        return Running(output, 0, dim, probs, k);
+    }
+
+    Running sparse_running_partial() {
+        return Running(output, 0, dim, probs, k);
+    }
+};
+
+template<typename Output>
+std::vector<Output*> quantile_pointers(std::vector<std::vector<Output> >& output) {
+    std::vector<Output*> ptrs;
+    ptrs.reserve(output.size());
+    for (auto& o : output) {
+        ptrs.push_back(o.data());
+    }
+    return ptrs;
+}
+
+template<bool ROW, typename Output, typename T, typename IDX>
+std::vector<std::vector<Output> > compute_quantiles(const Matrix<T, IDX>* p, const std::vector<double>& probs, int threads) {
+    size_t dim = (ROW ? p->nrow() : p->ncol());
+    std::vector<std::vector<Output> > output(probs.size(), std::vector<Output>(dim));
+    stats::QuantileFactory factory(quantile_pointers(output), (ROW ? p->ncol() : p->nrow()), probs);
+    apply<ROW ? 0 : 1>(p, factory, threads);
+    return output;
+}
+
+template<bool ROW, typename Output, typename T, typename IDX>
+std::vector<std::vector<Output> > compute_approximate_quantiles(const Matrix<T, IDX>* p, const std::vector<double>& probs, int threads, size_t k) {
+    size_t dim = (ROW ? p->nrow() : p->ncol());
+    std::vector<std::vector<Output> > output(probs.size(), std::vector<Output>(dim));
+    stats::ApproximateQuantileFactory factory(quantile_pointers(output), dim, (ROW ? p->ncol() : p->nrow()), probs, k);
+    apply<ROW ? 0 : 1>(p, factory, threads);
+    return output;
+}
+
+/**
+ * @endcond
+ */
+
+}
+
+/**
+ * Quantiles are computed by linear interpolation between order statistics, consistent with the default method in R's `quantile()` function.
+ * Order statistics are found by selection rather than sorting, with a counting-based fast path for small non-negative integers.
+ * All quantiles for a column are obtained from a single pass over the matrix, with successive selections on the same copy of each column.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param probs Probabilities of the quantiles, each in `[0, 1]`.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to `probs.size()`.
+ * Each inner vector corresponds to an entry of `probs` and has length equal to the number of columns, containing the column quantiles.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<std::vector<Output> > column_quantiles(const Matrix<T, IDX>* p, const std::vector<double>& probs, int threads = 1) {
+    return stats::compute_quantiles<false, Output>(p, probs, threads);
+}
+
+/**
+ * See `column_quantiles()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param prob Probability of the quantile, in `[0, 1]`.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of columns, containing the column quantiles.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<Output> column_quantiles(const Matrix<T, IDX>* p, double prob, int threads = 1) {
+    return std::move(stats::compute_quantiles<false, Output>(p, std::vector<double>{ prob }, threads).front());
+}
+
+/**
+ * See `column_quantiles()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param probs Probabilities of the quantiles, each in `[0, 1]`.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to `probs.size()`.
+ * Each inner vector corresponds to an entry of `probs` and has length equal to the number of rows, containing the row quantiles.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<std::vector<Output> > row_quantiles(const Matrix<T, IDX>* p, const std::vector<double>& probs, int threads = 1) {
+    return stats::compute_quantiles<true, Output>(p, probs, threads);
+}
+
+/**
+ * See `column_quantiles()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param prob Probability of the quantile, in `[0, 1]`.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of rows, containing the row quantiles.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<Output> row_quantiles(const Matrix<T, IDX>* p, double prob, int threads = 1) {
+    return std::move(stats::compute_quantiles<true, Output>(p, std::vector<double>{ prob }, threads).front());
+}
+
+/**
+ * Approximate quantiles are computed from a `stats::QuantileSketch` for each column.
+ * Unlike `column_quantiles()`, this supports running calculations, so row-major matrices can be processed in a single pass without buffering entire columns.
+ * All quantiles for a column are obtained from the same sketch.
+ * Zeros are handled implicitly, so the results are the same for dense and sparse representations of the same matrix in serial calculations.
+ * Parallel running calculations may split the rows across threads and merge the sketches, which yields slightly different approximations.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param probs Probabilities of the quantiles, each in `[0, 1]`.
+ * @param threads Number of threads to use.
+ * @param k Capacity of each sketch, see `stats::QuantileSketch`.
+ * Quantiles are exact for columns with no more than `k` non-zero values.
+ *
+ * @return A vector of length equal to `probs.size()`.
+ * Each inner vector corresponds to an entry of `probs` and has length equal to the number of columns, containing the approximate column quantiles.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<std::vector<Output> > column_approximate_quantiles(const Matrix<T, IDX>* p, const std::vector<double>& probs, int threads = 1, size_t k = 200) {
+    return stats::compute_approximate_quantiles<false, Output>(p, probs, threads, k);
+}
+
+/**
+ * See `column_approximate_quantiles()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param prob Probability of the quantile, in `[0, 1]`.
+ * @param threads Number of threads to use.
+ * @param k Capacity of each sketch, see `stats::QuantileSketch`.
+ *
+ * @return A vector of length equal to the number of columns, containing the approximate column quantiles.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<Output> column_approximate_quantiles(const Matrix<T, IDX>* p, double prob, int threads = 1, size_t k = 200) {
+    return std::move(stats::compute_approximate_quantiles<false, Output>(p, std::vector<double>{ prob }, threads, k).front());
+}
+
+/**
+ * See `column_approximate_quantiles()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param probs Probabilities of the quantiles, each in `[0, 1]`.
+ * @param threads Number of threads to use.
+ * @param k Capacity of each sketch, see `stats::QuantileSketch`.
+ *
+ * @return A vector of length equal to `probs.size()`.
+ * Each inner vector corresponds to an entry of `probs` and has length equal to the number of rows, containing the approximate row quantiles.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<std::vector<Output> > row_approximate_quantiles(const Matrix<T, IDX>* p, const std::vector<double>& probs, int threads = 1, size_t k = 200) {
+    return stats::compute_approximate_quantiles<true, Output>(p, probs, threads, k);
+}
+
+/**
+ * See `column_approximate_quantiles()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param prob Probability of the quantile, in `[0, 1]`.
+ * @param threads Number of threads to use.
+ * @param k Capacity of each sketch, see `stats::QuantileSketch`.
+ *
+ * @return A vector of length equal to the number of rows, containing the approximate row quantiles.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<Output> row_approximate_quantiles(const Matrix<T, IDX>* p, double prob, int threads = 1, size_t k = 200) {
+    return std::move(stats::compute_approximate_quantiles<true, Output>(p, std::vector<double>{ prob }, threads, k).front());
+}
+
+/**
+ * The median absolute deviation (MAD) is the median of the absolute differences between each value and the median of its column.
+ * No scaling constant is applied; multiply by 1.4826 to obtain a consistent estimator of the standard deviation for normally distributed data.
+ * For sparse matrices, the deviations of the zeros are handled implicitly.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of columns, containing the column MADs.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<Output> column_mads(const Matrix<T, IDX>* p, int threads = 1) {
+    std::vector<Output> output(p->ncol());
+    stats::MadFactory factory(output.data(), p->nrow());
+    apply<1>(p, factory, threads);
+    return output;
+}
+
+/**
+ * See `column_mads()` for details.
+ *
+ * @tparam Output Type of the output.
+ * @tparam T Type of the matrix value.
+ * @tparam IDX Type of the row/column indices.
+ *
+ * @param p Pointer to a `tatami::Matrix`.
+ * @param threads Number of threads to use.
+ *
+ * @return A vector of length equal to the number of rows, containing the row MADs.
+ */
+template<typename Output = double, typename T, typename IDX>
+std::vector<Output> row_mads(const Matrix<T, IDX>* p, int threads = 1) {
+    std::vector<Output> output(p->nrow());
+    stats::MadFactory factory(output.data(), p->ncol());
+    apply<0>(p, factory, threads);
+    return output;
+}
+
+}
+
+#endif
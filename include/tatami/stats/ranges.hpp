@@ -3,6 +3,7 @@
 
 #include "../base/Matrix.hpp"
 #include "apply.hpp"
+#include "kernels.hpp"
 #include <vector>
 #include <algorithm>
 
@@ -35,11 +36,7 @@ public:
         template<typename V>
         void compute(size_t i, const V* ptr) {
             if (otherdim) {
-                if constexpr(compute_max) {
-                    output[i] = *std::max_element(ptr, ptr + otherdim);
-                } else {
-                    output[i] = *std::min_element(ptr, ptr + otherdim);
-                }
+                output[i] = kernels::extreme<compute_max>(ptr, otherdim);
             }
         }
     private:
@@ -55,28 +52,26 @@ public:
     struct SparseDirect {
         SparseDirect(O* o, size_t d2) : output(o), otherdim(d2) {}
 
+        static constexpr bool background = true;
+
         template<typename T, typename IDX>
         void compute(size_t i, const SparseRange<T, IDX>& range) {
             if (range.number) {
-                if constexpr(compute_max) {
-                    output[i] = *std::max_element(range.value, range.value + range.number);
-                } else {
-                    output[i] = *std::min_element(range.value, range.value + range.number);
-                }
+                output[i] = kernels::extreme<compute_max>(range.value, range.number);
 
                 if (range.number != otherdim) {
                     if constexpr(compute_max) {
-                        if (output[i] < 0) {
-                            output[i] = 0;
+                        if (output[i] < range.background) {
+                            output[i] = range.background;
                         }
                     } else {
-                        if (output[i] > 0) {
-                            output[i] = 0;
+                        if (output[i] > range.background) {
+                            output[i] = range.background;
                         }
                     }
                 }
             } else if (otherdim) {
-                output[i] = 0;
+                output[i] = range.background;
             }
         }
     private:
@@ -98,17 +93,7 @@ public:
                 std::copy(ptr, ptr + dim, output);
                 first = false;
             } else {
-                for (size_t d = 0; d < dim; ++d) {
-                    if constexpr(compute_max) {
-                        if (output[d] < ptr[d]) {
-                            output[d] = ptr[d];
-                        }
-                    } else {
-                        if (output[d] > ptr[d]) {
-                            output[d] = ptr[d];
-                        }
-                    }
-                }
+                kernels::running_extreme<compute_max>(output, ptr, dim);
             }
         }
 
@@ -187,6 +172,81 @@ public:
     SparseRunning sparse_running(size_t start, size_t end) {
         return SparseRunning(output, dim, otherdim, start, end);
     }
+public:
+    struct RunningPartial {
+        RunningPartial(O* o, size_t d1, size_t d2) : output(o), otherdim(d2), values(d1), collected(d1) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            for (size_t d = 0, end = values.size(); d < end; ++d) {
+                update(d, ptr[d], 1);
+            }
+        }
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            for (size_t j = 0; j < range.number; ++j) {
+                update(range.index[j], range.value[j], 1);
+            }
+        }
+
+        void merge(const RunningPartial& other) {
+            for (size_t d = 0, end = values.size(); d < end; ++d) {
+                if (other.collected[d]) {
+                    update(d, other.values[d], other.collected[d]);
+                }
+            }
+        }
+
+        void finish() {
+            for (size_t d = 0, end = values.size(); d < end; ++d) {
+                auto& current = output[d];
+                current = values[d]; // values are zero-initialized, so this is correct if nothing was collected.
+                if (collected[d] < otherdim) {
+                    if constexpr(compute_max) {
+                        if (current < 0) {
+                            current = 0;
+                        }
+                    } else {
+                        if (current > 0) {
+                            current = 0;
+                        }
+                    }
+                }
+            }
+        }
+    private:
+        O* output;
+        size_t otherdim;
+        std::vector<O> values;
+        std::vector<size_t> collected;
+
+        void update(size_t d, O val, size_t n) {
+            auto& existing = values[d];
+            if (collected[d] == 0) {
+                existing = val;
+            } else {
+                if constexpr(compute_max) {
+                    if (existing < val) {
+                        existing = val;
+                    }
+                } else {
+                    if (existing > val) {
+                        existing = val;
+                    }
+                }
+            }
+            collected[d] += n;
+        }
+    };
+
+    RunningPartial dense_running_partial() {
+        return RunningPartial(output, dim, otherdim);
+    }
+
+    RunningPartial sparse_running_partial() {
+        return RunningPartial(output, dim, otherdim);
+    }
 };
 
 template<typename O>
@@ -310,6 +370,8 @@ public:
     struct SparseDirect {
         SparseDirect(typename MinFactory<O>::SparseDirect mn, typename MaxFactory<O>::SparseDirect mx) : mins(std::move(mn)), maxs(std::move(mx)) {}
 
+        static constexpr bool background = true;
+
         template<typename T, typename IDX>
         void compute(size_t i, const SparseRange<T, IDX>& range) {
             mins.compute(i, range);
@@ -378,6 +440,43 @@ public:
     SparseRunning sparse_running(size_t start, size_t end) {
         return SparseRunning(mins.sparse_running(start, end), maxs.sparse_running(start, end));
     }
+public:
+    struct RunningPartial {
+        RunningPartial(typename MinFactory<O>::RunningPartial mn, typename MaxFactory<O>::RunningPartial mx) : mins(std::move(mn)), maxs(std::move(mx)) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            mins.add(ptr);
+            maxs.add(ptr);
+        }
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            mins.add(range);
+            maxs.add(range);
+        }
+
+        void merge(const RunningPartial& other) {
+            mins.merge(other.mins);
+            maxs.merge(other.maxs);
+        }
+
+        void finish() {
+            mins.finish();
+            maxs.finish();
+        }
+    private:
+        typename MinFactory<O>::RunningPartial mins;
+        typename MaxFactory<O>::RunningPartial maxs;
+    };
+
+    RunningPartial dense_running_partial() {
+        return RunningPartial(mins.dense_running_partial(), maxs.dense_running_partial());
+    }
+
+    RunningPartial sparse_running_partial() {
+        return RunningPartial(mins.sparse_running_partial(), maxs.sparse_running_partial());
+    }
 };
 /**
  * @endcond
@@ -3,8 +3,9 @@
 
 #include "../base/Matrix.hpp"
 #include "apply.hpp"
+#include "kernels.hpp"
 #include <vector>
-#include <numeric>
+#include <algorithm>
 
 /**
  * @file sums.hpp
@@ -31,7 +32,7 @@ public:
 
         template<typename V>
         void compute(size_t i, const V* ptr) {
-            output[i] = std::accumulate(ptr, ptr + otherdim, static_cast<O>(0));
+            output[i] = kernels::sum<O>(ptr, otherdim);
         }
     private:
         O* output;
@@ -44,18 +45,24 @@ public:
 
 public:
     struct SparseDirect {
-        SparseDirect(O* o) : output(o) {}
+        SparseDirect(O* o, size_t d2) : output(o), otherdim(d2) {}
+
+        static constexpr bool background = true;
 
         template<typename T, typename IDX>
         void compute(size_t i, const SparseRange<T, IDX>& range) {
-            output[i] = std::accumulate(range.value, range.value + range.number, static_cast<O>(0));
+            output[i] = kernels::sum<O>(range.value, range.number);
+            if (range.number < otherdim) {
+                output[i] += static_cast<O>(range.background) * (otherdim - range.number);
+            }
         }
     private:
         O* output;
+        size_t otherdim;
     };
 
     SparseDirect sparse_direct() {
-        return SparseDirect(output);
+        return SparseDirect(output, otherdim);
     }
 
 public:
@@ -64,9 +71,7 @@ public:
 
         template<typename V>
         void add(const V* ptr) {
-            for (size_t d = 0; d < dim; ++d) {
-                output[d] += ptr[d];
-            }
+            kernels::running_sum(output, ptr, dim);
         }
 
         void finish() {}
@@ -106,6 +111,41 @@ public:
     SparseRunning sparse_running(size_t start, size_t end) {
         return SparseRunning(output);
     }
+public:
+    struct RunningPartial {
+        RunningPartial(O* o, size_t d1) : output(o), sums(d1) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            kernels::running_sum(sums.data(), ptr, sums.size());
+        }
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            for (size_t j = 0; j < range.number; ++j) {
+                sums[range.index[j]] += range.value[j];
+            }
+        }
+
+        void merge(const RunningPartial& other) {
+            kernels::running_sum(sums.data(), other.sums.data(), sums.size());
+        }
+
+        void finish() {
+            std::copy(sums.begin(), sums.end(), output);
+        }
+    private:
+        O* output;
+        std::vector<O> sums;
+    };
+
+    RunningPartial dense_running_partial() {
+        return RunningPartial(output, dim);
+    }
+
+    RunningPartial sparse_running_partial() {
+        return RunningPartial(output, dim);
+    }
 };
 
 }
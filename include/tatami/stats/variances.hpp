@@ -3,11 +3,12 @@
 
 #include "../base/Matrix.hpp"
 #include "apply.hpp"
+#include "kernels.hpp"
 
 #include <vector>
 #include <cmath>
-#include <numeric>
 #include <limits>
+#include <algorithm>
 
 /**
  * @file variances.hpp
@@ -63,11 +64,8 @@ std::pair<O, O> compute_direct(const T* ptr, size_t n) {
         return both_NaN<O>();
     }
 
-    O mean = std::accumulate(ptr, ptr + n, static_cast<O>(0))/n;
-    O var = 0;
-    for (size_t j = 0; j < n; ++j, ++ptr) {
-        var += (*ptr - mean) * (*ptr - mean);
-    }
+    O mean = kernels::sum<O>(ptr, n)/n;
+    O var = kernels::squared_deviations<O>(ptr, n, mean);
 
     return std::make_pair(mean, finish_variance_direct(var, n));
 }
@@ -81,6 +79,7 @@ std::pair<O, O> compute_direct(const T* ptr, size_t n) {
  * @tparam IDX Type of the indices.
  *
  * @param range A `SparseRange` object specifying the number and values of all non-zero indices.
+ * All other elements are assumed to be equal to `range.background`.
  * @param n Total length of the vector, including zero values.
  *
  * @return The sample mean and variance of values in the vector.
@@ -92,12 +91,20 @@ std::pair<O, O> compute_direct(const SparseRange<T, IDX>& range, size_t n) {
         return both_NaN<O>();
     }
 
-    O mean = std::accumulate(range.value, range.value + range.number, static_cast<O>(0))/n;
-    O var = 0;
-    for (size_t j = 0; j < range.number; ++j) {
-        var += (range.value[j] - mean) * (range.value[j] - mean);
+    // All unlisted elements are equal to the background, which is usually zero.
+    // We skip them entirely if there are none, in case the background is not finite.
+    size_t unlisted = n - range.number;
+    O mean = kernels::sum<O>(range.value, range.number);
+    if (unlisted) {
+        mean += static_cast<O>(range.background) * unlisted;
+    }
+    mean /= n;
+
+    O var = kernels::squared_deviations<O>(range.value, range.number, mean);
+    if (unlisted) {
+        O delta = range.background - mean;
+        var += delta * delta * unlisted;
     }
-    var += mean * mean * (n - range.number);
 
     return std::make_pair(mean, finish_variance_direct(var, n));
 }
@@ -122,11 +129,7 @@ std::pair<O, O> compute_direct(const SparseRange<T, IDX>& range, size_t n) {
 template<typename T, typename O>
 void compute_running(const T* ptr, size_t n, O* means, O* vars, int& count) { 
     ++count;
-    for (size_t i = 0; i < n; ++i, ++means, ++vars, ++ptr) {
-        const double delta=*ptr - *means;
-        *means += delta/count;
-        *vars += delta*(*ptr - *means);
-    }
+    kernels::running_welford(ptr, n, means, vars, count);
 }
 
 /**
@@ -145,16 +148,18 @@ void compute_running(const T* ptr, size_t n, O* means, O* vars, int& count) {
  * @param[out] vars Pointer to an array containing the running sum of squared differences from the mean for each target vector.
  * @param[out] nonzeros Pointer to an array containing the running number of non-zero values for each target vector.
  * @param count Number of times this function has already been called.
+ * @param offset Offset to subtract from each index in `range` before using it to access `means`, `vars` and `nonzeros`.
+ * This is typically the start of the current chunk when `range` only contains indices within that chunk.
  *
  * @return `means` and `vars` are updated with the corresponding elements from `range`.
  * `count` is incremented by 1.
  */
 template<typename T, typename IDX, typename O, typename Nz>
-void compute_running(const SparseRange<T, IDX>& range, O* means, O* vars, Nz* nonzeros, int& count) {
+void compute_running(const SparseRange<T, IDX>& range, O* means, O* vars, Nz* nonzeros, int& count, size_t offset = 0) {
     ++count;
     for (size_t j = 0; j < range.number; ++j) {
         if (range.value[j]) { // skip observed zeros so 'nonzeros' is what it says.
-            auto ri = range.index[j];
+            size_t ri = range.index[j] - offset;
             auto& curM = means[ri];
             auto& curS = vars[ri];
             auto& curNZ = nonzeros[ri];
@@ -196,22 +201,22 @@ void finish_running(size_t n, O* means, O* vars, int count) {
 }
 
 /**
- * Finish the running variance calculations from `compute_running()` with sparse inputs.
+ * Convert the running statistics from `compute_running()` with sparse inputs, so that they account for the zeros in each target vector.
+ * This yields the same running statistics as `compute_running()` with dense inputs, e.g., for use in `merge_running()`.
  *
  * @tparam O Type of the output data.
  * @tparam Nz Type fo the non-zero counts.
  *
  * @param n Number of target vectors.
- * @param[out] means Pointer to an array containing the running means for each target vector.
- * @param[out] vars Pointer to an array containing the running sum of squared differences from the mean for each target vector.
- * @param[out] nonzeros Pointer to an array containing the running number of non-zero values for each target vector.
+ * @param[out] means Pointer to an array containing the running means of the non-zero values for each target vector.
+ * @param[out] vars Pointer to an array containing the running sum of squared differences of the non-zero values for each target vector.
+ * @param[in] nonzeros Pointer to an array containing the running number of non-zero values for each target vector.
  * @param count Number of times the `compute_running()` function was called.
  *
- * @return Elements in `vars` are divided by `count - 1`.
- * For low values of `count`, `means` and/or `vars` may be filled with NaNs.
+ * @return `means` and `vars` are updated to the running mean and sum of squared differences of all values in each target vector.
  */
 template<typename O, typename Nz>
-void finish_running(size_t n, O* means, O* vars, Nz* nonzeros, int count) {
+void convert_running_nonzeros(size_t n, O* means, O* vars, const Nz* nonzeros, int count) {
     if (count) {
         for (size_t i = 0; i < n; ++i) {
             const double curNZ = nonzeros[i];
@@ -221,9 +226,68 @@ void finish_running(size_t n, O* means, O* vars, Nz* nonzeros, int count) {
             curM *= ratio;
         }
     }
+}
+
+/**
+ * Finish the running variance calculations from `compute_running()` with sparse inputs.
+ *
+ * @tparam O Type of the output data.
+ * @tparam Nz Type fo the non-zero counts.
+ *
+ * @param n Number of target vectors.
+ * @param[out] means Pointer to an array containing the running means for each target vector.
+ * @param[out] vars Pointer to an array containing the running sum of squared differences from the mean for each target vector.
+ * @param[out] nonzeros Pointer to an array containing the running number of non-zero values for each target vector.
+ * @param count Number of times the `compute_running()` function was called.
+ *
+ * @return Elements in `vars` are divided by `count - 1`.
+ * For low values of `count`, `means` and/or `vars` may be filled with NaNs.
+ */
+template<typename O, typename Nz>
+void finish_running(size_t n, O* means, O* vars, Nz* nonzeros, int count) {
+    convert_running_nonzeros(n, means, vars, nonzeros, count);
     finish_running(n, means, vars, count);
 }
 
+/**
+ * Merge two sets of running statistics from `compute_running()` using Chan's parallel algorithm.
+ * This is used to combine the statistics computed from different subsets of running vectors, e.g., in different threads.
+ *
+ * @tparam O Type of the output data.
+ *
+ * @param n Number of target vectors.
+ * @param[out] means Pointer to an array containing the running means for each target vector.
+ * @param[out] vars Pointer to an array containing the running sum of squared differences from the mean for each target vector.
+ * @param count Number of times the `compute_running()` function was called to compute `means` and `vars`.
+ * @param[in] other_means Pointer to an array containing the running means for each target vector from another set of running vectors.
+ * @param[in] other_vars Pointer to an array containing the running sum of squared differences for each target vector from another set of running vectors.
+ * @param other_count Number of times the `compute_running()` function was called to compute `other_means` and `other_vars`.
+ *
+ * @return `means` and `vars` are updated to contain the statistics for the union of both sets of running vectors.
+ * `count` is incremented by `other_count`.
+ * For sparse data, both sets of statistics should first be processed with `convert_running_nonzeros()`.
+ */
+template<typename O>
+void merge_running(size_t n, O* means, O* vars, int& count, const O* other_means, const O* other_vars, int other_count) {
+    if (other_count == 0) {
+        return;
+    }
+
+    if (count == 0) {
+        std::copy(other_means, other_means + n, means);
+        std::copy(other_vars, other_vars + n, vars);
+    } else {
+        const double total = count + other_count;
+        for (size_t i = 0; i < n; ++i) {
+            const double delta = other_means[i] - means[i];
+            means[i] += delta * other_count / total;
+            vars[i] += other_vars[i] + delta * delta * count * other_count / total;
+        }
+    }
+
+    count += other_count;
+}
+
 }
 
 template<typename O = double>
@@ -256,6 +320,8 @@ public:
     struct SparseDirect {
         SparseDirect(O* o, size_t d2) : output(o), otherdim(d2) {}
 
+        static constexpr bool background = true;
+
         template<typename T, typename IDX>
         void compute(size_t i, const SparseRange<T, IDX>& range) {
             output[i] = variances::compute_direct<O>(range, otherdim).second;
@@ -323,6 +389,75 @@ public:
     SparseRunning sparse_running(size_t start, size_t end) {
         return SparseRunning(output, dim, start, end);
     }
+
+public:
+    struct DenseRunningPartial {
+        DenseRunningPartial(O* o, size_t d1) : output(o), dim(d1), running_means(d1), running_vars(d1) {}
+
+        template<typename V>
+        void add(const V* ptr) {
+            variances::compute_running(ptr, dim, running_means.data(), running_vars.data(), counter);
+        }
+
+        void merge(const DenseRunningPartial& other) {
+            variances::merge_running(dim, running_means.data(), running_vars.data(), counter, other.running_means.data(), other.running_vars.data(), other.counter);
+        }
+
+        void finish() {
+            variances::finish_running(dim, running_means.data(), running_vars.data(), counter);
+            std::copy(running_vars.begin(), running_vars.end(), output);
+        }
+    private:
+        O* output;
+        size_t dim;
+        std::vector<O> running_means, running_vars;
+        int counter = 0;
+    };
+
+    DenseRunningPartial dense_running_partial() {
+        return DenseRunningPartial(output, dim);
+    }
+
+public:
+    struct SparseRunningPartial {
+        SparseRunningPartial(O* o, size_t d1) : output(o), dim(d1), running_means(d1), running_vars(d1), running_nzeros(d1) {}
+
+        template<typename T, typename IDX>
+        void add(const SparseRange<T, IDX>& range) {
+            variances::compute_running(range, running_means.data(), running_vars.data(), running_nzeros.data(), counter);
+        }
+
+        void merge(SparseRunningPartial& other) {
+            convert();
+            other.convert();
+            variances::merge_running(dim, running_means.data(), running_vars.data(), counter, other.running_means.data(), other.running_vars.data(), other.counter);
+        }
+
+        void finish() {
+            convert();
+            variances::finish_running(dim, running_means.data(), running_vars.data(), counter);
+            std::copy(running_vars.begin(), running_vars.end(), output);
+        }
+    private:
+        O* output;
+        size_t dim;
+        std::vector<O> running_means, running_vars;
+        std::vector<int> running_nzeros;
+        int counter = 0;
+        bool converted = false;
+
+        // Accounting for the zeros, so that we can merge with other partial states.
+        void convert() {
+            if (!converted) {
+                variances::convert_running_nonzeros(dim, running_means.data(), running_vars.data(), running_nzeros.data(), counter);
+                converted = true;
+            }
+        }
+    };
+
+    SparseRunningPartial sparse_running_partial() {
+        return SparseRunningPartial(output, dim);
+    }
 };
 
 }
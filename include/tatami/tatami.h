@@ -15,10 +15,14 @@
 #include "utils/wrap_shared_ptr.hpp"
 #include "utils/NakedArray.hpp"
 #include "utils/bind_intersection.hpp"
+#include "utils/ThreadPool.hpp"
 
 #include "stats/sums.hpp"
 #include "stats/variances.hpp"
 #include "stats/medians.hpp"
+#include "stats/quantiles.hpp"
+#include "stats/counts.hpp"
+#include "stats/grouped.hpp"
 
 #define TATAMI_VERSION_MAJOR 0
 #define TATAMI_VERSION_MINOR 99
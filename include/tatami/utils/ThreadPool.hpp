@@ -0,0 +1,198 @@
+#ifndef TATAMI_THREAD_POOL_HPP
+#define TATAMI_THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+
+/**
+ * @file ThreadPool.hpp
+ *
+ * @brief Persistent pool of threads for parallel calculations.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Persistent pool of threads for parallel calculations.
+ *
+ * This provides an alternative to OpenMP or `TATAMI_CUSTOM_PARALLEL` for `apply()`, `convert_to_dense()` and `convert_to_sparse()`.
+ * The worker threads are created once in the constructor and are re-used across calls,
+ * avoiding the cost of starting a new parallel region for each call on many small matrices.
+ * A single pool can be shared between multiple callers in different threads, who will then compete for the same workers;
+ * this caps the total number of threads that are used by **tatami** in an application.
+ *
+ * Calls to `run()` can be safely nested, e.g., when `apply()` is called inside a factory that is itself being run by `apply()` on the same pool.
+ * In such cases, the nested jobs are executed serially in the calling worker to avoid deadlocks and oversubscription.
+ *
+ * Note that file-backed matrices may need to serialize access to the file across threads.
+ * For example, callers should define `TATAMI_HDF5_PARALLEL_LOCK` when using a pool with the HDF5-backed matrices in a build without OpenMP.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param n Number of worker threads.
+     * If this is less than 1, no worker threads are created and all jobs are executed by the calling thread.
+     */
+    ThreadPool(int n) {
+        for (int i = 0; i < n; ++i) {
+            workers.emplace_back([this]() -> void { work(); });
+        }
+    }
+
+    /**
+     * Waits for all queued jobs to finish before joining the worker threads.
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lck(queue_lock);
+            stopping = true;
+        }
+        queue_cv.notify_all();
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    /**
+     * @cond
+     */
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    /**
+     * @endcond
+     */
+
+public:
+    /**
+     * @return Number of threads available for each call to `run()`.
+     * This is always at least 1 as the calling thread participates in the calculations.
+     */
+    int num_threads() const {
+        return (workers.empty() ? 1 : workers.size());
+    }
+
+    /**
+     * Run a series of jobs across the pool, blocking until all jobs are complete.
+     * The calling thread also executes queued jobs while it waits.
+     * If any job throws an exception, the first exception is re-thrown in the calling thread once all jobs have finished.
+     *
+     * @tparam Function Function to run in each job.
+     * This should accept the job index as a `size_t`.
+     *
+     * @param n Number of jobs.
+     * @param f Function to run for each job.
+     */
+    template<class Function>
+    void run(size_t n, Function f) {
+        if (n == 0) {
+            return;
+        }
+
+        // Running serially if we're already inside a worker, to avoid deadlocks
+        // from workers waiting on jobs that can never be picked up.
+        if (n == 1 || workers.empty() || current_pool() != nullptr) {
+            for (size_t j = 0; j < n; ++j) {
+                f(j);
+            }
+            return;
+        }
+
+        auto batch = std::make_shared<Batch>();
+        batch->remaining = n;
+
+        {
+            std::lock_guard<std::mutex> lck(queue_lock);
+            for (size_t j = 0; j < n; ++j) {
+                queue.emplace_back([batch, j, &f]() -> void {
+                    try {
+                        f(j);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> blck(batch->lock);
+                        if (!batch->error) {
+                            batch->error = std::current_exception();
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> blck(batch->lock);
+                    if (--(batch->remaining) == 0) {
+                        batch->cv.notify_all();
+                    }
+                });
+            }
+        }
+        queue_cv.notify_all();
+
+        // Helping out with the queue, which may contain jobs from other callers.
+        while (1) {
+            std::function<void()> job;
+            {
+                std::lock_guard<std::mutex> lck(queue_lock);
+                if (queue.empty()) {
+                    break;
+                }
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            execute(job);
+        }
+
+        std::unique_lock<std::mutex> blck(batch->lock);
+        batch->cv.wait(blck, [&]() -> bool { return batch->remaining == 0; });
+        if (batch->error) {
+            std::rethrow_exception(batch->error);
+        }
+    }
+
+private:
+    struct Batch {
+        std::mutex lock;
+        std::condition_variable cv;
+        size_t remaining = 0;
+        std::exception_ptr error;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()> > queue;
+    std::mutex queue_lock;
+    std::condition_variable queue_cv;
+    bool stopping = false;
+
+    static const ThreadPool*& current_pool() {
+        thread_local const ThreadPool* ptr = nullptr;
+        return ptr;
+    }
+
+    void execute(std::function<void()>& job) {
+        auto& current = current_pool();
+        auto previous = current;
+        current = this;
+        job();
+        current = previous;
+    }
+
+    void work() {
+        while (1) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lck(queue_lock);
+                queue_cv.wait(lck, [&]() -> bool { return stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            execute(job);
+        }
+    }
+};
+
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define TATAMI_CONVERT_TO_DENSE_H
 
 #include "../base/DenseMatrix.hpp"
+#include "../stats/parallelize.hpp"
+#include "ThreadPool.hpp"
 
 #include <memory>
 #include <vector>
@@ -16,18 +18,10 @@
 namespace tatami {
 
 /**
- * @tparam row_ Whether to return a row-major matrix.
- * @tparam MatrixIn Input matrix class, most typically a `tatami::Matrix`.
- * @tparam Data Type of data values in the output interface.
- * @tparam Index Integer type for the indices in the output interface.
- *
- * @param incoming Pointer to a `tatami::Matrix`.
- *
- * @return A pointer to a new `tatami::DenseMatrix` with the same dimensions and type as the matrix referenced by `incoming`.
- * If `row = true`, the matrix is row-major, otherwise it is column-major.
+ * @cond
  */
-template <bool row_, class MatrixIn, typename DataOut = typename MatrixIn::data_type, typename IndexOut = typename MatrixIn::index_type>
-inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_dense(const MatrixIn* incoming) {
+template <bool row_, typename DataOut, typename IndexOut, class MatrixIn, class Threads>
+std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_dense_internal(const MatrixIn* incoming, Threads& threads) {
     size_t NR = incoming->nrow();
     size_t NC = incoming->ncol();
     size_t primary = (row_ ? NR : NC);
@@ -35,53 +29,103 @@ inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_dense(const Matrix
 
     typedef typename MatrixIn::data_type DataIn;
     std::vector<DataOut> buffer(NR * NC);
-    std::vector<DataIn> temp(secondary);
 
     if (row_ == incoming->prefer_rows()) {
-        auto bptr = buffer.data();
-        auto wrk = incoming->new_workspace(row_);
-        
-        for (size_t p = 0; p < primary; ++p, bptr += secondary) {
-            if constexpr(std::is_same<DataIn, DataOut>::value) {
-                if constexpr(row_) {
-                    incoming->row_copy(p, bptr, wrk.get());
-                } else {
-                    incoming->column_copy(p, bptr, wrk.get());
-                }
-            } else {
-                const DataIn* ptr;
-                if constexpr(row_) {
-                    ptr = incoming->row(p, temp.data(), wrk.get());
-                } else {
-                    ptr = incoming->column(p, temp.data(), wrk.get());
+        stats::parallelize_chunks(primary, threads, APPLY_SCHEDULE_STATIC, [&](stats::WorkerChunks& chunks) -> void {
+            std::vector<DataIn> temp(secondary);
+            size_t start, end;
+            while (chunks.next(start, end)) {
+                auto bptr = buffer.data() + start * secondary;
+                auto wrk = incoming->new_workspace(row_);
+
+                for (size_t p = start; p < end; ++p, bptr += secondary) {
+                    if constexpr(std::is_same<DataIn, DataOut>::value) {
+                        if constexpr(row_) {
+                            incoming->row_copy(p, bptr, wrk.get());
+                        } else {
+                            incoming->column_copy(p, bptr, wrk.get());
+                        }
+                    } else {
+                        const DataIn* ptr;
+                        if constexpr(row_) {
+                            ptr = incoming->row(p, temp.data(), wrk.get());
+                        } else {
+                            ptr = incoming->column(p, temp.data(), wrk.get());
+                        }
+                        std::copy(ptr, ptr + secondary, bptr);
+                    }
                 }
-                std::copy(ptr, ptr + secondary, bptr);
             }
-        }
+        });
 
     } else {
         // We iterate on the incoming matrix's preferred dimension,
         // under the assumption that it may be arbitrarily costly to
         // extract in the non-preferred dim; it is thus cheaper to
         // do cache-unfriendly inserts into the output buffer.
-        auto wrk = incoming->new_workspace(!row_);
-        for (size_t s = 0; s < secondary; ++s) {
-            const DataIn* ptr;
-            if constexpr(row_) {
-                ptr = incoming->column(s, temp.data(), wrk.get());
-            } else {
-                ptr = incoming->row(s, temp.data(), wrk.get());
-            }
+        // Each worker handles a different set of preferred vectors,
+        // so they never write to the same position in the buffer.
+        stats::parallelize_chunks(secondary, threads, APPLY_SCHEDULE_STATIC, [&](stats::WorkerChunks& chunks) -> void {
+            std::vector<DataIn> temp(primary);
+            size_t start, end;
+            while (chunks.next(start, end)) {
+                auto wrk = incoming->new_workspace(!row_);
+                for (size_t s = start; s < end; ++s) {
+                    const DataIn* ptr;
+                    if constexpr(row_) {
+                        ptr = incoming->column(s, temp.data(), wrk.get());
+                    } else {
+                        ptr = incoming->row(s, temp.data(), wrk.get());
+                    }
 
-            auto bptr = buffer.begin() + s;
-            for (size_t p = 0; p < primary; ++p, bptr += secondary) {
-                *bptr = ptr[p]; 
+                    auto bptr = buffer.begin() + s;
+                    for (size_t p = 0; p < primary; ++p, bptr += secondary) {
+                        *bptr = ptr[p]; 
+                    }
+                }
             }
-        }
+        });
     }
 
     return std::shared_ptr<Matrix<DataOut, IndexOut> >(new DenseMatrix<row_, DataOut, IndexOut>(NR, NC, std::move(buffer)));
 }
+/**
+ * @endcond
+ */
+
+/**
+ * @tparam row_ Whether to return a row-major matrix.
+ * @tparam MatrixIn Input matrix class, most typically a `tatami::Matrix`.
+ * @tparam Data Type of data values in the output interface.
+ * @tparam Index Integer type for the indices in the output interface.
+ *
+ * @param incoming Pointer to a `tatami::Matrix`.
+ * @param threads Number of threads to use, see `apply()` for details on parallelization.
+ *
+ * @return A pointer to a new `tatami::DenseMatrix` with the same dimensions and type as the matrix referenced by `incoming`.
+ * If `row = true`, the matrix is row-major, otherwise it is column-major.
+ */
+template <bool row_, class MatrixIn, typename DataOut = typename MatrixIn::data_type, typename IndexOut = typename MatrixIn::index_type>
+inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_dense(const MatrixIn* incoming, int threads = 1) {
+    return convert_to_dense_internal<row_, DataOut, IndexOut>(incoming, threads);
+}
+
+/**
+ * @tparam row_ Whether to return a row-major matrix.
+ * @tparam MatrixIn Input matrix class, most typically a `tatami::Matrix`.
+ * @tparam Data Type of data values in the output interface.
+ * @tparam Index Integer type for the indices in the output interface.
+ *
+ * @param incoming Pointer to a `tatami::Matrix`.
+ * @param pool Pool of threads to use for extraction.
+ *
+ * @return A pointer to a new `tatami::DenseMatrix` with the same dimensions and type as the matrix referenced by `incoming`.
+ * If `row = true`, the matrix is row-major, otherwise it is column-major.
+ */
+template <bool row_, class MatrixIn, typename DataOut = typename MatrixIn::data_type, typename IndexOut = typename MatrixIn::index_type>
+inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_dense(const MatrixIn* incoming, ThreadPool& pool) {
+    return convert_to_dense_internal<row_, DataOut, IndexOut>(incoming, pool);
+}
 
 /**
  * This overload makes it easier to control the desired output order when it is not known at compile time.
@@ -93,18 +137,19 @@ inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_dense(const Matrix
  * @param incoming Pointer to a `tatami::Matrix`.
  * @param order Ordering of values in the output dense matrix - row-major (0) or column-major (1).
  * If set to -1, the ordering is chosen based on `tatami::Matrix::prefer_rows()`. 
+ * @param threads Number of threads to use.
  *
  * @return A pointer to a new `tatami::DenseMatrix` with the same dimensions and type as the matrix referenced by `incoming`.
  */
 template <class MatrixIn, typename DataOut = typename MatrixIn::data_type, typename IndexOut = typename MatrixIn::index_type>
-std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_dense(const MatrixIn* incoming, int order) {
+std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_dense(const MatrixIn* incoming, int order, int threads = 1) {
     if (order < 0) {
         order = static_cast<int>(!incoming->prefer_rows()); 
     }
     if (order == 0) {
-        return convert_to_dense<true, MatrixIn, DataOut, IndexOut>(incoming);
+        return convert_to_dense<true, MatrixIn, DataOut, IndexOut>(incoming, threads);
     } else {
-        return convert_to_dense<false, MatrixIn, DataOut, IndexOut>(incoming);
+        return convert_to_dense<false, MatrixIn, DataOut, IndexOut>(incoming, threads);
     }
 }
 
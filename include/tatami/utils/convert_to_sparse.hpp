@@ -2,10 +2,13 @@
 #define TATAMI_CONVERT_TO_SPARSE_H
 
 #include "../base/CompressedSparseMatrix.hpp"
+#include "../stats/parallelize.hpp"
+#include "ThreadPool.hpp"
 
 #include <memory>
 #include <vector>
 #include <deque>
+#include <algorithm>
 
 /**
  * @file convert_to_sparse.hpp
@@ -16,20 +19,10 @@
 namespace tatami {
 
 /**
- * @tparam row_ Whether to return a compressed sparse row matrix.
- * @tparam MatrixIn Input matrix class, most typically a `tatami::Matrix`.
- * @tparam Data Type of data values in the output interface.
- * @tparam Index Integer type for the indices in the output interface.
- *
- * @param incoming Pointer to a `tatami::Matrix`, possibly containing delayed operations.
- * @param reserve The expected density of non-zero values in `incoming`.
- * A slight overestimate will avoid reallocation of the temporary vectors.
- *
- * @return A pointer to a new `tatami::CompressedSparseMatrix`, with the same dimensions and type as the matrix referenced by `incoming`.
- * If `row = true`, the matrix is compressed sparse row, otherwise it is compressed sparse column.
+ * @cond
  */
-template <bool row_, class MatrixIn, typename DataOut = typename MatrixIn::data_type, typename IndexOut = typename MatrixIn::index_type>
-inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const MatrixIn* incoming, double reserve = 0.1) {
+template <bool row_, typename DataOut, typename IndexOut, class MatrixIn, class Threads>
+std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse_internal(const MatrixIn* incoming, double reserve, Threads& threads) {
     size_t NR = incoming->nrow();
     size_t NC = incoming->ncol();
     size_t primary = (row_ ? NR : NC);
@@ -42,8 +35,11 @@ inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const Matri
     typedef typename MatrixIn::data_type DataIn; 
     typedef typename MatrixIn::index_type IndexIn; 
 
-    if (row_ == incoming->prefer_rows()) {
-        size_t reservation = static_cast<double>(NR * NC) * reserve;
+    if (row_ == incoming->prefer_rows() && stats::count_threads(threads) <= 1) {
+        size_t reservation;
+        if (!incoming->nonzero_count(reservation)) {
+            reservation = static_cast<double>(NR * NC) * reserve;
+        }
         output_v.reserve(reservation);
         output_i.reserve(reservation);
 
@@ -92,55 +88,89 @@ inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const Matri
         }
 
     } else {
-        // We iterate on the incoming matrix's preferred dimension, under the
-        // assumption that it may be arbitrarily costly to extract in the
-        // non-preferred dim; it is thus cheaper to do cache-unfriendly inserts
-        // into the output buffer. In this case, there's not much choice but to
-        // make extensible vectors for each primary dimension.
+        // We make extensible vectors for each primary dimension element,
+        // so that each worker can fill its own elements independently.
         std::vector<std::vector<DataOut> > store_v(primary);
-        std::vector<std::vector<DataOut> > store_i(primary);
-        size_t reservation = secondary * reserve;
+        std::vector<std::vector<IndexOut> > store_i(primary);
+        std::vector<size_t> reservations(primary);
+        if (!incoming->nonzero_counts(row_, reservations.data())) {
+            std::fill(reservations.begin(), reservations.end(), static_cast<size_t>(secondary * reserve));
+        }
         for (size_t p = 0; p < primary; ++p) {
-            store_v[p].reserve(reservation);
-            store_i[p].reserve(reservation);
+            store_v[p].reserve(reservations[p]);
+            store_i[p].reserve(reservations[p]);
         }
 
-        auto wrk = incoming->new_workspace(!row_);
-        std::vector<DataIn> buffer_v(primary);
+        if (row_ == incoming->prefer_rows()) {
+            stats::parallelize_chunks(primary, threads, APPLY_SCHEDULE_STATIC, [&](stats::WorkerChunks& chunks) -> void {
+                std::vector<DataIn> buffer_v(secondary);
+                std::vector<IndexIn> buffer_i(secondary);
 
-        if (incoming->sparse()) {
-            std::vector<IndexIn> buffer_i(primary);
-            for (size_t s = 0; s < secondary; ++s) {
-                SparseRange<DataIn, IndexIn> range;
-                if constexpr(row_) {
-                    range = incoming->sparse_column(s, buffer_v.data(), buffer_i.data(), wrk.get());
-                } else {
-                    range = incoming->sparse_row(s, buffer_v.data(), buffer_i.data(), wrk.get());
-                }
-
-                for (size_t i = 0; i < range.number; ++i, ++range.value, ++range.index) {
-                    if (*range.value) {
-                        store_v[*range.index].push_back(*range.value);
-                        store_i[*range.index].push_back(s);
+                size_t start, end;
+                while (chunks.next(start, end)) {
+                    if (incoming->sparse()) {
+                        auto ext = (row_ ? incoming->sparse_row_extractor() : incoming->sparse_column_extractor());
+                        for (size_t p = start; p < end; ++p) {
+                            auto range = ext->fetch(p, buffer_v.data(), buffer_i.data());
+                            for (size_t i = 0; i < range.number; ++i, ++range.value, ++range.index) {
+                                if (*range.value) {
+                                    store_v[p].push_back(*range.value);
+                                    store_i[p].push_back(*range.index);
+                                }
+                            }
+                        }
+                    } else {
+                        auto ext = (row_ ? incoming->dense_row_extractor() : incoming->dense_column_extractor());
+                        for (size_t p = start; p < end; ++p) {
+                            auto ptr = ext->fetch(p, buffer_v.data());
+                            for (size_t s = 0; s < secondary; ++s, ++ptr) {
+                                if (*ptr) {
+                                    store_v[p].push_back(*ptr);
+                                    store_i[p].push_back(s);
+                                }
+                            }
+                        }
                     }
                 }
-            }
+            });
+
         } else {
-            for (size_t s = 0; s < secondary; ++s) {
-                const DataIn* ptr;
-                if constexpr(row_) {
-                    ptr = incoming->column(s, buffer_v.data(), wrk.get());
-                } else {
-                    ptr = incoming->row(s, buffer_v.data(), wrk.get());
-                }
+            // We iterate on the incoming matrix's preferred dimension, under the
+            // assumption that it may be arbitrarily costly to extract in the
+            // non-preferred dim; it is thus cheaper to do cache-unfriendly inserts
+            // into the output buffer. Each worker extracts the slice of every
+            // preferred vector that overlaps with its range of primary elements.
+            stats::parallelize_chunks(primary, threads, APPLY_SCHEDULE_STATIC, [&](stats::WorkerChunks& chunks) -> void {
+                size_t start, end;
+                while (chunks.next(start, end)) {
+                    std::vector<DataIn> buffer_v(end - start);
 
-                for (size_t p = 0; p < primary; ++p, ++ptr) {
-                    if (*ptr) {
-                        store_v[p].push_back(*ptr);
-                        store_i[p].push_back(s);
+                    if (incoming->sparse()) {
+                        std::vector<IndexIn> buffer_i(end - start);
+                        auto ext = (row_ ? incoming->sparse_column_extractor(start, end) : incoming->sparse_row_extractor(start, end));
+                        for (size_t s = 0; s < secondary; ++s) {
+                            auto range = ext->fetch(s, buffer_v.data(), buffer_i.data());
+                            for (size_t i = 0; i < range.number; ++i, ++range.value, ++range.index) {
+                                if (*range.value) {
+                                    store_v[*range.index].push_back(*range.value);
+                                    store_i[*range.index].push_back(s);
+                                }
+                            }
+                        }
+                    } else {
+                        auto ext = (row_ ? incoming->dense_column_extractor(start, end) : incoming->dense_row_extractor(start, end));
+                        for (size_t s = 0; s < secondary; ++s) {
+                            auto ptr = ext->fetch(s, buffer_v.data());
+                            for (size_t p = start; p < end; ++p, ++ptr) {
+                                if (*ptr) {
+                                    store_v[p].push_back(*ptr);
+                                    store_i[p].push_back(s);
+                                }
+                            }
+                        }
                     }
                 }
-            }
+            });
         }
 
         // Concatenating everything together.
@@ -160,6 +190,47 @@ inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const Matri
 
     return std::shared_ptr<Matrix<DataOut, IndexOut> >(new CompressedSparseMatrix<row_, DataOut, IndexOut>(NR, NC, std::move(output_v), std::move(output_i), std::move(indptrs)));
 }
+/**
+ * @endcond
+ */
+
+/**
+ * @tparam row_ Whether to return a compressed sparse row matrix.
+ * @tparam MatrixIn Input matrix class, most typically a `tatami::Matrix`.
+ * @tparam Data Type of data values in the output interface.
+ * @tparam Index Integer type for the indices in the output interface.
+ *
+ * @param incoming Pointer to a `tatami::Matrix`, possibly containing delayed operations.
+ * @param reserve The expected density of non-zero values in `incoming`.
+ * A slight overestimate will avoid reallocation of the temporary vectors.
+ * This is ignored if the number of non-zero elements is already known, see `Matrix::nonzero_count()` and `Matrix::nonzero_counts()`.
+ * @param threads Number of threads to use, see `apply()` for details on parallelization.
+ *
+ * @return A pointer to a new `tatami::CompressedSparseMatrix`, with the same dimensions and type as the matrix referenced by `incoming`.
+ * If `row = true`, the matrix is compressed sparse row, otherwise it is compressed sparse column.
+ */
+template <bool row_, class MatrixIn, typename DataOut = typename MatrixIn::data_type, typename IndexOut = typename MatrixIn::index_type>
+inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const MatrixIn* incoming, double reserve = 0.1, int threads = 1) {
+    return convert_to_sparse_internal<row_, DataOut, IndexOut>(incoming, reserve, threads);
+}
+
+/**
+ * @tparam row_ Whether to return a compressed sparse row matrix.
+ * @tparam MatrixIn Input matrix class, most typically a `tatami::Matrix`.
+ * @tparam Data Type of data values in the output interface.
+ * @tparam Index Integer type for the indices in the output interface.
+ *
+ * @param incoming Pointer to a `tatami::Matrix`, possibly containing delayed operations.
+ * @param reserve The expected density of non-zero values in `incoming`, see the other `convert_to_sparse()` overload.
+ * @param pool Pool of threads to use for extraction.
+ *
+ * @return A pointer to a new `tatami::CompressedSparseMatrix`, with the same dimensions and type as the matrix referenced by `incoming`.
+ * If `row = true`, the matrix is compressed sparse row, otherwise it is compressed sparse column.
+ */
+template <bool row_, class MatrixIn, typename DataOut = typename MatrixIn::data_type, typename IndexOut = typename MatrixIn::index_type>
+inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const MatrixIn* incoming, double reserve, ThreadPool& pool) {
+    return convert_to_sparse_internal<row_, DataOut, IndexOut>(incoming, reserve, pool);
+}
 
 /**
  * This overload makes it easier to control the desired output order when it is not known at compile time.
@@ -173,18 +244,19 @@ inline std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const Matri
  * @param incoming Pointer to a `tatami::Matrix`.
  * @param order Ordering of values in the output matrix - compressed sparse row (0) or column (1).
  * If set to -1, the ordering is chosen based on `tatami::Matrix::prefer_rows()`. 
+ * @param threads Number of threads to use.
  *
  * @return A pointer to a new `tatami::CompressedSparseMatrix`, with the same dimensions and type as the matrix referenced by `incoming`.
  */
 template <class MatrixIn, typename DataOut = typename MatrixIn::data_type, typename IndexOut = typename MatrixIn::index_type>
-std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const MatrixIn* incoming, int order) {
+std::shared_ptr<Matrix<DataOut, IndexOut> > convert_to_sparse(const MatrixIn* incoming, int order, int threads = 1) {
     if (order < 0) {
         order = static_cast<int>(!incoming->prefer_rows());
     }
     if (order == 0) {
-        return convert_to_sparse<true, MatrixIn, DataOut, IndexOut>(incoming);
+        return convert_to_sparse<true, MatrixIn, DataOut, IndexOut>(incoming, 0.1, threads);
     } else {
-        return convert_to_sparse<false, MatrixIn, DataOut, IndexOut>(incoming);
+        return convert_to_sparse<false, MatrixIn, DataOut, IndexOut>(incoming, 0.1, threads);
     }
 }
 
@@ -0,0 +1,93 @@
+#ifndef TEST_BLOCK_ACCESS_H
+#define TEST_BLOCK_ACCESS_H
+#include "utils.h"
+
+#include <vector>
+#include <algorithm>
+
+/* Tests the block extraction methods against the reference's one-at-a-time
+ * extraction. Buffers are pre-filled with junk to check that every entry is
+ * actually overwritten, including the zeroes in sparse matrices.
+ */
+
+template<bool ROW, class Matrix, class Matrix2>
+void test_block_access(const Matrix* ptr, const Matrix2* ref, size_t step, size_t start, size_t end) {
+    size_t NR = ptr->nrow();
+    ASSERT_EQ(NR, ref->nrow());
+    size_t NC = ptr->ncol();
+    ASSERT_EQ(NC, ref->ncol());
+
+    size_t dim = (ROW ? NR : NC);
+    size_t width = end - start;
+    auto wrk = ptr->new_workspace(ROW);
+
+    typedef typename Matrix::data_type T;
+    typedef typename Matrix::index_type IDX;
+    constexpr T junk = -12345;
+
+    for (size_t first = 0; first < dim; first += step) {
+        size_t last = std::min(dim, first + step);
+        size_t len = last - first;
+
+        std::vector<T> expected;
+        expected.reserve(len * width);
+        for (size_t i = first; i < last; ++i) {
+            auto current = (ROW ? ref->row(i, start, end) : ref->column(i, start, end));
+            expected.insert(expected.end(), current.begin(), current.end());
+        }
+
+        for (int w = 0; w < 2; ++w) {
+            auto curwork = (w ? wrk.get() : nullptr);
+
+            {
+                std::vector<T> buffer(len * width, junk);
+                const T* out = (ROW ? ptr->rows(first, last, buffer.data(), start, end, curwork) : ptr->columns(first, last, buffer.data(), start, end, curwork));
+                std::vector<T> observed(out, out + len * width);
+                EXPECT_EQ(expected, observed);
+            }
+
+            {
+                std::vector<T> vbuffer(len * width, junk);
+                std::vector<IDX> ibuffer(len * width);
+                std::vector<size_t> pbuffer(len + 1, 12345);
+
+                auto range = (ROW ?
+                    ptr->sparse_rows(first, last, vbuffer.data(), ibuffer.data(), pbuffer.data(), start, end, curwork) :
+                    ptr->sparse_columns(first, last, vbuffer.data(), ibuffer.data(), pbuffer.data(), start, end, curwork));
+                EXPECT_EQ(pbuffer[0], 0);
+                EXPECT_EQ(pbuffer[len], range.number);
+
+                std::vector<T> observed(len * width);
+                for (size_t i = 0; i < len; ++i) {
+                    auto dest = observed.begin() + i * width;
+                    for (size_t j = pbuffer[i]; j < pbuffer[i + 1]; ++j) {
+                        dest[range.index[j] - start] = range.value[j];
+                    }
+                }
+                EXPECT_EQ(expected, observed);
+            }
+        }
+    }
+}
+
+template<class Matrix, class Matrix2>
+void test_block_row_access(const Matrix* ptr, const Matrix2* ref, size_t step, size_t start, size_t end) {
+    test_block_access<true>(ptr, ref, step, start, end);
+}
+
+template<class Matrix, class Matrix2>
+void test_block_row_access(const Matrix* ptr, const Matrix2* ref, size_t step) {
+    test_block_access<true>(ptr, ref, step, 0, ptr->ncol());
+}
+
+template<class Matrix, class Matrix2>
+void test_block_column_access(const Matrix* ptr, const Matrix2* ref, size_t step, size_t start, size_t end) {
+    test_block_access<false>(ptr, ref, step, start, end);
+}
+
+template<class Matrix, class Matrix2>
+void test_block_column_access(const Matrix* ptr, const Matrix2* ref, size_t step) {
+    test_block_access<false>(ptr, ref, step, 0, ptr->nrow());
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef TEST_EXTRACTOR_ACCESS_H
+#define TEST_EXTRACTOR_ACCESS_H
+#include "utils.h"
+
+#include <vector>
+#include <memory>
+#include "tatami/base/Oracle.hpp"
+
+/* Tests the extractor objects against the reference's one-at-a-time
+ * extraction, visiting every 'jump'-th row/column in both directions. We also
+ * attach an oracle for the forward pass to check that it is respected, and
+ * check that the structure-only modes agree with the full extraction.
+ */
+
+template<bool ROW, class Matrix, class Matrix2>
+void test_extractor_access(const Matrix* ptr, const Matrix2* ref, size_t jump, size_t start, size_t end) {
+    size_t NR = ptr->nrow();
+    ASSERT_EQ(NR, ref->nrow());
+    size_t NC = ptr->ncol();
+    ASSERT_EQ(NC, ref->ncol());
+
+    size_t dim = (ROW ? NR : NC);
+    std::vector<size_t> forward;
+    for (size_t i = 0; i < dim; i += jump) {
+        forward.push_back(i);
+    }
+    std::vector<size_t> reverse(forward.rbegin(), forward.rend());
+
+    for (int o = 0; o < 2; ++o) {
+        const auto& sequence = (o ? reverse : forward);
+
+        auto dext = (ROW ? ptr->dense_row_extractor(start, end) : ptr->dense_column_extractor(start, end));
+        EXPECT_EQ(dext->first(), start);
+        EXPECT_EQ(dext->last(), end);
+        EXPECT_EQ(dext->length(), end - start);
+
+        auto sext = (ROW ? ptr->sparse_row_extractor(start, end) : ptr->sparse_column_extractor(start, end));
+        EXPECT_TRUE(sext->sorted());
+        EXPECT_EQ(sext->length(), end - start);
+
+        auto uext = (ROW ? ptr->sparse_row_extractor(start, end, false) : ptr->sparse_column_extractor(start, end, false));
+        EXPECT_FALSE(uext->sorted());
+        EXPECT_EQ(uext->mode(), tatami::SPARSE_EXTRACT_BOTH);
+
+        auto iext = (ROW ? ptr->sparse_row_extractor(start, end, true, tatami::SPARSE_EXTRACT_INDEX) : ptr->sparse_column_extractor(start, end, true, tatami::SPARSE_EXTRACT_INDEX));
+        EXPECT_EQ(iext->mode(), tatami::SPARSE_EXTRACT_INDEX);
+        auto next = (ROW ? ptr->sparse_row_extractor(start, end, true, tatami::SPARSE_EXTRACT_NONE) : ptr->sparse_column_extractor(start, end, true, tatami::SPARSE_EXTRACT_NONE));
+        EXPECT_EQ(next->mode(), tatami::SPARSE_EXTRACT_NONE);
+        std::vector<typename Matrix::index_type> ibuffer(end - start);
+
+        if (!o) {
+            std::shared_ptr<const tatami::Oracle> oracle(new tatami::FixedOracle(sequence));
+            dext->set_oracle(oracle);
+            sext->set_oracle(oracle);
+            uext->set_oracle(oracle);
+            iext->set_oracle(oracle);
+            next->set_oracle(oracle);
+        }
+
+        for (auto i : sequence) {
+            auto expected = (ROW ? ref->row(i, start, end) : ref->column(i, start, end));
+            EXPECT_EQ(expected, dext->fetch(i));
+            auto full = sext->fetch(i);
+            EXPECT_EQ(expected, expand(full, start, end));
+
+            auto irange = iext->fetch(i, NULL, ibuffer.data());
+            EXPECT_TRUE(irange.value == NULL);
+            EXPECT_EQ(full.index, std::vector<typename Matrix::index_type>(irange.index, irange.index + irange.number));
+            auto icopy = iext->fetch(i);
+            EXPECT_EQ(full.index, icopy.index);
+            EXPECT_TRUE(icopy.value.empty());
+
+            auto nrange = next->fetch(i, NULL, NULL);
+            EXPECT_EQ(full.index.size(), nrange.number);
+            EXPECT_TRUE(nrange.value == NULL);
+            EXPECT_TRUE(nrange.index == NULL);
+
+            auto unsorted = uext->fetch(i);
+            std::vector<typename Matrix::data_type> observed(end - start);
+            for (size_t j = 0; j < unsorted.index.size(); ++j) {
+                observed[unsorted.index[j] - start] = unsorted.value[j];
+            }
+            EXPECT_EQ(expected, observed);
+        }
+    }
+}
+
+template<class Matrix, class Matrix2>
+void test_extractor_row_access(const Matrix* ptr, const Matrix2* ref, size_t jump) {
+    test_extractor_access<true>(ptr, ref, jump, 0, ptr->ncol());
+}
+
+template<class Matrix, class Matrix2>
+void test_extractor_row_access(const Matrix* ptr, const Matrix2* ref, size_t jump, size_t start, size_t end) {
+    test_extractor_access<true>(ptr, ref, jump, start, end);
+}
+
+template<class Matrix, class Matrix2>
+void test_extractor_column_access(const Matrix* ptr, const Matrix2* ref, size_t jump) {
+    test_extractor_access<false>(ptr, ref, jump, 0, ptr->nrow());
+}
+
+template<class Matrix, class Matrix2>
+void test_extractor_column_access(const Matrix* ptr, const Matrix2* ref, size_t jump, size_t start, size_t end) {
+    test_extractor_access<false>(ptr, ref, jump, start, end);
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef TEST_INDEXED_ACCESS_H
+#define TEST_INDEXED_ACCESS_H
+#include "utils.h"
+
+#include <vector>
+
+/* Tests the indexed extraction methods against the reference's full
+ * extraction, using every 'jump'-th index starting from 'offset'.
+ * Buffers are pre-filled with junk to check that every entry is overwritten.
+ */
+
+template<bool ROW, class Matrix, class Matrix2>
+void test_indexed_access(const Matrix* ptr, const Matrix2* ref, size_t step, size_t offset, size_t jump) {
+    size_t NR = ptr->nrow();
+    ASSERT_EQ(NR, ref->nrow());
+    size_t NC = ptr->ncol();
+    ASSERT_EQ(NC, ref->ncol());
+
+    size_t dim = (ROW ? NR : NC);
+    size_t otherdim = (ROW ? NC : NR);
+    auto wrk = ptr->new_workspace(ROW);
+
+    typedef typename Matrix::data_type T;
+    typedef typename Matrix::index_type IDX;
+    constexpr T junk = -12345;
+
+    std::vector<IDX> indices;
+    for (size_t j = offset; j < otherdim; j += jump) {
+        indices.push_back(j);
+    }
+    size_t n = indices.size();
+
+    for (size_t i = 0; i < dim; i += step) {
+        auto full = (ROW ? ref->row(i) : ref->column(i));
+        std::vector<T> expected;
+        for (auto j : indices) {
+            expected.push_back(full[j]);
+        }
+
+        for (int w = 0; w < 2; ++w) {
+            auto curwork = (w ? wrk.get() : nullptr);
+
+            {
+                std::vector<T> buffer(n, junk);
+                const T* out = (ROW ? ptr->row_indexed(i, buffer.data(), n, indices.data(), curwork) : ptr->column_indexed(i, buffer.data(), n, indices.data(), curwork));
+                std::vector<T> observed(out, out + n);
+                EXPECT_EQ(expected, observed);
+            }
+
+            {
+                std::vector<T> vbuffer(n, junk);
+                std::vector<IDX> ibuffer(n);
+                auto range = (ROW ?
+                    ptr->sparse_row_indexed(i, vbuffer.data(), ibuffer.data(), n, indices.data(), curwork) :
+                    ptr->sparse_column_indexed(i, vbuffer.data(), ibuffer.data(), n, indices.data(), curwork));
+
+                std::vector<T> observed(otherdim);
+                for (size_t j = 0; j < range.number; ++j) {
+                    observed[range.index[j]] = range.value[j];
+                }
+
+                std::vector<T> observed_subset;
+                for (auto j : indices) {
+                    observed_subset.push_back(observed[j]);
+                }
+                EXPECT_EQ(expected, observed_subset);
+
+                // Checking that the returned indices are among those requested.
+                for (size_t j = 1; j < range.number; ++j) {
+                    EXPECT_TRUE(range.index[j] > range.index[j - 1]);
+                }
+                for (size_t j = 0; j < range.number; ++j) {
+                    EXPECT_EQ((static_cast<size_t>(range.index[j]) - offset) % jump, 0);
+                }
+            }
+        }
+    }
+}
+
+template<class Matrix, class Matrix2>
+void test_indexed_row_access(const Matrix* ptr, const Matrix2* ref, size_t step, size_t offset, size_t jump) {
+    test_indexed_access<true>(ptr, ref, step, offset, jump);
+}
+
+template<class Matrix, class Matrix2>
+void test_indexed_column_access(const Matrix* ptr, const Matrix2* ref, size_t step, size_t offset, size_t jump) {
+    test_indexed_access<false>(ptr, ref, step, offset, jump);
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef TEST_NONZERO_COUNTS_H
+#define TEST_NONZERO_COUNTS_H
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <numeric>
+#include "tatami/base/SparseRange.hpp"
+
+/* Tests the reported numbers of structural non-zero elements against those
+ * obtained by extraction. We also check that the numbers are available (or
+ * not) as expected, to make sure that they are propagated properly.
+ */
+
+template<bool ROW, class Matrix>
+std::vector<size_t> count_nonzeros_by_extraction(const Matrix* ptr) {
+    size_t dim = (ROW ? ptr->nrow() : ptr->ncol());
+    std::vector<size_t> output(dim);
+    auto ext = (ROW ? ptr->sparse_row_extractor(true, tatami::SPARSE_EXTRACT_NONE) : ptr->sparse_column_extractor(true, tatami::SPARSE_EXTRACT_NONE));
+    for (size_t i = 0; i < dim; ++i) {
+        output[i] = ext->fetch(i, NULL, NULL).number;
+    }
+    return output;
+}
+
+template<class Matrix>
+void test_nonzero_counts(const Matrix* ptr, bool has_row, bool has_column, bool has_total) {
+    auto row_expected = count_nonzeros_by_extraction<true>(ptr);
+    std::vector<size_t> row_observed(ptr->nrow());
+    EXPECT_EQ(ptr->nonzero_counts(true, row_observed.data()), has_row);
+    if (has_row) {
+        EXPECT_EQ(row_expected, row_observed);
+    }
+
+    auto column_expected = count_nonzeros_by_extraction<false>(ptr);
+    std::vector<size_t> column_observed(ptr->ncol());
+    EXPECT_EQ(ptr->nonzero_counts(false, column_observed.data()), has_column);
+    if (has_column) {
+        EXPECT_EQ(column_expected, column_observed);
+    }
+
+    size_t total = 0;
+    EXPECT_EQ(ptr->nonzero_count(total), has_total);
+    if (has_total) {
+        EXPECT_EQ(total, std::accumulate(row_expected.begin(), row_expected.end(), static_cast<size_t>(0)));
+    }
+}
+
+#endif
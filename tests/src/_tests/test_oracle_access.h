@@ -0,0 +1,83 @@
+#ifndef TEST_ORACLE_ACCESS_H
+#define TEST_ORACLE_ACCESS_H
+#include "utils.h"
+
+#include <vector>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include "tatami/base/Oracle.hpp"
+
+/* Tests extraction with an oracle attached to the workspace. The requests are
+ * made in the order of 'sequence' while the oracle predicts 'predictions',
+ * which may be different to check that incorrect predictions are harmless.
+ */
+
+template<bool ROW, class Matrix, class Matrix2>
+void test_oracle_access(const Matrix* ptr, const Matrix2* ref, const std::vector<size_t>& sequence, std::vector<size_t> predictions, size_t start, size_t end) {
+    size_t NR = ptr->nrow();
+    ASSERT_EQ(NR, ref->nrow());
+    size_t NC = ptr->ncol();
+    ASSERT_EQ(NC, ref->ncol());
+
+    std::shared_ptr<const tatami::Oracle> oracle(new tatami::FixedOracle(std::move(predictions)));
+    auto wrk = ptr->new_workspace(ROW);
+    ptr->set_oracle(ROW, wrk.get(), oracle);
+    auto swrk = ptr->new_workspace(ROW);
+    ptr->set_oracle(ROW, swrk.get(), oracle);
+
+    for (auto i : sequence) {
+        auto expected = (ROW ? ref->row(i, start, end) : ref->column(i, start, end));
+
+        auto observed = (ROW ? ptr->row(i, start, end, wrk.get()) : ptr->column(i, start, end, wrk.get()));
+        EXPECT_EQ(expected, observed);
+
+        auto sobserved = (ROW ? ptr->sparse_row(i, start, end, swrk.get()) : ptr->sparse_column(i, start, end, swrk.get()));
+        EXPECT_EQ(expected, expand(sobserved, start, end));
+    }
+}
+
+template<bool ROW, class Matrix, class Matrix2>
+void test_oracle_access(const Matrix* ptr, const Matrix2* ref, size_t jump, size_t start, size_t end) {
+    size_t dim = (ROW ? ptr->nrow() : ptr->ncol());
+
+    std::vector<size_t> forward;
+    for (size_t i = 0; i < dim; i += jump) {
+        forward.push_back(i);
+    }
+    test_oracle_access<ROW>(ptr, ref, forward, forward, start, end);
+
+    std::vector<size_t> reverse(forward.rbegin(), forward.rend());
+    test_oracle_access<ROW>(ptr, ref, reverse, reverse, start, end);
+
+    std::vector<size_t> shuffled(forward);
+    std::mt19937_64 rng(jump * 1000 + start);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    test_oracle_access<ROW>(ptr, ref, shuffled, shuffled, start, end);
+
+    // Incorrect predictions should still give the correct results.
+    test_oracle_access<ROW>(ptr, ref, forward, reverse, start, end);
+    test_oracle_access<ROW>(ptr, ref, shuffled, forward, start, end);
+}
+
+template<class Matrix, class Matrix2>
+void test_oracle_row_access(const Matrix* ptr, const Matrix2* ref, size_t jump) {
+    test_oracle_access<true>(ptr, ref, jump, 0, ptr->ncol());
+}
+
+template<class Matrix, class Matrix2>
+void test_oracle_row_access(const Matrix* ptr, const Matrix2* ref, size_t jump, size_t start, size_t end) {
+    test_oracle_access<true>(ptr, ref, jump, start, end);
+}
+
+template<class Matrix, class Matrix2>
+void test_oracle_column_access(const Matrix* ptr, const Matrix2* ref, size_t jump) {
+    test_oracle_access<false>(ptr, ref, jump, 0, ptr->nrow());
+}
+
+template<class Matrix, class Matrix2>
+void test_oracle_column_access(const Matrix* ptr, const Matrix2* ref, size_t jump, size_t start, size_t end) {
+    test_oracle_access<false>(ptr, ref, jump, start, end);
+}
+
+#endif
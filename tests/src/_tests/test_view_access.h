@@ -0,0 +1,69 @@
+#ifndef TEST_VIEW_ACCESS_H
+#define TEST_VIEW_ACCESS_H
+#include "utils.h"
+
+#include <vector>
+
+/* Tests the zero-copy views against the reference's extraction. We check that
+ * the views are reported as available (or not) as expected for each dimension,
+ * and that the contents of any returned view are correct for both the full
+ * range and a slice. Views may still be returned for individual rows/columns
+ * when they are not guaranteed, e.g., for some submatrices in a DelayedBind.
+ */
+
+template<bool ROW, class Matrix, class Matrix2>
+void test_view_access(const Matrix* ptr, const Matrix2* ref, bool has_dense, bool has_sparse) {
+    size_t NR = ptr->nrow();
+    ASSERT_EQ(NR, ref->nrow());
+    size_t NC = ptr->ncol();
+    ASSERT_EQ(NC, ref->ncol());
+
+    EXPECT_EQ(ptr->has_dense_view(ROW), has_dense);
+    EXPECT_EQ(ptr->has_sparse_view(ROW), has_sparse);
+
+    size_t dim = (ROW ? NR : NC);
+    size_t otherdim = (ROW ? NC : NR);
+    size_t start = otherdim / 3, end = otherdim - otherdim / 4;
+
+    for (size_t i = 0; i < dim; ++i) {
+        const typename Matrix::data_type* dview = NULL;
+        bool dfound = (ROW ? ptr->row_view(i, dview) : ptr->column_view(i, dview));
+        if (has_dense) {
+            EXPECT_TRUE(dfound);
+        }
+        if (dfound) {
+            auto expected = (ROW ? ref->row(i) : ref->column(i));
+            EXPECT_EQ(expected, std::vector<typename Matrix::data_type>(dview, dview + otherdim));
+
+            auto sliced = (ROW ? ref->row(i, start, end) : ref->column(i, start, end));
+            EXPECT_TRUE(ROW ? ptr->row_view(i, dview, start, end) : ptr->column_view(i, dview, start, end));
+            EXPECT_EQ(sliced, std::vector<typename Matrix::data_type>(dview, dview + (end - start)));
+        }
+
+        tatami::SparseRange<typename Matrix::data_type, typename Matrix::index_type> sview;
+        bool sfound = (ROW ? ptr->sparse_row_view(i, sview) : ptr->sparse_column_view(i, sview));
+        if (has_sparse) {
+            EXPECT_TRUE(sfound);
+        }
+        if (sfound) {
+            auto expected = (ROW ? ref->row(i) : ref->column(i));
+            EXPECT_EQ(expected, expand(sview, otherdim));
+
+            auto sliced = (ROW ? ref->row(i, start, end) : ref->column(i, start, end));
+            EXPECT_TRUE(ROW ? ptr->sparse_row_view(i, sview, start, end) : ptr->sparse_column_view(i, sview, start, end));
+            EXPECT_EQ(sliced, expand(sview, start, end));
+        }
+    }
+}
+
+template<class Matrix, class Matrix2>
+void test_view_row_access(const Matrix* ptr, const Matrix2* ref, bool has_dense, bool has_sparse) {
+    test_view_access<true>(ptr, ref, has_dense, has_sparse);
+}
+
+template<class Matrix, class Matrix2>
+void test_view_column_access(const Matrix* ptr, const Matrix2* ref, bool has_dense, bool has_sparse) {
+    test_view_access<false>(ptr, ref, has_dense, has_sparse);
+}
+
+#endif
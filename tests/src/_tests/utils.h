@@ -29,4 +29,22 @@ std::vector<T> expand(const tatami::SparseRangeCopy<T, IDX>& sparse, size_t star
     return output;
 }
 
+template<typename T, typename IDX>
+std::vector<T> expand(const tatami::SparseRange<T, IDX>& sparse, size_t dim) {
+    std::vector<T> output(dim);
+    for (size_t i = 0; i < sparse.number; ++i) {
+        output[sparse.index[i]] = sparse.value[i];
+    }
+    return output;
+}
+
+template<typename T, typename IDX>
+std::vector<T> expand(const tatami::SparseRange<T, IDX>& sparse, size_t start, size_t end) {
+    std::vector<T> output(end - start);
+    for (size_t i = 0; i < sparse.number; ++i) {
+        output[sparse.index[i] - start] = sparse.value[i];
+    }
+    return output;
+}
+
 #endif
@@ -8,6 +8,12 @@
 #include "tatami/utils/convert_to_sparse.hpp"
 
 #include "../_tests/test_row_access.h"
+#include "../_tests/test_block_access.h"
+#include "../_tests/test_indexed_access.h"
+#include "../_tests/test_oracle_access.h"
+#include "../_tests/test_extractor_access.h"
+#include "../_tests/test_nonzero_counts.h"
+#include "../_tests/test_view_access.h"
 #include "../_tests/test_column_access.h"
 #include "../_tests/simulate_vector.h"
 
@@ -74,6 +80,35 @@ TEST_F(SparseUtilsTest, Basic) {
     EXPECT_EQ(work_row.get(), nullptr);
 }
 
+TEST_F(SparseUtilsTest, NonZeroCounts) {
+    // Only available along the primary dimension.
+    test_nonzero_counts(sparse_row.get(), true, false, true);
+    test_nonzero_counts(sparse_column.get(), false, true, true);
+    test_nonzero_counts(dense.get(), false, false, false);
+}
+
+TEST_F(SparseUtilsTest, Views) {
+    // Only available along the primary dimension.
+    test_view_row_access(sparse_row.get(), dense.get(), false, true);
+    test_view_column_access(sparse_row.get(), dense.get(), false, false);
+    test_view_row_access(sparse_column.get(), dense.get(), false, false);
+    test_view_column_access(sparse_column.get(), dense.get(), false, true);
+}
+
+TEST_F(SparseUtilsTest, MemoryUsage) {
+    size_t nnz = 0;
+    sparse_column->nonzero_count(nnz);
+    EXPECT_GE(sparse_column->memory_usage(), nnz * (sizeof(double) + sizeof(int)) + (ncol + 1) * sizeof(size_t));
+    EXPECT_GE(sparse_row->memory_usage(), nnz * (sizeof(double) + sizeof(int)) + (nrow + 1) * sizeof(size_t));
+    EXPECT_GE(dense->memory_usage(), nrow * ncol * sizeof(double));
+
+    // No workspace is required along the primary dimension.
+    EXPECT_EQ(sparse_column->workspace_memory_usage(false), 0);
+    EXPECT_GE(sparse_column->workspace_memory_usage(true), ncol * (sizeof(size_t) + 2 * sizeof(int)));
+    EXPECT_EQ(sparse_row->workspace_memory_usage(true), 0);
+    EXPECT_GE(sparse_row->workspace_memory_usage(false), nrow * (sizeof(size_t) + 2 * sizeof(int)));
+}
+
 /*************************************
  *************************************/
 
@@ -183,3 +218,155 @@ INSTANTIATE_TEST_CASE_P(
         )
     )
 );
+
+/*************************************
+ *************************************/
+
+class SparseBlockAccessTest : public ::testing::TestWithParam<std::tuple<size_t, std::pair<size_t, size_t> > >, public SparseTestMethods {
+protected:
+    void SetUp() {
+        assemble();
+        return;
+    }
+};
+
+TEST_P(SparseBlockAccessTest, Full) {
+    size_t STEP = std::get<0>(GetParam());
+    test_block_row_access(sparse_column.get(), dense.get(), STEP);
+    test_block_row_access(sparse_row.get(), dense.get(), STEP);
+    test_block_column_access(sparse_column.get(), dense.get(), STEP);
+    test_block_column_access(sparse_row.get(), dense.get(), STEP);
+}
+
+TEST_P(SparseBlockAccessTest, Sliced) {
+    auto param = GetParam();
+    size_t STEP = std::get<0>(param);
+    auto interval = std::get<1>(param);
+    test_block_row_access(sparse_column.get(), dense.get(), STEP, interval.first, interval.second);
+    test_block_row_access(sparse_row.get(), dense.get(), STEP, interval.first, interval.second);
+    test_block_column_access(sparse_column.get(), dense.get(), STEP, interval.first, interval.second);
+    test_block_column_access(sparse_row.get(), dense.get(), STEP, interval.first, interval.second);
+}
+
+TEST_P(SparseBlockAccessTest, Details) {
+    // Full-length blocks along the primary dimension point directly to the internal data.
+    size_t STEP = std::get<0>(GetParam());
+    std::vector<double> outval(STEP * nrow);
+    std::vector<int> outidx(STEP * nrow);
+    std::vector<size_t> outptr(STEP + 1);
+
+    auto x = sparse_column->sparse_columns(0, STEP, outval.data(), outidx.data(), outptr.data(), 0, nrow);
+    EXPECT_FALSE(outval.data()==x.value);
+    EXPECT_FALSE(outidx.data()==x.index);
+
+    auto y = sparse_row->sparse_columns(0, STEP, outval.data(), outidx.data(), outptr.data(), 0, nrow);
+    EXPECT_TRUE(outval.data()==y.value);
+    EXPECT_TRUE(outidx.data()==y.index);
+    EXPECT_EQ(x.number, y.number);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    CompressedSparseMatrix,
+    SparseBlockAccessTest,
+    ::testing::Combine(
+        ::testing::Values(1, 7, 50), // number of rows/columns in each block.
+        ::testing::Values(
+            std::make_pair(0, 10),
+            std::make_pair(13, 57),
+            std::make_pair(50, 100)
+        )
+    )
+);
+
+/*************************************
+ *************************************/
+
+class SparseIndexedAccessTest : public ::testing::TestWithParam<std::tuple<size_t, std::pair<size_t, size_t> > >, public SparseTestMethods {
+protected:
+    void SetUp() {
+        assemble();
+        return;
+    }
+};
+
+TEST_P(SparseIndexedAccessTest, Basic) {
+    auto param = GetParam();
+    size_t STEP = std::get<0>(param);
+    auto jump = std::get<1>(param);
+    test_indexed_row_access(sparse_column.get(), dense.get(), STEP, jump.first, jump.second);
+    test_indexed_row_access(sparse_row.get(), dense.get(), STEP, jump.first, jump.second);
+    test_indexed_column_access(sparse_column.get(), dense.get(), STEP, jump.first, jump.second);
+    test_indexed_column_access(sparse_row.get(), dense.get(), STEP, jump.first, jump.second);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    CompressedSparseMatrix,
+    SparseIndexedAccessTest,
+    ::testing::Combine(
+        ::testing::Values(1, 3), // jump between rows/columns.
+        ::testing::Values(
+            std::make_pair(0, 1), // start and jump between indices.
+            std::make_pair(3, 5),
+            std::make_pair(10, 13)
+        )
+    )
+);
+
+/*************************************
+ *************************************/
+
+class SparseOracleTest : public ::testing::TestWithParam<size_t>, public SparseTestMethods {
+protected:
+    void SetUp() {
+        assemble();
+        return;
+    }
+};
+
+TEST_P(SparseOracleTest, Basic) {
+    size_t JUMP = GetParam();
+    test_oracle_row_access(sparse_column.get(), dense.get(), JUMP);
+    test_oracle_column_access(sparse_row.get(), dense.get(), JUMP);
+    test_oracle_row_access(sparse_column.get(), dense.get(), JUMP, 13, 57);
+    test_oracle_column_access(sparse_row.get(), dense.get(), JUMP, 50, 100);
+
+    // No effect along the preferred dimension.
+    test_oracle_row_access(sparse_row.get(), dense.get(), JUMP);
+    test_oracle_column_access(sparse_column.get(), dense.get(), JUMP);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    CompressedSparseMatrix,
+    SparseOracleTest,
+    ::testing::Values(1, 3, 7) // jump between requests.
+);
+
+/*************************************
+ *************************************/
+
+class SparseExtractorTest : public ::testing::TestWithParam<size_t>, public SparseTestMethods {
+protected:
+    void SetUp() {
+        assemble();
+        return;
+    }
+};
+
+TEST_P(SparseExtractorTest, Basic) {
+    size_t JUMP = GetParam();
+    test_extractor_row_access(sparse_row.get(), dense.get(), JUMP);
+    test_extractor_column_access(sparse_row.get(), dense.get(), JUMP);
+    test_extractor_row_access(sparse_column.get(), dense.get(), JUMP);
+    test_extractor_column_access(sparse_column.get(), dense.get(), JUMP);
+
+    test_extractor_row_access(sparse_row.get(), dense.get(), JUMP, 13, 57);
+    test_extractor_column_access(sparse_row.get(), dense.get(), JUMP, 50, 100);
+    test_extractor_row_access(sparse_column.get(), dense.get(), JUMP, 13, 57);
+    test_extractor_column_access(sparse_column.get(), dense.get(), JUMP, 50, 100);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    CompressedSparseMatrix,
+    SparseExtractorTest,
+    ::testing::Values(1, 3, 7) // jump between requests.
+);
@@ -7,9 +7,15 @@
 #include "tatami/base/DelayedBind.hpp"
 #include "tatami/base/DelayedIsometricOp.hpp"
 #include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/utils/convert_to_dense.hpp"
 
 #include "../data/data.h"
 #include "TestCore.h"
+#include "../_tests/test_block_access.h"
+#include "../_tests/test_indexed_access.h"
+#include "../_tests/test_oracle_access.h"
+#include "../_tests/test_nonzero_counts.h"
+#include "../_tests/test_view_access.h"
 
 const double MULT1 = 10, MULT2 = 1.5;
 
@@ -249,3 +255,152 @@ INSTANTIATE_TEST_CASE_P(
         )
     )
 );
+
+/****************************
+ ****************************/
+
+using BindBlockAccessTest = BindTest<std::tuple<bool, bool, bool, size_t> >;
+
+TEST_P(BindBlockAccessTest, Basic) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    auto ref = tatami::convert_to_dense<true>(bound.get());
+    size_t STEP = std::get<3>(param);
+    test_block_row_access(bound.get(), ref.get(), STEP);
+    test_block_column_access(bound.get(), ref.get(), STEP);
+    test_block_row_access(bound.get(), ref.get(), STEP, 1, bound->ncol() - 1);
+    test_block_column_access(bound.get(), ref.get(), STEP, 2, bound->nrow() - 3);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedBind,
+    BindBlockAccessTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // use sparse or dense for the first matrix.
+        ::testing::Values(true, false), // use sparse or dense for the second matrix.
+        ::testing::Values(true, false), // bind by row or by column
+        ::testing::Values(1, 7, 15) // number of rows/columns in each block, sometimes spanning multiple matrices.
+    )
+);
+
+/****************************
+ ****************************/
+
+using BindIndexedAccessTest = BindTest<std::tuple<bool, bool, bool, size_t> >;
+
+TEST_P(BindIndexedAccessTest, Basic) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    auto ref = tatami::convert_to_dense<true>(bound.get());
+    size_t JUMP = std::get<3>(param);
+    test_indexed_row_access(bound.get(), ref.get(), 1, 0, JUMP);
+    test_indexed_column_access(bound.get(), ref.get(), 1, 0, JUMP);
+    test_indexed_row_access(bound.get(), ref.get(), 3, 2, JUMP);
+    test_indexed_column_access(bound.get(), ref.get(), 3, 1, JUMP);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedBind,
+    BindIndexedAccessTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // use sparse or dense for the first matrix.
+        ::testing::Values(true, false), // use sparse or dense for the second matrix.
+        ::testing::Values(true, false), // bind by row or by column
+        ::testing::Values(1, 4, 9) // jump between indices, sometimes spanning multiple matrices.
+    )
+);
+
+/****************************
+ ****************************/
+
+using BindOracleTest = BindTest<std::tuple<bool, bool, bool, size_t> >;
+
+TEST_P(BindOracleTest, Basic) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    auto ref = tatami::convert_to_dense<true>(bound.get());
+    size_t JUMP = std::get<3>(param);
+    test_oracle_row_access(bound.get(), ref.get(), JUMP);
+    test_oracle_column_access(bound.get(), ref.get(), JUMP);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedBind,
+    BindOracleTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // use sparse or dense for the first matrix.
+        ::testing::Values(true, false), // use sparse or dense for the second matrix.
+        ::testing::Values(true, false), // bind by row or by column
+        ::testing::Values(1, 3) // jump between requests.
+    )
+);
+
+/****************************
+ ****************************/
+
+using BindNonZeroCountsTest = BindTest<std::tuple<bool, bool, bool> >;
+
+TEST_P(BindNonZeroCountsTest, Basic) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    // Column counts are only known if both matrices are CSC.
+    bool both_sparse = std::get<0>(param) && std::get<1>(param);
+    test_nonzero_counts(bound.get(), false, both_sparse, both_sparse);
+}
+
+TEST_P(BindNonZeroCountsTest, Views) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    // No views are available through the delayed multiplication.
+    test_view_row_access(bound.get(), bound.get(), false, false);
+    test_view_column_access(bound.get(), bound.get(), false, false);
+
+    // Otherwise, views are only available along the combining dimension when all matrices support them.
+    if (std::get<2>(param)) {
+        auto rbound = tatami::make_DelayedBind<0>(std::vector{ dense, dense });
+        auto ref = tatami::convert_to_dense<false>(rbound.get());
+        test_view_row_access(rbound.get(), ref.get(), true, false);
+        test_view_column_access(rbound.get(), ref.get(), false, false);
+    } else {
+        auto cbound = tatami::make_DelayedBind<1>(std::vector{ sparse, sparse });
+        auto ref = tatami::convert_to_dense<true>(cbound.get());
+        test_view_row_access(cbound.get(), ref.get(), false, false);
+        test_view_column_access(cbound.get(), ref.get(), false, true);
+
+        auto mixed = tatami::make_DelayedBind<1>(std::vector{ sparse, dense });
+        test_view_column_access(mixed.get(), ref.get(), false, false);
+    }
+}
+
+TEST_P(BindNonZeroCountsTest, MemoryUsage) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    // Each child is a delayed operation on top of the dense or sparse matrix.
+    size_t children = 0, children_row = 0, children_column = 0;
+    for (auto s : { std::get<0>(param), std::get<1>(param) }) {
+        const auto& x = (s ? sparse : dense);
+        children += x->memory_usage();
+        children_row += x->workspace_memory_usage(true);
+        children_column += x->workspace_memory_usage(false);
+    }
+
+    EXPECT_GT(bound->memory_usage(), children);
+    EXPECT_GT(bound->workspace_memory_usage(true), children_row);
+    EXPECT_GT(bound->workspace_memory_usage(false), children_column);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedBind,
+    BindNonZeroCountsTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // use sparse or dense for the first matrix.
+        ::testing::Values(true, false), // use sparse or dense for the second matrix.
+        ::testing::Values(true, false) // bind by row or by column
+    )
+);
@@ -3,13 +3,21 @@
 #include <vector>
 #include <memory>
 #include <tuple>
+#include <algorithm>
 
 #include "tatami/base/DenseMatrix.hpp"
+#include "tatami/base/CompressedSparseMatrix.hpp"
 #include "tatami/base/DelayedSubset.hpp"
+#include "tatami/base/DelayedTranspose.hpp"
 #include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/utils/convert_to_dense.hpp"
 
 #include "../data/data.h"
 #include "TestCore.h"
+#include "../_tests/test_oracle_access.h"
+#include "../_tests/test_extractor_access.h"
+#include "../_tests/test_nonzero_counts.h"
+#include "../_tests/test_view_access.h"
 
 template<class PARAM> 
 class SubsetTest : public TestCore<::testing::TestWithParam<PARAM> > {
@@ -112,7 +120,9 @@ INSTANTIATE_TEST_CASE_P(
         ::testing::Values(
             std::vector<size_t>({ 0, 3, 3, 13, 5, 2, 19, 4, 6, 11, 19, 8 }), // with duplicates
             std::vector<size_t>({ 1, 2, 3, 5, 9, 13, 17 }), // ordered, no duplicates
-            std::vector<size_t>({ 8, 9, 10, 11}) // consecutive
+            std::vector<size_t>({ 0, 2, 4, 6, 8, 10, 12, 14, 16, 18 }), // ordered, too many runs for block extraction
+            std::vector<size_t>({ 8, 9, 10, 11}), // consecutive
+            std::vector<size_t>({ 11, 10, 9, 8, 7, 6 }) // reversed
         )
     )
 );
@@ -424,3 +434,199 @@ INSTANTIATE_TEST_CASE_P(
     )
 );
 
+
+/****************************************************
+ ****************************************************/
+
+class SubsetOracleTest : public SubsetTest<std::tuple<size_t, std::vector<size_t> > > {};
+
+TEST_P(SubsetOracleTest, Basic) {
+    size_t JUMP = std::get<0>(GetParam());
+    std::vector<size_t> sub = std::get<1>(GetParam());
+
+    // Subsetting along both dimensions of the column-major sparse matrix, so that the oracle reaches its workspace.
+    for (auto ptr : { tatami::make_DelayedSubset<0>(sparse, sub), tatami::make_DelayedSubset<1>(tatami::make_DelayedTranspose(sparse), sub) }) {
+        auto ref = tatami::convert_to_dense<true>(ptr.get());
+        test_oracle_row_access(ptr.get(), ref.get(), JUMP);
+        test_oracle_column_access(ptr.get(), ref.get(), JUMP);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedSubset,
+    SubsetOracleTest,
+    ::testing::Combine(
+        ::testing::Values(1, 3), // jump between requests.
+        ::testing::Values(
+            std::vector<size_t>({ 17, 18, 11, 18, 15, 17, 13, 18, 11, 9, 6, 3, 6, 18, 1 }), // with duplicates
+            std::vector<size_t>({ 2, 3, 5, 7, 9, 11, 13 }), // ordered, no duplicates
+            std::vector<size_t>({ 0, 2, 4, 6, 8, 10, 12, 14, 16, 18 }), // ordered, too many runs for block extraction
+            std::vector<size_t>({ 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 }) // consecutive
+        )
+    )
+);
+
+/****************************************************
+ ****************************************************/
+
+class SubsetExtractorTest : public SubsetTest<std::tuple<size_t, std::vector<size_t> > > {};
+
+TEST_P(SubsetExtractorTest, Basic) {
+    size_t JUMP = std::get<0>(GetParam());
+    std::vector<size_t> sub = std::get<1>(GetParam());
+
+    for (auto ptr : { 
+        tatami::make_DelayedSubset<0>(dense, sub), 
+        tatami::make_DelayedSubset<0>(sparse, sub),
+        tatami::make_DelayedSubset<1>(tatami::make_DelayedTranspose(dense), sub), 
+        tatami::make_DelayedSubset<1>(tatami::make_DelayedTranspose(sparse), sub)
+    }) {
+        auto ref = tatami::convert_to_dense<true>(ptr.get());
+        test_extractor_row_access(ptr.get(), ref.get(), JUMP);
+        test_extractor_column_access(ptr.get(), ref.get(), JUMP);
+
+        size_t NR = ptr->nrow(), NC = ptr->ncol();
+        test_extractor_row_access(ptr.get(), ref.get(), JUMP, NC / 3, NC - NC / 4);
+        test_extractor_column_access(ptr.get(), ref.get(), JUMP, NR / 4, NR - NR / 3);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedSubset,
+    SubsetExtractorTest,
+    ::testing::Combine(
+        ::testing::Values(1, 3), // jump between requests.
+        ::testing::Values(
+            std::vector<size_t>({ 17, 18, 11, 18, 15, 17, 13, 18, 11, 9, 6, 3, 6, 18, 1 }), // with duplicates
+            std::vector<size_t>({ 2, 3, 5, 7, 9 }), // ordered, no duplicates
+            std::vector<size_t>({ 0, 2, 4, 6, 8, 10, 12, 14, 16, 18 }), // ordered, too many runs for block extraction
+            std::vector<size_t>({ 3, 4, 5, 6, 7, 8, 9 }), // consecutive
+            std::vector<size_t>({ 9, 8, 7, 6, 5, 4, 3 }) // reversed
+        )
+    )
+);
+
+/****************************************************
+ ****************************************************/
+
+class SubsetNonZeroCountsTest : public SubsetTest<std::vector<size_t> > {};
+
+TEST_P(SubsetNonZeroCountsTest, Basic) {
+    std::vector<size_t> sub = GetParam();
+    auto sparse_row = tatami::convert_to_sparse<true>(dense.get());
+
+    // Only available along the subsetted dimension.
+    test_nonzero_counts(tatami::make_DelayedSubset<0>(sparse_row, sub).get(), true, false, true);
+    test_nonzero_counts(tatami::make_DelayedSubset<1>(tatami::make_DelayedTranspose(sparse_row), sub).get(), false, true, true);
+    test_nonzero_counts(tatami::make_DelayedSubset<0>(sparse, sub).get(), false, false, false);
+    test_nonzero_counts(tatami::make_DelayedSubset<0>(dense, sub).get(), false, false, false);
+}
+
+TEST_P(SubsetNonZeroCountsTest, Views) {
+    std::vector<size_t> sub = GetParam();
+
+    // Only available along the subsetted dimension.
+    auto dense_subbed = tatami::make_DelayedSubset<0>(dense, sub);
+    auto ref = tatami::convert_to_dense<false>(dense_subbed.get());
+    test_view_row_access(dense_subbed.get(), ref.get(), true, false);
+    test_view_column_access(dense_subbed.get(), ref.get(), false, false);
+
+    auto sparse_row = tatami::convert_to_sparse<true>(dense.get());
+    auto sparse_subbed = tatami::make_DelayedSubset<1>(tatami::make_DelayedTranspose(sparse_row), sub);
+    auto tref = tatami::convert_to_dense<true>(sparse_subbed.get());
+    test_view_row_access(sparse_subbed.get(), tref.get(), false, false);
+    test_view_column_access(sparse_subbed.get(), tref.get(), false, true);
+
+    test_view_row_access(tatami::make_DelayedSubset<0>(sparse, sub).get(), ref.get(), false, false);
+}
+
+TEST_P(SubsetNonZeroCountsTest, MemoryUsage) {
+    std::vector<size_t> sub = GetParam();
+    auto subbed = tatami::make_DelayedSubset<0>(sparse, sub);
+    EXPECT_GE(subbed->memory_usage(), sparse->memory_usage() + sub.size() * sizeof(size_t));
+
+    // Reverse mapping is only stored for sorted and unique indices.
+    auto sorted = std::is_sorted(sub.begin(), sub.end()) && std::adjacent_find(sub.begin(), sub.end()) == sub.end();
+    if (sorted) {
+        EXPECT_GE(subbed->memory_usage(), sparse->memory_usage() + sub.size() * sizeof(size_t) + sparse->nrow() * sizeof(int));
+    }
+
+    // Extraction along the subsetted dimension has no extra overhead.
+    EXPECT_EQ(subbed->workspace_memory_usage(true), sparse->workspace_memory_usage(true));
+
+    // Otherwise, gathering buffers are only needed for unsorted or duplicated indices.
+    EXPECT_GE(subbed->workspace_memory_usage(false), sparse->workspace_memory_usage(false));
+    if (!sorted) {
+        EXPECT_GE(subbed->workspace_memory_usage(false), sparse->workspace_memory_usage(false) + sub.size() * sizeof(int));
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedSubset,
+    SubsetNonZeroCountsTest,
+    ::testing::Values(
+        std::vector<size_t>({ 17, 18, 11, 18, 15, 17, 13, 18, 11, 9, 6, 3, 6, 18, 1 }), // with duplicates
+        std::vector<size_t>({ 2, 3, 5, 7, 9 }) // ordered, no duplicates
+    )
+);
+
+/****************************************************
+ ****************************************************/
+
+TEST(DelayedSubset, SparseDuplicates) {
+    // Row-major sparse matrix with an explicitly stored zero at (1, 2).
+    std::vector<double> values { 1, 2, 0, 3, 4, 5 };
+    std::vector<int> indices { 0, 3, 2, 4, 1, 3 };
+    std::vector<size_t> indptrs { 0, 2, 4, 6 };
+    auto mat = std::shared_ptr<tatami::NumericMatrix>(new tatami::CompressedSparseRowMatrix<double, int>(3, 5, values, indices, indptrs));
+
+    std::vector<size_t> sub { 4, 3, 3, 2, 0, 4, 2 };
+    auto subbed = tatami::make_DelayedSubset<1>(mat, sub);
+
+    std::vector<std::vector<int> > expected_indices { { 1, 2, 4 }, { 0, 3, 5, 6 }, { 1, 2 } };
+    std::vector<std::vector<double> > expected_values { { 2, 2, 1 }, { 3, 0, 3, 0 }, { 5, 5 } };
+
+    auto ext = subbed->sparse_row_extractor();
+    auto work = subbed->new_workspace(true);
+    for (size_t r = 0; r < 3; ++r) {
+        // Explicit zeros are preserved, and duplicated indices are reported multiple times.
+        auto out = ext->fetch(r);
+        EXPECT_EQ(out.index, expected_indices[r]);
+        EXPECT_EQ(out.value, expected_values[r]);
+
+        auto out2 = subbed->sparse_row(r, work.get());
+        EXPECT_EQ(out2.index, expected_indices[r]);
+        EXPECT_EQ(out2.value, expected_values[r]);
+    }
+
+    // Same elements when unsorted, just possibly in a different order.
+    auto uext = subbed->sparse_row_extractor(0, sub.size(), false);
+    for (size_t r = 0; r < 3; ++r) {
+        auto out = uext->fetch(r);
+        std::vector<std::pair<int, double> > collected;
+        for (size_t i = 0; i < out.index.size(); ++i) {
+            collected.emplace_back(out.index[i], out.value[i]);
+        }
+        std::sort(collected.begin(), collected.end());
+
+        ASSERT_EQ(collected.size(), expected_indices[r].size());
+        for (size_t i = 0; i < collected.size(); ++i) {
+            EXPECT_EQ(collected[i].first, expected_indices[r][i]);
+            EXPECT_EQ(collected[i].second, expected_values[r][i]);
+        }
+    }
+
+    // Indices and counts are correct without the values.
+    auto iext = subbed->sparse_row_extractor(0, sub.size(), true, tatami::SPARSE_EXTRACT_INDEX);
+    auto next = subbed->sparse_row_extractor(0, sub.size(), true, tatami::SPARSE_EXTRACT_NONE);
+    for (size_t r = 0; r < 3; ++r) {
+        auto out = iext->fetch(r);
+        EXPECT_EQ(out.index, expected_indices[r]);
+        EXPECT_TRUE(out.value.empty());
+
+        std::vector<double> vbuffer(sub.size());
+        std::vector<int> ibuffer(sub.size());
+        auto range = next->fetch(r, vbuffer.data(), ibuffer.data());
+        EXPECT_EQ(range.number, expected_indices[r].size());
+    }
+}
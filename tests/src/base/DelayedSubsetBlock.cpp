@@ -10,6 +10,11 @@
 
 #include "../data/data.h"
 #include "TestCore.h"
+#include "../_tests/test_block_access.h"
+#include "../_tests/test_indexed_access.h"
+#include "../_tests/test_extractor_access.h"
+#include "../_tests/test_nonzero_counts.h"
+#include "../_tests/test_view_access.h"
 
 template<class PARAM> 
 class SubsetBlockTest : public TestCore<::testing::TestWithParam<PARAM> > {
@@ -234,3 +239,139 @@ INSTANTIATE_TEST_CASE_P(
         )        
     )
 );
+
+/*****************************
+ *****************************/
+
+using SubsetBlockBlockAccessTest = SubsetBlockTest<std::tuple<bool, std::pair<double, double>, size_t> >;
+
+TEST_P(SubsetBlockBlockAccessTest, Basic) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    size_t STEP = std::get<2>(param);
+    for (auto ptr : { dense_block, sparse_block }) {
+        test_block_row_access(ptr.get(), ref.get(), STEP);
+        test_block_column_access(ptr.get(), ref.get(), STEP);
+        test_block_row_access(ptr.get(), ref.get(), STEP, 1, ptr->ncol() - 1);
+        test_block_column_access(ptr.get(), ref.get(), STEP, 2, ptr->nrow());
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedSubsetBlock,
+    SubsetBlockBlockAccessTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // row or column subsetting, respectively.
+        ::testing::Values(
+            std::make_pair(0.0, 0.5),
+            std::make_pair(0.25, 0.8),
+            std::make_pair(0.4, 1)
+        ),
+        ::testing::Values(1, 4) // number of rows/columns in each block.
+    )
+);
+
+/*****************************
+ *****************************/
+
+using SubsetBlockIndexedAccessTest = SubsetBlockTest<std::tuple<bool, std::pair<double, double>, size_t> >;
+
+TEST_P(SubsetBlockIndexedAccessTest, Basic) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    size_t JUMP = std::get<2>(param);
+    for (auto ptr : { dense_block, sparse_block }) {
+        test_indexed_row_access(ptr.get(), ref.get(), 1, 0, JUMP);
+        test_indexed_column_access(ptr.get(), ref.get(), 1, 0, JUMP);
+        test_indexed_row_access(ptr.get(), ref.get(), 2, 3, JUMP);
+        test_indexed_column_access(ptr.get(), ref.get(), 2, 1, JUMP);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedSubsetBlock,
+    SubsetBlockIndexedAccessTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // row or column subsetting, respectively.
+        ::testing::Values(
+            std::make_pair(0.0, 0.5),
+            std::make_pair(0.25, 0.8),
+            std::make_pair(0.4, 1)
+        ),
+        ::testing::Values(1, 3, 7) // jump between indices.
+    )
+);
+
+/*****************************
+ *****************************/
+
+using SubsetBlockExtractorTest = SubsetBlockTest<std::tuple<bool, std::pair<double, double>, size_t> >;
+
+TEST_P(SubsetBlockExtractorTest, Basic) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    size_t JUMP = std::get<2>(param);
+    for (auto ptr : { dense_block, sparse_block }) {
+        test_extractor_row_access(ptr.get(), ref.get(), JUMP);
+        test_extractor_column_access(ptr.get(), ref.get(), JUMP);
+        test_extractor_row_access(ptr.get(), ref.get(), JUMP, 1, ptr->ncol() - 1);
+        test_extractor_column_access(ptr.get(), ref.get(), JUMP, 2, ptr->nrow() - 1);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedSubsetBlock,
+    SubsetBlockExtractorTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // row or column subsetting, respectively.
+        ::testing::Values(
+            std::make_pair(0.0, 0.5),
+            std::make_pair(0.25, 0.8),
+            std::make_pair(0.4, 1)
+        ),
+        ::testing::Values(1, 3) // jump between requests.
+    )
+);
+
+/*****************************
+ *****************************/
+
+using SubsetBlockNonZeroCountsTest = SubsetBlockTest<std::tuple<bool, std::pair<double, double> > >;
+
+TEST_P(SubsetBlockNonZeroCountsTest, Basic) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    // The underlying matrix is CSC, so counts are only available when subsetting columns.
+    bool by_row = std::get<0>(param);
+    test_nonzero_counts(sparse_block.get(), false, !by_row, !by_row);
+    test_nonzero_counts(dense_block.get(), false, false, false);
+}
+
+TEST_P(SubsetBlockNonZeroCountsTest, Views) {
+    auto param = GetParam();
+    extra_assemble(param);
+
+    // Dense views are available on either side of the block, but sparse views are only available along it.
+    bool by_row = std::get<0>(param);
+    test_view_row_access(dense_block.get(), ref.get(), true, false);
+    test_view_column_access(dense_block.get(), ref.get(), false, false);
+    test_view_row_access(sparse_block.get(), ref.get(), false, false);
+    test_view_column_access(sparse_block.get(), ref.get(), false, !by_row);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DelayedSubsetBlock,
+    SubsetBlockNonZeroCountsTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // row or column subsetting, respectively.
+        ::testing::Values(
+            std::make_pair(0.0, 0.5),
+            std::make_pair(0.25, 0.8),
+            std::make_pair(0.4, 1)
+        )
+    )
+);
@@ -6,9 +6,15 @@
 #include "tatami/base/DenseMatrix.hpp"
 #include "tatami/base/DelayedTranspose.hpp"
 #include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/utils/convert_to_dense.hpp"
 
 #include "../data/data.h"
 #include "TestCore.h"
+#include "../_tests/test_block_access.h"
+#include "../_tests/test_indexed_access.h"
+#include "../_tests/test_extractor_access.h"
+#include "../_tests/test_nonzero_counts.h"
+#include "../_tests/test_view_access.h"
 
 template<class PARAM>
 class TransposeTest: public TestCore<::testing::TestWithParam<PARAM> > {
@@ -155,3 +161,87 @@ INSTANTIATE_TEST_CASE_P(
 );
 
 
+
+using TransposeBlockTest = TransposeTest<int>;
+
+TEST_P(TransposeBlockTest, Basic) {
+    size_t STEP = GetParam();
+    auto ref = tatami::convert_to_dense<true>(tdense.get());
+    for (auto ptr : { tdense, tsparse }) {
+        test_block_row_access(ptr.get(), ref.get(), STEP);
+        test_block_column_access(ptr.get(), ref.get(), STEP);
+        test_block_row_access(ptr.get(), ref.get(), STEP, 3, ptr->ncol());
+        test_block_column_access(ptr.get(), ref.get(), STEP, 1, ptr->nrow() - 2);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    TransposeTest,
+    TransposeBlockTest,
+    ::testing::Values(1, 3, 8) // number of rows/columns in each block.
+);
+
+using TransposeIndexedTest = TransposeTest<int>;
+
+TEST_P(TransposeIndexedTest, Basic) {
+    size_t JUMP = GetParam();
+    auto ref = tatami::convert_to_dense<true>(tdense.get());
+    for (auto ptr : { tdense, tsparse }) {
+        test_indexed_row_access(ptr.get(), ref.get(), 1, 0, JUMP);
+        test_indexed_column_access(ptr.get(), ref.get(), 1, 0, JUMP);
+        test_indexed_row_access(ptr.get(), ref.get(), 3, 2, JUMP);
+        test_indexed_column_access(ptr.get(), ref.get(), 3, 1, JUMP);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    TransposeTest,
+    TransposeIndexedTest,
+    ::testing::Values(1, 3, 8) // jump between indices.
+);
+
+using TransposeExtractorTest = TransposeTest<int>;
+
+TEST_P(TransposeExtractorTest, Basic) {
+    size_t JUMP = GetParam();
+    auto ref = tatami::convert_to_dense<true>(tdense.get());
+    for (auto ptr : { tdense, tsparse }) {
+        test_extractor_row_access(ptr.get(), ref.get(), JUMP);
+        test_extractor_column_access(ptr.get(), ref.get(), JUMP);
+        test_extractor_row_access(ptr.get(), ref.get(), JUMP, 3, ptr->ncol());
+        test_extractor_column_access(ptr.get(), ref.get(), JUMP, 1, ptr->nrow() - 2);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    TransposeTest,
+    TransposeExtractorTest,
+    ::testing::Values(1, 3) // jump between requests.
+);
+
+using TransposeNonZeroCountsTest = TransposeTest<int>;
+
+TEST_F(TransposeNonZeroCountsTest, Basic) {
+    // Column counts of the CSC matrix become row counts after transposition.
+    test_nonzero_counts(tsparse.get(), true, false, true);
+    test_nonzero_counts(tdense.get(), false, false, false);
+}
+
+TEST_F(TransposeNonZeroCountsTest, Views) {
+    // Row views of the row-major matrix become column views after transposition.
+    auto ref = tatami::convert_to_dense<true>(tdense.get());
+    test_view_row_access(tdense.get(), ref.get(), false, false);
+    test_view_column_access(tdense.get(), ref.get(), true, false);
+    test_view_row_access(tsparse.get(), ref.get(), false, true);
+    test_view_column_access(tsparse.get(), ref.get(), false, false);
+}
+
+TEST_F(TransposeNonZeroCountsTest, MemoryUsage) {
+    EXPECT_GT(tsparse->memory_usage(), sparse->memory_usage());
+    EXPECT_GT(tdense->memory_usage(), dense->memory_usage());
+
+    // Workspaces are swapped with respect to the underlying matrix.
+    EXPECT_EQ(tsparse->workspace_memory_usage(true), sparse->workspace_memory_usage(false));
+    EXPECT_EQ(tsparse->workspace_memory_usage(false), sparse->workspace_memory_usage(true));
+    EXPECT_EQ(tsparse->workspace_memory_usage(true), 0);
+}
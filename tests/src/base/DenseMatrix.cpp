@@ -7,6 +7,10 @@
 #include "tatami/base/DenseMatrix.hpp"
 #include "../_tests/test_column_access.h"
 #include "../_tests/test_row_access.h"
+#include "../_tests/test_block_access.h"
+#include "../_tests/test_indexed_access.h"
+#include "../_tests/test_extractor_access.h"
+#include "../_tests/test_view_access.h"
 #include "../_tests/simulate_vector.h"
 
 TEST(DenseMatrix, Basic) {
@@ -52,6 +56,11 @@ TEST(DenseMatrix, OddsAndEnds) {
     std::iota(more_contents.begin(), more_contents.end(), 1);
     tatami::DenseColumnMatrix<double, int, std::deque<double> > mat2(10, 20, more_contents);
     EXPECT_EQ(more_contents.size(), 200);
+
+    // No views are available without contiguous storage.
+    EXPECT_FALSE(mat2.has_dense_view(false));
+    const double* view;
+    EXPECT_FALSE(mat2.column_view(0, view));
 }
 
 /*************************************
@@ -95,6 +104,14 @@ TEST_F(DenseUtilsTest, Basic) {
     EXPECT_FALSE(dense_row->sparse());
 }
 
+TEST_F(DenseUtilsTest, Views) {
+    // Only available along the storage order.
+    test_view_row_access(dense_row.get(), dense_column.get(), true, false);
+    test_view_column_access(dense_row.get(), dense_column.get(), false, false);
+    test_view_row_access(dense_column.get(), dense_row.get(), false, false);
+    test_view_column_access(dense_column.get(), dense_row.get(), true, false);
+}
+
 /*************************************
  *************************************/
 
@@ -157,3 +174,104 @@ INSTANTIATE_TEST_CASE_P(
         )
     )
 );
+
+/*************************************
+ *************************************/
+
+class DenseBlockAccessTest : public ::testing::TestWithParam<std::tuple<size_t, std::pair<size_t, size_t> > >, public DenseTestMethods {
+protected:
+    void SetUp() {
+        assemble();
+        return;
+    }
+};
+
+TEST_P(DenseBlockAccessTest, Full) {
+    size_t STEP = std::get<0>(GetParam());
+    test_block_row_access(dense_row.get(), dense_column.get(), STEP);
+    test_block_row_access(dense_column.get(), dense_row.get(), STEP);
+    test_block_column_access(dense_row.get(), dense_column.get(), STEP);
+    test_block_column_access(dense_column.get(), dense_row.get(), STEP);
+}
+
+TEST_P(DenseBlockAccessTest, Sliced) {
+    auto param = GetParam();
+    size_t STEP = std::get<0>(param);
+    auto interval = std::get<1>(param);
+    test_block_row_access(dense_row.get(), dense_column.get(), STEP, interval.first, interval.second);
+    test_block_row_access(dense_column.get(), dense_row.get(), STEP, interval.first, interval.second);
+    test_block_column_access(dense_row.get(), dense_column.get(), STEP, interval.first, interval.second);
+    test_block_column_access(dense_column.get(), dense_row.get(), STEP, interval.first, interval.second);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DenseMatrix,
+    DenseBlockAccessTest,
+    ::testing::Combine(
+        ::testing::Values(1, 7, 50), // number of rows/columns in each block.
+        ::testing::Values(
+            std::make_pair(0, 10),
+            std::make_pair(13, 57),
+            std::make_pair(50, 100)
+        )
+    )
+);
+
+/*************************************
+ *************************************/
+
+class DenseIndexedAccessTest : public ::testing::TestWithParam<std::tuple<size_t, std::pair<size_t, size_t> > >, public DenseTestMethods {
+protected:
+    void SetUp() {
+        assemble();
+        return;
+    }
+};
+
+TEST_P(DenseIndexedAccessTest, Basic) {
+    auto param = GetParam();
+    size_t STEP = std::get<0>(param);
+    auto jump = std::get<1>(param);
+    test_indexed_row_access(dense_row.get(), dense_column.get(), STEP, jump.first, jump.second);
+    test_indexed_row_access(dense_column.get(), dense_row.get(), STEP, jump.first, jump.second);
+    test_indexed_column_access(dense_row.get(), dense_column.get(), STEP, jump.first, jump.second);
+    test_indexed_column_access(dense_column.get(), dense_row.get(), STEP, jump.first, jump.second);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DenseMatrix,
+    DenseIndexedAccessTest,
+    ::testing::Combine(
+        ::testing::Values(1, 3), // jump between rows/columns.
+        ::testing::Values(
+            std::make_pair(0, 1), // start and jump between indices.
+            std::make_pair(3, 5),
+            std::make_pair(10, 13)
+        )
+    )
+);
+
+/*************************************
+ *************************************/
+
+class DenseExtractorTest : public ::testing::TestWithParam<size_t>, public DenseTestMethods {
+protected:
+    void SetUp() {
+        assemble();
+        return;
+    }
+};
+
+TEST_P(DenseExtractorTest, Basic) {
+    size_t JUMP = GetParam();
+    test_extractor_row_access(dense_row.get(), dense_column.get(), JUMP);
+    test_extractor_column_access(dense_row.get(), dense_column.get(), JUMP);
+    test_extractor_row_access(dense_column.get(), dense_row.get(), JUMP, 13, 57);
+    test_extractor_column_access(dense_column.get(), dense_row.get(), JUMP, 50, 100);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    DenseMatrix,
+    DenseExtractorTest,
+    ::testing::Values(1, 3, 7) // jump between requests.
+);
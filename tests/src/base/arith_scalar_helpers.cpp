@@ -7,9 +7,14 @@
 #include "tatami/base/DenseMatrix.hpp"
 #include "tatami/base/DelayedIsometricOp.hpp"
 #include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/utils/convert_to_dense.hpp"
 
 #include "../data/data.h"
 #include "TestCore.h"
+#include "../_tests/test_block_access.h"
+#include "../_tests/test_indexed_access.h"
+#include "../_tests/test_extractor_access.h"
+#include "../_tests/test_nonzero_counts.h"
 
 template<class PARAM> 
 class ArithScalarTest : public TestCore<::testing::TestWithParam<PARAM> > {
@@ -201,3 +206,106 @@ INSTANTIATE_TEST_CASE_P(
         ::testing::Values(true, false)
     )
 );
+
+/****************************
+ ********* BLOCKS ***********
+ ****************************/
+
+class ArithScalarBlockTest : public ArithScalarTest<size_t> {};
+
+TEST_P(ArithScalarBlockTest, Basic) {
+    size_t STEP = GetParam();
+
+    // Checking both sparsity-preserving and -breaking operations.
+    auto dense_add = tatami::make_DelayedIsometricOp(dense, tatami::DelayedAddScalarHelper<double>(5));
+    auto sparse_add = tatami::make_DelayedIsometricOp(sparse, tatami::DelayedAddScalarHelper<double>(5));
+    auto dense_mult = tatami::make_DelayedIsometricOp(dense, tatami::DelayedMultiplyScalarHelper<double>(3));
+    auto sparse_mult = tatami::make_DelayedIsometricOp(sparse, tatami::DelayedMultiplyScalarHelper<double>(3));
+
+    for (auto ptr : { dense_add, sparse_add, dense_mult, sparse_mult }) {
+        auto ref = tatami::convert_to_dense<true>(ptr.get());
+        test_block_row_access(ptr.get(), ref.get(), STEP);
+        test_block_column_access(ptr.get(), ref.get(), STEP);
+        test_block_row_access(ptr.get(), ref.get(), STEP, 2, ptr->ncol() - 1);
+        test_block_column_access(ptr.get(), ref.get(), STEP, 3, ptr->nrow());
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ArithScalar,
+    ArithScalarBlockTest,
+    ::testing::Values(1, 3, 8) // number of rows/columns in each block.
+);
+
+/****************************
+ ********* INDEXED **********
+ ****************************/
+
+class ArithScalarIndexedTest : public ArithScalarTest<size_t> {};
+
+TEST_P(ArithScalarIndexedTest, Basic) {
+    size_t JUMP = GetParam();
+
+    // Checking both sparsity-preserving and -breaking operations.
+    auto dense_add = tatami::make_DelayedIsometricOp(dense, tatami::DelayedAddScalarHelper<double>(5));
+    auto sparse_add = tatami::make_DelayedIsometricOp(sparse, tatami::DelayedAddScalarHelper<double>(5));
+    auto dense_mult = tatami::make_DelayedIsometricOp(dense, tatami::DelayedMultiplyScalarHelper<double>(3));
+    auto sparse_mult = tatami::make_DelayedIsometricOp(sparse, tatami::DelayedMultiplyScalarHelper<double>(3));
+
+    for (auto ptr : { dense_add, sparse_add, dense_mult, sparse_mult }) {
+        auto ref = tatami::convert_to_dense<true>(ptr.get());
+        test_indexed_row_access(ptr.get(), ref.get(), 1, 0, JUMP);
+        test_indexed_column_access(ptr.get(), ref.get(), 1, 0, JUMP);
+        test_indexed_row_access(ptr.get(), ref.get(), 3, 2, JUMP);
+        test_indexed_column_access(ptr.get(), ref.get(), 3, 1, JUMP);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ArithScalar,
+    ArithScalarIndexedTest,
+    ::testing::Values(1, 3, 8) // jump between indices.
+);
+
+/****************************
+ ******** EXTRACTOR *********
+ ****************************/
+
+class ArithScalarExtractorTest : public ArithScalarTest<size_t> {};
+
+TEST_P(ArithScalarExtractorTest, Basic) {
+    size_t JUMP = GetParam();
+
+    // Checking both sparsity-preserving and -breaking operations.
+    auto dense_add = tatami::make_DelayedIsometricOp(dense, tatami::DelayedAddScalarHelper<double>(5));
+    auto sparse_add = tatami::make_DelayedIsometricOp(sparse, tatami::DelayedAddScalarHelper<double>(5));
+    auto dense_mult = tatami::make_DelayedIsometricOp(dense, tatami::DelayedMultiplyScalarHelper<double>(3));
+    auto sparse_mult = tatami::make_DelayedIsometricOp(sparse, tatami::DelayedMultiplyScalarHelper<double>(3));
+
+    for (auto ptr : { dense_add, sparse_add, dense_mult, sparse_mult }) {
+        auto ref = tatami::convert_to_dense<true>(ptr.get());
+        test_extractor_row_access(ptr.get(), ref.get(), JUMP);
+        test_extractor_column_access(ptr.get(), ref.get(), JUMP);
+        test_extractor_row_access(ptr.get(), ref.get(), JUMP, 2, ptr->ncol() - 1);
+        test_extractor_column_access(ptr.get(), ref.get(), JUMP, 3, ptr->nrow() - 2);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ArithScalar,
+    ArithScalarExtractorTest,
+    ::testing::Values(1, 3) // jump between requests.
+);
+
+/****************************
+ ****** NON-ZERO COUNTS *****
+ ****************************/
+
+class ArithScalarNonZeroCountsTest : public ArithScalarTest<int> {};
+
+TEST_F(ArithScalarNonZeroCountsTest, Basic) {
+    // Counts are only propagated for sparsity-preserving operations.
+    test_nonzero_counts(tatami::make_DelayedIsometricOp(sparse, tatami::DelayedMultiplyScalarHelper<double>(3)).get(), false, true, true);
+    test_nonzero_counts(tatami::make_DelayedIsometricOp(sparse, tatami::DelayedAddScalarHelper<double>(5)).get(), false, false, false);
+    test_nonzero_counts(tatami::make_DelayedIsometricOp(dense, tatami::DelayedMultiplyScalarHelper<double>(3)).get(), false, false, false);
+}
@@ -949,3 +949,133 @@ INSTANTIATE_TEST_CASE_P(
 );
 
 
+
+/****************************
+ ***** BULK OPERATIONS ******
+ ****************************/
+
+// Hides the bulk methods of the helper, so that the operation is applied to
+// each element separately.
+template<class OP>
+struct ElementwiseOnly {
+    ElementwiseOnly(OP o) : op(std::move(o)) {}
+    double operator()(size_t r, size_t c, double val) const {
+        return op(r, c, val);
+    }
+    static const bool sparse = OP::sparse;
+    OP op;
+};
+
+class ArithVectorBulkTest : public ArithVectorTest<int> {
+protected:
+    template<class OP>
+    void compare(OP op) {
+        static_assert(tatami::has_dense_apply<OP, double>::value);
+        static_assert(tatami::has_sparse_apply<OP, double, int>::value);
+        static_assert(!tatami::has_dense_apply<ElementwiseOnly<OP>, double>::value);
+        static_assert(!tatami::has_sparse_apply<ElementwiseOnly<OP>, double, int>::value);
+
+        for (auto mat : { dense, sparse }) {
+            auto bulk = tatami::make_DelayedIsometricOp(mat, op);
+            auto ref = tatami::make_DelayedIsometricOp(mat, ElementwiseOnly<OP>(op));
+            size_t NR = mat->nrow(), NC = mat->ncol();
+
+            for (size_t r = 0; r < NR; ++r) {
+                EXPECT_EQ(extract_dense<true>(bulk.get(), r), extract_dense<true>(ref.get(), r));
+                EXPECT_EQ(extract_sparse<true>(bulk.get(), r), extract_sparse<true>(ref.get(), r));
+                EXPECT_EQ(extract_dense<true>(bulk.get(), r, 1, NC - 2), extract_dense<true>(ref.get(), r, 1, NC - 2));
+                EXPECT_EQ(extract_sparse<true>(bulk.get(), r, 1, NC - 2), extract_sparse<true>(ref.get(), r, 1, NC - 2));
+            }
+
+            for (size_t c = 0; c < NC; ++c) {
+                EXPECT_EQ(extract_dense<false>(bulk.get(), c), extract_dense<false>(ref.get(), c));
+                EXPECT_EQ(extract_sparse<false>(bulk.get(), c), extract_sparse<false>(ref.get(), c));
+                EXPECT_EQ(extract_dense<false>(bulk.get(), c, 2, NR - 1), extract_dense<false>(ref.get(), c, 2, NR - 1));
+                EXPECT_EQ(extract_sparse<false>(bulk.get(), c, 2, NR - 1), extract_sparse<false>(ref.get(), c, 2, NR - 1));
+            }
+
+            // Checking the block and indexed extraction methods.
+            {
+                std::vector<double> buffer1(NR * NC), buffer2(NR * NC);
+                auto out1 = bulk->rows(1, NR - 1, buffer1.data(), 2, NC);
+                auto out2 = ref->rows(1, NR - 1, buffer2.data(), 2, NC);
+                size_t n = (NR - 2) * (NC - 2);
+                EXPECT_EQ(std::vector<double>(out1, out1 + n), std::vector<double>(out2, out2 + n));
+
+                out1 = bulk->columns(0, NC - 1, buffer1.data(), 3, NR);
+                out2 = ref->columns(0, NC - 1, buffer2.data(), 3, NR);
+                n = (NC - 1) * (NR - 3);
+                EXPECT_EQ(std::vector<double>(out1, out1 + n), std::vector<double>(out2, out2 + n));
+
+                std::vector<int> ibuffer1(NR * NC), ibuffer2(NR * NC);
+                std::vector<size_t> pbuffer1(NC + 1), pbuffer2(NC + 1);
+                auto sout1 = bulk->sparse_columns(1, NC, buffer1.data(), ibuffer1.data(), pbuffer1.data(), 0, NR - 2);
+                auto sout2 = ref->sparse_columns(1, NC, buffer2.data(), ibuffer2.data(), pbuffer2.data(), 0, NR - 2);
+                ASSERT_EQ(sout1.number, sout2.number);
+                EXPECT_EQ(pbuffer1, pbuffer2);
+                EXPECT_EQ(std::vector<double>(sout1.value, sout1.value + sout1.number), std::vector<double>(sout2.value, sout2.value + sout2.number));
+                EXPECT_EQ(std::vector<int>(sout1.index, sout1.index + sout1.number), std::vector<int>(sout2.index, sout2.index + sout2.number));
+            }
+
+            {
+                std::vector<int> rindices, cindices;
+                for (size_t r = 0; r < NR; r += 3) {
+                    rindices.push_back(r);
+                }
+                for (size_t c = 1; c < NC; c += 2) {
+                    cindices.push_back(c);
+                }
+
+                std::vector<double> buffer1(std::max(NR, NC)), buffer2(buffer1.size());
+                for (size_t r = 0; r < NR; ++r) {
+                    auto out1 = bulk->row_indexed(r, buffer1.data(), cindices.size(), cindices.data());
+                    auto out2 = ref->row_indexed(r, buffer2.data(), cindices.size(), cindices.data());
+                    EXPECT_EQ(std::vector<double>(out1, out1 + cindices.size()), std::vector<double>(out2, out2 + cindices.size()));
+                }
+                for (size_t c = 0; c < NC; ++c) {
+                    auto out1 = bulk->column_indexed(c, buffer1.data(), rindices.size(), rindices.data());
+                    auto out2 = ref->column_indexed(c, buffer2.data(), rindices.size(), rindices.data());
+                    EXPECT_EQ(std::vector<double>(out1, out1 + rindices.size()), std::vector<double>(out2, out2 + rindices.size()));
+                }
+            }
+
+            // Checking the extractors.
+            {
+                auto bext = bulk->dense_column_extractor(1, NR);
+                auto rext = ref->dense_column_extractor(1, NR);
+                std::vector<double> buffer1(NR), buffer2(NR);
+                for (size_t c = 0; c < NC; ++c) {
+                    auto out1 = bext->fetch(c, buffer1.data());
+                    auto out2 = rext->fetch(c, buffer2.data());
+                    EXPECT_EQ(std::vector<double>(out1, out1 + NR - 1), std::vector<double>(out2, out2 + NR - 1));
+                }
+
+                auto bsext = bulk->sparse_row_extractor(0, NC - 1);
+                auto rsext = ref->sparse_row_extractor(0, NC - 1);
+                std::vector<double> vbuffer1(NC), vbuffer2(NC);
+                std::vector<int> ibuffer1(NC), ibuffer2(NC);
+                for (size_t r = 0; r < NR; ++r) {
+                    auto out1 = bsext->fetch(r, vbuffer1.data(), ibuffer1.data());
+                    auto out2 = rsext->fetch(r, vbuffer2.data(), ibuffer2.data());
+                    ASSERT_EQ(out1.number, out2.number);
+                    EXPECT_EQ(std::vector<double>(out1.value, out1.value + out1.number), std::vector<double>(out2.value, out2.value + out2.number));
+                    EXPECT_EQ(std::vector<int>(out1.index, out1.index + out1.number), std::vector<int>(out2.index, out2.index + out2.number));
+                }
+            }
+        }
+    }
+};
+
+TEST_F(ArithVectorBulkTest, Margins) {
+    auto rvec = create_vector(dense->nrow(), -2.1, 0.5); // no zeros, to avoid NaNs from division.
+    auto cvec = create_vector(dense->ncol(), 1, 0.25);
+
+    compare(tatami::make_DelayedAddVectorHelper<0>(rvec));
+    compare(tatami::make_DelayedAddVectorHelper<1>(cvec));
+    compare(tatami::make_DelayedSubtractVectorHelper<true, 0>(rvec));
+    compare(tatami::make_DelayedSubtractVectorHelper<false, 1>(cvec));
+    compare(tatami::make_DelayedMultiplyVectorHelper<0>(rvec));
+    compare(tatami::make_DelayedMultiplyVectorHelper<1>(cvec));
+    compare(tatami::make_DelayedDivideVectorHelper<true, 1>(cvec));
+    compare(tatami::make_DelayedDivideVectorHelper<false, 0>(rvec));
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <cmath>
+
+#include "tatami/base/DenseMatrix.hpp"
+#include "tatami/base/DelayedIsometricOp.hpp"
+#include "tatami/utils/convert_to_sparse.hpp"
+
+#include "../data/data.h"
+#include "../_tests/simulate_vector.h"
+#include "TestCore.h"
+
+class ComposeTest : public TestCore<::testing::Test> {
+protected:
+    std::shared_ptr<tatami::NumericMatrix> dense, sparse;
+    std::vector<double> size_factors, centers;
+
+    void SetUp() {
+        dense = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+        sparse = tatami::convert_to_sparse<false>(dense.get()); // column major.
+
+        size_factors.resize(dense->ncol());
+        for (size_t c = 0; c < size_factors.size(); ++c) {
+            size_factors[c] = 0.5 + c * 0.1;
+        }
+        centers.resize(dense->nrow());
+        for (size_t r = 0; r < centers.size(); ++r) {
+            centers[r] = r * 0.2 - 1;
+        }
+    }
+
+    // Typical normalization pipeline.
+    std::shared_ptr<tatami::NumericMatrix> normalize(std::shared_ptr<tatami::NumericMatrix> mat, bool center) const {
+        auto abs = tatami::make_DelayedIsometricOp(mat, tatami::DelayedAbsHelper());
+        auto div = tatami::make_DelayedIsometricOp(abs, tatami::make_DelayedDivideVectorHelper<true, 1>(size_factors));
+        auto log = tatami::make_DelayedIsometricOp(div, tatami::DelayedLog1pHelper(2.0));
+        if (!center) {
+            return log;
+        }
+        auto sub = tatami::make_DelayedIsometricOp(log, tatami::make_DelayedSubtractVectorHelper<true, 0>(centers));
+        return tatami::make_DelayedIsometricOp(sub, tatami::DelayedMultiplyScalarHelper<double>(2));
+    }
+
+    double reference(size_t r, size_t c, bool center) const {
+        double val = std::log1p(std::abs(sparse_matrix[r * sparse_ncol + c]) / size_factors[c]) / std::log(2.0);
+        if (center) {
+            val = (val - centers[r]) * 2;
+        }
+        return val;
+    }
+};
+
+TEST_F(ComposeTest, Fusion) {
+    for (auto center : { false, true }) {
+        for (auto mat : { dense, sparse }) {
+            auto fused = normalize(mat, center);
+
+            // All layers are fused into a single chain around the original matrix.
+            typedef tatami::DelayedIsometricOp<double, int, tatami::DelayedChainHelper<double, int, false> > DenseChain;
+            typedef tatami::DelayedIsometricOp<double, int, tatami::DelayedChainHelper<double, int, true> > SparseChain;
+            if (center) {
+                EXPECT_TRUE(dynamic_cast<const DenseChain*>(fused.get()) != NULL);
+            } else {
+                EXPECT_TRUE(dynamic_cast<const SparseChain*>(fused.get()) != NULL);
+            }
+            EXPECT_EQ(fused->sparse(), mat->sparse() && !center);
+            EXPECT_EQ(fused->prefer_rows(), mat->prefer_rows());
+
+            for (size_t c = 0; c < mat->ncol(); ++c) {
+                std::vector<double> expected(mat->nrow());
+                for (size_t r = 0; r < mat->nrow(); ++r) {
+                    expected[r] = reference(r, c, center);
+                }
+                auto outputD = extract_dense<false>(fused.get(), c);
+                for (size_t r = 0; r < mat->nrow(); ++r) {
+                    EXPECT_FLOAT_EQ(outputD[r], expected[r]);
+                }
+                auto outputS = extract_sparse<false>(fused.get(), c);
+                EXPECT_EQ(outputS, outputD);
+            }
+
+            for (size_t r = 0; r < mat->nrow(); ++r) {
+                std::vector<double> expected(mat->ncol());
+                for (size_t c = 0; c < mat->ncol(); ++c) {
+                    expected[c] = reference(r, c, center);
+                }
+                auto outputD = extract_dense<true>(fused.get(), r);
+                for (size_t c = 0; c < mat->ncol(); ++c) {
+                    EXPECT_FLOAT_EQ(outputD[c], expected[c]);
+                }
+                auto outputS = extract_sparse<true>(fused.get(), r, 1, mat->ncol() - 1);
+                EXPECT_EQ(outputS, std::vector<double>(outputD.begin() + 1, outputD.end() - 1));
+            }
+        }
+    }
+}
+
+TEST_F(ComposeTest, Independence) {
+    // Intermediate layers are not affected by fusion.
+    auto abs = tatami::make_DelayedIsometricOp(sparse, tatami::DelayedAbsHelper());
+    auto mult = tatami::make_DelayedIsometricOp(abs, tatami::DelayedMultiplyScalarHelper<double>(3));
+    auto add = tatami::make_DelayedIsometricOp(abs, tatami::DelayedAddScalarHelper<double>(1));
+    EXPECT_TRUE(abs->sparse());
+    EXPECT_TRUE(mult->sparse());
+    EXPECT_FALSE(add->sparse());
+
+    for (size_t c = 0; c < sparse->ncol(); ++c) {
+        auto base = extract_dense<false>(sparse.get(), c);
+        auto outA = extract_dense<false>(abs.get(), c);
+        auto outM = extract_sparse<false>(mult.get(), c);
+        auto outP = extract_sparse<false>(add.get(), c);
+        for (size_t r = 0; r < sparse->nrow(); ++r) {
+            EXPECT_EQ(outA[r], std::abs(base[r]));
+            EXPECT_EQ(outM[r], std::abs(base[r]) * 3);
+            EXPECT_EQ(outP[r], std::abs(base[r]) + 1);
+        }
+    }
+}
+
+TEST_F(ComposeTest, CompileTime) {
+    auto op = tatami::make_DelayedComposedHelper(
+        tatami::make_DelayedMultiplyVectorHelper<0>(centers),
+        tatami::make_DelayedAddVectorHelper<1>(size_factors)
+    );
+    EXPECT_FALSE(decltype(op)::sparse);
+
+    auto nested = tatami::make_DelayedIsometricOp(
+        tatami::make_DelayedIsometricOp(sparse, tatami::make_DelayedMultiplyVectorHelper<0>(centers)),
+        tatami::make_DelayedAddVectorHelper<1>(size_factors)
+    );
+
+    for (auto mat : { dense, sparse }) {
+        auto composed = tatami::make_DelayedIsometricOp(mat, op);
+        EXPECT_FALSE(composed->sparse());
+        for (size_t r = 0; r < mat->nrow(); ++r) {
+            EXPECT_EQ(extract_dense<true>(composed.get(), r), extract_dense<true>(nested.get(), r));
+            EXPECT_EQ(extract_sparse<true>(composed.get(), r), extract_dense<true>(nested.get(), r));
+        }
+        for (size_t c = 0; c < mat->ncol(); ++c) {
+            EXPECT_EQ(extract_dense<false>(composed.get(), c, 2, mat->nrow() - 3), extract_dense<false>(nested.get(), c, 2, mat->nrow() - 3));
+        }
+    }
+
+    auto sop = tatami::make_DelayedComposedHelper(tatami::DelayedSqrtHelper(), tatami::DelayedRoundHelper());
+    EXPECT_TRUE(decltype(sop)::sparse);
+}
+
+TEST(ComposeChunks, AcrossChunkBoundaries) {
+    // More elements than the chunk size, to check that the indices are correctly offset for each chunk.
+    size_t NR = 3, NC = 2500;
+    auto dump = simulate_sparse_vector<double>(NR * NC, 0.2);
+    auto dense = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+    auto sparse = tatami::convert_to_sparse<true>(dense.get());
+
+    std::vector<double> cvec(NC);
+    for (size_t c = 0; c < NC; ++c) {
+        cvec[c] = c + 1;
+    }
+
+    for (auto mat : { dense, sparse }) {
+        auto first = tatami::make_DelayedIsometricOp(mat, tatami::make_DelayedMultiplyVectorHelper<1>(cvec));
+        auto second = tatami::make_DelayedIsometricOp(first, tatami::make_DelayedDivideVectorHelper<true, 1>(cvec));
+        auto third = tatami::make_DelayedIsometricOp(second, tatami::make_DelayedAddVectorHelper<1>(cvec));
+
+        auto ext = third->dense_row_extractor(5, NC - 7);
+        std::vector<double> buffer(NC);
+        for (size_t r = 0; r < NR; ++r) {
+            auto out = ext->fetch(r, buffer.data());
+            for (size_t c = 5; c < NC - 7; ++c) {
+                EXPECT_FLOAT_EQ(out[c - 5], dump[r * NC + c] + cvec[c]);
+            }
+        }
+
+        auto sfirst = tatami::make_DelayedIsometricOp(mat, tatami::make_DelayedMultiplyVectorHelper<1>(cvec));
+        auto ssecond = tatami::make_DelayedIsometricOp(sfirst, tatami::make_DelayedDivideVectorHelper<true, 1>(cvec));
+        EXPECT_EQ(ssecond->sparse(), mat->sparse());
+        auto sext = ssecond->sparse_row_extractor();
+        std::vector<int> ibuffer(NC);
+        for (size_t r = 0; r < NR; ++r) {
+            auto out = sext->fetch(r, buffer.data(), ibuffer.data());
+            for (size_t i = 0; i < out.number; ++i) {
+                EXPECT_FLOAT_EQ(out.value[i], dump[r * NC + out.index[i]]);
+            }
+        }
+    }
+}
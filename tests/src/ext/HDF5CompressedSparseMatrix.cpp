@@ -17,6 +17,10 @@
 
 #include "../_tests/test_column_access.h"
 #include "../_tests/test_row_access.h"
+#include "../_tests/test_block_access.h"
+#include "../_tests/test_oracle_access.h"
+#include "../_tests/test_extractor_access.h"
+#include "../_tests/test_nonzero_counts.h"
 #include "../_tests/simulate_vector.h"
 
 class HDF5SparseMatrixTestMethods {
@@ -96,6 +100,39 @@ TEST_F(HDF5SparseUtilsTest, Basic) {
     }
 }
 
+TEST_F(HDF5SparseUtilsTest, NonZeroCounts) {
+    const size_t NR = 200, NC = 100;
+    dump(50, NR, NC);
+
+    // Only available along the primary dimension.
+    {
+        tatami::HDF5CompressedSparseMatrix<true, double, int> mat(NR, NC, fpath, name + "/data", name + "/index", name + "/indptr");
+        test_nonzero_counts(&mat, true, false, true);
+    }
+
+    {
+        tatami::HDF5CompressedSparseMatrix<false, double, int> mat(NC, NR, fpath, name + "/data", name + "/index", name + "/indptr");
+        test_nonzero_counts(&mat, false, true, true);
+    }
+}
+
+TEST_F(HDF5SparseUtilsTest, MemoryUsage) {
+    const size_t NR = 200, NC = 100;
+    dump(50, NR, NC);
+
+    tatami::HDF5CompressedSparseMatrix<true, double, int> mat(NR, NC, fpath, name + "/data", name + "/index", name + "/indptr");
+    EXPECT_GE(mat.memory_usage(), (NR + 1) * sizeof(hsize_t));
+
+    // The primary cache should be bounded by the cache limit.
+    size_t total = 0;
+    mat.nonzero_count(total);
+    EXPECT_GE(mat.workspace_memory_usage(true), total * (sizeof(double) + sizeof(int)));
+
+    tatami::HDF5CompressedSparseMatrix<true, double, int> mat2(NR, NC, fpath, name + "/data", name + "/index", name + "/indptr", 1000);
+    EXPECT_LT(mat2.workspace_memory_usage(true), mat.workspace_memory_usage(true));
+    EXPECT_LT(mat2.workspace_memory_usage(false), mat.workspace_memory_usage(true));
+}
+
 /*************************************
  *************************************/
 
@@ -307,3 +344,172 @@ INSTANTIATE_TEST_CASE_P(
         ::testing::Values(0, 10, 100) // chunk size
     )
 );
+
+/*************************************
+ *************************************/
+
+class HDF5SparseBlockTest : public ::testing::TestWithParam<std::tuple<size_t, int> >, public HDF5SparseMatrixTestMethods {};
+
+TEST_P(HDF5SparseBlockTest, Basic) {
+    auto param = GetParam(); 
+    size_t STEP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    const size_t NR = 50, NC = 20; // smaller for the secondary dimension.
+    dump(caching, NR, NC);
+
+    {
+        tatami::HDF5CompressedSparseMatrix<true, double, int> mat(NR, NC, fpath, name + "/data", name + "/index", name + "/indptr", NR * 2); 
+        tatami::CompressedSparseMatrix<
+            true, 
+            double, 
+            int, 
+            decltype(triplets.value), 
+            decltype(triplets.index), 
+            decltype(triplets.ptr)
+        > ref(NR, NC, triplets.value, triplets.index, triplets.ptr);
+
+        test_block_row_access(&mat, &ref, STEP);
+        test_block_column_access(&mat, &ref, STEP);
+        test_block_row_access(&mat, &ref, STEP, 3, 17);
+        test_block_column_access(&mat, &ref, STEP, 11, 42);
+    }
+
+    {
+        tatami::HDF5CompressedSparseMatrix<false, double, int> mat(NC, NR, fpath, name + "/data", name + "/index", name + "/indptr", NR * 2);
+        tatami::CompressedSparseMatrix<
+            false, 
+            double, 
+            int, 
+            decltype(triplets.value), 
+            decltype(triplets.index), 
+            decltype(triplets.ptr)
+        > ref(NC, NR, triplets.value, triplets.index, triplets.ptr);
+
+        test_block_row_access(&mat, &ref, STEP);
+        test_block_column_access(&mat, &ref, STEP);
+        test_block_row_access(&mat, &ref, STEP, 11, 42);
+        test_block_column_access(&mat, &ref, STEP, 3, 17);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    HDF5SparseMatrix,
+    HDF5SparseBlockTest,
+    ::testing::Combine(
+        ::testing::Values(1, 6, 25), // number of rows/columns in each block.
+        ::testing::Values(0, 10, 100) // chunk size
+    )
+);
+
+/*************************************
+ *************************************/
+
+class HDF5SparseOracleTest : public ::testing::TestWithParam<std::tuple<size_t, int> >, public HDF5SparseMatrixTestMethods {};
+
+TEST_P(HDF5SparseOracleTest, Basic) {
+    auto param = GetParam(); 
+    size_t JUMP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    const size_t NR = 100, NC = 40;
+    dump(caching, NR, NC);
+
+    {
+        tatami::HDF5CompressedSparseMatrix<true, double, int> mat(NR, NC, fpath, name + "/data", name + "/index", name + "/indptr", NR * 2); 
+        tatami::CompressedSparseMatrix<
+            true, 
+            double, 
+            int, 
+            decltype(triplets.value), 
+            decltype(triplets.index), 
+            decltype(triplets.ptr)
+        > ref(NR, NC, triplets.value, triplets.index, triplets.ptr);
+
+        test_oracle_row_access(&mat, &ref, JUMP);
+        test_oracle_row_access(&mat, &ref, JUMP, 5, 31);
+        test_oracle_column_access(&mat, &ref, JUMP);
+    }
+
+    {
+        tatami::HDF5CompressedSparseMatrix<false, double, int> mat(NC, NR, fpath, name + "/data", name + "/index", name + "/indptr", NR * 2);
+        tatami::CompressedSparseMatrix<
+            false, 
+            double, 
+            int, 
+            decltype(triplets.value), 
+            decltype(triplets.index), 
+            decltype(triplets.ptr)
+        > ref(NC, NR, triplets.value, triplets.index, triplets.ptr);
+
+        test_oracle_column_access(&mat, &ref, JUMP);
+        test_oracle_column_access(&mat, &ref, JUMP, 5, 31);
+        test_oracle_row_access(&mat, &ref, JUMP);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    HDF5SparseMatrix,
+    HDF5SparseOracleTest,
+    ::testing::Combine(
+        ::testing::Values(1, 3, 7), // jump between requests.
+        ::testing::Values(0, 10, 100) // chunk size
+    )
+);
+
+/*************************************
+ *************************************/
+
+class HDF5SparseExtractorTest : public ::testing::TestWithParam<std::tuple<size_t, int> >, public HDF5SparseMatrixTestMethods {};
+
+TEST_P(HDF5SparseExtractorTest, Basic) {
+    auto param = GetParam(); 
+    size_t JUMP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    const size_t NR = 100, NC = 40;
+    dump(caching, NR, NC);
+
+    {
+        tatami::HDF5CompressedSparseMatrix<true, double, int> mat(NR, NC, fpath, name + "/data", name + "/index", name + "/indptr", NR * 2); 
+        tatami::CompressedSparseMatrix<
+            true, 
+            double, 
+            int, 
+            decltype(triplets.value), 
+            decltype(triplets.index), 
+            decltype(triplets.ptr)
+        > ref(NR, NC, triplets.value, triplets.index, triplets.ptr);
+
+        test_extractor_row_access(&mat, &ref, JUMP);
+        test_extractor_row_access(&mat, &ref, JUMP, 5, 31);
+        test_extractor_column_access(&mat, &ref, JUMP);
+        test_extractor_column_access(&mat, &ref, JUMP, 11, 87);
+    }
+
+    {
+        tatami::HDF5CompressedSparseMatrix<false, double, int> mat(NC, NR, fpath, name + "/data", name + "/index", name + "/indptr", NR * 2);
+        tatami::CompressedSparseMatrix<
+            false, 
+            double, 
+            int, 
+            decltype(triplets.value), 
+            decltype(triplets.index), 
+            decltype(triplets.ptr)
+        > ref(NC, NR, triplets.value, triplets.index, triplets.ptr);
+
+        test_extractor_column_access(&mat, &ref, JUMP);
+        test_extractor_column_access(&mat, &ref, JUMP, 5, 31);
+        test_extractor_row_access(&mat, &ref, JUMP);
+        test_extractor_row_access(&mat, &ref, JUMP, 11, 87);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    HDF5SparseMatrix,
+    HDF5SparseExtractorTest,
+    ::testing::Combine(
+        ::testing::Values(1, 7), // jump between requests.
+        ::testing::Values(0, 100) // chunk size
+    )
+);
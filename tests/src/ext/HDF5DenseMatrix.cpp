@@ -18,6 +18,10 @@ std::mutex hdf5_lock; // declared in hdf5_custom_lock.h, defined here.
 
 #include "../_tests/test_column_access.h"
 #include "../_tests/test_row_access.h"
+#include "../_tests/test_block_access.h"
+#include "../_tests/test_indexed_access.h"
+#include "../_tests/test_oracle_access.h"
+#include "../_tests/test_extractor_access.h"
 #include "../_tests/simulate_vector.h"
 
 const size_t NR = 200, NC = 100;
@@ -159,6 +163,39 @@ TEST_P(HDF5DenseAccessTest, Apply) {
     EXPECT_EQ(tatami::column_sums(&mat), tatami::column_sums(&ref));
 }
 
+TEST_P(HDF5DenseAccessTest, ApplyTiled) {
+    auto param = GetParam(); 
+    auto caching = std::get<2>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int> mat(fpath, name);
+    tatami::DenseRowMatrix<double, int> ref(NR, NC, values);
+
+    typedef std::pair<size_t, size_t> Tiles;
+    auto expected_tiles = (caching.first == 0 ? Tiles(1, NC) : Tiles(caching.first, caching.second));
+    EXPECT_EQ(mat.tile_dimensions(), expected_tiles);
+
+    auto tmat = tatami::make_DelayedTranspose(std::shared_ptr<tatami::NumericMatrix>(new tatami::HDF5DenseMatrix<double, int>(fpath, name)));
+    EXPECT_EQ(tmat->tile_dimensions(), std::make_pair(expected_tiles.second, expected_tiles.first));
+
+    // Using small tiles to force multiple tiles in each dimension.
+    for (size_t limit : { static_cast<size_t>(1000), static_cast<size_t>(100000000) }) {
+        std::vector<double> rows(NR);
+        tatami::stats::SumFactory rfactory(rows.data(), NR, NC);
+        tatami::apply_tiled<0>(&mat, rfactory, 1, limit);
+        EXPECT_EQ(rows, tatami::row_sums(&ref));
+
+        std::vector<double> cols(NC);
+        tatami::stats::SumFactory cfactory(cols.data(), NC, NR);
+        tatami::apply_tiled<1>(&mat, cfactory, 3, limit);
+        EXPECT_EQ(cols, tatami::column_sums(&ref));
+
+        std::vector<double> trows(NC);
+        tatami::stats::SumFactory tfactory(trows.data(), NC, NR);
+        tatami::apply_tiled<0>(tmat.get(), tfactory, 3, limit);
+        EXPECT_EQ(trows, tatami::column_sums(&ref));
+    }
+}
+
 INSTANTIATE_TEST_CASE_P(
     HDF5DenseMatrix,
     HDF5DenseAccessTest,
@@ -235,3 +272,195 @@ INSTANTIATE_TEST_CASE_P(
 
 /*************************************
  *************************************/
+
+class HDF5DenseBlockTest : public ::testing::TestWithParam<std::tuple<size_t, std::pair<int, int> > >, public HDF5DenseMatrixTestMethods {};
+
+TEST_P(HDF5DenseBlockTest, Basic) {
+    auto param = GetParam(); 
+    size_t STEP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int> mat(fpath, name, NR * 10);
+    tatami::DenseRowMatrix<double, int> ref(NR, NC, values);
+
+    test_block_row_access(&mat, &ref, STEP);
+    test_block_column_access(&mat, &ref, STEP);
+    test_block_row_access(&mat, &ref, STEP, 5, 67);
+    test_block_column_access(&mat, &ref, STEP, 13, 150);
+}
+
+TEST_P(HDF5DenseBlockTest, Transposed) {
+    auto param = GetParam(); 
+    size_t STEP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int, true> mat(fpath, name, NC * 5);
+    std::shared_ptr<tatami::Matrix<double, int> > ptr(new tatami::DenseRowMatrix<double, int>(NR, NC, values));
+    tatami::DelayedTranspose<double, int> ref(std::move(ptr));
+
+    test_block_row_access(&mat, &ref, STEP);
+    test_block_column_access(&mat, &ref, STEP);
+    test_block_row_access(&mat, &ref, STEP, 13, 150);
+    test_block_column_access(&mat, &ref, STEP, 5, 67);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    HDF5DenseMatrix,
+    HDF5DenseBlockTest,
+    ::testing::Combine(
+        ::testing::Values(1, 9, 40), // number of rows/columns in each block.
+        ::testing::Values(
+            std::make_pair(7, 13), // using chunk sizes that are a little odd to check for off-by-one errors.
+            std::make_pair(13, 7),
+            std::make_pair(0, 0)
+        )
+    )
+);
+
+/*************************************
+ *************************************/
+
+class HDF5DenseIndexedTest : public ::testing::TestWithParam<std::tuple<size_t, std::pair<int, int> > >, public HDF5DenseMatrixTestMethods {};
+
+TEST_P(HDF5DenseIndexedTest, Basic) {
+    auto param = GetParam(); 
+    size_t JUMP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int> mat(fpath, name, NR * 10);
+    tatami::DenseRowMatrix<double, int> ref(NR, NC, values);
+
+    test_indexed_row_access(&mat, &ref, 3, 0, JUMP);
+    test_indexed_column_access(&mat, &ref, 3, 0, JUMP);
+    test_indexed_row_access(&mat, &ref, 7, 5, JUMP);
+    test_indexed_column_access(&mat, &ref, 7, 13, JUMP);
+}
+
+TEST_P(HDF5DenseIndexedTest, Transposed) {
+    auto param = GetParam(); 
+    size_t JUMP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int, true> mat(fpath, name, NC * 5);
+    std::shared_ptr<tatami::Matrix<double, int> > ptr(new tatami::DenseRowMatrix<double, int>(NR, NC, values));
+    tatami::DelayedTranspose<double, int> ref(std::move(ptr));
+
+    test_indexed_row_access(&mat, &ref, 3, 0, JUMP);
+    test_indexed_column_access(&mat, &ref, 3, 0, JUMP);
+    test_indexed_row_access(&mat, &ref, 7, 13, JUMP);
+    test_indexed_column_access(&mat, &ref, 7, 5, JUMP);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    HDF5DenseMatrix,
+    HDF5DenseIndexedTest,
+    ::testing::Combine(
+        ::testing::Values(1, 4, 11), // jump between indices.
+        ::testing::Values(
+            std::make_pair(7, 13), // using chunk sizes that are a little odd to check for off-by-one errors.
+            std::make_pair(13, 7),
+            std::make_pair(0, 0)
+        )
+    )
+);
+
+/*************************************
+ *************************************/
+
+class HDF5DenseOracleTest : public ::testing::TestWithParam<std::tuple<size_t, std::pair<int, int> > >, public HDF5DenseMatrixTestMethods {};
+
+TEST_P(HDF5DenseOracleTest, Basic) {
+    auto param = GetParam(); 
+    size_t JUMP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int> mat(fpath, name, NR * 10);
+    tatami::DenseRowMatrix<double, int> ref(NR, NC, values);
+
+    test_oracle_row_access(&mat, &ref, JUMP);
+    test_oracle_column_access(&mat, &ref, JUMP);
+    test_oracle_row_access(&mat, &ref, JUMP, 5, 67);
+    test_oracle_column_access(&mat, &ref, JUMP, 13, 150);
+}
+
+TEST_P(HDF5DenseOracleTest, Transposed) {
+    auto param = GetParam(); 
+    size_t JUMP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int, true> mat(fpath, name, NC * 5);
+    std::shared_ptr<tatami::Matrix<double, int> > ptr(new tatami::DenseRowMatrix<double, int>(NR, NC, values));
+    tatami::DelayedTranspose<double, int> ref(std::move(ptr));
+
+    test_oracle_row_access(&mat, &ref, JUMP);
+    test_oracle_column_access(&mat, &ref, JUMP);
+    test_oracle_row_access(&mat, &ref, JUMP, 13, 150);
+    test_oracle_column_access(&mat, &ref, JUMP, 5, 67);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    HDF5DenseMatrix,
+    HDF5DenseOracleTest,
+    ::testing::Combine(
+        ::testing::Values(1, 3, 7), // jump between requests.
+        ::testing::Values(
+            std::make_pair(7, 13), // using chunk sizes that are a little odd to check for off-by-one errors.
+            std::make_pair(13, 7),
+            std::make_pair(0, 0)
+        )
+    )
+);
+
+/*************************************
+ *************************************/
+
+class HDF5DenseExtractorTest : public ::testing::TestWithParam<std::tuple<size_t, std::pair<int, int> > >, public HDF5DenseMatrixTestMethods {};
+
+TEST_P(HDF5DenseExtractorTest, Basic) {
+    auto param = GetParam(); 
+    size_t JUMP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int> mat(fpath, name, NR * 10);
+    tatami::DenseRowMatrix<double, int> ref(NR, NC, values);
+
+    test_extractor_row_access(&mat, &ref, JUMP);
+    test_extractor_column_access(&mat, &ref, JUMP);
+    test_extractor_row_access(&mat, &ref, JUMP, 5, 67);
+    test_extractor_column_access(&mat, &ref, JUMP, 13, 150);
+}
+
+TEST_P(HDF5DenseExtractorTest, Transposed) {
+    auto param = GetParam(); 
+    size_t JUMP = std::get<0>(param);
+
+    auto caching = std::get<1>(param);
+    dump(caching);
+    tatami::HDF5DenseMatrix<double, int, true> mat(fpath, name, NC * 5);
+    std::shared_ptr<tatami::Matrix<double, int> > ptr(new tatami::DenseRowMatrix<double, int>(NR, NC, values));
+    tatami::DelayedTranspose<double, int> ref(std::move(ptr));
+
+    test_extractor_row_access(&mat, &ref, JUMP);
+    test_extractor_column_access(&mat, &ref, JUMP);
+    test_extractor_row_access(&mat, &ref, JUMP, 13, 150);
+    test_extractor_column_access(&mat, &ref, JUMP, 5, 67);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    HDF5DenseMatrix,
+    HDF5DenseExtractorTest,
+    ::testing::Combine(
+        ::testing::Values(1, 7), // jump between requests.
+        ::testing::Values(
+            std::make_pair(7, 13), // using chunk sizes that are a little odd to check for off-by-one errors.
+            std::make_pair(0, 0)
+        )
+    )
+);
@@ -1,13 +1,26 @@
 #include <gtest/gtest.h>
 #include <vector>
+#include <algorithm>
+#include <numeric>
+
+#ifdef CUSTOM_PARALLEL_TEST
+// Put this before any tatami apply imports.
+#include "custom_parallel.h"
+#endif
 
 #include "tatami/stats/apply.hpp"
 #include "tatami/base/DenseMatrix.hpp"
 #include "tatami/utils/convert_to_dense.hpp"
 #include "tatami/utils/convert_to_sparse.hpp"
 #include "tatami/stats/variances.hpp"
+#include "tatami/stats/sums.hpp"
+#include "tatami/stats/ranges.hpp"
+#include "tatami/stats/combined.hpp"
+#include "tatami/stats/medians.hpp"
+#include "tatami/utils/ThreadPool.hpp"
 
 #include "../data/data.h"
+#include "../_tests/simulate_vector.h"
 
 /* This suite of tests just checks that we actually 
  * get different results under each mode. */
@@ -255,3 +268,499 @@ TEST(ApplyCheck, VariableDispatchColumnsCopy) {
         EXPECT_EQ(output, std::vector<double>(N, 2));
     }
 }
+
+/* Checking that the dynamic scheduler gives the same results as the static
+ * scheduler across all paths, and that each job is processed exactly once. */
+
+TEST(ApplyCheck, DynamicSchedule) {
+    auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    auto dense_column = tatami::convert_to_dense<false>(dense_row.get());
+    auto sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        {
+            auto ref = tatami::row_sums(ptr.get());
+            size_t N = ptr->nrow();
+            for (int threads : { 1, 3 }) {
+                std::vector<double> output(N);
+                tatami::stats::SumFactory factory(output.data(), N, ptr->ncol());
+                tatami::apply<0>(ptr.get(), factory, threads, tatami::APPLY_SCHEDULE_DYNAMIC);
+                EXPECT_EQ(output, ref);
+            }
+        }
+
+        {
+            auto ref = tatami::column_sums(ptr.get());
+            size_t N = ptr->ncol();
+            for (int threads : { 1, 3 }) {
+                std::vector<double> output(N);
+                tatami::stats::SumFactory factory(output.data(), N, ptr->nrow());
+                tatami::apply<1>(ptr.get(), factory, threads, tatami::APPLY_SCHEDULE_DYNAMIC);
+                EXPECT_EQ(output, ref);
+            }
+        }
+    }
+}
+
+TEST(ApplyCheck, ParallelizeChunks) {
+    for (size_t n : { 0, 1, 2, 10, 101 }) {
+        for (auto schedule : { tatami::APPLY_SCHEDULE_STATIC, tatami::APPLY_SCHEDULE_DYNAMIC }) {
+            for (int threads : { 1, 3 }) {
+                std::vector<int> visited(n);
+                tatami::stats::parallelize_chunks(n, threads, schedule, [&](tatami::stats::WorkerChunks& chunks) -> void {
+                    size_t start, end;
+                    while (chunks.next(start, end)) {
+                        EXPECT_LT(start, end);
+                        EXPECT_LE(end, n);
+                        for (size_t i = start; i < end; ++i) {
+                            ++visited[i];
+                        }
+                    }
+                });
+                EXPECT_EQ(visited, std::vector<int>(n, 1));
+            }
+        }
+    }
+}
+
+TEST(ApplyCheck, ChunkBoundaries) {
+    // Equal costs.
+    EXPECT_EQ(tatami::stats::chunk_boundaries(10, NULL, 3), std::vector<size_t>({ 0, 4, 8, 10 }));
+    EXPECT_EQ(tatami::stats::chunk_boundaries(2, NULL, 4), std::vector<size_t>({ 0, 1, 2, 2, 2 }));
+
+    // Skewed costs, where the first few jobs are much more expensive.
+    std::vector<size_t> costs(100);
+    for (size_t i = 0; i < costs.size(); ++i) {
+        costs[i] = (i < 10 ? 100 : 1);
+    }
+
+    size_t nchunks = 4;
+    auto boundaries = tatami::stats::chunk_boundaries(costs.size(), costs.data(), nchunks);
+    ASSERT_EQ(boundaries.size(), nchunks + 1);
+    EXPECT_EQ(boundaries.front(), 0);
+    EXPECT_EQ(boundaries.back(), costs.size());
+    EXPECT_TRUE(std::is_sorted(boundaries.begin(), boundaries.end()));
+    EXPECT_LT(boundaries[1], 10); // first chunk only contains expensive jobs.
+
+    double total = costs.size();
+    for (auto c : costs) {
+        total += c;
+    }
+    for (size_t i = 0; i < nchunks; ++i) {
+        double chunk_cost = 0;
+        for (size_t j = boundaries[i]; j < boundaries[i + 1]; ++j) {
+            chunk_cost += costs[j] + 1;
+        }
+        EXPECT_LE(chunk_cost, total / nchunks + 101);
+    }
+
+    // Checking that the costs are respected by the parallelization.
+    for (auto schedule : { tatami::APPLY_SCHEDULE_STATIC, tatami::APPLY_SCHEDULE_DYNAMIC }) {
+        std::vector<int> visited(costs.size());
+        tatami::stats::parallelize_chunks(costs.size(), costs.data(), 3, schedule, [&](tatami::stats::WorkerChunks& chunks) -> void {
+            size_t start, end;
+            while (chunks.next(start, end)) {
+                for (size_t i = start; i < end; ++i) {
+                    ++visited[i];
+                }
+            }
+        });
+        EXPECT_EQ(visited, std::vector<int>(costs.size(), 1));
+    }
+}
+
+TEST(ApplyCheck, NonZeroCosts) {
+    auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    auto sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    // Only available along the primary dimension, and only when multiple threads are requested.
+    auto costs = tatami::stats::nonzero_costs<true>(sparse_row.get(), 3);
+    ASSERT_EQ(costs.size(), sparse_nrow);
+    for (size_t r = 0; r < sparse_nrow; ++r) {
+        size_t expected = 0;
+        for (size_t c = 0; c < sparse_ncol; ++c) {
+            expected += (sparse_matrix[c + r * sparse_ncol] != 0);
+        }
+        EXPECT_EQ(costs[r], expected);
+    }
+
+    EXPECT_TRUE(tatami::stats::nonzero_costs<true>(sparse_row.get(), 1).empty());
+    EXPECT_TRUE(tatami::stats::nonzero_costs<true>(sparse_column.get(), 3).empty());
+    EXPECT_TRUE(tatami::stats::nonzero_costs<false>(dense_row.get(), 3).empty());
+
+    // Same results with the balanced partitions.
+    for (auto schedule : { tatami::APPLY_SCHEDULE_STATIC, tatami::APPLY_SCHEDULE_DYNAMIC }) {
+        std::vector<double> output(sparse_nrow);
+        tatami::stats::SumFactory factory(output.data(), sparse_nrow, sparse_ncol);
+        tatami::apply<0>(sparse_row.get(), factory, 3, schedule);
+        EXPECT_EQ(output, tatami::row_sums(dense_row.get()));
+    }
+}
+
+/* Checking that the tiled traversal gives the same results as the usual
+ * traversal, for a range of tile sizes and numbers of threads. */
+
+TEST(ApplyCheck, Tiled) {
+    auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    auto dense_column = tatami::convert_to_dense<false>(dense_row.get());
+    auto sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        for (size_t limit : { sizeof(double), 7 * 3 * sizeof(double), static_cast<size_t>(100000000) }) {
+            for (int threads : { 1, 3 }) {
+                {
+                    size_t N = ptr->nrow();
+                    std::vector<double> output(N);
+                    tatami::stats::SumFactory factory(output.data(), N, ptr->ncol());
+                    tatami::apply_tiled<0>(ptr.get(), factory, threads, limit);
+                    auto ref = tatami::row_sums(ptr.get());
+                    for (size_t i = 0; i < N; ++i) {
+                        EXPECT_FLOAT_EQ(output[i], ref[i]);
+                    }
+                }
+
+                {
+                    size_t N = ptr->ncol();
+                    std::vector<double> output(N);
+                    tatami::stats::SumFactory factory(output.data(), N, ptr->nrow());
+                    tatami::apply_tiled<1>(ptr.get(), factory, threads, limit);
+                    auto ref = tatami::column_sums(ptr.get());
+                    for (size_t i = 0; i < N; ++i) {
+                        EXPECT_FLOAT_EQ(output[i], ref[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Uses the running calculations in all cases.
+    {
+        size_t N = sparse_nrow;
+        std::vector<double> output(N);
+        SillyFactory factory(output.data(), N);
+        tatami::apply_tiled<0>(dense_row.get(), factory);
+        EXPECT_EQ(output, std::vector<double>(N, 3));
+        tatami::apply_tiled<0>(sparse_row.get(), factory);
+        EXPECT_EQ(output, std::vector<double>(N, 4));
+    }
+}
+
+TEST(ApplyCheck, TiledPool) {
+    auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    for (auto ptr : { dense_row, sparse_column }) {
+        for (int threads : { 1, 3 }) {
+            tatami::ThreadPool pool(threads);
+            for (size_t limit : { 7 * 3 * sizeof(double), static_cast<size_t>(100000000) }) {
+                {
+                    size_t N = ptr->nrow();
+                    std::vector<double> output(N);
+                    tatami::stats::VarianceFactory factory(output.data(), N, ptr->ncol());
+                    tatami::apply_tiled<0>(ptr.get(), factory, pool, limit);
+                    auto ref = tatami::row_variances(ptr.get());
+                    for (size_t i = 0; i < N; ++i) {
+                        EXPECT_FLOAT_EQ(output[i], ref[i]);
+                    }
+                }
+
+                {
+                    size_t N = ptr->ncol();
+                    std::vector<double> output(N);
+                    tatami::stats::SumFactory factory(output.data(), N, ptr->nrow());
+                    tatami::apply_tiled<1>(ptr.get(), factory, pool, limit);
+                    auto ref = tatami::column_sums(ptr.get());
+                    for (size_t i = 0; i < N; ++i) {
+                        EXPECT_FLOAT_EQ(output[i], ref[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(ApplyCheck, ChooseTiles) {
+    auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    typedef std::pair<size_t, size_t> Tiles;
+    EXPECT_EQ(dense_row->tile_dimensions(), (Tiles(0, 0)));
+
+    // Extended along the running dimension first.
+    EXPECT_EQ(tatami::stats::choose_tiles<true>(dense_row.get(), sizeof(double), 1), (Tiles(1, 1)));
+    EXPECT_EQ(tatami::stats::choose_tiles<true>(dense_row.get(), 5 * sizeof(double), 1), (Tiles(1, 5)));
+    EXPECT_EQ(tatami::stats::choose_tiles<true>(dense_row.get(), 35 * sizeof(double), 1), (Tiles(3, sparse_ncol)));
+    EXPECT_EQ(tatami::stats::choose_tiles<false>(dense_row.get(), 35 * sizeof(double), 1), (Tiles(1, sparse_nrow)));
+    EXPECT_EQ(tatami::stats::choose_tiles<true>(dense_row.get(), 100000000, 1), (Tiles(sparse_nrow, sparse_ncol)));
+
+    // Each thread gets at least one tile.
+    EXPECT_EQ(tatami::stats::choose_tiles<true>(dense_row.get(), 100000000, 3), (Tiles(7, sparse_ncol)));
+}
+
+/*****************************************/
+
+struct PartialFactory {
+    PartialFactory(double* o, size_t d1) : output(o), dim(d1) {}
+
+    double* output;
+    size_t dim;
+
+    struct DenseDirect {
+        DenseDirect(double* o) : output(o) {}
+        template<typename V>
+        void compute(size_t i, const V*) {
+            output[i] = -1;
+        }
+        double* output;
+    };
+
+    DenseDirect dense_direct() {
+        return DenseDirect(output);
+    }
+
+    struct DenseRunningPartial {
+        DenseRunningPartial(double* o, size_t d1) : output(o), dim(d1) {}
+        template<typename V>
+        void add(const V*) {
+            ++counter;
+        }
+        void merge(DenseRunningPartial& other) {
+            counter += other.counter;
+            ++merged;
+        }
+        void finish() {
+            std::fill(output, output + dim, counter * 100 + merged);
+        }
+        double* output;
+        size_t dim;
+        int counter = 0;
+        int merged = 0;
+    };
+
+    struct DenseRunning {
+        DenseRunning(double* o, size_t d1) : output(o), dim(d1) {}
+        template<typename V>
+        void add(const V*) {
+            ++counter;
+        }
+        void finish() {
+            std::fill(output, output + dim, counter * 100);
+        }
+        double* output;
+        size_t dim;
+        int counter = 0;
+    };
+
+    DenseRunning dense_running() {
+        return DenseRunning(output, dim);
+    }
+
+    DenseRunningPartial dense_running_partial() {
+        return DenseRunningPartial(output, dim);
+    }
+};
+
+TEST(ApplyCheck, RunningPartial) {
+    size_t NR = 101, NC = 2;
+    auto vec = simulate_sparse_vector<double>(NR * NC, 0.3);
+    auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, vec));
+    auto sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+    tatami::ThreadPool pool(3);
+
+    // Partial states are only used when there are fewer target vectors than threads.
+    {
+        std::vector<double> output(NC);
+        PartialFactory factory(output.data(), NC);
+        tatami::apply<1>(dense_row.get(), factory, pool);
+        EXPECT_EQ(output, std::vector<double>(NC, NR * 100 + 2));
+
+        tatami::apply<1>(dense_row.get(), factory);
+        EXPECT_EQ(output, std::vector<double>(NC, NR * 100));
+
+        tatami::ThreadPool pool2(2);
+        tatami::apply<1>(dense_row.get(), factory, pool2);
+        EXPECT_EQ(output, std::vector<double>(NC, NR * 100));
+    }
+
+    for (auto ptr : { dense_row, sparse_row }) {
+        auto ref_sums = tatami::column_sums(ptr.get());
+        auto ref_vars = tatami::column_variances(ptr.get());
+        auto ref_mins = tatami::column_mins(ptr.get());
+        auto ref_maxs = tatami::column_maxs(ptr.get());
+
+        for (int threads : { 2, 3 }) {
+            std::vector<double> sums(NC), vars(NC), mins(NC), maxs(NC);
+            tatami::stats::SumFactory sfactory(sums.data(), NC, NR);
+            tatami::stats::VarianceFactory vfactory(vars.data(), NC, NR);
+            tatami::stats::RangeFactory rfactory(mins.data(), maxs.data(), NC, NR);
+            tatami::ThreadPool pool(threads);
+
+            // Results may differ slightly due to the different order of summation.
+            tatami::apply<1>(ptr.get(), sfactory, pool);
+            tatami::apply<1>(ptr.get(), vfactory, pool);
+            tatami::apply<1>(ptr.get(), rfactory, pool);
+            for (size_t c = 0; c < NC; ++c) {
+                EXPECT_FLOAT_EQ(sums[c], ref_sums[c]);
+                EXPECT_FLOAT_EQ(vars[c], ref_vars[c]);
+            }
+            EXPECT_EQ(mins, ref_mins);
+            EXPECT_EQ(maxs, ref_maxs);
+
+            // Also works with the other parallelization mechanisms.
+            std::fill(sums.begin(), sums.end(), 0);
+            std::fill(vars.begin(), vars.end(), 0);
+            tatami::apply<1>(ptr.get(), sfactory, threads);
+            tatami::apply<1>(ptr.get(), vfactory, threads);
+            for (size_t c = 0; c < NC; ++c) {
+                EXPECT_FLOAT_EQ(sums[c], ref_sums[c]);
+                EXPECT_FLOAT_EQ(vars[c], ref_vars[c]);
+            }
+
+            // Combined factories merge each of their components.
+            std::fill(sums.begin(), sums.end(), 0);
+            std::fill(vars.begin(), vars.end(), 0);
+            std::fill(mins.begin(), mins.end(), 0);
+            std::fill(maxs.begin(), maxs.end(), 0);
+            auto combined = tatami::make_CombinedFactory(sfactory, vfactory, rfactory);
+            tatami::apply<1>(ptr.get(), combined, pool);
+            for (size_t c = 0; c < NC; ++c) {
+                EXPECT_FLOAT_EQ(sums[c], ref_sums[c]);
+                EXPECT_FLOAT_EQ(vars[c], ref_vars[c]);
+            }
+            EXPECT_EQ(mins, ref_mins);
+            EXPECT_EQ(maxs, ref_maxs);
+        }
+    }
+
+    // Handles ranges that are all-positive or all-negative in some threads, 
+    // where the implicit zeros of the sparse matrix must still be considered.
+    {
+        std::vector<double> skewed(NR * NC);
+        for (size_t r = 0; r < NR; ++r) {
+            if (r % 7 == 0) {
+                skewed[r * NC] = r + 1;
+                skewed[r * NC + 1] = -static_cast<double>(r) - 1;
+            }
+        }
+        auto dense = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, skewed));
+        auto sparse = tatami::convert_to_sparse<true>(dense.get());
+        for (auto ptr : { dense, sparse }) {
+            std::vector<double> mins(NC), maxs(NC);
+            tatami::stats::RangeFactory rfactory(mins.data(), maxs.data(), NC, NR);
+            tatami::apply<1>(ptr.get(), rfactory, pool);
+            EXPECT_EQ(mins, tatami::column_mins(ptr.get()));
+            EXPECT_EQ(maxs, tatami::column_maxs(ptr.get()));
+        }
+    }
+}
+
+/*****************************************/
+
+struct DirectSumFactory {
+    DirectSumFactory(double* o) : output(o) {}
+
+    double* output;
+
+    struct DenseDirect {
+        DenseDirect(double* o, size_t n) : output(o), len(n) {}
+        template<typename V>
+        void compute(size_t i, const V* ptr) {
+            output[i] = std::accumulate(ptr, ptr + len, 0.0);
+        }
+        double* output;
+        size_t len;
+    };
+
+    struct SparseDirect {
+        SparseDirect(double* o) : output(o) {}
+        template<typename T, typename IDX>
+        void compute(size_t i, const tatami::SparseRange<T, IDX>& range) {
+            // Also checking that the indices are sorted.
+            EXPECT_TRUE(std::is_sorted(range.index, range.index + range.number));
+            output[i] = std::accumulate(range.value, range.value + range.number, 0.0);
+        }
+        double* output;
+    };
+
+    size_t len = 0;
+
+    DenseDirect dense_direct() {
+        return DenseDirect(output, len);
+    }
+
+    SparseDirect sparse_direct() {
+        return SparseDirect(output);
+    }
+};
+
+TEST(ApplyCheck, Transposed) {
+    auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    auto dense_column = tatami::convert_to_dense<false>(dense_row.get());
+    auto sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    // Blocks of 1 target vector, a few target vectors, and all target vectors.
+    std::vector<size_t> limits { 1, 5 * sparse_ncol * sizeof(double), 100000000 };
+
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        for (int threads : { 1, 3 }) {
+            for (auto schedule : { tatami::APPLY_SCHEDULE_STATIC, tatami::APPLY_SCHEDULE_DYNAMIC }) {
+                {
+                    size_t N = ptr->nrow();
+                    std::vector<double> ref(N);
+                    DirectSumFactory rfactory(ref.data());
+                    rfactory.len = ptr->ncol();
+                    tatami::apply<0>(ptr.get(), rfactory, threads, schedule, 0);
+
+                    for (auto limit : limits) {
+                        std::vector<double> output(N);
+                        DirectSumFactory factory(output.data());
+                        factory.len = ptr->ncol();
+                        tatami::apply<0>(ptr.get(), factory, threads, schedule, limit);
+                        EXPECT_EQ(output, ref);
+                    }
+                }
+
+                {
+                    size_t N = ptr->ncol();
+                    std::vector<double> ref(N);
+                    DirectSumFactory rfactory(ref.data());
+                    rfactory.len = ptr->nrow();
+                    tatami::apply<1>(ptr.get(), rfactory, threads, schedule, 0);
+
+                    for (auto limit : limits) {
+                        std::vector<double> output(N);
+                        DirectSumFactory factory(output.data());
+                        factory.len = ptr->nrow();
+                        tatami::apply<1>(ptr.get(), factory, threads, schedule, limit);
+                        EXPECT_EQ(output, ref);
+                    }
+                }
+            }
+        }
+
+        // Works with factories that mutate the buffers.
+        for (int threads : { 1, 3 }) {
+            size_t N = ptr->nrow();
+            std::vector<double> ref(N);
+            tatami::stats::MedianFactory rfactory(ref.data(), ptr->ncol());
+            tatami::apply<0>(ptr.get(), rfactory, threads, tatami::APPLY_SCHEDULE_STATIC, 0);
+
+            for (auto limit : limits) {
+                std::vector<double> output(N);
+                tatami::stats::MedianFactory factory(output.data(), ptr->ncol());
+                tatami::apply<0>(ptr.get(), factory, threads, tatami::APPLY_SCHEDULE_STATIC, limit);
+                EXPECT_EQ(output, ref);
+            }
+        }
+    }
+}
+
+TEST(ApplyCheck, ChooseTransposeBlock) {
+    EXPECT_EQ(tatami::stats::choose_transpose_block(100, 10, 8, 8000, 1), 100);
+    EXPECT_EQ(tatami::stats::choose_transpose_block(100, 10, 8, 800, 1), 10);
+    EXPECT_EQ(tatami::stats::choose_transpose_block(100, 10, 8, 800, 2), 5);
+    EXPECT_EQ(tatami::stats::choose_transpose_block(100, 10, 8, 1, 2), 1);
+    EXPECT_EQ(tatami::stats::choose_transpose_block(100, 0, 8, 800, 2), 100);
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <cmath>
+#include <limits>
+
+#ifdef CUSTOM_PARALLEL_TEST
+// Put this before any tatami apply imports.
+#include "custom_parallel.h"
+#endif
+
+#include "tatami/base/DenseMatrix.hpp"
+#include "tatami/base/DelayedIsometricOp.hpp"
+#include "tatami/base/math_helpers.hpp"
+#include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/stats/sums.hpp"
+#include "tatami/stats/variances.hpp"
+#include "tatami/stats/ranges.hpp"
+
+#include "../data/data.h"
+
+class SparseBackgroundTest : public ::testing::TestWithParam<int> {
+protected:
+    std::shared_ptr<tatami::NumericMatrix> dense_row, sparse_row, sparse_column;
+    std::vector<double> row_centers, column_centers;
+
+    void SetUp() {
+        dense_row.reset(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+        sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+        sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+        row_centers.resize(sparse_nrow);
+        for (size_t r = 0; r < sparse_nrow; ++r) {
+            row_centers[r] = r * 0.3 - 2;
+        }
+        column_centers.resize(sparse_ncol);
+        for (size_t c = 0; c < sparse_ncol; ++c) {
+            column_centers[c] = c * 0.7 + 1;
+        }
+    }
+
+    // Centering and shifting is the same for all elements in each row (if MARGIN = 0) or column.
+    template<int MARGIN>
+    std::shared_ptr<tatami::NumericMatrix> center(std::shared_ptr<tatami::NumericMatrix> mat) const {
+        auto sub = tatami::make_DelayedIsometricOp(mat, tatami::make_DelayedSubtractVectorHelper<true, MARGIN>(MARGIN == 0 ? row_centers : column_centers));
+        return tatami::make_DelayedIsometricOp(sub, tatami::DelayedAddScalarHelper<double>(0.5));
+    }
+
+    static void compare_double_vectors(const std::vector<double>& left, const std::vector<double>& right) {
+        ASSERT_EQ(left.size(), right.size());
+        for (size_t i = 0; i < left.size(); ++i) {
+            EXPECT_FLOAT_EQ(left[i], right[i]);
+        }
+    }
+};
+
+TEST_P(SparseBackgroundTest, Extraction) {
+    auto ref = center<0>(dense_row);
+    auto bg = center<0>(sparse_row);
+    EXPECT_FALSE(bg->sparse());
+    EXPECT_TRUE(bg->sparse_background(true));
+    EXPECT_FALSE(bg->sparse_background(false));
+    EXPECT_FALSE(ref->sparse_background(true)); // underlying matrix is not sparse.
+
+    size_t first = 3, last = sparse_ncol - 2;
+    auto rext = ref->dense_row_extractor(first, last);
+    auto sext = bg->sparse_row_extractor(first, last);
+    EXPECT_TRUE(sext->set_background(true));
+
+    for (size_t r = 0; r < sparse_nrow; ++r) {
+        auto expected = rext->fetch(r);
+        auto observed = sext->fetch(r);
+
+        // Only the originally non-zero entries are reported.
+        EXPECT_TRUE(observed.value.size() < expected.size());
+        EXPECT_EQ(observed.background, 0.5 - row_centers[r]);
+
+        std::vector<double> expanded(last - first, observed.background);
+        for (size_t i = 0; i < observed.index.size(); ++i) {
+            expanded[observed.index[i] - first] = observed.value[i];
+        }
+        compare_double_vectors(expanded, expected);
+    }
+
+    // Switching it off gives us all elements again.
+    EXPECT_FALSE(sext->set_background(false));
+    for (size_t r = 0; r < sparse_nrow; ++r) {
+        auto expected = rext->fetch(r);
+        auto observed = sext->fetch(r);
+        EXPECT_EQ(observed.background, 0);
+        compare_double_vectors(observed.value, expected);
+    }
+
+    // Columns are not uniform, so no background is reported.
+    auto cext = bg->sparse_column_extractor();
+    EXPECT_FALSE(cext->set_background(true));
+    auto crext = ref->dense_column_extractor();
+    for (size_t c = 0; c < sparse_ncol; ++c) {
+        auto observed = cext->fetch(c);
+        EXPECT_EQ(observed.background, 0);
+        compare_double_vectors(observed.value, crext->fetch(c));
+    }
+}
+
+TEST_P(SparseBackgroundTest, Statistics) {
+    int threads = GetParam();
+
+    auto rref = center<0>(dense_row);
+    auto rbg = center<0>(sparse_row);
+    compare_double_vectors(tatami::row_sums(rbg.get(), threads), tatami::row_sums(rref.get(), threads));
+    compare_double_vectors(tatami::row_variances(rbg.get(), threads), tatami::row_variances(rref.get(), threads));
+    compare_double_vectors(tatami::row_mins(rbg.get(), threads), tatami::row_mins(rref.get(), threads));
+    compare_double_vectors(tatami::row_maxs(rbg.get(), threads), tatami::row_maxs(rref.get(), threads));
+
+    auto rranges = tatami::row_ranges(rbg.get(), threads);
+    compare_double_vectors(rranges.first, tatami::row_mins(rref.get(), threads));
+    compare_double_vectors(rranges.second, tatami::row_maxs(rref.get(), threads));
+
+    // Same for columns.
+    auto cref = center<1>(dense_row);
+    auto cbg = center<1>(sparse_column);
+    EXPECT_TRUE(cbg->sparse_background(false));
+    compare_double_vectors(tatami::column_sums(cbg.get(), threads), tatami::column_sums(cref.get(), threads));
+    compare_double_vectors(tatami::column_variances(cbg.get(), threads), tatami::column_variances(cref.get(), threads));
+    compare_double_vectors(tatami::column_mins(cbg.get(), threads), tatami::column_mins(cref.get(), threads));
+    compare_double_vectors(tatami::column_maxs(cbg.get(), threads), tatami::column_maxs(cref.get(), threads));
+
+    // Still works along the non-uniform dimension.
+    compare_double_vectors(tatami::column_sums(rbg.get(), threads), tatami::column_sums(rref.get(), threads));
+    compare_double_vectors(tatami::row_variances(cbg.get(), threads), tatami::row_variances(cref.get(), threads));
+}
+
+TEST_P(SparseBackgroundTest, SparseOperation) {
+    // Background is propagated through sparsity-preserving operations.
+    int threads = GetParam();
+    auto rref = tatami::make_DelayedIsometricOp(center<0>(dense_row), tatami::DelayedMultiplyScalarHelper<double>(2));
+    auto rbg = tatami::make_DelayedIsometricOp(center<0>(sparse_row), tatami::DelayedMultiplyScalarHelper<double>(2));
+    EXPECT_TRUE(rbg->sparse_background(true));
+    compare_double_vectors(tatami::row_sums(rbg.get(), threads), tatami::row_sums(rref.get(), threads));
+    compare_double_vectors(tatami::row_variances(rbg.get(), threads), tatami::row_variances(rref.get(), threads));
+
+    // A sparse operation on a plain sparse matrix has a zero background.
+    auto scaled = tatami::make_DelayedIsometricOp(sparse_row, tatami::DelayedMultiplyScalarHelper<double>(2));
+    EXPECT_FALSE(scaled->sparse_background(true));
+    auto ext = scaled->sparse_row_extractor();
+    EXPECT_FALSE(ext->set_background(true));
+}
+
+TEST_P(SparseBackgroundTest, NonFinite) {
+    // Background is -Inf, but the first row has no unlisted elements so it should not contribute.
+    int threads = GetParam();
+    auto dense = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(2, 3, std::vector<double>{ 1, 2, 3, 4, 0, 5 }));
+    auto sparse = tatami::convert_to_sparse<true>(dense.get());
+
+    auto ref = tatami::make_DelayedIsometricOp(dense, tatami::DelayedLogHelper<double>());
+    auto bg = tatami::make_DelayedIsometricOp(sparse, tatami::DelayedLogHelper<double>());
+    EXPECT_TRUE(bg->sparse_background(true));
+
+    auto rsums = tatami::row_sums(bg.get(), threads);
+    compare_double_vectors(rsums, tatami::row_sums(ref.get(), threads));
+    EXPECT_TRUE(std::isfinite(rsums[0]));
+    EXPECT_EQ(rsums[1], -std::numeric_limits<double>::infinity());
+
+    auto rvars = tatami::row_variances(bg.get(), threads);
+    auto rrvars = tatami::row_variances(ref.get(), threads);
+    EXPECT_FLOAT_EQ(rvars[0], rrvars[0]);
+    EXPECT_TRUE(std::isnan(rvars[1]));
+    EXPECT_TRUE(std::isnan(rrvars[1]));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SparseBackground,
+    SparseBackgroundTest,
+    ::testing::Values(1, 3)
+);
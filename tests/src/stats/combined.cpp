@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#ifdef CUSTOM_PARALLEL_TEST
+// Put this before any tatami apply imports.
+#include "custom_parallel.h"
+#endif
+
+#include "tatami/base/DenseMatrix.hpp"
+#include "tatami/utils/convert_to_dense.hpp"
+#include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/stats/combined.hpp"
+#include "tatami/stats/sums.hpp"
+#include "tatami/stats/variances.hpp"
+#include "tatami/stats/ranges.hpp"
+
+#include "../data/data.h"
+
+/* The combined factory should use the same calculation modes as the
+ * individual factories, so we expect exactly the same results. */
+
+class CombinedFactoryTest : public ::testing::TestWithParam<int> {
+protected:
+    std::vector<std::shared_ptr<tatami::NumericMatrix> > matrices;
+
+    void SetUp() {
+        auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+        matrices.push_back(dense_row);
+        matrices.push_back(tatami::convert_to_dense<false>(dense_row.get()));
+        matrices.push_back(tatami::convert_to_sparse<true>(dense_row.get()));
+        matrices.push_back(tatami::convert_to_sparse<false>(dense_row.get()));
+    }
+};
+
+TEST_P(CombinedFactoryTest, Rows) {
+    int threads = GetParam();
+    for (const auto& ptr : matrices) {
+        size_t NR = ptr->nrow(), NC = ptr->ncol();
+        std::vector<double> sums(NR), vars(NR), mins(NR), maxs(NR);
+
+        auto factory = tatami::make_CombinedFactory(
+            tatami::stats::SumFactory(sums.data(), NR, NC),
+            tatami::stats::VarianceFactory(vars.data(), NR, NC),
+            tatami::stats::RangeFactory(mins.data(), maxs.data(), NR, NC)
+        );
+        tatami::apply<0>(ptr.get(), factory, threads);
+
+        EXPECT_EQ(sums, tatami::row_sums(ptr.get()));
+        EXPECT_EQ(vars, tatami::row_variances(ptr.get()));
+        auto ranges = tatami::row_ranges(ptr.get());
+        EXPECT_EQ(mins, ranges.first);
+        EXPECT_EQ(maxs, ranges.second);
+    }
+}
+
+TEST_P(CombinedFactoryTest, Columns) {
+    int threads = GetParam();
+    for (const auto& ptr : matrices) {
+        size_t NR = ptr->nrow(), NC = ptr->ncol();
+        std::vector<double> sums(NC), vars(NC), mins(NC), maxs(NC);
+
+        auto factory = tatami::make_CombinedFactory(
+            tatami::stats::SumFactory(sums.data(), NC, NR),
+            tatami::stats::VarianceFactory(vars.data(), NC, NR),
+            tatami::stats::MinFactory<double>(mins.data(), NC, NR),
+            tatami::stats::MaxFactory<double>(maxs.data(), NC, NR)
+        );
+        tatami::apply<1>(ptr.get(), factory, threads);
+
+        EXPECT_EQ(sums, tatami::column_sums(ptr.get()));
+        EXPECT_EQ(vars, tatami::column_variances(ptr.get()));
+        EXPECT_EQ(mins, tatami::column_mins(ptr.get()));
+        EXPECT_EQ(maxs, tatami::column_maxs(ptr.get()));
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    CombinedFactory,
+    CombinedFactoryTest,
+    ::testing::Values(1, 3) // number of threads
+);
+
+/*****************************************/
+
+/* Checking that the modes are only available when they are supported by all
+ * component factories. */
+
+struct DenseOnlyFactory {
+    DenseOnlyFactory(double* o, size_t d2) : output(o), otherdim(d2) {}
+
+    struct DenseDirect {
+        DenseDirect(double* o, size_t d2) : output(o), otherdim(d2) {}
+
+        template<typename V>
+        void compute(size_t i, const V* ptr) {
+            output[i] = 0;
+            for (size_t j = 0; j < otherdim; ++j) {
+                output[i] += (ptr[j] != 0);
+            }
+        }
+    private:
+        double* output;
+        size_t otherdim;
+    };
+
+    DenseDirect dense_direct() {
+        return DenseDirect(output, otherdim);
+    }
+private:
+    double* output;
+    size_t otherdim;
+};
+
+TEST(CombinedFactory, Configuration) {
+    typedef tatami::stats::CombinedFactory<tatami::stats::SumFactory<double>, tatami::stats::VarianceFactory<double> > Full;
+    EXPECT_TRUE(tatami::stats::has_sparse_direct<Full>::value);
+    EXPECT_TRUE(tatami::stats::has_dense_running<Full>::value);
+    EXPECT_TRUE(tatami::stats::has_dense_running_parallel<Full>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_running<Full>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_running_parallel<Full>::value);
+
+    typedef tatami::stats::CombinedFactory<tatami::stats::SumFactory<double>, DenseOnlyFactory> Partial;
+    EXPECT_FALSE(tatami::stats::has_sparse_direct<Partial>::value);
+    EXPECT_FALSE(tatami::stats::has_dense_running<Partial>::value);
+    EXPECT_FALSE(tatami::stats::has_dense_running_parallel<Partial>::value);
+    EXPECT_FALSE(tatami::stats::has_sparse_running<Partial>::value);
+    EXPECT_FALSE(tatami::stats::has_sparse_running_parallel<Partial>::value);
+}
+
+TEST(CombinedFactory, DenseFallback) {
+    auto dense_row = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    std::vector<double> expected_detected(sparse_nrow);
+    for (size_t r = 0; r < sparse_nrow; ++r) {
+        for (size_t c = 0; c < sparse_ncol; ++c) {
+            expected_detected[r] += (sparse_matrix[c + r * sparse_ncol] != 0);
+        }
+    }
+
+    for (auto ptr : { dense_row, sparse_column }) {
+        std::vector<double> sums(sparse_nrow), detected(sparse_nrow);
+        auto factory = tatami::make_CombinedFactory(
+            tatami::stats::SumFactory(sums.data(), sparse_nrow, sparse_ncol),
+            DenseOnlyFactory(detected.data(), sparse_ncol)
+        );
+        tatami::apply<0>(ptr.get(), factory);
+
+        EXPECT_EQ(detected, expected_detected);
+        auto ref = tatami::row_sums(ptr.get());
+        ASSERT_EQ(sums.size(), ref.size());
+        for (size_t r = 0; r < sparse_nrow; ++r) {
+            EXPECT_FLOAT_EQ(sums[r], ref[r]);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#ifdef CUSTOM_PARALLEL_TEST
+// Put this before any tatami apply imports.
+#include "custom_parallel.h"
+#endif
+
+#include "tatami/base/DenseMatrix.hpp"
+#include "tatami/base/DelayedTranspose.hpp"
+#include "tatami/utils/convert_to_dense.hpp"
+#include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/stats/counts.hpp"
+
+#include "../data/data.h"
+#include "../_tests/simulate_vector.h"
+
+class ComputingDimCountsTest : public ::testing::TestWithParam<std::tuple<double, int> > {
+protected:
+    size_t NR = 57, NC = 31;
+    std::vector<double> dump;
+    std::shared_ptr<tatami::NumericMatrix> dense_row, dense_column, sparse_row, sparse_column;
+
+    void SetUp() {
+        dump = simulate_sparse_vector<double>(NR * NC, 0.2);
+        dense_row.reset(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+        dense_column = tatami::convert_to_dense<false>(dense_row.get());
+        sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+        sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+    }
+
+    template<class Function>
+    std::vector<size_t> reference(bool row, Function f) const {
+        std::vector<size_t> output(row ? NR : NC);
+        for (size_t r = 0; r < NR; ++r) {
+            for (size_t c = 0; c < NC; ++c) {
+                output[row ? r : c] += f(dump[r * NC + c]);
+            }
+        }
+        return output;
+    }
+};
+
+TEST_P(ComputingDimCountsTest, NonZero) {
+    int threads = std::get<1>(GetParam());
+
+    auto rref = reference(true, [](double x) -> bool { return x != 0; });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        EXPECT_EQ(rref, tatami::row_nnz(ptr.get(), threads));
+    }
+
+    auto cref = reference(false, [](double x) -> bool { return x != 0; });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        EXPECT_EQ(cref, tatami::column_nnz(ptr.get(), threads));
+    }
+
+    // Counts are propagated through delayed operations.
+    auto tsparse = tatami::make_DelayedTranspose(sparse_column);
+    EXPECT_EQ(rref, tatami::column_nnz(tsparse.get(), threads));
+    EXPECT_EQ(cref, tatami::row_nnz(tsparse.get(), threads));
+
+    // Works with other output types.
+    auto dref = tatami::row_nnz<double>(sparse_column.get(), threads);
+    EXPECT_EQ(std::vector<double>(rref.begin(), rref.end()), dref);
+    dref = tatami::row_nnz<double>(sparse_row.get(), threads);
+    EXPECT_EQ(std::vector<double>(rref.begin(), rref.end()), dref);
+}
+
+TEST_P(ComputingDimCountsTest, Threshold) {
+    double threshold = std::get<0>(GetParam());
+    int threads = std::get<1>(GetParam());
+
+    auto rref = reference(true, [&](double x) -> bool { return x > threshold; });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        EXPECT_EQ(rref, tatami::row_count_above(ptr.get(), threshold, threads));
+    }
+
+    auto cref = reference(false, [&](double x) -> bool { return x > threshold; });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        EXPECT_EQ(cref, tatami::column_count_above(ptr.get(), threshold, threads));
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ComputingDimCounts,
+    ComputingDimCountsTest,
+    ::testing::Combine(
+        ::testing::Values(-2.5, -0.1, 0, 0.5, 5),
+        ::testing::Values(1, 3)
+    )
+);
+
+TEST(ComputingDimCounts, FewTargets) {
+    // Fewer target vectors than threads, to check the partial running calculations.
+    size_t NR = 2, NC = 101;
+    auto dump = simulate_sparse_vector<double>(NR * NC, 0.3);
+    auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+    auto dense_column = tatami::convert_to_dense<false>(dense_row.get());
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    auto ref = tatami::row_nnz(dense_row.get());
+    EXPECT_EQ(ref, tatami::row_nnz(dense_column.get(), 3));
+    EXPECT_EQ(ref, tatami::row_nnz(sparse_column.get(), 3));
+
+    ref = tatami::row_count_above(dense_row.get(), -1.0);
+    EXPECT_EQ(ref, tatami::row_count_above(dense_column.get(), -1.0, 3));
+    EXPECT_EQ(ref, tatami::row_count_above(sparse_column.get(), -1.0, 3));
+}
+
+TEST(ComputingDimCounts, Configuration) {
+    typedef tatami::stats::NonZeroCountFactory<size_t> NnzFact;
+    EXPECT_TRUE(tatami::stats::has_sparse_running<NnzFact>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_running_parallel<NnzFact>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_running_partial<NnzFact>::value);
+
+    typedef decltype(std::declval<NnzFact>().sparse_direct()) NnzSparse;
+    const tatami::SparseExtractMode direct_mode = tatami::stats::sparse_extract_mode<NnzSparse>::value;
+    EXPECT_EQ(direct_mode, tatami::SPARSE_EXTRACT_NONE);
+    typedef decltype(std::declval<NnzFact>().sparse_running()) NnzRunning;
+    const tatami::SparseExtractMode running_mode = tatami::stats::sparse_extract_mode<NnzRunning>::value;
+    EXPECT_EQ(running_mode, tatami::SPARSE_EXTRACT_INDEX);
+
+    typedef tatami::stats::ThresholdCountFactory<size_t> ThreshFact;
+    typedef decltype(std::declval<ThreshFact>().sparse_direct()) ThreshSparse;
+    const tatami::SparseExtractMode thresh_mode = tatami::stats::sparse_extract_mode<ThreshSparse>::value;
+    EXPECT_EQ(thresh_mode, tatami::SPARSE_EXTRACT_BOTH); // just a negative control.
+}
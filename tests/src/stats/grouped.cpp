@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <cmath>
+
+#ifdef CUSTOM_PARALLEL_TEST
+// Put this before any tatami apply imports.
+#include "custom_parallel.h"
+#endif
+
+#include "tatami/base/DenseMatrix.hpp"
+#include "tatami/base/DelayedSubset.hpp"
+#include "tatami/utils/convert_to_dense.hpp"
+#include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/stats/grouped.hpp"
+#include "tatami/stats/sums.hpp"
+#include "tatami/stats/variances.hpp"
+#include "tatami/stats/counts.hpp"
+
+#include "../data/data.h"
+#include "../_tests/simulate_vector.h"
+
+class ComputingGroupedTest : public ::testing::TestWithParam<std::tuple<int, int> > {
+protected:
+    size_t NR = 67, NC = 39;
+    std::vector<double> dump;
+    std::shared_ptr<tatami::NumericMatrix> dense_row, dense_column, sparse_row, sparse_column;
+
+    void SetUp() {
+        dump = simulate_sparse_vector<double>(NR * NC, 0.2);
+        dense_row.reset(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+        dense_column = tatami::convert_to_dense<false>(dense_row.get());
+        sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+        sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+    }
+
+    static std::vector<int> create_groups(size_t n, int ngroups) {
+        std::vector<int> group(n);
+        for (size_t i = 0; i < n; ++i) {
+            group[i] = (i * 7) % ngroups; // interleaved, to check that groups are not assumed to be contiguous.
+        }
+        return group;
+    }
+
+    // Reference results from one subset per group.
+    template<bool ROW, class Function>
+    static auto reference(std::shared_ptr<tatami::NumericMatrix> mat, const std::vector<int>& group, int ngroups, Function f) {
+        std::vector<decltype(f(mat.get()))> output;
+        for (int g = 0; g < ngroups; ++g) {
+            std::vector<int> keep;
+            for (size_t i = 0; i < group.size(); ++i) {
+                if (group[i] == g) {
+                    keep.push_back(i);
+                }
+            }
+            auto sub = tatami::make_DelayedSubset<(ROW ? 1 : 0)>(mat, std::move(keep));
+            output.push_back(f(sub.get()));
+        }
+        return output;
+    }
+
+    static void compare_double_vectors(const std::vector<std::vector<double> >& left, const std::vector<std::vector<double> >& right) {
+        ASSERT_EQ(left.size(), right.size());
+        for (size_t g = 0; g < left.size(); ++g) {
+            ASSERT_EQ(left[g].size(), right[g].size());
+            for (size_t i = 0; i < left[g].size(); ++i) {
+                if (std::isnan(right[g][i])) {
+                    EXPECT_TRUE(std::isnan(left[g][i]));
+                } else {
+                    EXPECT_FLOAT_EQ(left[g][i], right[g][i]);
+                }
+            }
+        }
+    }
+};
+
+TEST_P(ComputingGroupedTest, Sums) {
+    int ngroups = std::get<0>(GetParam());
+    int threads = std::get<1>(GetParam());
+
+    auto rgroup = create_groups(NC, ngroups);
+    auto rref = reference<true>(dense_row, rgroup, ngroups, [](const tatami::NumericMatrix* p) { return tatami::row_sums(p); });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        compare_double_vectors(tatami::row_sums_by_group(ptr.get(), rgroup.data(), threads), rref);
+    }
+
+    auto cgroup = create_groups(NR, ngroups);
+    auto cref = reference<false>(dense_row, cgroup, ngroups, [](const tatami::NumericMatrix* p) { return tatami::column_sums(p); });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        compare_double_vectors(tatami::column_sums_by_group(ptr.get(), cgroup.data(), threads), cref);
+    }
+}
+
+TEST_P(ComputingGroupedTest, Means) {
+    int ngroups = std::get<0>(GetParam());
+    int threads = std::get<1>(GetParam());
+
+    auto rgroup = create_groups(NC, ngroups);
+    auto rref = reference<true>(dense_row, rgroup, ngroups, [](const tatami::NumericMatrix* p) { return tatami::row_sums(p); });
+    auto rsizes = tatami::stats::tabulate_groups(rgroup.data(), NC);
+    for (int g = 0; g < ngroups; ++g) {
+        for (auto& x : rref[g]) {
+            x /= rsizes[g];
+        }
+    }
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        compare_double_vectors(tatami::row_means_by_group(ptr.get(), rgroup.data(), threads), rref);
+    }
+
+    auto cgroup = create_groups(NR, ngroups);
+    auto cref = reference<false>(dense_row, cgroup, ngroups, [](const tatami::NumericMatrix* p) { return tatami::column_sums(p); });
+    auto csizes = tatami::stats::tabulate_groups(cgroup.data(), NR);
+    for (int g = 0; g < ngroups; ++g) {
+        for (auto& x : cref[g]) {
+            x /= csizes[g];
+        }
+    }
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        compare_double_vectors(tatami::column_means_by_group(ptr.get(), cgroup.data(), threads), cref);
+    }
+}
+
+TEST_P(ComputingGroupedTest, NonZero) {
+    int ngroups = std::get<0>(GetParam());
+    int threads = std::get<1>(GetParam());
+
+    auto rgroup = create_groups(NC, ngroups);
+    auto rref = reference<true>(dense_row, rgroup, ngroups, [](const tatami::NumericMatrix* p) { return tatami::row_nnz(p); });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        EXPECT_EQ(tatami::row_nnz_by_group(ptr.get(), rgroup.data(), threads), rref);
+    }
+
+    auto cgroup = create_groups(NR, ngroups);
+    auto cref = reference<false>(dense_row, cgroup, ngroups, [](const tatami::NumericMatrix* p) { return tatami::column_nnz(p); });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        EXPECT_EQ(tatami::column_nnz_by_group(ptr.get(), cgroup.data(), threads), cref);
+    }
+}
+
+TEST_P(ComputingGroupedTest, Variances) {
+    int ngroups = std::get<0>(GetParam());
+    int threads = std::get<1>(GetParam());
+
+    auto rgroup = create_groups(NC, ngroups);
+    auto rref = reference<true>(dense_row, rgroup, ngroups, [](const tatami::NumericMatrix* p) { return tatami::row_variances(p); });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        compare_double_vectors(tatami::row_variances_by_group(ptr.get(), rgroup.data(), threads), rref);
+    }
+
+    auto cgroup = create_groups(NR, ngroups);
+    auto cref = reference<false>(dense_row, cgroup, ngroups, [](const tatami::NumericMatrix* p) { return tatami::column_variances(p); });
+    for (auto ptr : { dense_row, dense_column, sparse_row, sparse_column }) {
+        compare_double_vectors(tatami::column_variances_by_group(ptr.get(), cgroup.data(), threads), cref);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ComputingGrouped,
+    ComputingGroupedTest,
+    ::testing::Combine(
+        ::testing::Values(1, 3, 8),
+        ::testing::Values(1, 3)
+    )
+);
+
+TEST(ComputingGrouped, Singletons) {
+    // Each group has only one element, so all variances are NaN.
+    size_t NR = 10, NC = 3;
+    auto dump = simulate_sparse_vector<double>(NR * NC, 0.3);
+    auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    std::vector<int> group { 2, 0, 1 };
+    for (auto ptr : { dense_row.get(), sparse_column.get() }) {
+        auto vars = tatami::row_variances_by_group(ptr, group.data());
+        ASSERT_EQ(vars.size(), 3);
+        for (const auto& v : vars) {
+            for (auto x : v) {
+                EXPECT_TRUE(std::isnan(x));
+            }
+        }
+
+        auto means = tatami::row_means_by_group(ptr, group.data());
+        ASSERT_EQ(means.size(), 3);
+        for (size_t r = 0; r < NR; ++r) {
+            EXPECT_EQ(means[2][r], dump[r * NC]);
+            EXPECT_EQ(means[0][r], dump[r * NC + 1]);
+            EXPECT_EQ(means[1][r], dump[r * NC + 2]);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "tatami/stats/kernels.hpp"
+
+#include "../_tests/simulate_vector.h"
+
+class KernelsTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(KernelsTest, Reductions) {
+    size_t n = GetParam();
+    auto values = simulate_dense_vector<double>(n, -10, 10, n);
+
+    double ref_sum = std::accumulate(values.begin(), values.end(), 0.0);
+    double sum = tatami::stats::kernels::sum<double>(values.data(), n);
+    EXPECT_NEAR(sum, ref_sum, 1e-8);
+
+    double mean = (n ? ref_sum / n : 0);
+    double ref_ss = 0;
+    for (auto v : values) {
+        ref_ss += (v - mean) * (v - mean);
+    }
+    EXPECT_NEAR(tatami::stats::kernels::squared_deviations<double>(values.data(), n, mean), ref_ss, 1e-8);
+
+    if (n) {
+        EXPECT_EQ(tatami::stats::kernels::extreme<true>(values.data(), n), *std::max_element(values.begin(), values.end()));
+        EXPECT_EQ(tatami::stats::kernels::extreme<false>(values.data(), n), *std::min_element(values.begin(), values.end()));
+    }
+
+    // Integer inputs are exact.
+    std::vector<int> ivalues(n);
+    std::iota(ivalues.begin(), ivalues.end(), -static_cast<int>(n / 2));
+    EXPECT_EQ(tatami::stats::kernels::sum<double>(ivalues.data(), n), std::accumulate(ivalues.begin(), ivalues.end(), 0.0));
+}
+
+TEST_P(KernelsTest, Running) {
+    size_t n = GetParam();
+    auto first = simulate_dense_vector<double>(n, -10, 10, n);
+    auto second = simulate_dense_vector<double>(n, -10, 10, n + 1);
+
+    // Element-wise updates should be exactly the same as a scalar loop.
+    auto sums = first;
+    tatami::stats::kernels::running_sum(sums.data(), second.data(), n);
+    auto maxs = first;
+    tatami::stats::kernels::running_extreme<true>(maxs.data(), second.data(), n);
+    auto mins = first;
+    tatami::stats::kernels::running_extreme<false>(mins.data(), second.data(), n);
+
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(sums[i], first[i] + second[i]);
+        EXPECT_EQ(maxs[i], std::max(first[i], second[i]));
+        EXPECT_EQ(mins[i], std::min(first[i], second[i]));
+    }
+
+    std::vector<double> means(n), vars(n);
+    tatami::stats::kernels::running_welford(first.data(), n, means.data(), vars.data(), 1);
+    tatami::stats::kernels::running_welford(second.data(), n, means.data(), vars.data(), 2);
+    for (size_t i = 0; i < n; ++i) {
+        double expected_mean = (first[i] + second[i]) / 2;
+        EXPECT_FLOAT_EQ(means[i], expected_mean);
+        double delta = first[i] - second[i];
+        EXPECT_FLOAT_EQ(vars[i], delta * delta / 2);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Kernels,
+    KernelsTest,
+    ::testing::Values(0, 1, 7, 8, 9, 64, 101, 1000)
+);
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <vector>
+#include <algorithm>
+#include <cmath>
 
 #ifdef CUSTOM_PARALLEL_TEST
 // Put this before any tatami apply imports.
@@ -13,6 +15,7 @@
 #include "tatami/stats/medians.hpp"
 
 #include "../data/data.h"
+#include "../_tests/simulate_vector.h"
 
 TEST(ComputingDimMedians, SparseMedians) {
     auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
@@ -176,6 +179,109 @@ TEST(ComputingDimMedians, RowMediansNaN) {
     EXPECT_TRUE(std::isnan(rref.back()));
 }
 
+static double reference_median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    if (n % 2 == 1) {
+        return values[n / 2];
+    } else {
+        return (values[n / 2] + values[n / 2 - 1]) / 2;
+    }
+}
+
+TEST(ComputingDimMedians, SparseSelection) {
+    // Checking all combinations of negative, zero and positive counts.
+    for (size_t nneg = 0; nneg < 5; ++nneg) {
+        for (size_t nzero = 0; nzero < 5; ++nzero) {
+            for (size_t npos = 0; npos < 5; ++npos) {
+                if (nneg + nzero + npos == 0) {
+                    continue;
+                }
+
+                std::vector<double> nonzeros;
+                for (size_t i = 0; i < nneg; ++i) {
+                    nonzeros.push_back(-0.5 - i * 1.5);
+                }
+                for (size_t i = 0; i < npos; ++i) {
+                    nonzeros.push_back(0.25 + i * 2.5);
+                }
+                std::reverse(nonzeros.begin(), nonzeros.end());
+
+                auto full = nonzeros;
+                full.resize(full.size() + nzero);
+                double expected = reference_median(full);
+
+                EXPECT_EQ(tatami::stats::compute_sparse_median<double>(nonzeros.data(), nonzeros.size(), nzero), expected);
+                EXPECT_EQ(tatami::stats::compute_median<double>(full.data(), full.size()), expected);
+            }
+        }
+    }
+
+    EXPECT_TRUE(std::isnan(tatami::stats::compute_sparse_median<double>((double*)NULL, 0, 0)));
+}
+
+TEST(ComputingDimMedians, CountedMedians) {
+    std::vector<size_t> counts;
+    double output;
+
+    for (size_t n = 5; n < 30; ++n) {
+        auto values = simulate_dense_vector<double>(n, 0, 5, n);
+        for (auto& v : values) {
+            v = std::floor(v);
+        }
+
+        for (size_t nzero = 0; nzero < 3; ++nzero) {
+            auto full = values;
+            full.resize(full.size() + nzero);
+            EXPECT_TRUE(tatami::stats::compute_counted_median(values.data(), values.size(), nzero, counts, output));
+            EXPECT_EQ(output, reference_median(full));
+        }
+    }
+
+    // Falls back for non-integer, negative or large values.
+    std::vector<double> values { 1, 2, 3.5 };
+    EXPECT_FALSE(tatami::stats::compute_counted_median(values.data(), values.size(), 0, counts, output));
+    values.back() = -1;
+    EXPECT_FALSE(tatami::stats::compute_counted_median(values.data(), values.size(), 0, counts, output));
+    values.back() = 100;
+    EXPECT_FALSE(tatami::stats::compute_counted_median(values.data(), values.size(), 0, counts, output));
+}
+
+TEST(ComputingDimMedians, IntegerMedians) {
+    size_t NR = 51, NC = 40;
+    auto dump = simulate_sparse_vector<double>(NR * NC, 0.4, 0, 20);
+    for (auto& d : dump) {
+        d = std::floor(d);
+    }
+
+    auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+    auto dense_column = tatami::convert_to_dense<false>(dense_row.get());
+    auto sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    std::vector<double> rref(NR);
+    for (size_t r = 0; r < NR; ++r) {
+        rref[r] = reference_median(std::vector<double>(dump.begin() + r * NC, dump.begin() + (r + 1) * NC));
+    }
+    EXPECT_EQ(rref, tatami::row_medians(dense_row.get()));
+    EXPECT_EQ(rref, tatami::row_medians(dense_column.get()));
+    EXPECT_EQ(rref, tatami::row_medians(sparse_row.get()));
+    EXPECT_EQ(rref, tatami::row_medians(sparse_column.get(), 3));
+
+    std::vector<double> cref(NC);
+    for (size_t c = 0; c < NC; ++c) {
+        std::vector<double> column(NR);
+        for (size_t r = 0; r < NR; ++r) {
+            column[r] = dump[r * NC + c];
+        }
+        cref[c] = reference_median(std::move(column));
+    }
+    EXPECT_EQ(cref, tatami::column_medians(dense_row.get()));
+    EXPECT_EQ(cref, tatami::column_medians(dense_column.get()));
+    EXPECT_EQ(cref, tatami::column_medians(sparse_row.get(), 3));
+    EXPECT_EQ(cref, tatami::column_medians(sparse_column.get()));
+}
+
 TEST(ComputingDimMedians, Configuration) {
     typedef tatami::stats::MedianFactory<double> MedFact;
     EXPECT_FALSE(tatami::stats::has_sparse_running<MedFact>::value);
@@ -0,0 +1,363 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#ifdef CUSTOM_PARALLEL_TEST
+// Put this before any tatami apply imports.
+#include "custom_parallel.h"
+#endif
+
+#include "tatami/base/DenseMatrix.hpp"
+#include "tatami/utils/convert_to_dense.hpp"
+#include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/stats/quantiles.hpp"
+#include "tatami/stats/medians.hpp"
+
+#include "../data/data.h"
+#include "../_tests/simulate_vector.h"
+
+static double reference_quantile(std::vector<double> values, double prob) {
+    std::sort(values.begin(), values.end());
+    double h = (values.size() - 1) * prob;
+    size_t lo = std::floor(h);
+    size_t hi = std::min(lo + 1, values.size() - 1);
+    return values[lo] + (h - lo) * (values[hi] - values[lo]);
+}
+
+static std::vector<double> reference_row_quantiles(const std::vector<double>& values, size_t NR, size_t NC, double prob) {
+    std::vector<double> output(NR);
+    for (size_t r = 0; r < NR; ++r) {
+        output[r] = reference_quantile(std::vector<double>(values.begin() + r * NC, values.begin() + (r + 1) * NC), prob);
+    }
+    return output;
+}
+
+static std::vector<double> reference_column_quantiles(const std::vector<double>& values, size_t NR, size_t NC, double prob) {
+    std::vector<double> output(NC);
+    for (size_t c = 0; c < NC; ++c) {
+        std::vector<double> column(NR);
+        for (size_t r = 0; r < NR; ++r) {
+            column[r] = values[r * NC + c];
+        }
+        output[c] = reference_quantile(std::move(column), prob);
+    }
+    return output;
+}
+
+template<class L, class R>
+void compare_double_vectors (const L& left, const R& right) {
+    ASSERT_EQ(left.size(), right.size());
+    for (size_t i = 0; i < left.size(); ++i) {
+        EXPECT_DOUBLE_EQ(left[i], right[i]);
+    }
+}
+
+class ComputingDimQuantilesTest : public ::testing::TestWithParam<std::tuple<double, bool> > {
+protected:
+    size_t NR = 43, NC = 37;
+    std::vector<double> dump;
+    std::unique_ptr<tatami::NumericMatrix> dense_row;
+    std::shared_ptr<tatami::NumericMatrix> dense_column, sparse_row, sparse_column;
+
+    void assemble(bool integer) {
+        dump = simulate_sparse_vector<double>(NR * NC, 0.3, (integer ? 0 : -5), 10);
+        if (integer) {
+            for (auto& d : dump) {
+                d = std::floor(d);
+            }
+        }
+
+        dense_row.reset(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+        dense_column = tatami::convert_to_dense<false>(dense_row.get());
+        sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+        sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+    }
+};
+
+TEST_P(ComputingDimQuantilesTest, Exact) {
+    auto param = GetParam();
+    double prob = std::get<0>(param);
+    assemble(std::get<1>(param));
+
+    auto rref = reference_row_quantiles(dump, NR, NC, prob);
+    compare_double_vectors(rref, tatami::row_quantiles(dense_row.get(), prob));
+    compare_double_vectors(rref, tatami::row_quantiles(dense_column.get(), prob));
+    compare_double_vectors(rref, tatami::row_quantiles(sparse_row.get(), prob));
+    compare_double_vectors(rref, tatami::row_quantiles(sparse_column.get(), prob, 3));
+
+    auto cref = reference_column_quantiles(dump, NR, NC, prob);
+    compare_double_vectors(cref, tatami::column_quantiles(dense_row.get(), prob, 3));
+    compare_double_vectors(cref, tatami::column_quantiles(dense_column.get(), prob));
+    compare_double_vectors(cref, tatami::column_quantiles(sparse_row.get(), prob));
+    compare_double_vectors(cref, tatami::column_quantiles(sparse_column.get(), prob));
+}
+
+TEST_P(ComputingDimQuantilesTest, Approximate) {
+    auto param = GetParam();
+    double prob = std::get<0>(param);
+    assemble(std::get<1>(param));
+
+    // Sketches are exact when there are no more than 'k' non-zero values.
+    auto rref = reference_row_quantiles(dump, NR, NC, prob);
+    compare_double_vectors(rref, tatami::row_approximate_quantiles(dense_row.get(), prob));
+    compare_double_vectors(rref, tatami::row_approximate_quantiles(dense_column.get(), prob));
+    compare_double_vectors(rref, tatami::row_approximate_quantiles(sparse_row.get(), prob, 3));
+    compare_double_vectors(rref, tatami::row_approximate_quantiles(sparse_column.get(), prob, 3));
+
+    auto cref = reference_column_quantiles(dump, NR, NC, prob);
+    compare_double_vectors(cref, tatami::column_approximate_quantiles(dense_row.get(), prob, 3));
+    compare_double_vectors(cref, tatami::column_approximate_quantiles(dense_column.get(), prob, 3));
+    compare_double_vectors(cref, tatami::column_approximate_quantiles(sparse_row.get(), prob));
+    compare_double_vectors(cref, tatami::column_approximate_quantiles(sparse_column.get(), prob));
+}
+
+TEST_P(ComputingDimQuantilesTest, Multiple) {
+    auto param = GetParam();
+    double prob = std::get<0>(param);
+    assemble(std::get<1>(param));
+
+    // Unsorted and duplicated probabilities are handled correctly.
+    std::vector<double> probs { 0.95, prob, 0.05, 1 - prob, prob, 0.5 };
+
+    auto rexact = tatami::row_quantiles(sparse_row.get(), probs);
+    auto rexact_dense = tatami::row_quantiles(dense_column.get(), probs, 3);
+    auto rapprox = tatami::row_approximate_quantiles(sparse_column.get(), probs, 3);
+    auto cexact = tatami::column_quantiles(dense_row.get(), probs, 3);
+    auto cexact_sparse = tatami::column_quantiles(sparse_column.get(), probs);
+    auto capprox = tatami::column_approximate_quantiles(dense_row.get(), probs);
+    ASSERT_EQ(rexact.size(), probs.size());
+    ASSERT_EQ(capprox.size(), probs.size());
+
+    for (size_t q = 0; q < probs.size(); ++q) {
+        auto rref = reference_row_quantiles(dump, NR, NC, probs[q]);
+        compare_double_vectors(rref, rexact[q]);
+        compare_double_vectors(rref, rexact_dense[q]);
+        compare_double_vectors(rref, rapprox[q]);
+
+        auto cref = reference_column_quantiles(dump, NR, NC, probs[q]);
+        compare_double_vectors(cref, cexact[q]);
+        compare_double_vectors(cref, cexact_sparse[q]);
+        compare_double_vectors(cref, capprox[q]);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ComputingDimQuantiles,
+    ComputingDimQuantilesTest,
+    ::testing::Combine(
+        ::testing::Values(0, 0.05, 0.3, 0.5, 0.95, 1),
+        ::testing::Values(false, true)
+    )
+);
+
+TEST(ComputingDimQuantiles, Medians) {
+    auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    compare_double_vectors(tatami::row_medians(dense_row.get()), tatami::row_quantiles(dense_row.get(), 0.5));
+    compare_double_vectors(tatami::row_medians(dense_row.get()), tatami::row_quantiles(sparse_column.get(), 0.5));
+    compare_double_vectors(tatami::column_medians(dense_row.get()), tatami::column_quantiles(dense_row.get(), 0.5));
+    compare_double_vectors(tatami::column_medians(dense_row.get()), tatami::column_quantiles(sparse_column.get(), 0.5));
+}
+
+TEST(ComputingDimQuantiles, Empty) {
+    auto dense = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(10, 0, std::vector<double>()));
+    auto rref = tatami::row_quantiles(dense.get(), 0.2);
+    EXPECT_EQ(rref.size(), 10);
+    EXPECT_TRUE(std::isnan(rref.front()));
+
+    auto aref = tatami::row_approximate_quantiles(dense.get(), 0.2);
+    EXPECT_EQ(aref.size(), 10);
+    EXPECT_TRUE(std::isnan(aref.back()));
+
+    auto mref = tatami::row_quantiles(dense.get(), std::vector<double>{ 0.2, 0.8 });
+    EXPECT_EQ(mref.size(), 2);
+    EXPECT_EQ(mref.back().size(), 10);
+    EXPECT_TRUE(std::isnan(mref.back().front()));
+
+    EXPECT_ANY_THROW({
+        tatami::row_quantiles(dense.get(), 1.5);
+    });
+    EXPECT_ANY_THROW({
+        tatami::row_approximate_quantiles(dense.get(), -1);
+    });
+    EXPECT_ANY_THROW({
+        tatami::column_quantiles(dense.get(), std::vector<double>{ 0.5, 2 });
+    });
+}
+
+TEST(ComputingDimQuantiles, ManyProbabilities) {
+    // Checking that successive selections on the same buffer are correct for all ranks,
+    // including those adjacent to the boundaries between negative values, zeros and positive values.
+    size_t NR = 11, NC = 29;
+    auto dump = simulate_sparse_vector<double>(NR * NC, 0.5, -10, 10);
+    auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+    auto sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+
+    std::vector<double> probs;
+    for (size_t i = 0; i <= 2 * NC; ++i) {
+        probs.push_back(static_cast<double>(i) / (2 * NC));
+    }
+
+    auto dres = tatami::row_quantiles(dense_row.get(), probs);
+    auto sres = tatami::row_quantiles(sparse_row.get(), probs);
+    for (size_t q = 0; q < probs.size(); ++q) {
+        auto ref = reference_row_quantiles(dump, NR, NC, probs[q]);
+        compare_double_vectors(ref, dres[q]);
+        compare_double_vectors(ref, sres[q]);
+    }
+}
+
+TEST(ComputingDimQuantiles, Mads) {
+    size_t NR = 51, NC = 24;
+    for (bool integer : { false, true }) {
+        auto dump = simulate_sparse_vector<double>(NR * NC, 0.4, (integer ? 0 : -5), 10);
+        if (integer) {
+            for (auto& d : dump) {
+                d = std::floor(d);
+            }
+        }
+
+        auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+        auto dense_column = tatami::convert_to_dense<false>(dense_row.get());
+        auto sparse_row = tatami::convert_to_sparse<true>(dense_row.get());
+        auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+        std::vector<double> rref(NR);
+        for (size_t r = 0; r < NR; ++r) {
+            std::vector<double> row(dump.begin() + r * NC, dump.begin() + (r + 1) * NC);
+            double center = reference_quantile(row, 0.5);
+            for (auto& x : row) {
+                x = std::abs(x - center);
+            }
+            rref[r] = reference_quantile(std::move(row), 0.5);
+        }
+        compare_double_vectors(rref, tatami::row_mads(dense_row.get()));
+        compare_double_vectors(rref, tatami::row_mads(dense_column.get(), 3));
+        compare_double_vectors(rref, tatami::row_mads(sparse_row.get()));
+        compare_double_vectors(rref, tatami::row_mads(sparse_column.get(), 3));
+
+        std::vector<double> cref(NC);
+        for (size_t c = 0; c < NC; ++c) {
+            std::vector<double> column(NR);
+            for (size_t r = 0; r < NR; ++r) {
+                column[r] = dump[r * NC + c];
+            }
+            double center = reference_quantile(column, 0.5);
+            for (auto& x : column) {
+                x = std::abs(x - center);
+            }
+            cref[c] = reference_quantile(std::move(column), 0.5);
+        }
+        compare_double_vectors(cref, tatami::column_mads(dense_row.get(), 3));
+        compare_double_vectors(cref, tatami::column_mads(dense_column.get()));
+        compare_double_vectors(cref, tatami::column_mads(sparse_row.get(), 3));
+        compare_double_vectors(cref, tatami::column_mads(sparse_column.get()));
+    }
+
+    auto empty = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(10, 0, std::vector<double>()));
+    auto eref = tatami::row_mads(empty.get());
+    EXPECT_EQ(eref.size(), 10);
+    EXPECT_TRUE(std::isnan(eref.front()));
+}
+
+TEST(ComputingDimQuantiles, ApproximateAccuracy) {
+    // Fewer target vectors than threads, to check the merging of partial sketches.
+    size_t NR = 2, NC = 5000;
+    auto dump = simulate_sparse_vector<double>(NR * NC, 0.5, -10, 10);
+    auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, dump));
+    auto dense_column = tatami::convert_to_dense<false>(dense_row.get());
+    auto sparse_column = tatami::convert_to_sparse<false>(dense_row.get());
+
+    for (double prob : { 0.05, 0.5, 0.95 }) {
+        auto serial = tatami::row_approximate_quantiles(dense_column.get(), prob, 1, 50);
+        EXPECT_EQ(serial, tatami::row_approximate_quantiles(sparse_column.get(), prob, 1, 50));
+        EXPECT_EQ(serial, tatami::row_approximate_quantiles(dense_row.get(), prob, 1, 50));
+
+        auto parallel = tatami::row_approximate_quantiles(sparse_column.get(), prob, 3, 50);
+        auto dparallel = tatami::row_approximate_quantiles(dense_column.get(), prob, 3, 50);
+
+        // Checking that the ranks of the approximations are close to the requested probability.
+        for (size_t r = 0; r < NR; ++r) {
+            std::vector<double> row(dump.begin() + r * NC, dump.begin() + (r + 1) * NC);
+            std::sort(row.begin(), row.end());
+            for (auto approx : { serial[r], parallel[r], dparallel[r] }) {
+                double lower = static_cast<double>(std::lower_bound(row.begin(), row.end(), approx) - row.begin()) / NC;
+                double upper = static_cast<double>(std::upper_bound(row.begin(), row.end(), approx) - row.begin()) / NC;
+                EXPECT_GT(prob, lower - 0.05);
+                EXPECT_LT(prob, upper + 0.05);
+            }
+        }
+    }
+}
+
+TEST(QuantileSketch, Merge) {
+    auto values = simulate_dense_vector<double>(10000, -5, 5);
+
+    tatami::stats::QuantileSketch full(100), left(100), right(100);
+    for (size_t i = 0; i < values.size(); ++i) {
+        full.add(values[i]);
+        (i < values.size() / 3 ? left : right).add(values[i]);
+    }
+    left.merge(right);
+    EXPECT_EQ(left.count(), values.size());
+    EXPECT_EQ(full.count(), values.size());
+
+    for (double prob : { 0.01, 0.25, 0.5, 0.75, 0.99 }) {
+        double expected = reference_quantile(values, prob);
+        EXPECT_LT(std::abs(full.quantile(prob) - expected), 0.3);
+        EXPECT_LT(std::abs(left.quantile(prob) - expected), 0.3);
+    }
+
+    // Implicit zeros are respected.
+    tatami::stats::QuantileSketch small;
+    small.add(1);
+    small.add(2);
+    EXPECT_EQ(small.quantile(0.5, 3), 0);
+    EXPECT_EQ(small.quantile(std::vector<double>{ 1, 0.5 }, 3), std::vector<double>({ 2, 0 }));
+    EXPECT_EQ(small.quantile(1, 3), 2);
+    EXPECT_DOUBLE_EQ(small.quantile(0.5, 1), 1);
+
+    small.clear();
+    EXPECT_EQ(small.count(), 0);
+    EXPECT_TRUE(std::isnan(small.quantile(0.5)));
+}
+
+TEST(QuantileSketch, ExactAtCapacity) {
+    // No compaction occurs with exactly 'k' observations.
+    size_t k = 50;
+    auto values = simulate_dense_vector<double>(k, -5, 5);
+    tatami::stats::QuantileSketch sketch(k);
+    for (auto v : values) {
+        sketch.add(v);
+    }
+
+    for (double prob : { 0.0, 0.01, 0.25, 0.5, 0.75, 0.99, 1.0 }) {
+        EXPECT_DOUBLE_EQ(sketch.quantile(prob), reference_quantile(values, prob));
+    }
+
+    // One more observation triggers compaction without losing any weight.
+    sketch.add(0);
+    EXPECT_EQ(sketch.count(), k + 1);
+}
+
+TEST(ComputingDimQuantiles, Configuration) {
+    typedef tatami::stats::QuantileFactory<double> QuantFact;
+    EXPECT_FALSE(tatami::stats::has_dense_running<QuantFact>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_direct<QuantFact>::value);
+
+    typedef tatami::stats::MadFactory<double> MadFact;
+    EXPECT_FALSE(tatami::stats::has_dense_running<MadFact>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_direct<MadFact>::value);
+
+    typedef tatami::stats::ApproximateQuantileFactory<double> ApproxFact;
+    EXPECT_TRUE(tatami::stats::has_sparse_direct<ApproxFact>::value);
+    EXPECT_TRUE(tatami::stats::has_dense_running<ApproxFact>::value);
+    EXPECT_TRUE(tatami::stats::has_dense_running_parallel<ApproxFact>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_running<ApproxFact>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_running_parallel<ApproxFact>::value);
+    EXPECT_TRUE(tatami::stats::has_dense_running_partial<ApproxFact>::value);
+    EXPECT_TRUE(tatami::stats::has_sparse_running_partial<ApproxFact>::value);
+}
@@ -14,6 +14,16 @@
 
 #include "../data/data.h"
 
+// Sums are computed in a different order in each calculation mode, see kernels.hpp.
+template<class L, class R>
+void compare_double_vectors (const L& left, const R& right) {
+    ASSERT_EQ(left.size(), right.size());
+    for (size_t i = 0; i < left.size(); ++i) {
+        EXPECT_FLOAT_EQ(left[i], right[i]);
+    }
+    return;
+}
+
 TEST(ComputingDimsums, RowSums) {
     auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
     auto dense_column = tatami::convert_to_dense<false>(dense_row.get());
@@ -27,16 +37,16 @@ TEST(ComputingDimsums, RowSums) {
         }
     }
 
-    EXPECT_EQ(ref, tatami::row_sums(dense_row.get()));
-    EXPECT_EQ(ref, tatami::row_sums(dense_column.get()));
-    EXPECT_EQ(ref, tatami::row_sums(sparse_row.get()));
-    EXPECT_EQ(ref, tatami::row_sums(sparse_column.get()));
+    compare_double_vectors(ref, tatami::row_sums(dense_row.get()));
+    compare_double_vectors(ref, tatami::row_sums(dense_column.get()));
+    compare_double_vectors(ref, tatami::row_sums(sparse_row.get()));
+    compare_double_vectors(ref, tatami::row_sums(sparse_column.get()));
 
     // Checking same results from parallel code.
-    EXPECT_EQ(ref, tatami::row_sums(dense_row.get(), 3));
-    EXPECT_EQ(ref, tatami::row_sums(dense_column.get(), 3));
-    EXPECT_EQ(ref, tatami::row_sums(sparse_row.get(), 3));
-    EXPECT_EQ(ref, tatami::row_sums(sparse_column.get(), 3));
+    compare_double_vectors(ref, tatami::row_sums(dense_row.get(), 3));
+    compare_double_vectors(ref, tatami::row_sums(dense_column.get(), 3));
+    compare_double_vectors(ref, tatami::row_sums(sparse_row.get(), 3));
+    compare_double_vectors(ref, tatami::row_sums(sparse_column.get(), 3));
 }
 
 TEST(ComputingDimsums, ColumnSums) {
@@ -52,16 +62,16 @@ TEST(ComputingDimsums, ColumnSums) {
         }
     }
 
-    EXPECT_EQ(ref, tatami::column_sums(dense_row.get()));
-    EXPECT_EQ(ref, tatami::column_sums(dense_column.get()));
-    EXPECT_EQ(ref, tatami::column_sums(sparse_row.get()));
-    EXPECT_EQ(ref, tatami::column_sums(sparse_column.get()));
+    compare_double_vectors(ref, tatami::column_sums(dense_row.get()));
+    compare_double_vectors(ref, tatami::column_sums(dense_column.get()));
+    compare_double_vectors(ref, tatami::column_sums(sparse_row.get()));
+    compare_double_vectors(ref, tatami::column_sums(sparse_column.get()));
 
     // Checking same results from parallel code.
-    EXPECT_EQ(ref, tatami::column_sums(dense_column.get(), 3));
-    EXPECT_EQ(ref, tatami::column_sums(dense_column.get(), 3));
-    EXPECT_EQ(ref, tatami::column_sums(sparse_column.get(), 3));
-    EXPECT_EQ(ref, tatami::column_sums(sparse_column.get(), 3));
+    compare_double_vectors(ref, tatami::column_sums(dense_column.get(), 3));
+    compare_double_vectors(ref, tatami::column_sums(dense_column.get(), 3));
+    compare_double_vectors(ref, tatami::column_sums(sparse_column.get(), 3));
+    compare_double_vectors(ref, tatami::column_sums(sparse_column.get(), 3));
 }
 
 TEST(ComputingDimsums, Configuration) {
@@ -147,3 +147,36 @@ TEST(RunningVariances, SensibleZeros) {
 
     EXPECT_EQ(ref_nzeros, running_nzeros);
 }
+
+TEST(RunningVariances, Merge) {
+    auto dense_row = std::unique_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(sparse_nrow, sparse_ncol, sparse_matrix));
+    size_t NR = dense_row->nrow();
+    size_t NC = dense_row->ncol();
+    auto ref = tatami::row_variances(dense_row.get());
+
+    // Splitting the columns into two uneven subsets and merging the results.
+    int split = NC / 3;
+    std::vector<double> means1(NR), vars1(NR), means2(NR), vars2(NR);
+    int count = 0, count2 = 0;
+    for (int c = 0; c < static_cast<int>(NC); ++c) {
+        auto col = dense_row->column(c);
+        if (c < split) {
+            tatami::stats::variances::compute_running(col.data(), NR, means1.data(), vars1.data(), count);
+        } else {
+            tatami::stats::variances::compute_running(col.data(), NR, means2.data(), vars2.data(), count2);
+        }
+    }
+
+    tatami::stats::variances::merge_running(NR, means1.data(), vars1.data(), count, means2.data(), vars2.data(), count2);
+    EXPECT_EQ(count, static_cast<int>(NC));
+    tatami::stats::variances::finish_running(NR, means1.data(), vars1.data(), count);
+    compare_double_vectors(vars1, ref);
+
+    // Merging into an empty set.
+    std::vector<double> means0(NR), vars0(NR);
+    int count0 = 0;
+    tatami::stats::variances::merge_running(NR, means0.data(), vars0.data(), count0, means1.data(), vars1.data(), count);
+    EXPECT_EQ(count0, static_cast<int>(NC));
+    EXPECT_EQ(means0, means1);
+    EXPECT_EQ(vars0, vars1);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "tatami/utils/ThreadPool.hpp"
+#include "tatami/base/DenseMatrix.hpp"
+#include "tatami/utils/convert_to_sparse.hpp"
+#include "tatami/stats/sums.hpp"
+#include "tatami/stats/variances.hpp"
+#include "../_tests/simulate_vector.h"
+
+#include <vector>
+#include <thread>
+#include <stdexcept>
+
+TEST(ThreadPool, Basic) {
+    for (int nthreads : { 0, 1, 3 }) {
+        tatami::ThreadPool pool(nthreads);
+        EXPECT_EQ(pool.num_threads(), std::max(1, nthreads));
+
+        for (size_t n : { 0, 1, 2, 10, 101 }) {
+            std::vector<int> visited(n);
+            pool.run(n, [&](size_t j) -> void {
+                ++visited[j];
+            });
+            EXPECT_EQ(visited, std::vector<int>(n, 1));
+        }
+    }
+}
+
+TEST(ThreadPool, Exception) {
+    tatami::ThreadPool pool(3);
+    std::vector<int> visited(10);
+    EXPECT_THROW({
+        pool.run(visited.size(), [&](size_t j) -> void {
+            ++visited[j];
+            if (j == 5) {
+                throw std::runtime_error("oops");
+            }
+        });
+    }, std::runtime_error);
+
+    // All jobs still run, and the pool is still usable afterwards.
+    EXPECT_EQ(visited, std::vector<int>(visited.size(), 1));
+    pool.run(visited.size(), [&](size_t j) -> void {
+        ++visited[j];
+    });
+    EXPECT_EQ(visited, std::vector<int>(visited.size(), 2));
+}
+
+TEST(ThreadPool, Nested) {
+    tatami::ThreadPool pool(3);
+    size_t outer = 5, inner = 7;
+    std::vector<int> visited(outer * inner);
+    pool.run(outer, [&](size_t i) -> void {
+        pool.run(inner, [&](size_t j) -> void {
+            ++visited[i * inner + j];
+        });
+    });
+    EXPECT_EQ(visited, std::vector<int>(visited.size(), 1));
+}
+
+TEST(ThreadPool, Shared) {
+    tatami::ThreadPool pool(2);
+    size_t ncallers = 4, n = 50;
+    std::vector<std::vector<int> > visited(ncallers, std::vector<int>(n));
+
+    std::vector<std::thread> callers;
+    for (size_t c = 0; c < ncallers; ++c) {
+        callers.emplace_back([&](size_t c) -> void {
+            for (int rep = 0; rep < 10; ++rep) {
+                pool.run(n, [&](size_t j) -> void {
+                    ++visited[c][j];
+                });
+            }
+        }, c);
+    }
+    for (auto& c : callers) {
+        c.join();
+    }
+
+    for (size_t c = 0; c < ncallers; ++c) {
+        EXPECT_EQ(visited[c], std::vector<int>(n, 10));
+    }
+}
+
+/*****************************************/
+
+TEST(ThreadPool, Apply) {
+    size_t NR = 55, NC = 23;
+    auto vec = simulate_sparse_vector<double>(NR * NC, 0.2);
+    auto dense = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double>(NR, NC, vec));
+    auto sparse = tatami::convert_to_sparse<false>(dense.get());
+    tatami::ThreadPool pool(3);
+
+    for (auto ptr : { dense, sparse }) {
+        for (auto schedule : { tatami::APPLY_SCHEDULE_STATIC, tatami::APPLY_SCHEDULE_DYNAMIC }) {
+            std::vector<double> rows(NR);
+            tatami::stats::SumFactory rfactory(rows.data(), NR, NC);
+            tatami::apply<0>(ptr.get(), rfactory, pool, schedule);
+            EXPECT_EQ(rows, tatami::row_sums(ptr.get()));
+
+            std::vector<double> cols(NC);
+            tatami::stats::SumFactory cfactory(cols.data(), NC, NR);
+            tatami::apply<1>(ptr.get(), cfactory, pool, schedule);
+            EXPECT_EQ(cols, tatami::column_sums(ptr.get()));
+
+            // Variances use different algorithms depending on the access pattern, so we only check for approximate equality.
+            std::vector<double> vars(NC);
+            tatami::stats::VarianceFactory vfactory(vars.data(), NC, NR);
+            tatami::apply<1>(ptr.get(), vfactory, pool, schedule);
+            auto ref = tatami::column_variances(ptr.get());
+            for (size_t c = 0; c < NC; ++c) {
+                EXPECT_FLOAT_EQ(vars[c], ref[c]);
+            }
+        }
+    }
+}
@@ -91,3 +91,27 @@ TEST(ConvertToDense, Automatic) {
         EXPECT_TRUE(converted->prefer_rows());
     }
 }
+
+TEST(ConvertToDense, Parallel) {
+    size_t NR = 70, NC = 50;
+    auto vec = simulate_sparse_vector<double>(NR * NC, 0.15);
+    tatami::DenseMatrix<true, double, int> mat(NR, NC, vec);
+    tatami::ThreadPool pool(3);
+
+    auto par_row = tatami::convert_to_dense<true>(&mat, 3);
+    auto par_col = tatami::convert_to_dense<false>(&mat, 3);
+    auto pool_row = tatami::convert_to_dense<true>(&mat, pool);
+    auto pool_col = tatami::convert_to_dense<false, decltype(mat), int, size_t>(&mat, pool); // works for a different type.
+    EXPECT_TRUE(pool_row->prefer_rows());
+    EXPECT_FALSE(pool_col->prefer_rows());
+
+    for (size_t i = 0; i < NR; ++i) {
+        auto start = vec.begin() + i * NC;
+        std::vector<double> expected(start, start + NC);
+        EXPECT_EQ(par_row->row(i), expected);
+        EXPECT_EQ(par_col->row(i), expected);
+        EXPECT_EQ(pool_row->row(i), expected);
+        std::vector<int> expected2(start, start + NC);
+        EXPECT_EQ(pool_col->row(i), expected2);
+    }
+}
@@ -91,3 +91,36 @@ TEST(ConvertToSparse, Automatic) {
         EXPECT_TRUE(converted->prefer_rows());
     }
 }
+
+TEST(ConvertToSparse, Parallel) {
+    size_t NR = 70, NC = 50;
+    auto vec = simulate_sparse_vector<double>(NR * NC, 0.15);
+    tatami::DenseMatrix<true, double, int> dense(NR, NC, vec);
+    auto sparse = tatami::convert_to_sparse<false>(&dense);
+    tatami::ThreadPool pool(3);
+
+    std::vector<const tatami::NumericMatrix*> inputs { &dense, sparse.get() };
+    for (auto mat : inputs) {
+        auto ref_row = tatami::convert_to_sparse<true>(mat);
+        auto ref_col = tatami::convert_to_sparse<false>(mat);
+
+        auto par_row = tatami::convert_to_sparse<true>(mat, 0.1, 3);
+        auto par_col = tatami::convert_to_sparse<false>(mat, 0.1, 3);
+        auto pool_row = tatami::convert_to_sparse<true>(mat, 0.1, pool);
+        auto pool_col = tatami::convert_to_sparse<false>(mat, 0.1, pool);
+
+        for (size_t i = 0; i < NR; ++i) {
+            auto expected = ref_row->row(i);
+            EXPECT_EQ(par_row->row(i), expected);
+            EXPECT_EQ(pool_row->row(i), expected);
+            EXPECT_EQ(par_col->row(i), expected);
+            EXPECT_EQ(pool_col->row(i), expected);
+        }
+
+        for (size_t i = 0; i < NC; ++i) {
+            auto expected = ref_col->column(i);
+            EXPECT_EQ(par_col->column(i), expected);
+            EXPECT_EQ(pool_col->column(i), expected);
+        }
+    }
+}